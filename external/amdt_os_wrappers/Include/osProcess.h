@@ -101,14 +101,15 @@ OS_API bool osExecAndGrabOutput(const char* cmd, const bool& cancelSignal, gtStr
 
 #ifdef _WIN32
 OS_API bool osExecAndGrabOutputAndError(const char* cmd, const bool& cancelSignal,
-    const gtString& workingDir, gtString& cmdOutput, gtString& cmdErrOutput);
+    const gtString& workingDir, gtString& cmdOutput, gtString& cmdErrOutput, long* pExitCode = NULL);
 
 OS_API bool osExecAndGrabOutputAndErrorDebug(const char*     cmd, 
                                              const bool&     cancel_signal,
                                              const gtString& working_dir,
                                              gtString&       cmd_output,
                                              gtString&       cmd_er_output,
-                                             gtString&       cmd_debug_output);
+                                             gtString&       cmd_debug_output,
+                                             long*           exit_code = NULL);
 #endif
 
 OS_API bool osGetMemoryUsage(const unsigned int processID,
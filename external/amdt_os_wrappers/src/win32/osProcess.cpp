@@ -1729,12 +1729,13 @@ OS_API bool osExecAndGrabOutput(const char* cmd, const bool& cancelSignal, gtStr
 //              workingDir - the working directory to set for the launched process.
 //              cmdErrOutput - an output parameter to hold the command's stderr output.
 //              cmdOutput - an output parameter to hold the command's stdout output.
+//              pExitCode - an optional output parameter to hold the command's exit code.
 // Return Val:  bool - Success / failure.
 // Author:      AMD Developer Tools Team
 // Date:        03/07/2019
 // ---------------------------------------------------------------------------
 OS_API bool osExecAndGrabOutputAndError(const char* cmd, const bool& cancelSignal,
-    const gtString& workingDir, gtString& cmdOutput, gtString& cmdErrOutput)
+    const gtString& workingDir, gtString& cmdOutput, gtString& cmdErrOutput, long* pExitCode)
 {
     bool ret = false;
     SECURITY_ATTRIBUTES sa;
@@ -1831,6 +1832,13 @@ OS_API bool osExecAndGrabOutputAndError(const char* cmd, const bool& cancelSigna
 
             if (!cancelSignal)
             {
+                // Read the exit code of the process.
+                DWORD exitCode = 0;
+                if (pExitCode != NULL && GetExitCodeProcess(pi.hProcess, &exitCode))
+                {
+                    *pExitCode = static_cast<long>(exitCode);
+                }
+
                 CloseHandle(pi.hProcess);
                 CloseHandle(pi.hThread);
                 CloseHandle(hOut);
@@ -1912,6 +1920,7 @@ OS_API bool osExecAndGrabOutputAndError(const char* cmd, const bool& cancelSigna
 //              cmdDebugOutput - an output parameter to hold the command's debug output.
 //              cmdErrOutput - an output parameter to hold the command's stderr output.
 //              cmdOutput - an output parameter to hold the command's stdout output.
+//              exit_code - an optional output parameter to hold the command's exit code.
 // Return Val:  bool - Success / failure.
 // Author:      AMD Developer Tools Team
 // Date:        10/26/2023
@@ -1921,7 +1930,8 @@ OS_API bool osExecAndGrabOutputAndErrorDebug(const char*     cmd,
                                              const gtString& working_dir,
                                              gtString&       cmd_output,
                                              gtString&       cmd_err_output,
-                                             gtString&       cmd_debug_output)
+                                             gtString&       cmd_debug_output,
+                                             long*           exit_code)
 {
     bool                ret = false;
     SECURITY_ATTRIBUTES sa;
@@ -2069,6 +2079,13 @@ OS_API bool osExecAndGrabOutputAndErrorDebug(const char*     cmd,
 
             if (!cancel_signal)
             {
+                // Read the exit code of the process.
+                DWORD process_exit_code = 0;
+                if (exit_code != NULL && GetExitCodeProcess(pi.hProcess, &process_exit_code))
+                {
+                    *exit_code = static_cast<long>(process_exit_code);
+                }
+
                 CloseHandle(pi.hProcess);
                 CloseHandle(pi.hThread);
                 CloseHandle(h_out);
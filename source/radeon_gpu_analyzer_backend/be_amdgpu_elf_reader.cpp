@@ -0,0 +1,398 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the in-process reader of AMDGPU code objects.
+//=============================================================================
+
+// C++.
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+// Infra.
+#include "CElf.h"
+
+// Yaml.
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4127)
+#endif
+#include "yaml-cpp/yaml.h"
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+// Local.
+#include "radeon_gpu_analyzer_backend/be_amdgpu_elf_reader.h"
+
+// The note that holds the code object metadata (code object V3 and later).
+static const char*    kAmdgpuNoteName       = "AMDGPU";
+static const uint32_t kNtAmdgpuMetadata     = 32;
+static const size_t   kElfNoteHeaderSize    = 3 * sizeof(uint32_t);
+static const size_t   kElfNoteAlignment     = 4;
+
+// The maximum nesting depth of the MessagePack documents (the metadata is only a few levels deep).
+static const int kMaxMsgPackDepth = 64;
+
+// Round the value up to a multiple of the ELF note alignment.
+static size_t AlignNoteOffset(size_t value)
+{
+    return (value + kElfNoteAlignment - 1) & ~(kElfNoteAlignment - 1);
+}
+
+// Format a floating-point value of the metadata the way llvm-readobj prints it ("1.000000e+00").
+static std::string FormatFloat(double value)
+{
+    std::string ret;
+    if (std::isnan(value))
+    {
+        ret = "nan";
+    }
+    else if (std::isinf(value))
+    {
+        ret = (value < 0 ? "-INF" : "INF");
+    }
+    else
+    {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%e", value);
+        ret = text;
+    }
+    return ret;
+}
+
+// A decoder of MessagePack documents into YAML nodes.
+class MsgPackDecoder
+{
+public:
+    explicit MsgPackDecoder(const std::vector<char>& data)
+        : data_(data)
+    {
+    }
+
+    // Decode the next object in the document.
+    bool Decode(YAML::Node& node, int depth)
+    {
+        uint64_t tag = 0;
+        bool     ret = (depth < kMaxMsgPackDepth) && ReadUint(1, tag);
+        if (ret)
+        {
+            if (tag <= 0x7f)
+            {
+                // Positive fixint.
+                node = std::to_string(tag);
+            }
+            else if (tag <= 0x8f)
+            {
+                ret = DecodeMap(tag & 0x0f, node, depth);
+            }
+            else if (tag <= 0x9f)
+            {
+                ret = DecodeArray(tag & 0x0f, node, depth);
+            }
+            else if (tag <= 0xbf)
+            {
+                ret = DecodeString(tag & 0x1f, node);
+            }
+            else if (tag >= 0xe0)
+            {
+                // Negative fixint.
+                node = std::to_string(static_cast<int8_t>(tag));
+            }
+            else
+            {
+                ret = DecodeTagged(static_cast<uint8_t>(tag), node, depth);
+            }
+        }
+
+        return ret;
+    }
+
+    // True if the whole document was decoded.
+    bool IsDone() const
+    {
+        return offset_ == data_.size();
+    }
+
+private:
+    // Decode an object whose tag is in the range [0xc0, 0xdf].
+    bool DecodeTagged(uint8_t tag, YAML::Node& node, int depth)
+    {
+        bool     ret  = true;
+        uint64_t size = 0;
+        switch (tag)
+        {
+        case 0xc0:
+            node = YAML::Node(YAML::NodeType::Null);
+            break;
+        case 0xc2:
+            node = "false";
+            break;
+        case 0xc3:
+            node = "true";
+            break;
+        case 0xc4:
+        case 0xc5:
+        case 0xc6:
+            // Binary data.
+            ret = ReadUint(size_t(1) << (tag - 0xc4), size) && DecodeString(size, node);
+            break;
+        case 0xc7:
+        case 0xc8:
+        case 0xc9:
+            // Extension types are not used by the metadata. Skip the type and the data.
+            ret = ReadUint(size_t(1) << (tag - 0xc7), size) && Skip(size + 1);
+            node = YAML::Node(YAML::NodeType::Null);
+            break;
+        case 0xca:
+        {
+            uint64_t bits = 0;
+            float    value;
+            uint32_t value_bits;
+            ret        = ReadUint(4, bits);
+            value_bits = static_cast<uint32_t>(bits);
+            std::memcpy(&value, &value_bits, sizeof(value));
+            node = FormatFloat(value);
+            break;
+        }
+        case 0xcb:
+        {
+            uint64_t bits = 0;
+            double   value;
+            ret = ReadUint(8, bits);
+            std::memcpy(&value, &bits, sizeof(value));
+            node = FormatFloat(value);
+            break;
+        }
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+        {
+            uint64_t value = 0;
+            ret            = ReadUint(size_t(1) << (tag - 0xcc), value);
+            node           = std::to_string(value);
+            break;
+        }
+        case 0xd0:
+        case 0xd1:
+        case 0xd2:
+        case 0xd3:
+        {
+            // Sign-extend the value.
+            const size_t byte_count = size_t(1) << (tag - 0xd0);
+            uint64_t     value      = 0;
+            ret                     = ReadUint(byte_count, value);
+            const int    shift      = static_cast<int>(64 - 8 * byte_count);
+            node                    = std::to_string(static_cast<int64_t>(value << shift) >> shift);
+            break;
+        }
+        case 0xd4:
+        case 0xd5:
+        case 0xd6:
+        case 0xd7:
+        case 0xd8:
+            // Fixed-size extension types. Skip the type and the data.
+            ret  = Skip((size_t(1) << (tag - 0xd4)) + 1);
+            node = YAML::Node(YAML::NodeType::Null);
+            break;
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            ret = ReadUint(size_t(1) << (tag - 0xd9), size) && DecodeString(size, node);
+            break;
+        case 0xdc:
+        case 0xdd:
+            ret = ReadUint(tag == 0xdc ? 2 : 4, size) && DecodeArray(size, node, depth);
+            break;
+        case 0xde:
+        case 0xdf:
+            ret = ReadUint(tag == 0xde ? 2 : 4, size) && DecodeMap(size, node, depth);
+            break;
+        default:
+            // 0xc1 is never used.
+            ret = false;
+            break;
+        }
+
+        return ret;
+    }
+
+    bool DecodeArray(uint64_t count, YAML::Node& node, int depth)
+    {
+        // Each element takes at least one byte, which bounds the count of a malformed document.
+        bool ret = (count <= data_.size() - offset_);
+        node     = YAML::Node(YAML::NodeType::Sequence);
+        for (uint64_t i = 0; ret && i < count; i++)
+        {
+            YAML::Node element;
+            ret = Decode(element, depth + 1);
+            node.push_back(element);
+        }
+        return ret;
+    }
+
+    bool DecodeMap(uint64_t count, YAML::Node& node, int depth)
+    {
+        bool ret = (count <= data_.size() - offset_);
+        node     = YAML::Node(YAML::NodeType::Map);
+        for (uint64_t i = 0; ret && i < count; i++)
+        {
+            YAML::Node key, value;
+            ret = Decode(key, depth + 1) && key.IsScalar() && Decode(value, depth + 1);
+            if (ret)
+            {
+                node[key.Scalar()] = value;
+            }
+        }
+        return ret;
+    }
+
+    bool DecodeString(uint64_t size, YAML::Node& node)
+    {
+        bool ret = (size <= data_.size() - offset_);
+        if (ret)
+        {
+            node = std::string(data_.data() + offset_, static_cast<size_t>(size));
+            offset_ += static_cast<size_t>(size);
+        }
+        return ret;
+    }
+
+    // Read a big-endian unsigned integer.
+    bool ReadUint(size_t byte_count, uint64_t& value)
+    {
+        bool ret = (byte_count <= data_.size() - offset_);
+        if (ret)
+        {
+            value = 0;
+            for (size_t i = 0; i < byte_count; i++)
+            {
+                value = (value << 8) | static_cast<uint8_t>(data_[offset_++]);
+            }
+        }
+        return ret;
+    }
+
+    bool Skip(uint64_t size)
+    {
+        bool ret = (size <= data_.size() - offset_);
+        if (ret)
+        {
+            offset_ += static_cast<size_t>(size);
+        }
+        return ret;
+    }
+
+    const std::vector<char>& data_;
+    size_t                   offset_ = 0;
+};
+
+BeAmdgpuElfReader::BeAmdgpuElfReader()
+{
+}
+
+BeAmdgpuElfReader::~BeAmdgpuElfReader()
+{
+}
+
+bool BeAmdgpuElfReader::Load(const std::string& filename)
+{
+    elf_ = std::make_unique<CElf>(filename);
+    if (!elf_->good())
+    {
+        elf_.reset();
+    }
+    return (elf_ != nullptr);
+}
+
+bool BeAmdgpuElfReader::GetSymbols(std::vector<Symbol>& symbols) const
+{
+    const CElfSymbolTable* symbol_table = (elf_ != nullptr ? elf_->GetSymbolTable() : nullptr);
+    bool                   ret          = (symbol_table != nullptr);
+    if (ret)
+    {
+        symbols.clear();
+        symbols.reserve(symbol_table->GetNumSymbols());
+        for (auto iter = symbol_table->SymbolsBegin(); ret && iter != symbol_table->SymbolsEnd(); ++iter)
+        {
+            Symbol         symbol;
+            unsigned char  bind = 0, type = 0, other = 0;
+            CElfSection*   section = nullptr;
+            Elf64_Addr     value   = 0;
+            Elf64_Xword    size    = 0;
+            ret = symbol_table->GetInfo(iter, &symbol.name, &bind, &type, &other, &section, &value, &size);
+            if (ret)
+            {
+                symbol.section = (section != nullptr ? section->GetName() : "");
+                symbol.value   = value;
+                symbol.size    = size;
+                symbol.type    = type;
+                symbols.push_back(symbol);
+            }
+        }
+    }
+    return ret;
+}
+
+bool BeAmdgpuElfReader::GetSectionData(const std::string& section_name, std::vector<char>& data) const
+{
+    const CElfSection* section = (elf_ != nullptr ? elf_->GetSection(section_name) : nullptr);
+    if (section != nullptr)
+    {
+        data = section->GetData();
+    }
+    return (section != nullptr);
+}
+
+bool BeAmdgpuElfReader::GetMetadata(YAML::Node& metadata) const
+{
+    bool ret = false;
+    if (elf_ != nullptr)
+    {
+        const size_t kNoteNameSize = std::strlen(kAmdgpuNoteName) + 1;
+        for (auto iter = elf_->SectionsBegin(); !ret && iter != elf_->SectionsEnd(); ++iter)
+        {
+            if ((*iter)->GetType() != SHT_NOTE)
+            {
+                continue;
+            }
+
+            // Go over the notes in the section: {name size, descriptor size, type, name, descriptor},
+            // where the name and the descriptor are padded to the note alignment.
+            const std::vector<char>& notes  = (*iter)->GetData();
+            size_t                   offset = 0;
+            while (!ret && offset + kElfNoteHeaderSize <= notes.size())
+            {
+                uint32_t header[3];
+                std::memcpy(header, notes.data() + offset, sizeof(header));
+                const size_t name_offset = offset + kElfNoteHeaderSize;
+                const size_t desc_offset = AlignNoteOffset(name_offset + header[0]);
+                const size_t desc_end    = desc_offset + header[1];
+                if (desc_end > notes.size() || desc_offset < name_offset)
+                {
+                    break;
+                }
+
+                if (header[2] == kNtAmdgpuMetadata && header[0] == kNoteNameSize &&
+                    std::memcmp(notes.data() + name_offset, kAmdgpuNoteName, kNoteNameSize) == 0)
+                {
+                    const std::vector<char> descriptor(notes.begin() + desc_offset, notes.begin() + desc_end);
+                    ret = DecodeMsgPack(descriptor, metadata);
+                    break;
+                }
+                offset = AlignNoteOffset(desc_end);
+            }
+        }
+    }
+    return ret;
+}
+
+bool BeAmdgpuElfReader::DecodeMsgPack(const std::vector<char>& msgpack, YAML::Node& node)
+{
+    MsgPackDecoder decoder(msgpack);
+    return decoder.Decode(node, 0) && decoder.IsDone();
+}
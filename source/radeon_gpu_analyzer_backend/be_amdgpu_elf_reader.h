@@ -0,0 +1,63 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for the in-process reader of AMDGPU code objects.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERBACKEND_SRC_BE_AMDGPU_ELF_READER_H_
+#define RGA_RADEONGPUANALYZERBACKEND_SRC_BE_AMDGPU_ELF_READER_H_
+
+// C++.
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CElf;
+namespace YAML
+{
+    class Node;
+}
+
+// Reads the symbol table, the sections and the metadata of an AMDGPU code object in-process,
+// without launching llvm-readobj.
+class BeAmdgpuElfReader
+{
+public:
+    // A symbol from the symbol table of the code object.
+    struct Symbol
+    {
+        std::string name;
+        std::string section;
+        uint64_t    value = 0;
+        uint64_t    size  = 0;
+        unsigned    type  = 0;
+    };
+
+    BeAmdgpuElfReader();
+    ~BeAmdgpuElfReader();
+
+    // Load the code object from the given file.
+    // Returns false if the file cannot be read or is not a supported ELF file.
+    bool Load(const std::string& filename);
+
+    // Get the symbols of the symbol table, in the order of the table.
+    bool GetSymbols(std::vector<Symbol>& symbols) const;
+
+    // Get the content of the section with the given name.
+    bool GetSectionData(const std::string& section_name, std::vector<char>& data) const;
+
+    // Get the code object metadata (the MessagePack NT_AMDGPU_METADATA note) as a YAML node,
+    // with the same structure as the metadata that is printed by llvm-readobj.
+    bool GetMetadata(YAML::Node& metadata) const;
+
+    // Decode a MessagePack document into a YAML node.
+    // Returns false if the document is malformed.
+    static bool DecodeMsgPack(const std::vector<char>& msgpack, YAML::Node& node);
+
+private:
+    std::unique_ptr<CElf> elf_;
+};
+
+#endif  // RGA_RADEONGPUANALYZERBACKEND_SRC_BE_AMDGPU_ELF_READER_H_
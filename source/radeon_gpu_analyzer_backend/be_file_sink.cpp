@@ -0,0 +1,78 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for rga backend buffered output file sink.
+//=============================================================================
+
+// C++.
+#include <cstring>
+
+// Local.
+#include "radeon_gpu_analyzer_backend/be_file_sink.h"
+
+BeFileSink::BeFileSink(size_t buffer_size) : buffer_(buffer_size > 0 ? buffer_size : kDefaultBufferSize)
+{
+}
+
+BeFileSink::~BeFileSink()
+{
+    Close();
+}
+
+bool BeFileSink::Open(const std::string& file_name)
+{
+    Close();
+
+    file_          = std::fopen(file_name.c_str(), "w");
+    buffered_size_ = 0;
+    is_good_       = (file_ != nullptr);
+    return is_good_;
+}
+
+bool BeFileSink::Write(std::string_view text)
+{
+    if (is_good_)
+    {
+        if (buffer_.size() - buffered_size_ < text.size())
+        {
+            is_good_ = Flush();
+        }
+
+        if (is_good_)
+        {
+            if (text.size() < buffer_.size())
+            {
+                std::memcpy(buffer_.data() + buffered_size_, text.data(), text.size());
+                buffered_size_ += text.size();
+            }
+            else
+            {
+                // The text does not fit in the buffer: write it directly.
+                is_good_ = (std::fwrite(text.data(), 1, text.size(), file_) == text.size());
+            }
+        }
+    }
+
+    return is_good_;
+}
+
+bool BeFileSink::Close()
+{
+    bool ret = false;
+    if (file_ != nullptr)
+    {
+        ret = is_good_ && Flush();
+        ret = (std::fclose(file_) == 0) && ret;
+        file_ = nullptr;
+    }
+    is_good_ = false;
+    return ret;
+}
+
+bool BeFileSink::Flush()
+{
+    bool ret = (std::fwrite(buffer_.data(), 1, buffered_size_, file_) == buffered_size_);
+    buffered_size_ = 0;
+    return ret;
+}
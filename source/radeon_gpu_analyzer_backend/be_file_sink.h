@@ -0,0 +1,62 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for rga backend buffered output file sink.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERBACKEND_SRC_BE_FILE_SINK_H_
+#define RGA_RADEONGPUANALYZERBACKEND_SRC_BE_FILE_SINK_H_
+
+// C++.
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Buffered text file writer.
+// The sink can be reopened for a different file after it was closed, in which case the write buffer is reused.
+class BeFileSink
+{
+public:
+    // Default size of the write buffer, in bytes.
+    static const size_t kDefaultBufferSize = 64 * 1024;
+
+    explicit BeFileSink(size_t buffer_size = kDefaultBufferSize);
+    ~BeFileSink();
+
+    BeFileSink(const BeFileSink&)            = delete;
+    BeFileSink& operator=(const BeFileSink&) = delete;
+
+    // Open the given file for writing, truncating it. A file that is already open is closed first.
+    bool Open(const std::string& file_name);
+
+    // Append the given text to the file.
+    // Returns false if the file is not open or if writing to it failed.
+    bool Write(std::string_view text);
+
+    // Flush the buffered text and close the file.
+    // Returns true if all of the text was successfully written.
+    bool Close();
+
+    // Returns true if a file is currently open.
+    bool IsOpen() const { return file_ != nullptr; }
+
+private:
+    // Write the buffered text to the file.
+    bool Flush();
+
+    // The output file.
+    std::FILE* file_ = nullptr;
+
+    // The write buffer.
+    std::vector<char> buffer_;
+
+    // Number of bytes in the write buffer that were not written to the file yet.
+    size_t buffered_size_ = 0;
+
+    // True if no write to the current file has failed.
+    bool is_good_ = false;
+};
+
+#endif  // RGA_RADEONGPUANALYZERBACKEND_SRC_BE_FILE_SINK_H_
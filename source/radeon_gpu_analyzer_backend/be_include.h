@@ -228,7 +228,8 @@ struct AnalysisData
         num_alu_instructions(0),
         num_instructions_control_flow(0),
         num_instructions_fetch(0),
-        isa_size(0)
+        isa_size(0),
+        estimated_cycles(static_cast<uint64_t>(-1))
     {
     }
 
@@ -259,6 +260,7 @@ struct AnalysisData
     uint64_t num_instructions_control_flow;    // DX: Number of control flow instructions in the shader
     uint64_t num_instructions_fetch;           // DX: Number of HW TFETCHinstructions / Tx Units used
     uint64_t isa_size;                         // Size of ISA
+    uint64_t estimated_cycles;                 // Estimated cycles to execute the ISA, with loop bodies weighted by their iteration count
 
 public:
     // Lambda returning "N/A" string if value = -1 or string representation of value itself otherwise.
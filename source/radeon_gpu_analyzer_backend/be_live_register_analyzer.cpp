@@ -0,0 +1,726 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for rga backend live register analyzer.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstdio>
+#include <vector>
+
+// Shared.
+#include "common/rga_shared_utils.h"
+
+// Local.
+#include "radeon_gpu_analyzer_backend/be_live_register_analyzer.h"
+#include "emulator/parser/be_isa_parser.h"
+
+// CLI.
+#include "source/radeon_gpu_analyzer_cli/kc_statistics_device_props.h"
+
+using namespace beKA;
+
+// Static constants.
+
+// The number of registers of each class that the analysis tracks.
+static const size_t kMaxVgprs = 512;
+static const size_t kMaxSgprs = 128;
+
+// Marks of the state of a register in the register map of a livereg report line.
+static const char kLiveregMarkDead           = ' ';
+static const char kLiveregMarkLive           = ':';
+static const char kLiveregMarkDefined        = '^';
+static const char kLiveregMarkUsed           = 'v';
+static const char kLiveregMarkUsedAndDefined = 'x';
+
+// The legend at the top of a livereg report, and the width of the line under its column titles.
+static const char* kStrLiveregLegend =
+    "Legend:\n"
+    "  ':' means that the register is kept alive, while it is not actively being used by the current instruction\n"
+    "  '^' means that the current instruction writes to the register\n"
+    "  'v' means that the current instruction reads from the register\n"
+    "  'x' means that the current instruction both reads from the register and writes to it\n"
+    " 'Rn': Number of live registers\n\n";
+static const size_t kLiveregSeparatorWidth = 80;
+
+// The labels of the shae reports are named "label_<name>", without the prefixes of the disassembler.
+static const char*            kStrLiveregLabelPrefix = "label_";
+static const std::string_view kLabelPrefixes[]       = {"label_", "_L", "L", "BB"};
+
+// The encoding suffixes of the opcodes, which the shae reports omit.
+static const std::string_view kEncodingSuffixes[] = {"_e32", "_e64", "_sdwa", "_dpp"};
+
+// Scalar instructions that do not write a register operand.
+static const std::string_view kNoDestinationScalarPrefixes[] = {
+    "s_cmp",       "s_bitcmp",       "s_branch",    "s_cbranch",     "s_waitcnt",  "s_wait_",     "s_nop",         "s_endpgm",
+    "s_barrier",   "s_sendmsg",      "s_set",       "s_sleep",       "s_dcache",   "s_icache",    "s_gl1",         "s_trap",
+    "s_ttrace",    "s_delay_alu",    "s_clause",    "s_inst_prefetch", "s_code_end", "s_round_mode", "s_denorm_mode", "s_incperflevel",
+    "s_decperflevel", "s_prefetch"};
+
+// Scalar instructions that write only part of their destination, or that update it conditionally.
+static const std::string_view kPartialDestinationScalarPrefixes[] = {"s_addk_", "s_mulk_", "s_cmovk_", "s_cmov_", "s_bitset"};
+
+// Memory instructions.
+static const std::string_view kMemoryPrefixes[] = {
+    "buffer_", "tbuffer_", "global_", "flat_", "scratch_", "image_", "ds_", "s_load", "s_buffer_", "s_store", "s_scratch_", "s_atomic"};
+
+// LDS instructions that write a register operand.
+static const std::string_view kLdsDestinationTokens[] = {"read", "load", "rtn", "swizzle", "permute", "append", "consume", "ordered_count"};
+
+// Vector instructions that accumulate into their destination, or that write only some of its lanes.
+static const std::string_view kAccumulatingVectorTokens[] = {"mac_", "_dot2c_", "_dot4c_", "_dot8c_", "v_writelane", "v_interp_p2"};
+
+// Vector instructions that write a carry (or a scale flag) to their second operand.
+static const std::string_view kCarryOutVectorPrefixes[] = {"v_addc_", "v_subb_", "v_subbrev_", "v_div_scale_", "v_mad_u64_u32", "v_mad_i64_i32"};
+
+// GFX8 integer additions write their carry to their second operand when they are encoded as VOP3.
+static const std::string_view kGfx8CarryOutVectorPrefixes[] = {"v_add_u32", "v_sub_u32", "v_subrev_u32"};
+
+// The operand separator of dual-issued (VOPD) instructions.
+static const std::string_view kDualIssueSeparator = "::";
+static const std::string_view kDualIssuePrefix    = "v_dual_";
+
+// *** INTERNALLY LINKED SYMBOLS - START ***
+
+// A set of VGPRs and SGPRs.
+struct RegisterSet
+{
+    std::bitset<kMaxVgprs> vgprs;
+    std::bitset<kMaxSgprs> sgprs;
+
+    RegisterSet& operator|=(const RegisterSet& other)
+    {
+        vgprs |= other.vgprs;
+        sgprs |= other.sgprs;
+        return *this;
+    }
+
+    bool operator==(const RegisterSet& other) const
+    {
+        return vgprs == other.vgprs && sgprs == other.sgprs;
+    }
+
+    // Remove the registers of the other set from this set.
+    RegisterSet& Remove(const RegisterSet& other)
+    {
+        vgprs &= ~other.vgprs;
+        sgprs &= ~other.sgprs;
+        return *this;
+    }
+};
+
+// The registers that an instruction reads and writes.
+struct InstructionRegisters
+{
+    RegisterSet uses;
+    RegisterSet defs;
+};
+
+// How an instruction writes its leading operands.
+struct DestinationInfo
+{
+    // The number of leading operands that the instruction writes.
+    size_t count = 1;
+
+    // True if the instruction also reads the registers that it writes.
+    bool is_read = false;
+};
+
+// The register file of the target.
+struct RegisterFileInfo
+{
+    uint32_t vgprs_total      = 0;
+    uint32_t vgpr_granularity = 0;
+    uint32_t sgprs_total      = 0;
+
+    // SGPRs are allocated in blocks of this many registers, or 0 if every wave gets all of the available SGPRs.
+    uint32_t sgpr_granularity = 0;
+};
+
+static bool StartsWith(std::string_view text, std::string_view prefix)
+{
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+template <size_t N>
+static bool StartsWithAny(std::string_view text, const std::string_view (&prefixes)[N])
+{
+    for (std::string_view prefix : prefixes)
+    {
+        if (StartsWith(text, prefix))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <size_t N>
+static bool ContainsAny(std::string_view text, const std::string_view (&tokens)[N])
+{
+    for (std::string_view token : tokens)
+    {
+        if (text.find(token) != std::string_view::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool IsIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Returns true if the given modifier appears as a whole word in the operands.
+static bool HasModifier(std::string_view operands, std::string_view modifier)
+{
+    for (size_t pos = operands.find(modifier); pos != std::string_view::npos; pos = operands.find(modifier, pos + 1))
+    {
+        size_t end = pos + modifier.size();
+        if ((pos == 0 || !IsIdentifierChar(operands[pos - 1])) && (end == operands.size() || !IsIdentifierChar(operands[end])))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string_view Trim(std::string_view text)
+{
+    size_t begin = 0;
+    size_t end   = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin])))
+    {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1])))
+    {
+        --end;
+    }
+    return text.substr(begin, end - begin);
+}
+
+// Split the operands of an instruction at the commas that are not nested in brackets or parentheses.
+static void SplitOperands(std::string_view operands, std::vector<std::string_view>& split)
+{
+    split.clear();
+    int    depth = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < operands.size(); ++i)
+    {
+        char c = operands[i];
+        if (c == '[' || c == '(')
+        {
+            ++depth;
+        }
+        else if ((c == ']' || c == ')') && depth > 0)
+        {
+            --depth;
+        }
+        else if (c == ',' && depth == 0)
+        {
+            split.push_back(Trim(operands.substr(start, i - start)));
+            start = i + 1;
+        }
+    }
+    std::string_view last = Trim(operands.substr(start));
+    if (!last.empty())
+    {
+        split.push_back(last);
+    }
+}
+
+static uint32_t ParseNumber(std::string_view text, size_t& pos)
+{
+    uint32_t ret = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])))
+    {
+        ret = ret * 10 + static_cast<uint32_t>(text[pos] - '0');
+        ++pos;
+    }
+    return ret;
+}
+
+// Add the VGPRs ("v5", "v[4:7]") and the SGPRs ("s2", "s[0:3]") that the given operand text references to the given set.
+static void AddRegisters(std::string_view text, RegisterSet& registers)
+{
+    for (size_t i = 0; i + 1 < text.size(); ++i)
+    {
+        char c = text[i];
+        if ((c == 'v' || c == 's') && (i == 0 || !IsIdentifierChar(text[i - 1])))
+        {
+            size_t   pos         = i + 1;
+            uint32_t first       = 0;
+            uint32_t last        = 0;
+            bool     is_register = false;
+            if (std::isdigit(static_cast<unsigned char>(text[pos])))
+            {
+                first       = ParseNumber(text, pos);
+                last        = first;
+                is_register = (pos == text.size() || !IsIdentifierChar(text[pos]));
+            }
+            else if (text[pos] == '[')
+            {
+                ++pos;
+                first = ParseNumber(text, pos);
+                last  = first;
+                if (pos < text.size() && text[pos] == ':')
+                {
+                    ++pos;
+                    last = ParseNumber(text, pos);
+                }
+                is_register = (pos < text.size() && text[pos] == ']' && first <= last);
+            }
+
+            if (is_register)
+            {
+                const size_t max_registers = (c == 'v' ? kMaxVgprs : kMaxSgprs);
+                for (size_t r = first; r <= last && r < max_registers; ++r)
+                {
+                    if (c == 'v')
+                    {
+                        registers.vgprs.set(r);
+                    }
+                    else
+                    {
+                        registers.sgprs.set(r);
+                    }
+                }
+                i = pos - 1;
+            }
+        }
+    }
+}
+
+static DestinationInfo GetDestinationInfo(std::string_view opcode, std::string_view operands, size_t operand_count)
+{
+    DestinationInfo info;
+    if (StartsWithAny(opcode, kMemoryPrefixes))
+    {
+        if (opcode.find("atomic") != std::string_view::npos)
+        {
+            // Atomics write their first operand only if they return the previous value of the memory.
+            // Global and flat atomics return it in a separate register, while the others return it in place of their data operand.
+            bool is_returning = opcode.find("_rtn") != std::string_view::npos || HasModifier(operands, "glc") || HasModifier(operands, "sc0") ||
+                                operands.find("TH_ATOMIC_RETURN") != std::string_view::npos;
+            info.count   = is_returning ? 1 : 0;
+            info.is_read = !StartsWith(opcode, "global_") && !StartsWith(opcode, "flat_");
+        }
+        else if (StartsWith(opcode, "ds_"))
+        {
+            info.count = ContainsAny(opcode, kLdsDestinationTokens) ? 1 : 0;
+        }
+        else if (opcode.find("store") != std::string_view::npos || opcode.find("_lds") != std::string_view::npos ||
+                 opcode.find("_wb") != std::string_view::npos || opcode.find("_inv") != std::string_view::npos)
+        {
+            info.count = 0;
+        }
+
+        // 16-bit loads preserve the other half of their destination.
+        info.is_read = info.is_read || (info.count > 0 && opcode.find("d16") != std::string_view::npos);
+    }
+    else if (StartsWith(opcode, "exp"))
+    {
+        info.count = 0;
+    }
+    else if (StartsWith(opcode, "s_"))
+    {
+        if (opcode.find("_rtn") == std::string_view::npos && StartsWithAny(opcode, kNoDestinationScalarPrefixes))
+        {
+            info.count = 0;
+        }
+        info.is_read = StartsWithAny(opcode, kPartialDestinationScalarPrefixes);
+    }
+    else if (StartsWith(opcode, "v_swap"))
+    {
+        info.count   = 2;
+        info.is_read = true;
+    }
+    else
+    {
+        if (opcode.find("_co_") != std::string_view::npos || StartsWithAny(opcode, kCarryOutVectorPrefixes) ||
+            (operand_count >= 4 && StartsWithAny(opcode, kGfx8CarryOutVectorPrefixes)))
+        {
+            info.count = 2;
+        }
+        info.is_read = ContainsAny(opcode, kAccumulatingVectorTokens) || operands.find("UNUSED_PRESERVE") != std::string_view::npos;
+    }
+    return info;
+}
+
+// Collect the registers that the given instruction reads and writes.
+static void CollectInstructionRegisters(std::string_view opcode, std::string_view operands, InstructionRegisters& registers)
+{
+    // A dual-issued instruction is a pair of vector instructions: "v_dual_<op> <operands> :: v_dual_<op> <operands>".
+    size_t separator = operands.find(kDualIssueSeparator);
+    if (StartsWith(opcode, kDualIssuePrefix) && separator != std::string_view::npos)
+    {
+        std::string_view second = Trim(operands.substr(separator + kDualIssueSeparator.size()));
+        size_t           opcode_end = std::min(second.find_first_of(" \t"), second.size());
+        CollectInstructionRegisters(opcode, Trim(operands.substr(0, separator)), registers);
+        CollectInstructionRegisters(second.substr(0, opcode_end), Trim(second.substr(opcode_end)), registers);
+    }
+    else
+    {
+        std::vector<std::string_view> split;
+        SplitOperands(operands, split);
+        DestinationInfo destination = GetDestinationInfo(opcode, operands, split.size());
+
+        for (size_t i = 0; i < split.size(); ++i)
+        {
+            RegisterSet operand_registers;
+            AddRegisters(split[i], operand_registers);
+
+            // Comparisons write their result to an SGPR. Those that write only to EXEC or VCC take VGPRs as their first operand.
+            // Similarly, the carry is written to an SGPR, and an instruction whose carry is implicit has a source in its place.
+            bool is_destination = (i < destination.count);
+            if (is_destination && (i > 0 || StartsWith(opcode, "v_cmp")) && !StartsWith(opcode, "v_swap"))
+            {
+                is_destination = operand_registers.vgprs.none();
+            }
+
+            if (is_destination)
+            {
+                registers.defs |= operand_registers;
+
+                // Partial writes of 16-bit halves preserve the other half.
+                std::string_view operand = split[i];
+                bool is_partial_write = operand.size() > 2 && operand[operand.size() - 2] == '.' && (operand.back() == 'l' || operand.back() == 'h');
+                if (destination.is_read || is_partial_write)
+                {
+                    registers.uses |= operand_registers;
+                }
+            }
+            else
+            {
+                registers.uses |= operand_registers;
+            }
+        }
+    }
+}
+
+// Get the register file of the target from the device properties. Fails if the target is not known.
+static bool GetRegisterFileInfo(const std::string& target, beWaveSize wave_size, const std::string& isa, RegisterFileInfo& info)
+{
+    const std::string device = RgaSharedUtils::ToLower(target);
+    const auto        props  = kRgaDeviceProps.find(device);
+    bool              ret    = (props != kRgaDeviceProps.end());
+    if (ret)
+    {
+        // Deduce the wave size from the registers that hold the execution mask, if it was not given. Pre-RDNA targets always use wave64.
+        bool is_wave32 = RgaSharedUtils::IsNaviTarget(device) &&
+                         (wave_size == kWave32 ||
+                          (wave_size == kUnknown && (isa.find("exec_lo") != std::string::npos || isa.find("vcc_lo") != std::string::npos)));
+
+        info.vgprs_total      = static_cast<uint32_t>(props->second.available_vgprs);
+        info.vgpr_granularity = static_cast<uint32_t>(is_wave32 ? 2 * props->second.vgpr_granularity : props->second.vgpr_granularity);
+        info.sgprs_total      = static_cast<uint32_t>(props->second.available_sgprs);
+        info.sgpr_granularity = static_cast<uint32_t>(props->second.sgpr_granularity);
+    }
+    return ret;
+}
+
+// Returns true if the instruction is a dual-issued (VOPD) pair, which takes two lines of the livereg report.
+static bool IsDualIssue(std::string_view opcode)
+{
+    return StartsWith(opcode, kDualIssuePrefix);
+}
+
+// Append an instruction to a livereg report line: the opcode without its encoding suffix, and the operands without the modifiers.
+static void AppendInstructionText(std::string_view opcode, std::string_view operands, std::string& report)
+{
+    for (std::string_view suffix : kEncodingSuffixes)
+    {
+        if (opcode.size() > suffix.size() && opcode.compare(opcode.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            opcode.remove_suffix(suffix.size());
+            break;
+        }
+    }
+    report.append(opcode);
+
+    // The modifiers follow the last operand after a space. The operands of s_delay_alu are separated by " | ".
+    size_t operands_end = 0;
+    while (operands_end < operands.size() &&
+           !(operands[operands_end] == ' ' && operands_end > 0 && operands[operands_end - 1] != ',' && operands[operands_end - 1] != '|' &&
+             (operands_end + 1 == operands.size() || operands[operands_end + 1] != '|')))
+    {
+        ++operands_end;
+    }
+    operands = Trim(operands.substr(0, operands_end));
+    if (!operands.empty())
+    {
+        report.push_back(' ');
+        report.append(operands);
+    }
+}
+
+// Append the text of the given instruction to a livereg report line. Each half of a dual-issued instruction is written separately.
+static void AppendInstruction(const Instruction& instruction, std::string& report)
+{
+    std::string_view opcode    = instruction.GetInstructionOpCode();
+    std::string_view operands  = instruction.GetInstructionParameters();
+    size_t           separator = operands.find(kDualIssueSeparator);
+    if (IsDualIssue(opcode) && separator != std::string_view::npos)
+    {
+        std::string_view second     = Trim(operands.substr(separator + kDualIssueSeparator.size()));
+        size_t           opcode_end = std::min(second.find_first_of(" \t"), second.size());
+        AppendInstructionText(opcode, Trim(operands.substr(0, separator)), report);
+        report.append(" :: ");
+        AppendInstructionText(second.substr(0, opcode_end), Trim(second.substr(opcode_end)), report);
+    }
+    else
+    {
+        AppendInstructionText(opcode, operands, report);
+    }
+}
+
+// Write the livereg report of the registers of one class.
+// For each instruction that the program reaches, the report lists the number of registers that are live while the instruction executes,
+// and the state of each register of the class, up to the highest register that the program references.
+template <size_t N>
+static void WriteLiveregReport(const std::vector<Instruction*>&         instructions,
+                               const std::vector<bool>&                 is_reached,
+                               const std::vector<InstructionRegisters>& instruction_registers,
+                               const std::vector<RegisterSet>&          live_after,
+                               std::bitset<N> RegisterSet::*            register_class,
+                               const char*                              register_class_name,
+                               uint32_t                                 registers_total,
+                               uint32_t                                 granularity,
+                               bool                                     is_fixed_allocation,
+                               std::string&                             report)
+{
+    std::bitset<N> referenced;
+    for (size_t i = 0; i < instructions.size(); ++i)
+    {
+        if (is_reached[i])
+        {
+            referenced |= instruction_registers[i].uses.*register_class;
+            referenced |= instruction_registers[i].defs.*register_class;
+        }
+    }
+    size_t register_count = N;
+    while (register_count > 0 && !referenced.test(register_count - 1))
+    {
+        --register_count;
+    }
+
+    report.clear();
+    report.reserve(instructions.size() * (register_count + 64));
+    report.append(kStrLiveregLegend);
+    report.append("  Line | Rn  | ").append(register_count, ' ').append(" | Instruction\n");
+    report.append(kLiveregSeparatorWidth, '-').append("\n");
+
+    size_t           max_live_count = 0;
+    uint32_t         line_number    = 0;
+    std::string_view label;
+    std::string      register_map(register_count, kLiveregMarkDead);
+    for (size_t i = 0; i < instructions.size(); ++i)
+    {
+        const Instruction& instruction = *instructions[i];
+        if (!is_reached[i])
+        {
+            continue;
+        }
+        else if (instruction.GetInstructionOpCode().empty())
+        {
+            // The label is written in front of the first instruction of its block.
+            label = instruction.GetPointingLabelString();
+            continue;
+        }
+
+        const std::bitset<N>& uses  = instruction_registers[i].uses.*register_class;
+        const std::bitset<N>& defs  = instruction_registers[i].defs.*register_class;
+        const std::bitset<N>& after = live_after[i].*register_class;
+        for (size_t r = 0; r < register_count; ++r)
+        {
+            bool is_used    = uses.test(r);
+            bool is_defined = defs.test(r);
+            if (is_used && is_defined)
+            {
+                register_map[r] = kLiveregMarkUsedAndDefined;
+            }
+            else if (is_defined)
+            {
+                register_map[r] = kLiveregMarkDefined;
+            }
+            else if (is_used)
+            {
+                register_map[r] = kLiveregMarkUsed;
+            }
+            else
+            {
+                register_map[r] = after.test(r) ? kLiveregMarkLive : kLiveregMarkDead;
+            }
+        }
+
+        // A register that is written but never read is not live.
+        size_t live_count = (after | uses).count();
+        max_live_count    = std::max(max_live_count, live_count);
+        line_number += IsDualIssue(instruction.GetInstructionOpCode()) ? 2 : 1;
+
+        char prefix[32];
+        std::snprintf(prefix, sizeof(prefix), "%6u | %3zu | ", line_number, live_count);
+        report.append(prefix).append(register_map).append(" | ");
+        report.append(BeLiveRegisterAnalyzer::GetInstructionText(instruction, label)).append("\n");
+        label = std::string_view();
+    }
+
+    char summary[128];
+    if (max_live_count == 0)
+    {
+        std::snprintf(summary, sizeof(summary), "\nNo %ss used\n\n", register_class_name);
+    }
+    else if (is_fixed_allocation)
+    {
+        std::snprintf(summary, sizeof(summary), "\nMaximum # %s used %3zu, %ss allocated : %3zu\n", register_class_name, max_live_count, register_class_name,
+                      register_count);
+    }
+    else
+    {
+        // The hardware allocates the registers up to the highest referenced register.
+        size_t allocated = ((register_count + granularity - 1) / granularity) * granularity;
+        std::snprintf(summary, sizeof(summary), "\nMaximum # %s used %3zu, %ss allocated by HW: %3zu (%zu requested)\n", register_class_name, max_live_count,
+                      register_class_name, allocated, register_count);
+    }
+    report.append(summary);
+
+    report.append("\nArchitecture info:\n");
+    report.append("  ").append(register_class_name).append("s total: ").append(std::to_string(registers_total)).append("\n");
+    if (!is_fixed_allocation)
+    {
+        report.append("  ").append(register_class_name).append(" allocation granularity: ").append(std::to_string(granularity)).append("\n");
+    }
+}
+
+// *** INTERNALLY LINKED SYMBOLS - END ***
+
+beStatus BeLiveRegisterAnalyzer::Analyze(const std::string& isa, const std::string& target, beWaveSize wave_size, std::string* vgpr_report, std::string* sgpr_report)
+{
+    beStatus ret = kBeStatusGeneralFailed;
+
+    // The instructions and the control flow graph are parsed like for the ISA CSV file, so the reports match its lines.
+    ParserIsa        parser;
+    RegisterFileInfo register_file;
+    if (GetRegisterFileInfo(target, wave_size, isa, register_file) && parser.ParseStream(isa, true, true))
+    {
+        const std::vector<Instruction*>&   instructions = parser.GetInstructions();
+        const ISAProgramGraph&             graph        = parser.GetProgramGraph();
+        const std::vector<IsaBasicBlock>&  blocks       = graph.GetBlocks();
+
+        std::vector<InstructionRegisters> instruction_registers(instructions.size());
+        for (size_t i = 0; i < instructions.size(); ++i)
+        {
+            CollectInstructionRegisters(instructions[i]->GetInstructionOpCode(), instructions[i]->GetInstructionParameters(), instruction_registers[i]);
+        }
+
+        // The blocks that are not reached from the entry of the program, like the padding after its end, are not reported.
+        std::vector<bool> is_block_reached;
+        std::vector<bool> is_reached(instructions.size(), false);
+        graph.GetBlocksOfProgramPath(ISAProgramGraph::kCalcAll, is_block_reached);
+        for (size_t b = 0; b < blocks.size(); ++b)
+        {
+            std::fill(is_reached.begin() + blocks[b].first_instruction, is_reached.begin() + blocks[b].end_instruction, is_block_reached[b]);
+        }
+
+        // The registers that each block reads before writing them, and the registers that it writes.
+        std::vector<RegisterSet> block_uses(blocks.size());
+        std::vector<RegisterSet> block_defs(blocks.size());
+        for (size_t b = 0; b < blocks.size(); ++b)
+        {
+            for (uint32_t i = blocks[b].end_instruction; i-- > blocks[b].first_instruction;)
+            {
+                block_uses[b].Remove(instruction_registers[i].defs) |= instruction_registers[i].uses;
+                block_defs[b] |= instruction_registers[i].defs;
+            }
+        }
+
+        // Solve live_in(b) = uses(b) | (live_out(b) - defs(b)), where live_out(b) is the union of the live_in of the successors of b.
+        // The blocks are visited in reverse program order, so programs without loops converge in a single iteration.
+        std::vector<RegisterSet> live_in(blocks.size());
+        std::vector<RegisterSet> live_out(blocks.size());
+        bool                     is_changed = true;
+        while (is_changed)
+        {
+            is_changed = false;
+            for (uint32_t b = static_cast<uint32_t>(blocks.size()); b-- > 0;)
+            {
+                RegisterSet block_live_out;
+                for (const IsaEdge* edge = graph.SuccessorsBegin(b); edge != graph.SuccessorsEnd(b); ++edge)
+                {
+                    block_live_out |= live_in[edge->block];
+                }
+
+                RegisterSet block_live_in = block_live_out;
+                block_live_in.Remove(block_defs[b]) |= block_uses[b];
+                live_out[b] = block_live_out;
+                if (!(block_live_in == live_in[b]))
+                {
+                    live_in[b] = block_live_in;
+                    is_changed = true;
+                }
+            }
+        }
+
+        // The registers that are live after each instruction.
+        std::vector<RegisterSet> live_after(instructions.size());
+        for (size_t b = 0; b < blocks.size(); ++b)
+        {
+            RegisterSet live = live_out[b];
+            for (uint32_t i = blocks[b].end_instruction; i-- > blocks[b].first_instruction;)
+            {
+                live_after[i] = live;
+                live.Remove(instruction_registers[i].defs) |= instruction_registers[i].uses;
+            }
+        }
+
+        if (vgpr_report != nullptr)
+        {
+            WriteLiveregReport(instructions, is_reached, instruction_registers, live_after, &RegisterSet::vgprs, "VGPR",
+                register_file.vgprs_total, register_file.vgpr_granularity, false, *vgpr_report);
+        }
+        if (sgpr_report != nullptr)
+        {
+            WriteLiveregReport(instructions, is_reached, instruction_registers, live_after, &RegisterSet::sgprs, "SGPR",
+                register_file.sgprs_total, register_file.sgpr_granularity, register_file.sgpr_granularity == 0, *sgpr_report);
+        }
+
+        ret = kBeStatusSuccess;
+    }
+
+    return ret;
+}
+
+std::string BeLiveRegisterAnalyzer::GetInstructionText(const Instruction& instruction, std::string_view label)
+{
+    std::string text;
+    if (!label.empty())
+    {
+        text.append(kStrLiveregLabelPrefix).append(GetLabelName(label)).append(": ");
+    }
+    AppendInstruction(instruction, text);
+    return text;
+}
+
+std::string_view BeLiveRegisterAnalyzer::GetLabelName(std::string_view label)
+{
+    if (!label.empty() && label.back() == ':')
+    {
+        label.remove_suffix(1);
+    }
+    for (std::string_view prefix : kLabelPrefixes)
+    {
+        if (StartsWith(label, prefix))
+        {
+            label.remove_prefix(prefix.size());
+            break;
+        }
+    }
+    return label;
+}
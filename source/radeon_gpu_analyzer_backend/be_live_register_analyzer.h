@@ -0,0 +1,51 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for rga backend live register analyzer.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERBACKEND_SRC_BE_LIVE_REGISTER_ANALYZER_H_
+#define RGA_RADEONGPUANALYZERBACKEND_SRC_BE_LIVE_REGISTER_ANALYZER_H_
+
+// C++.
+#include <string>
+#include <string_view>
+
+// Local.
+#include "radeon_gpu_analyzer_backend/be_data_types.h"
+#include "radeon_gpu_analyzer_backend/be_include.h"
+
+// An instruction of the ISA parser.
+class Instruction;
+
+namespace beKA
+{
+    // Live register analysis of ISA disassembly.
+    // The VGPR and SGPR liveness are computed together by a backward bit-vector dataflow analysis over the
+    // instructions and the control flow graph that ParserIsa builds, and reported in the livereg text format of the
+    // shader analysis tool (shae), whose lines match the instructions of the ISA CSV file.
+    class BeLiveRegisterAnalyzer
+    {
+    public:
+        // Analyze the live registers of the given ISA disassembly, that was generated for the given target.
+        // The register file sizes are taken from the device properties; the analysis fails if the target is not known.
+        // The wave size is deduced from the disassembly if it is kUnknown. Pre-RDNA targets always use wave64.
+        // The VGPR and SGPR reports are stored in vgpr_report and sgpr_report; either of them can be null if it is not required.
+        static beStatus Analyze(const std::string& isa, const std::string& target, beWaveSize wave_size, std::string* vgpr_report, std::string* sgpr_report);
+
+        // Get the text of the given instruction as the shae reports write it: the opcode without its encoding suffix, and the operands
+        // without their modifiers. If a label is given, the instruction is the first one of the label's block, and the label is written in front of it.
+        static std::string GetInstructionText(const Instruction& instruction, std::string_view label);
+
+        // Get the name of the given label as the shae reports write it, without the prefix of the disassembler and the colon ("L0:" is "0").
+        static std::string_view GetLabelName(std::string_view label);
+
+    private:
+        // No instances.
+        BeLiveRegisterAnalyzer()  = delete;
+        ~BeLiveRegisterAnalyzer() = delete;
+    };
+}
+
+#endif // RGA_RADEONGPUANALYZERBACKEND_SRC_BE_LIVE_REGISTER_ANALYZER_H_
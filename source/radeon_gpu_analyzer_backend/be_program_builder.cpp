@@ -7,6 +7,7 @@
 
 // Local.
 #include "radeon_gpu_analyzer_backend/be_program_builder.h"
+#include "radeon_gpu_analyzer_backend/be_file_sink.h"
 #include "emulator/parser/be_isa_parser.h"
 
 bool BeProgramBuilder::LogCallback(const std::string& str)
@@ -20,45 +21,129 @@ bool BeProgramBuilder::LogCallback(const std::string& str)
     return ret;
 }
 
-beKA::beStatus BeProgramBuilder::ParseIsaToCsv(const std::string& isa_text, const std::string& device,
-    std::string& parsed_isa_text, bool add_line_numbers, bool is_header_required)
+// *****************************************
+// *** INTERNALLY LINKED SYMBOLS - START ***
+// *****************************************
+
+// Pass the CSV representation of the given instruction to the given consumer, unless it is a padding instruction.
+// "row" is the buffer of the CSV representation, which is reused for all instructions.
+// Returns false if the consumer failed.
+template <typename RowConsumer>
+static bool WriteCsvRow(const Instruction& instruction, const std::string& device, bool add_line_numbers, std::string& row, RowConsumer& consume_row)
 {
-    beKA::beStatus     status = beKA::kBeStatusParseIsaToCsvFailed;
-    std::stringstream  parsed_isa;
-    ParserIsa          parser;
-    std::string        input_isa;
+    // Padding instruction to be ignored.
+    const char* kCodeEndPadding = "s_code_end";
 
-    if (is_header_required)
+    bool ret = true;
+    if (instruction.GetInstructionOpCode().find(kCodeEndPadding) == std::string::npos)
     {
-        // Add ISA starting and ending tokens so that Parser can recognize it.
-        std::stringstream  input_isa_stream;
-        input_isa_stream << kStrHsailDisassemblyTokenStart << isa_text << kStrHsailDisassemblyTokenEnd << std::endl;
-        input_isa = input_isa_stream.str();
+        instruction.GetCsvString(device, add_line_numbers, row);
+        ret = consume_row(row);
     }
-    else
+    return ret;
+}
+
+// The loop iteration counts of a cycle estimate that is made from the parse of the CSV rows, and its result.
+struct CycleEstimate
+{
+    int                                         loop_iteration_count;
+    const std::unordered_map<std::string, int>& loop_iteration_overrides;
+    uint64_t&                                   estimated_cycles;
+};
+
+// Parse the given ISA text, and pass the CSV representation of each instruction to the given consumer.
+// The row of each instruction is passed on as soon as its line is parsed. Unless the cycles are estimated ("estimate" is not null),
+// the instruction is released afterwards, so neither the ISA text nor its instructions are copied or held.
+// If the parsing fails, the rows that were already passed on are not valid.
+template <typename RowConsumer>
+static beKA::beStatus ParseIsaToCsvRows(const std::string& isa_text, const std::string& device, bool add_line_numbers, bool is_header_required,
+                                        const CycleEstimate* estimate, RowConsumer consume_row)
+{
+    std::string row;
+    bool        is_written = true;
+    ParserIsa   parser;
+    if (estimate != nullptr)
+    {
+        parser.SetLoopIterationCounts(estimate->loop_iteration_count > 0 ? estimate->loop_iteration_count : ISAProgramGraph::kDefaultIterationCount,
+                                      estimate->loop_iteration_overrides);
+    }
+    bool is_parsed = parser.ParseStream(isa_text, is_header_required, estimate != nullptr, [&](const Instruction& instruction) {
+        is_written = WriteCsvRow(instruction, device, add_line_numbers, row, consume_row);
+        return is_written;
+    });
+    if (is_parsed && estimate != nullptr)
+    {
+        estimate->estimated_cycles = parser.GetProgramGraph().GetEstimatedCycles(device);
+    }
+    return (!is_written ? beKA::kBeStatusWriteToFileFailed : (is_parsed ? beKA::kBeStatusSuccess : beKA::kBeStatusParseIsaToCsvFailed));
+}
+
+// Append the given CSV row to "parsed_isa".
+static bool AppendCsvRow(std::string& parsed_isa, const std::string& row)
+{
+    parsed_isa.append(row);
+    return true;
+}
+
+// ***************************************
+// *** INTERNALLY LINKED SYMBOLS - END ***
+// ***************************************
+
+beKA::beStatus BeProgramBuilder::ParseIsaToCsv(const std::string& isa_text, const std::string& device,
+    std::string& parsed_isa_text, bool add_line_numbers, bool is_header_required)
+{
+    std::string parsed_isa;
+    beKA::beStatus status = ParseIsaToCsvRows(isa_text, device, add_line_numbers, is_header_required, nullptr,
+                                              [&parsed_isa](const std::string& row) { return AppendCsvRow(parsed_isa, row); });
+    if (status == beKA::kBeStatusSuccess)
     {
-        input_isa = isa_text;
+        parsed_isa_text.swap(parsed_isa);
     }
+    return status;
+}
 
-    if (parser.Parse(input_isa))
+beKA::beStatus BeProgramBuilder::ParseIsaToCsv(const std::string& isa_text, const std::string& device,
+    BeFileSink& sink, bool add_line_numbers, bool is_header_required)
+{
+    return ParseIsaToCsvRows(isa_text, device, add_line_numbers, is_header_required, nullptr, [&sink](const std::string& row) { return sink.Write(row); });
+}
+
+beKA::beStatus BeProgramBuilder::ParseIsaToCsv(const std::string& isa_text, const std::string& device, std::string& parsed_isa_text,
+    bool add_line_numbers, bool is_header_required, int loop_iteration_count,
+    const std::unordered_map<std::string, int>& loop_iteration_overrides, uint64_t& estimated_cycles)
+{
+    std::string    parsed_isa;
+    CycleEstimate  estimate = {loop_iteration_count, loop_iteration_overrides, estimated_cycles};
+    beKA::beStatus status   = ParseIsaToCsvRows(isa_text, device, add_line_numbers, is_header_required, &estimate,
+                                              [&parsed_isa](const std::string& row) { return AppendCsvRow(parsed_isa, row); });
+    if (status == beKA::kBeStatusSuccess)
     {
-        // Padding instruction to be ignored.
-        const char* kCodeEndPadding = "s_code_end";
-        for (const Instruction* instruction : parser.GetInstructions())
-        {
-            std::string instruction_str;
-            instruction->GetCsvString(device, add_line_numbers, instruction_str);
-            if (instruction->GetInstructionOpCode().find(kCodeEndPadding) == std::string::npos)
-            {
-                parsed_isa << instruction_str;
-            }
-        }
-        parsed_isa_text = parsed_isa.str();
-        status = beKA::kBeStatusSuccess;
+        parsed_isa_text.swap(parsed_isa);
     }
     return status;
 }
 
+beKA::beStatus BeProgramBuilder::ParseIsaToCsv(const std::string& isa_text, const std::string& device, BeFileSink& sink,
+    bool add_line_numbers, bool is_header_required, int loop_iteration_count,
+    const std::unordered_map<std::string, int>& loop_iteration_overrides, uint64_t& estimated_cycles)
+{
+    CycleEstimate estimate = {loop_iteration_count, loop_iteration_overrides, estimated_cycles};
+    return ParseIsaToCsvRows(isa_text, device, add_line_numbers, is_header_required, &estimate, [&sink](const std::string& row) { return sink.Write(row); });
+}
+
+bool BeProgramBuilder::EstimateIsaCycles(const std::string& isa_text, const std::string& device, int loop_iteration_count,
+    const std::unordered_map<std::string, int>& loop_iteration_overrides, uint64_t& estimated_cycles, bool is_header_required)
+{
+    ParserIsa parser;
+    parser.SetLoopIterationCounts(loop_iteration_count > 0 ? loop_iteration_count : ISAProgramGraph::kDefaultIterationCount, loop_iteration_overrides);
+    bool ret = parser.ParseStream(isa_text, is_header_required, true);
+    if (ret)
+    {
+        estimated_cycles = parser.GetProgramGraph().GetEstimatedCycles(device);
+    }
+    return ret;
+}
+
 void BeProgramBuilder::SetLog(LoggingCallBackFuncP callback)
 {
     log_callback_ = callback;
@@ -17,10 +17,13 @@
 // C++.
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "radeon_gpu_analyzer_backend/be_include.h"
 #include "DeviceInfo.h"
 
+class BeFileSink;
+
 class BeProgramBuilder
 {
 public:
@@ -44,6 +47,31 @@ public:
     static beKA::beStatus ParseIsaToCsv(const std::string& isa_text, const std::string& device,
                                         std::string& parsed_isa_text, bool should_add_line_numbers = false, bool is_header_required = false);
 
+    // Parse ISA text and write its CSV representation to the given sink, one instruction at a time.
+    // Each row is written as soon as the line of its instruction is parsed, and neither the CSV text nor the parsed
+    // instructions are held in memory as a whole, which keeps the memory footprint low for large ISA.
+    static beKA::beStatus ParseIsaToCsv(const std::string& isa_text, const std::string& device,
+                                        BeFileSink& sink, bool should_add_line_numbers = false, bool is_header_required = false);
+
+    // Parse ISA text and convert it to CSV format (see above), and estimate the number of cycles that it takes to execute it
+    // (see EstimateIsaCycles()) from the same parse of the ISA.
+    static beKA::beStatus ParseIsaToCsv(const std::string& isa_text, const std::string& device, std::string& parsed_isa_text,
+                                        bool should_add_line_numbers, bool is_header_required, int loop_iteration_count,
+                                        const std::unordered_map<std::string, int>& loop_iteration_overrides, uint64_t& estimated_cycles);
+
+    // Parse ISA text and write its CSV representation to the given sink (see above), and estimate the number of cycles that it takes
+    // to execute it (see EstimateIsaCycles()) from the same parse of the ISA. The instructions are held until the end of the parse.
+    static beKA::beStatus ParseIsaToCsv(const std::string& isa_text, const std::string& device, BeFileSink& sink,
+                                        bool should_add_line_numbers, bool is_header_required, int loop_iteration_count,
+                                        const std::unordered_map<std::string, int>& loop_iteration_overrides, uint64_t& estimated_cycles);
+
+    // Estimate the number of cycles that it takes to execute the given ISA on the given device.
+    // Loop bodies are weighted by "loop_iteration_count" (0 for the default), or by the count in "loop_iteration_overrides"
+    // for loops whose header label is listed there. If "is_header_required" is true, adds standard disassembly header to the ISA text.
+    static bool EstimateIsaCycles(const std::string& isa_text, const std::string& device, int loop_iteration_count,
+                                  const std::unordered_map<std::string, int>& loop_iteration_overrides, uint64_t& estimated_cycles,
+                                  bool is_header_required = false);
+
     // Set callback function for diagnostic output.
     void SetLog(LoggingCallBackFuncP callback);
 
@@ -1823,7 +1823,7 @@ void BeProgramBuilderDx12::PerformLiveVgprAnalysis(const std::string& isa_file,
                 KcUtils::DeleteFile(output_filename.c_str());
             }
 
-            is_ok = KcUtils::PerformLiveRegisterAnalysis(isa_file, target, output_filename, NULL, config.print_process_cmd_line);
+            is_ok = KcUtils::PerformLiveRegisterAnalysis(isa_file, target, output_filename, NULL);
             if (is_ok)
             {
                 if (KcUtils::FileNotEmpty(output_filename))
@@ -1874,7 +1874,7 @@ void BeProgramBuilderDx12::PerformLiveSgprAnalysis(const std::string& isa_file,
                 KcUtils::DeleteFile(output_filename.c_str());
             }
 
-            is_ok = KcUtils::PerformLiveRegisterAnalysis(isa_file, target, output_filename, NULL, config.print_process_cmd_line, true);
+            is_ok = KcUtils::PerformLiveRegisterAnalysis(isa_file, target, output_filename, NULL, true);
             if (is_ok)
             {
                 if (KcUtils::FileNotEmpty(output_filename))
@@ -1936,7 +1936,7 @@ void BeProgramBuilderDx12::GeneratePerBlockCfg(const std::string& isa_file,
                 BeUtils::DeleteFileFromDisk(output_filename);
             }
 
-            is_ok = KcUtils::GenerateControlFlowGraph(isa_file, target, output_filename, NULL, false, config_updated.print_process_cmd_line);
+            is_ok = KcUtils::GenerateControlFlowGraph(isa_file, target, output_filename, NULL, false);
             if (is_ok)
             {
                 if (KcUtils::FileNotEmpty(output_filename))
@@ -1997,7 +1997,7 @@ void BeProgramBuilderDx12::GeneratePerInstructionCfg(const std::string& isa_file
                 BeUtils::DeleteFileFromDisk(output_filename);
             }
 
-            is_ok = KcUtils::GenerateControlFlowGraph(isa_file, target, output_filename, NULL, true, config_updated.print_process_cmd_line);
+            is_ok = KcUtils::GenerateControlFlowGraph(isa_file, target, output_filename, NULL, true);
             if (is_ok)
             {
                 if (KcUtils::FileNotEmpty(output_filename))
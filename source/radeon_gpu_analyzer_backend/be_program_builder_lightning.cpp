@@ -5,6 +5,12 @@
 /// @brief Implementation for rga backend progam builder (legacy) opencl class.
 //=============================================================================
 
+// C++.
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string_view>
+
 // Infra.
 #include "external/amdt_os_wrappers/Include/osFilePath.h"
 #include "external/amdt_os_wrappers/Include/osDirectory.h"
@@ -28,6 +34,7 @@
 #include "radeon_gpu_analyzer_backend/be_utils.h"
 #include "radeon_gpu_analyzer_backend/be_string_constants.h"
 #include "radeon_gpu_analyzer_backend/be_program_builder_lightning.h"
+#include "radeon_gpu_analyzer_backend/be_amdgpu_elf_reader.h"
 #include "emulator/parser/be_isa_parser.h"
 
 // *****************************************
@@ -112,7 +119,11 @@ static const wchar_t* kLcOpenclLlvmReadobjExecutable = L"llvm-readobj";
 // ***************************************
 
 static bool GetIsaSize(const std::string& isa_as_text, const std::string& kernel_name, size_t& size_in_bytes);
+static bool GetCompilerExecutable(beKA::RgaMode mode, const std::string& user_bin_folder, osFilePath& compiler_exec);
 static beKA::beStatus  ParseCodeProps(const std::string & md_text, CodePropsMap& code_props);
+static beKA::beStatus  ParseCodePropsNode(const YAML::Node& codeobj_metadata_node, CodePropsMap& code_props);
+static beKA::beStatus  ParseKernelNames(const std::string& md_text, std::vector<std::string>& kernel_names);
+static beKA::beStatus  ParseKernelNamesNode(const YAML::Node& codeobj_metadata_node, std::vector<std::string>& kernel_names);
 
 beKA::beStatus BeProgramBuilderLightning::GetKernelIlText(const std::string & device, const std::string & kernel, std::string & il)
 {
@@ -149,8 +160,53 @@ beKA::beStatus BeProgramBuilderLightning::GetCompilerVersion(beKA::RgaMode
                                                              bool               should_print_cmd,
                                                              std::string&       out_text)
 {
+    // The version only depends on the compiler executable, so the compiler is invoked once per compiler directory,
+    // as long as its executable is not replaced (a server may run while the compiler is updated).
+    struct CachedVersion
+    {
+        std::filesystem::file_time_type write_time;
+        std::uintmax_t                  size = 0;
+        std::string                     version;
+    };
+    static std::map<std::pair<beKA::RgaMode, std::string>, CachedVersion> version_cache;
+    static std::mutex                                                     version_cache_lock;
+    const auto                                                            cache_key = std::make_pair(mode, user_bin_folder);
+
+    // Stamp the version with the modification time and the size of the executable. The version is not cached if they cannot be read.
+    CachedVersion   stamp;
+    osFilePath      compiler_exec;
+    std::error_code error;
+    bool            is_stamped = GetCompilerExecutable(mode, user_bin_folder, compiler_exec);
+    if (is_stamped)
+    {
+        const std::filesystem::path exec_path(compiler_exec.asString().asASCIICharArray());
+        stamp.write_time = std::filesystem::last_write_time(exec_path, error);
+        is_stamped       = !error;
+        stamp.size       = std::filesystem::file_size(exec_path, error);
+        is_stamped       = is_stamped && !error;
+    }
+
+    if (is_stamped)
+    {
+        std::lock_guard<std::mutex> lock(version_cache_lock);
+        auto cached = version_cache.find(cache_key);
+        if (cached != version_cache.end() && cached->second.write_time == stamp.write_time && cached->second.size == stamp.size)
+        {
+            out_text = cached->second.version;
+            return beKA::kBeStatusSuccess;
+        }
+    }
+
     std::string error_text;
     beKA::beStatus  status = InvokeCompiler(mode, user_bin_folder, kStrLcCompilerOpenclSwitchVersion, should_print_cmd, out_text, error_text);
+
+    if (status == beKA::kBeStatusSuccess && is_stamped)
+    {
+        std::lock_guard<std::mutex> lock(version_cache_lock);
+        stamp.version            = out_text;
+        version_cache[cache_key] = stamp;
+    }
+
     return status;
 }
 
@@ -308,6 +364,14 @@ beKA::beStatus BeProgramBuilderLightning::ConstructOpenCLCompilerOptions(const C
     return status;
 }
 
+beKA::beStatus BeProgramBuilderLightning::GetOpenCLCompilerOptions(const CmpilerPaths&  compiler_paths,
+                                                                   const OpenCLOptions& user_options,
+                                                                   const std::string&   device,
+                                                                   std::string&         options)
+{
+    return ConstructOpenCLCompilerOptions(compiler_paths, user_options, {}, "", device, options);
+}
+
 beKA::beStatus BeProgramBuilderLightning::CompileOpenCLToBinary(const CmpilerPaths& compiler_paths,
     const OpenCLOptions& user_options,
     const std::vector<std::string>& src_file_names,
@@ -364,6 +428,34 @@ beKA::beStatus BeProgramBuilderLightning::CompileOpenCLToLlvmIr(const CmpilerPat
     return status;
 }
 
+// Select the compiler executable for the given mode: the one in the user's compiler folder, if provided, or the one shipped with RGA.
+// Returns false if the mode has no compiler.
+static bool GetCompilerExecutable(beKA::RgaMode mode, const std::string& user_bin_folder, osFilePath& compiler_exec)
+{
+    bool ret = true;
+    if (!user_bin_folder.empty())
+    {
+        gtString  bin_folder;
+        bin_folder << user_bin_folder.c_str();
+        compiler_exec.setFileDirectory(bin_folder);
+        compiler_exec.setFileName(kLcOpenclCompilerExecutable);
+        compiler_exec.setFileExtension(kLcCompilerExecutableExtension);
+    }
+    else if (mode == beKA::RgaMode::kModeOpenclOffline)
+    {
+        osGetCurrentApplicationPath(compiler_exec, false);
+        compiler_exec.appendSubDirectory(kLcOpenclRootDir);
+        compiler_exec.appendSubDirectory(kLcOpenclBinDir);
+        compiler_exec.setFileName(kLcOpenclCompilerExecutable);
+        compiler_exec.setFileExtension(kLcCompilerExecutableExtension);
+    }
+    else
+    {
+        ret = false;
+    }
+    return ret;
+}
+
 beKA::beStatus BeProgramBuilderLightning::InvokeCompiler(beKA::RgaMode      mode,
     const std::string& user_bin_folder,
     const std::string& cmd_line_options,
@@ -383,28 +475,9 @@ beKA::beStatus BeProgramBuilderLightning::InvokeCompiler(beKA::RgaMode      mode
     }
 
     // Select the compiler executable.
-    if (!user_bin_folder.empty())
+    if (!GetCompilerExecutable(mode, user_bin_folder, lc_compiler_exec))
     {
-        gtString  bin_folder;
-        bin_folder << user_bin_folder.c_str();
-        lc_compiler_exec.setFileDirectory(bin_folder);
-        lc_compiler_exec.setFileName(kLcOpenclCompilerExecutable);
-        lc_compiler_exec.setFileExtension(kLcCompilerExecutableExtension);
-    }
-    else
-    {
-        if (mode == beKA::RgaMode::kModeOpenclOffline)
-        {
-            osGetCurrentApplicationPath(lc_compiler_exec, false);
-            lc_compiler_exec.appendSubDirectory(kLcOpenclRootDir);
-            lc_compiler_exec.appendSubDirectory(kLcOpenclBinDir);
-            lc_compiler_exec.setFileName(kLcOpenclCompilerExecutable);
-            lc_compiler_exec.setFileExtension(kLcCompilerExecutableExtension);
-        }
-        else
-        {
-            return beKA::kBeStatusUnknownInputLang;
-        }
+        return beKA::kBeStatusUnknownInputLang;
     }
 
     KcUtils::ProcessStatus  procStatus = KcUtils::LaunchProcess(lc_compiler_exec.asString().asASCIICharArray(),
@@ -421,6 +494,7 @@ beKA::beStatus BeProgramBuilderLightning::InvokeCompiler(beKA::RgaMode      mode
     case KcUtils::ProcessStatus::kLaunchFailed:
     case KcUtils::ProcessStatus::kCreateTempFileFailed:
     case KcUtils::ProcessStatus::kReadTempFileFailed:
+    case KcUtils::ProcessStatus::kReadOutputFailed:
         status = beKA::kBeStatusLightningCompilerLaunchFailed;
         break;
     case KcUtils::ProcessStatus::kTimeOut:
@@ -457,7 +531,8 @@ beKA::beStatus BeProgramBuilderLightning::PreprocessOpencl(const CmpilerPaths& c
                                                            const std::string&  input_file,
                                                            const std::string&  args,
                                                            bool                should_print_cmd,
-                                                           std::string&        output)
+                                                           std::string&        output,
+                                                           const std::string&  device)
 {
     std::string     standard_options = "";
      beKA::beStatus status           = AddCompilerStandardOptions(beKA::RgaMode::kModeOpenclOffline, compiler_paths, standard_options);
@@ -469,9 +544,9 @@ beKA::beStatus BeProgramBuilderLightning::PreprocessOpencl(const CmpilerPaths& c
         compiler_args << " " << kStrLcOpenclStdOption << "=" << kStrLcOpenclStdDefaultValue;
         compiler_args << " " << kStrLcOpenclDefs;
 
-        // Add a default device selection option.
+        // Add the device selection option, or a default one.
         // (as of v2.8 we need to specify *some* default device needed for clang-19 in RGA).
-        compiler_args << " " << kStrLcCompilerOpenclSwitchDevice << kStrLcCompilerOpenclDefaultDevice;
+        compiler_args << " " << kStrLcCompilerOpenclSwitchDevice << (device.empty() ? kStrLcCompilerOpenclDefaultDevice : device);
         
         std::string std_out, std_err;
 
@@ -566,7 +641,15 @@ beKA::beStatus BeProgramBuilderLightning::ExtractKernelCodeProps(const std::stri
 {
     beKA::beStatus  status = beKA::kBeStatusLightningExtractCodePropsFailed;
     std::string  metadata_text;
-    if ((status = ExtractMetadata(user_bin_dir, bin_filename, should_print_cmd, metadata_text)) == beKA::beStatus::kBeStatusSuccess)
+
+    // Read the metadata in-process, and fall back to llvm-readobj if the code object cannot be read.
+    BeAmdgpuElfReader  elf_reader;
+    YAML::Node  codeobj_metadata_node;
+    if (elf_reader.Load(bin_filename) && elf_reader.GetMetadata(codeobj_metadata_node))
+    {
+        status = ParseCodePropsNode(codeobj_metadata_node, code_props);
+    }
+    else if ((status = ExtractMetadata(user_bin_dir, bin_filename, should_print_cmd, metadata_text)) == beKA::beStatus::kBeStatusSuccess)
     {
         status = ParseCodeProps(metadata_text, code_props);
     }
@@ -580,53 +663,26 @@ beKA::beStatus BeProgramBuilderLightning::ExtractKernelNames(const std::string&
     beKA::beStatus status = beKA::kBeStatusSuccess;
     std::string metadata, options, error_text;
 
-    // Launch the LC ReadObj and parse its output.
-    status = ConstructObjDumpOptions(ObjDumpOp::kGetMetadata, user_bin_dir, bin_filename, "", should_print_cmd, options);
-
-    if (status == beKA::kBeStatusSuccess)
+    // Read the metadata in-process, and fall back to llvm-readobj if the code object cannot be read.
+    BeAmdgpuElfReader elf_reader;
+    YAML::Node codeobj_metadata_node;
+    if (elf_reader.Load(bin_filename) && elf_reader.GetMetadata(codeobj_metadata_node))
     {
-        status = InvokeObjDump(ObjDumpOp::kGetMetadata, user_bin_dir, options, should_print_cmd, metadata, error_text);
+        status = ParseKernelNamesNode(codeobj_metadata_node, kernel_names);
     }
-
-    if (status == beKA::kBeStatusSuccess)
+    else
     {
-        YAML::Node codeobj_metadata_node, kernels_metadata_map, kernel_name;
-        size_t start_offset = 0, end_offset;
-        start_offset = metadata.find(kStrLcCodeObjectMetadataTokenStart);
+        // Launch the LC ReadObj and parse its output.
+        status = ConstructObjDumpOptions(ObjDumpOp::kGetMetadata, user_bin_dir, bin_filename, "", should_print_cmd, options);
 
-        // Load all Metadata nodes found in the objdump output.
-        while ((end_offset = metadata.find(kStrLcCodeObjectMetadataTokenEnd, start_offset)) != std::string::npos)
+        if (status == beKA::kBeStatusSuccess)
         {
-            try
-            {
-                codeobj_metadata_node = YAML::Load(metadata.substr(start_offset + kStrLcCodeObjectMetadataTokenStart.size(), end_offset - (start_offset + kStrLcCodeObjectMetadataTokenStart.size())));
-            }
-            catch (YAML::ParserException&)
-            {
-                status = beKA::kBeStatusLightningExtractKernelNamesFailed;
-            }
+            status = InvokeObjDump(ObjDumpOp::kGetMetadata, user_bin_dir, options, should_print_cmd, metadata, error_text);
+        }
 
-            if (status == beKA::kBeStatusSuccess && codeobj_metadata_node.IsMap())
-            {
-                // Look for kernels metadata.
-                if (status == beKA::kBeStatusSuccess &&
-                    (kernels_metadata_map = codeobj_metadata_node[kStrCodeObjectMetadataKeyKernels]).IsDefined())
-                {
-                    for (const YAML::Node& kernel_metadata : kernels_metadata_map)
-                    {
-                        if (status == beKA::kBeStatusSuccess && (kernel_name = kernel_metadata[kStrCodeObjectMetadataKeyKernelName]).IsDefined())
-                        {
-                            kernel_names.push_back(kernel_name.as<std::string>());
-                        }
-                        else
-                        {
-                            status = beKA::kBeStatusLightningExtractKernelNamesFailed;
-                            break;
-                        }
-                    }
-                }
-            }
-            start_offset = metadata.find(kStrLcCodeObjectMetadataTokenStart, end_offset);
+        if (status == beKA::kBeStatusSuccess)
+        {
+            status = ParseKernelNames(metadata, kernel_names);
         }
     }
 
@@ -654,22 +710,54 @@ int BeProgramBuilderLightning::GetIsaSize(const std::string & isa_text)
 
 int BeProgramBuilderLightning::GetKernelCodeSize(const std::string & user_bin_dir, const std::string & bin_file,
                                                  const std::string & kernel_name, bool should_print_cmd)
+{
+    int ret = -1;
+    SymbolSizeMap symbol_sizes;
+    if (ExtractSymbolSizes(user_bin_dir, bin_file, should_print_cmd, symbol_sizes) == beKA::beStatus::kBeStatusSuccess)
+    {
+        auto symbol = symbol_sizes.find(kernel_name);
+        if (symbol != symbol_sizes.end())
+        {
+            ret = symbol->second;
+        }
+    }
+
+    return ret;
+}
+
+beKA::beStatus BeProgramBuilderLightning::ExtractSymbolSizes(const std::string& user_bin_dir,
+                                                             const std::string& bin_file,
+                                                             bool               should_print_cmd,
+                                                             SymbolSizeMap&     symbol_sizes)
 {
     beKA::beStatus status = beKA::beStatus::kBeStatusLightningGetKernelCodeSizeFailed;
     std::string symbols, options, error_text;
-    int ret = -1, symSize;
-    size_t offset, name_offset, size_offset;
-    std::size_t    name_end_offset = std::string::npos;
-
-    // Launch the LC ReadObj.
-    status = ConstructObjDumpOptions(ObjDumpOp::kGetKernelCodeSize, user_bin_dir, bin_file, "", should_print_cmd, options);
 
-    if (status == beKA::beStatus::kBeStatusSuccess)
+    // Read the symbol table in-process, and fall back to llvm-readobj if the code object cannot be read.
+    BeAmdgpuElfReader elf_reader;
+    std::vector<BeAmdgpuElfReader::Symbol> elf_symbols;
+    const bool is_read_in_process = elf_reader.Load(bin_file) && elf_reader.GetSymbols(elf_symbols);
+    if (is_read_in_process)
     {
-        status = InvokeObjDump(ObjDumpOp::kGetKernelCodeSize, user_bin_dir, options, should_print_cmd, symbols, error_text);
+        for (const BeAmdgpuElfReader::Symbol& symbol : elf_symbols)
+        {
+            // Keep the first symbol with a given name.
+            symbol_sizes.emplace(symbol.name, static_cast<int>(symbol.size));
+        }
+        status = beKA::beStatus::kBeStatusSuccess;
     }
+    else
+    {
+        // Launch the LC ReadObj.
+        status = ConstructObjDumpOptions(ObjDumpOp::kGetKernelCodeSize, user_bin_dir, bin_file, "", should_print_cmd, options);
 
-    if (status == beKA::beStatus::kBeStatusSuccess)
+        if (status == beKA::beStatus::kBeStatusSuccess)
+        {
+            status = InvokeObjDump(ObjDumpOp::kGetKernelCodeSize, user_bin_dir, options, should_print_cmd, symbols, error_text);
+        }
+    }
+
+    if (!is_read_in_process && status == beKA::beStatus::kBeStatusSuccess)
     {
         // Parse the readobj output.
         // readobj uses its own format, so we have to parse it manually.
@@ -695,51 +783,40 @@ int BeProgramBuilderLightning::GetKernelCodeSize(const std::string & user_bin_di
         //      }
         //      ...
         //    ]
+        //
+        // The output is scanned once, and the name and size of each symbol are only looked for within its own block.
+        size_t offset = symbols.find(kStrReadObjKeySymbols);
+        if (offset != std::string::npos)
+        {
+            offset = symbols.find(kStrReadObjKeySymbol, offset);
+        }
 
-        if (status == beKA::beStatus::kBeStatusSuccess)
+        while (offset != std::string::npos)
         {
-            if ((offset = symbols.find(kStrReadObjKeySymbols)) != std::string::npos)
+            const size_t           block_end  = symbols.find(kStrReadObjKeySymbol, offset + kStrReadObjKeySymbol.size());
+            const size_t           block_size = (block_end == std::string::npos ? symbols.size() : block_end) - offset;
+            const std::string_view block(symbols.data() + offset, block_size);
+
+            size_t name_offset = block.find(kStrReadObjKeyName);
+            if (name_offset != std::string::npos)
             {
-                bool stop = false;
-                while (!stop && (offset = symbols.find(kStrReadObjKeySymbol, offset)) != std::string::npos)
+                name_offset += kStrReadObjKeyName.size();
+                size_t name_end_offset = block.find(kStrReadObjKeyNameEnd, name_offset);
+                size_t size_offset     = block.find(kStrReadObjKeySize, name_offset);
+                if (name_end_offset != std::string::npos && size_offset != std::string::npos)
                 {
-                    name_offset = symbols.find(kStrReadObjKeyName, offset);
-                    if (name_offset != std::string::npos)
-                    {
-                        size_offset = symbols.find(kStrReadObjKeySize, name_offset);
-                        if (size_offset != std::string::npos)
-                        {
-                            size_offset += kStrReadObjKeySize.size();
-                            name_end_offset = symbols.find(kStrReadObjKeyNameEnd, name_offset);
-                        }
-                        if (name_end_offset != std::string::npos)
-                        {
-                            name_offset += kStrReadObjKeyName.size();
-                            size_t kernel_name_end = symbols.find(kStrReadObjKeyNameEnd, name_offset);
-                            if (symbols.substr(name_offset, kernel_name_end - name_offset) == kernel_name)
-                            {
-                                size_t size_end_offset = symbols.find("\n    Bind", size_offset);
-                                if (size_end_offset != std::string::npos)
-                                {
-                                    std::string size_as_string = symbols.substr(size_offset, size_end_offset - size_offset);
-                                    symSize = std::atoi(size_as_string.c_str());
-                                    ret = symSize;
-                                    stop = true;
-                                }
-                                else
-                                {
-                                    ret = 0;
-                                }
-                            }
-                            offset = size_offset;
-                        }
-                    }
+                    // Keep the first symbol with a given name.
+                    size_offset += kStrReadObjKeySize.size();
+                    symbol_sizes.emplace(std::string(block.substr(name_offset, name_end_offset - name_offset)),
+                                         std::atoi(std::string(block.substr(size_offset, block.find('\n', size_offset) - size_offset)).c_str()));
                 }
             }
+
+            offset = block_end;
         }
     }
 
-    return ret;
+    return status;
 }
 
 beKA::beStatus BeProgramBuilderLightning::ConstructObjDumpOptions(ObjDumpOp op,
@@ -849,14 +926,29 @@ beKA::beStatus BeProgramBuilderLightning::FilterCodeObjOutput(ObjDumpOp op, std:
 
 bool BeProgramBuilderLightning::DoesReadobjSupportMetadata(const std::string& user_bin_dir, bool should_print_cmd)
 {
+    // The result only depends on the readobj executable, so it is probed once per compiler directory.
+    static std::map<std::string, bool> is_supported_cache;
+    static std::mutex                  is_supported_cache_lock;
     std::string  out, err;
     bool ret = false;
 
+    {
+        std::lock_guard<std::mutex> lock(is_supported_cache_lock);
+        auto cached = is_supported_cache.find(user_bin_dir);
+        if (cached != is_supported_cache.end())
+        {
+            return cached->second;
+        }
+    }
+
     if (InvokeObjDump(ObjDumpOp::kGetMetadata, user_bin_dir, kStrLcObjDumpSwitchHelp, should_print_cmd, out, err) == beKA::beStatus::kBeStatusSuccess)
     {
         ret = (out.find(kStrLcObjDumpMetdataOptionToken) != std::string::npos);
     }
 
+    std::lock_guard<std::mutex> lock(is_supported_cache_lock);
+    is_supported_cache[user_bin_dir] = ret;
+
     return ret;
 }
 
@@ -905,15 +997,43 @@ static bool ParseKernelCodeProps(const YAML::Node& kernel_metadata, KernelCodePr
     return result;
 }
 
+// Extract CodeProps data for all kernels from a single CodeObj metadata node.
+static beKA::beStatus ParseCodePropsNode(const YAML::Node& codeobj_metadata_node, CodePropsMap& code_props)
+{
+    beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
+    YAML::Node kernels_metadata_map, kernel_name;
+
+    if (codeobj_metadata_node.IsMap() &&
+        (kernels_metadata_map = codeobj_metadata_node[kStrCodeObjectMetadataKeyKernels]).IsDefined())
+    {
+        for (const YAML::Node& kernel_metadata : kernels_metadata_map)
+        {
+            KernelCodeProperties kernel_code_props;
+            if ((kernel_name = kernel_metadata[kStrCodeObjectMetadataKeyKernelName]).IsDefined() &&
+                ParseKernelCodeProps(kernel_metadata, kernel_code_props))
+            {
+                code_props[kernel_name.as<std::string>()] = kernel_code_props;
+            }
+            else
+            {
+                status = beKA::beStatus::kBeStatusLightningParseCodeObjMDFailed;
+                break;
+            }
+        }
+    }
+
+    return status;
+}
+
 // Parse the provided CodeObj metadata and extract CodeProps data for all kernels.
 static beKA::beStatus ParseCodeProps(const std::string& metadata_text, CodePropsMap& code_props)
 {
     beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
     size_t start_offset, end_offset;
-    YAML::Node codeobj_metadata_node, kernels_metadata_map, kernel_name;
+    YAML::Node codeobj_metadata_node;
     start_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenStart);
 
-    while ((end_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenEnd, start_offset)) != std::string::npos)
+    while (status == beKA::beStatus::kBeStatusSuccess && (end_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenEnd, start_offset)) != std::string::npos)
     {
         try
         {
@@ -927,25 +1047,63 @@ static beKA::beStatus ParseCodeProps(const std::string& metadata_text, CodeProps
             break;
         }
 
-        if (codeobj_metadata_node.IsMap() &&
-            (kernels_metadata_map = codeobj_metadata_node[kStrCodeObjectMetadataKeyKernels]).IsDefined())
+        status = ParseCodePropsNode(codeobj_metadata_node, code_props);
+        start_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenStart, end_offset);
+    }
+
+    return status;
+}
+
+// Extract the names of all kernels from a single CodeObj metadata node.
+static beKA::beStatus ParseKernelNamesNode(const YAML::Node& codeobj_metadata_node, std::vector<std::string>& kernel_names)
+{
+    beKA::beStatus status = beKA::kBeStatusSuccess;
+    YAML::Node kernels_metadata_map, kernel_name;
+
+    // Look for kernels metadata.
+    if (codeobj_metadata_node.IsMap() &&
+        (kernels_metadata_map = codeobj_metadata_node[kStrCodeObjectMetadataKeyKernels]).IsDefined())
+    {
+        for (const YAML::Node& kernel_metadata : kernels_metadata_map)
         {
-            for (const YAML::Node& kernel_metadata : kernels_metadata_map)
+            if ((kernel_name = kernel_metadata[kStrCodeObjectMetadataKeyKernelName]).IsDefined())
             {
-                KernelCodeProperties kernel_code_props;
-                if (status == beKA::beStatus::kBeStatusSuccess &&
-                    (kernel_name = kernel_metadata[kStrCodeObjectMetadataKeyKernelName]).IsDefined() &&
-                    ParseKernelCodeProps(kernel_metadata, kernel_code_props))
-                {
-                    code_props[kernel_name.as<std::string>()] = kernel_code_props;
-                }
-                else
-                {
-                    status = beKA::beStatus::kBeStatusLightningParseCodeObjMDFailed;
-                    break;
-                }
+                kernel_names.push_back(kernel_name.as<std::string>());
+            }
+            else
+            {
+                status = beKA::kBeStatusLightningExtractKernelNamesFailed;
+                break;
             }
         }
+    }
+
+    return status;
+}
+
+// Parse the provided CodeObj metadata text and extract the names of all kernels.
+static beKA::beStatus ParseKernelNames(const std::string& metadata_text, std::vector<std::string>& kernel_names)
+{
+    beKA::beStatus status = beKA::kBeStatusSuccess;
+    size_t start_offset = 0, end_offset;
+    YAML::Node codeobj_metadata_node;
+    start_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenStart);
+
+    // Load all Metadata nodes found in the objdump output.
+    while (status == beKA::kBeStatusSuccess && (end_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenEnd, start_offset)) != std::string::npos)
+    {
+        try
+        {
+            codeobj_metadata_node = YAML::Load(metadata_text.substr(start_offset + kStrLcCodeObjectMetadataTokenStart.size(),
+                                                                    end_offset - (start_offset + kStrLcCodeObjectMetadataTokenStart.size())));
+        }
+        catch (YAML::ParserException&)
+        {
+            status = beKA::kBeStatusLightningExtractKernelNamesFailed;
+            break;
+        }
+
+        status = ParseKernelNamesNode(codeobj_metadata_node, kernel_names);
         start_offset = metadata_text.find(kStrLcCodeObjectMetadataTokenStart, end_offset);
     }
 
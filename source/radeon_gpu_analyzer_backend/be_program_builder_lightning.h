@@ -45,6 +45,9 @@ struct KernelCodeProperties
 // Maps  kernel_name --> KernelCodeProperties.
 typedef  std::map<std::string, KernelCodeProperties> CodePropsMap;
 
+// Symbol name --> symbol size (in bytes).
+typedef  std::unordered_map<std::string, int> SymbolSizeMap;
+
 class BeProgramBuilderLightning : public BeProgramBuilder
 {
 public:
@@ -80,13 +83,22 @@ public:
                                                 bool                            should_print_cmd,
                                                 std::string&                    error_msg);
 
+    // Builds the options for compiling OpenCL sources for "device", excluding the input and output files.
+    // The options are the same for every compilation with the given user options and target.
+    static beKA::beStatus GetOpenCLCompilerOptions(const CmpilerPaths&  compiler_paths,
+                                                   const OpenCLOptions& user_options,
+                                                   const std::string&   device,
+                                                   std::string&         options);
+
     // Preprocess input file using the OpenCL Lightning Compiler. The preprocessed program text
     // is returned in "output" string.
+    // The program is preprocessed for "device", or for a default device if "device" is empty.
     static beKA::beStatus PreprocessOpencl(const CmpilerPaths& compiler_paths,
                                            const std::string&  input_file,
                                            const std::string&  args, 
                                            bool                should_print_cmd, 
-                                           std::string&        output);
+                                           std::string&        output,
+                                           const std::string&  device = "");
 
     // Disassemble binary to ISA text.
     static beKA::beStatus DisassembleBinary(const std::string& user_bin_dir,
@@ -122,9 +134,16 @@ public:
     static int  GetIsaSize(const std::string& isa_disassembly);
 
     // Extract the size of binary section for the provided kernel.
+    // To get the sizes of several kernels, use ExtractSymbolSizes(), which reads the symbol table only once.
     static int  GetKernelCodeSize(const std::string& user_bin_dir, const std::string& bin_file,
                                   const std::string& kernel_name, bool should_print_cmd);
 
+    // Extract the sizes of all of the symbols in the binary from its symbol table.
+    static beKA::beStatus ExtractSymbolSizes(const std::string& user_bin_dir,
+                                             const std::string& bin_file,
+                                             bool               should_print_cmd,
+                                             SymbolSizeMap&     symbol_sizes);
+
 protected:
     // Adds standard options required to compile source language with LC compiler to the "options" string.
     static beKA::beStatus AddCompilerStandardOptions(beKA::RgaMode mode, const CmpilerPaths& compiler_paths, std::string& options);
@@ -18,6 +18,7 @@
 #include "radeon_gpu_analyzer_backend/be_program_builder_opengl.h"
 #include "radeon_gpu_analyzer_backend/be_utils.h"
 #include "radeon_gpu_analyzer_backend/be_backend.h"
+#include "source/radeon_gpu_analyzer_cli/kc_utils.h"
 
 // Device info.
 #include "DeviceInfoUtils.h"
@@ -385,6 +386,12 @@ beKA::beStatus BeProgramBuilderOpengl::Compile(const OpenglOptions& gl_options,
                 // Redirect build log to a temporary file.
                 const gtString kGlcTmpOutputFile = L"glcTempFile.txt";
                 osFilePath     tmp_file_path(osFilePath::OS_TEMP_DIRECTORY);
+                if (!gl_options.temp_dir.empty())
+                {
+                    gtString temp_dir;
+                    temp_dir << gl_options.temp_dir.c_str();
+                    tmp_file_path.setFileDirectory(temp_dir);
+                }
                 tmp_file_path.setFileName(kGlcTmpOutputFile);
 
                 // Delete the log file if it already exists.
@@ -401,7 +408,8 @@ beKA::beStatus BeProgramBuilderOpengl::Compile(const OpenglOptions& gl_options,
 
                 // Launch glc.
                 BeUtils::PrintCmdLine(cmd.str(), should_print_cmd);
-                bool is_launch_success = osExecAndGrabOutput(cmd.str().c_str(), cancel_signal, glc_output);
+                std::string glc_error;
+                bool        is_launch_success = KcUtils::ExecAndGrabOutput(cmd.str(), glc_output, glc_error);
                 if (is_launch_success)
                 {
                     // This is how glc signals success.
@@ -431,6 +439,10 @@ beKA::beStatus BeProgramBuilderOpengl::Compile(const OpenglOptions& gl_options,
                         {
                             build_log << "Error: " << glc_output << L"\n";
                         }
+                        if (!glc_error.empty())
+                        {
+                            build_log << glc_error.c_str();
+                        }
                     }
                     else if (!VerifyGlcOutput(gl_options, device_gfx_ip))
                     {
@@ -466,12 +478,11 @@ bool BeProgramBuilderOpengl::GetOpenGLVersion(bool should_print_cmd, gtString& o
     std::stringstream cmd;
     cmd << glc_path << " \";;;;;;;;;;;;;;;;;;;;;version;;;;;;;\"";
 
-    // A flag for canceling the operation, we will not use it.
-    bool dummy_cancel_flag = false;
     BeUtils::PrintCmdLine(cmd.str(), should_print_cmd);
-    bool isLaunchSuccess = osExecAndGrabOutput(cmd.str().c_str(), dummy_cancel_flag, opengl_version);
+    std::string error;
+    bool        isLaunchSuccess = KcUtils::ExecAndGrabOutput(cmd.str(), opengl_version, error);
 
-    return isLaunchSuccess;
+    return isLaunchSuccess && !opengl_version.isEmpty();
 }
 
 bool BeProgramBuilderOpengl::GetDeviceGLName(const std::string& device_name, std::string& valid_device_name) const
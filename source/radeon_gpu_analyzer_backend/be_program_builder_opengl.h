@@ -61,6 +61,9 @@ struct OpenglOptions : public beKA::CompileOptions
     // ISA binary output file name.
     std::string program_binary_filename;
 
+    // Directory for the temporary files of glc (the OS temp directory if empty).
+    std::string temp_dir;
+
     // True to generate AMD ISA binaries.
     bool is_amd_isa_binaries_required = false;
 
@@ -16,6 +16,7 @@
 // Local.
 #include "radeon_gpu_analyzer_backend/be_program_builder_vk_offline.h"
 #include "radeon_gpu_analyzer_backend/be_utils.h"
+#include "source/radeon_gpu_analyzer_cli/kc_utils.h"
 
 // Device info.
 #include "DeviceInfoUtils.h"
@@ -255,6 +256,12 @@ beKA::beStatus BeProgramBuilderVkOffline::CompileWithAmdllpc(const VkOfflineOpti
         // Redirect build log to a temporary file.
         const gtString kAmdllpcTmpOutputFile = L"amdllpcTempFile.txt";
         osFilePath     tmp_file_path(osFilePath::OS_TEMP_DIRECTORY);
+        if (!vulkan_options.temp_dir.empty())
+        {
+            gtString temp_dir;
+            temp_dir << vulkan_options.temp_dir.c_str();
+            tmp_file_path.setFileDirectory(temp_dir);
+        }
         tmp_file_path.setFileName(kAmdllpcTmpOutputFile);
 
         // Delete the log file if it already exists.
@@ -283,7 +290,8 @@ beKA::beStatus BeProgramBuilderVkOffline::CompileWithAmdllpc(const VkOfflineOpti
             gtString amdllpc_output;
             std::string cmdStr = cmd.str();
             BeUtils::PrintCmdLine(cmdStr, should_print_cmd);
-            bool is_launch_success = osExecAndGrabOutput(cmd.str().c_str(), cancel_signal, amdllpc_output);
+            std::string amdllpc_error;
+            bool        is_launch_success = KcUtils::ExecAndGrabOutput(cmd.str(), amdllpc_output, amdllpc_error);
             if (is_launch_success)
             {
                 // This is how amdspv signals success.
@@ -313,6 +321,10 @@ beKA::beStatus BeProgramBuilderVkOffline::CompileWithAmdllpc(const VkOfflineOpti
                     {
                         build_log << "Error: " << amdllpc_output << L"\n";
                     }
+                    if (!amdllpc_error.empty())
+                    {
+                        build_log << amdllpc_error.c_str();
+                    }
                 }
                 else
                 {
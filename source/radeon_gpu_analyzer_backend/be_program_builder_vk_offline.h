@@ -66,6 +66,9 @@ struct VkOfflineOptions : public beKA::CompileOptions
     // Full path to output pipeline ELF binary file.
     std::string pipeline_binary;
 
+    // Directory for the temporary files of amdllpc (the OS temp directory if empty).
+    std::string temp_dir;
+
     // True to generate SPIR-V binaries.
     bool is_spirv_binaries_required = false;
 
@@ -11,19 +11,11 @@
 #include <sstream>
 #include <fstream>
 
-// Infra.
-#include "external/amdt_os_wrappers/Include/osProcess.h"
-#include "external/amdt_os_wrappers/Include/osFilePath.h"
-#include "external/amdt_os_wrappers/Include/osFile.h"
-#include "external/amdt_os_wrappers/Include/osApplication.h"
-#include "external/amdt_os_wrappers/Include/osDirectory.h"
-
-// Shared.
-#include "common/rga_shared_utils.h"
-
 // Local.
+#include "radeon_gpu_analyzer_backend/be_live_register_analyzer.h"
 #include "radeon_gpu_analyzer_backend/be_static_isa_analyzer.h"
 #include "radeon_gpu_analyzer_backend/be_utils.h"
+#include "emulator/parser/be_isa_parser.h"
 
 // CLI.
 #include "source/radeon_gpu_analyzer_cli/kc_utils.h"
@@ -31,184 +23,131 @@
 using namespace beKA;
 
 // Static constants.
-static const std::string kShaeOptLivereg       = "analyse-liveness --arch-info";
-static const std::string kShaeOptLiveregWave64 = "--wave-size 64";
-static const std::string kShaeOptLiveregWave32 = "--wave-size 32";
-static const std::string kShaeOptLiveregSgpr   = "--reg-type sgpr";
-
-static const std::string kShaeOptCfgPerBlock = "dump-bb-cfg";
-static const std::string kShaeOptCfgPerInstruciton = "dump-pi-cfg";
-
-static bool GetLiveRegAnalyzerPath(std::string& analyzer_path)
-{
-#ifdef AMD_INTERNAL
-
-#ifdef __linux
-    analyzer_path = "shae-internal";
-#elif _WIN64
-    analyzer_path = "utils\\shae-internal.exe";
-#else
-    analyzer_path = "x86\\shae-internal.exe";
-#endif
 
-#else
+// The names of the nodes of the control flow graphs.
+static const char* kStrDotEntryName       = "entry";
+static const char* kStrDotExitName        = "exit";
+static const char* kStrDotBlockNamePrefix = "basic_block_";
 
-#ifdef __linux
-    analyzer_path = "shae";
-#elif _WIN64
-    analyzer_path = "utils\\shae.exe";
-#else
-    analyzer_path = "x86\\shae.exe";
-#endif
+// *** INTERNALLY LINKED SYMBOLS - START ***
 
-#endif // AMD_INTERNAL
-    return true;
-}
-
-// Accepts the target name and returns the relevant Shae --isa command.
-static std::string GetShaeIsaCmd(const gtString& target)
+// Write the given text as a dot string, with the characters that are special to dot escaped.
+static void WriteDotString(std::ostream& os, std::string_view text)
 {
-    const gtString kShaeGfx8    = L"gfx8";
-    const gtString kShaeGfx9    = L"gfx9";
-    const gtString kShaeGfx90a  = L"gfx90a";
-    const gtString kShaeGfx942  = L"gfx942";
-    const gtString kShaeGfx950  = L"gfx950";
-    const gtString kShaeGfx10_1 = L"gfx10_1";
-    const gtString kShaeGfx10_3 = L"gfx10_3";
-    const gtString kShaeGfx11   = L"gfx11";
-    const gtString kShaeGfx11_5 = L"gfx11_5";
-    const gtString kShaeGfx12   = L"gfx12";
-
-    const gtString kShaeGfx1100 = L"gfx1100";
-    const gtString kShaeGfx1101 = L"gfx1101";
-    const gtString kShaeGfx1151 = L"gfx1151";
-    const gtString kShaeGfx1200 = L"gfx1200";
-    const gtString kShaeGfx1201 = L"gfx1201";
-
-    const gtString kShaeOptionIsa  = L"--isa";
-    const gtString kShaeOptionArch = L"--arch";
-
-    bool              should_add_arch_option = false;
-    std::stringstream shae_gfx_generation;
-    shae_gfx_generation << kShaeOptionIsa.asASCIICharArray() << " ";
-    if (RgaSharedUtils::IsNavi4Target(target.asASCIICharArray()))
+    for (char c : text)
     {
-        shae_gfx_generation << kShaeGfx12.asASCIICharArray();
-
-        if (target.isEqualNoCase(kShaeGfx1200) || target.isEqualNoCase(kShaeGfx1201))
+        if (c == '"' || c == '\\')
         {
-            should_add_arch_option = true;
+            os << '\\';
         }
+        os << c;
     }
-    else if (RgaSharedUtils::IsNavi3Dot5Target(target.asASCIICharArray()))
-    {
-        shae_gfx_generation << kShaeGfx11_5.asASCIICharArray();
+}
 
-        if (target.isEqualNoCase(kShaeGfx1151))
-        {
-            should_add_arch_option = true;
-        }
-    }
-    else if (RgaSharedUtils::IsNavi3Target(target.asASCIICharArray()))
-    {
-        shae_gfx_generation << kShaeGfx11.asASCIICharArray();
+// Get the name of the node of the given block: the name of the block's label, or "basic_block_<n>" for the n-th block of the program.
+static std::string GetDotBlockName(const std::vector<Instruction*>& instructions, const IsaBasicBlock& block, uint32_t block_index)
+{
+    // A labeled block starts at the definition of its label, which is an instruction without an opcode.
+    const Instruction& first      = *instructions[block.first_instruction];
+    bool               is_labeled = first.GetInstructionOpCode().empty() && !first.GetPointingLabelString().empty();
+    return is_labeled ? std::string(BeLiveRegisterAnalyzer::GetLabelName(first.GetPointingLabelString())) : kStrDotBlockNamePrefix + std::to_string(block_index + 1);
+}
 
-        if (target.isEqualNoCase(kShaeGfx1100) || target.isEqualNoCase(kShaeGfx1101))
+// Write the node of the given block, which lists the instructions of the block.
+static void WriteDotBlock(std::ostream& os, const std::vector<Instruction*>& instructions, const IsaBasicBlock& block, const std::string& name)
+{
+    os << "\"n_" << name << "\" [ label= \"" << name << "\n";
+    for (uint32_t i = block.first_instruction; i < block.end_instruction; ++i)
+    {
+        if (!instructions[i]->GetInstructionOpCode().empty())
         {
-            should_add_arch_option = true;
+            WriteDotString(os, BeLiveRegisterAnalyzer::GetInstructionText(*instructions[i], std::string_view()));
+            os << "\\l";
         }
     }
-    else if (RgaSharedUtils::IsNavi21AndBeyond(target.asASCIICharArray()))
-    {
-        shae_gfx_generation << kShaeGfx10_3.asASCIICharArray();
-    }
-    else if (RgaSharedUtils::IsNaviTarget(target.asASCIICharArray()))
-    {
-        shae_gfx_generation << kShaeGfx10_1.asASCIICharArray();
-    }
-    else if (RgaSharedUtils::IsVegaTarget(target.asASCIICharArray()))
+    os << "\" ]\n";
+}
+
+// Write a node for each instruction of the given block. The nodes of a block share its name, and are chained in program order.
+static void WriteDotBlockInstructions(std::ostream& os, const std::vector<Instruction*>& instructions, const IsaBasicBlock& block, const std::string& name)
+{
+    std::string_view label;
+    bool             is_first = true;
+    for (uint32_t i = block.first_instruction; i < block.end_instruction; ++i)
     {
-        if (RgaSharedUtils::IsMi350Target(target.asASCIICharArray()))
-        {
-            shae_gfx_generation << kShaeGfx950.asASCIICharArray();
-        }
-        else if (RgaSharedUtils::IsMi300Target(target.asASCIICharArray()))
+        if (instructions[i]->GetInstructionOpCode().empty())
         {
-            shae_gfx_generation << kShaeGfx942.asASCIICharArray();
-        }
-        else if (RgaSharedUtils::IsMi200Target(target.asASCIICharArray()))
-        {
-            shae_gfx_generation << kShaeGfx90a.asASCIICharArray();
+            // The label is written in front of the first instruction of its block.
+            label = instructions[i]->GetPointingLabelString();
         }
         else
         {
-            shae_gfx_generation << kShaeGfx9.asASCIICharArray();
+            os << "\"n_" << name << "\" [label=\"";
+            WriteDotString(os, BeLiveRegisterAnalyzer::GetInstructionText(*instructions[i], label));
+            os << "\"]\n";
+            if (!is_first)
+            {
+                os << "\"n_" << name << "\":s -> \"n_" << name << "\";\n";
+            }
+            label    = std::string_view();
+            is_first = false;
         }
     }
-    else
-    {
-        // Fall back to GFX8.
-        shae_gfx_generation << kShaeGfx8.asASCIICharArray();
-    }
-
-    if (should_add_arch_option)
-    {
-        shae_gfx_generation << " " << kShaeOptionArch.asASCIICharArray() << " " << target.asASCIICharArray();
-    }
-
-    return shae_gfx_generation.str().c_str();
 }
 
-static beKA::beStatus PerformAnalysis(const gtString& isa_filename, const gtString& target, const gtString& output_filename,
-    const std::string& shae_cmd, bool should_print_cmd)
+// Generate the dot graph of the given program, in the format of the shader analysis tool (shae).
+// In a per-block graph, every basic block is a node that lists the instructions of the block.
+// In a per-instruction graph, every instruction is a node. The entry leads to the first block, and the blocks without successors lead to the exit.
+static std::string GenerateDotGraph(const ParserIsa& parser, bool is_per_instruction)
 {
-    beStatus ret = kBeStatusGeneralFailed;
-
-    // Get the ISA analyzer's path.
-    std::string analyzer_path;
-    bool is_ok = GetLiveRegAnalyzerPath(analyzer_path);
+    const std::vector<Instruction*>&  instructions = parser.GetInstructions();
+    const ISAProgramGraph&            graph        = parser.GetProgramGraph();
+    const std::vector<IsaBasicBlock>& blocks       = graph.GetBlocks();
+    const uint32_t                    block_count  = static_cast<uint32_t>(blocks.size());
 
-    if (is_ok && !analyzer_path.empty())
+    std::vector<std::string> names(block_count);
+    for (uint32_t b = 0; b < block_count; ++b)
     {
-        // Validate the input ISA file.
-        osFilePath isa_file_path(isa_filename);
+        names[b] = GetDotBlockName(instructions, blocks[b], b);
+    }
 
-        if (isa_file_path.exists())
+    std::ostringstream dot;
+    dot << "digraph {\n";
+    dot << "node [shape=box]\n";
+    dot << "\"n_" << kStrDotEntryName << "\" [ label= \"" << kStrDotEntryName << "\n\" style=rounded]\n";
+    for (uint32_t b = 0; b < block_count; ++b)
+    {
+        if (is_per_instruction)
         {
-            // Construct the command.
-            std::stringstream cmd;
-            cmd << analyzer_path << " " << GetShaeIsaCmd(target) << " " << shae_cmd << " \"" << isa_filename.asASCIICharArray()
-                << "\" \"" << output_filename.asASCIICharArray() << '"';
-
-            // Cancel signal. Not in use for now.
-            bool should_cancel = false;
-
-            gtString analyzer_output;
-            BeUtils::PrintCmdLine(cmd.str(), should_print_cmd);
-            is_ok = osExecAndGrabOutput(cmd.str().c_str(), should_cancel, analyzer_output);
-
-            if (is_ok)
-            {
-                ret = kBeStatusSuccess;
-            }
-            else
-            {
-                ret = kBeStatusShaeFailedToLaunch;
-            }
+            WriteDotBlockInstructions(dot, instructions, blocks[b], names[b]);
         }
         else
         {
-            ret = kBeStatusShaeIsaFileNotFound;
+            WriteDotBlock(dot, instructions, blocks[b], names[b]);
         }
     }
-    else
+    dot << "\"n_" << kStrDotExitName << "\" [ label= \"" << kStrDotExitName << "\n\" style=rounded]\n";
+
+    // The taken side of a conditional branch is listed first.
+    dot << "\"n_" << kStrDotEntryName << "\":s -> \"n_" << names[0] << "\";\n";
+    for (uint32_t b = 0; b < block_count; ++b)
     {
-        ret = kBeStatusShaeCannotLocateAnalyzer;
+        for (const IsaEdge* edge = graph.SuccessorsBegin(b); edge != graph.SuccessorsEnd(b); ++edge)
+        {
+            dot << "\"n_" << names[b] << "\":s -> \"n_" << names[edge->block] << "\";\n";
+        }
+        if (graph.SuccessorsBegin(b) == graph.SuccessorsEnd(b))
+        {
+            dot << "\"n_" << names[b] << "\":s -> \"n_" << kStrDotExitName << "\";\n";
+        }
     }
+    dot << "}\n";
 
-    return ret;
+    return dot.str();
 }
 
+// *** INTERNALLY LINKED SYMBOLS - END ***
+
 beKA::beStatus beKA::BeStaticIsaAnalyzer::PreprocessIsaFile(const std::string& isa_filename, const std::string& output_filename)
 {
     beStatus ret = kBeStatusGeneralFailed;
@@ -242,97 +181,57 @@ beKA::beStatus beKA::BeStaticIsaAnalyzer::PreprocessIsaFile(const std::string& i
     return ret;
 }
 
-beKA::beStatus beKA::BeStaticIsaAnalyzer::PerformLiveRegisterAnalysis(const gtString& isa_filename, const gtString& target,
-                                                                      const gtString& output_filename,
-                                                                      beWaveSize      wave_size,
-                                                                      bool            should_print_cmd,
-                                                                      bool            is_reg_type_sgpr)
+beKA::beStatus beKA::BeStaticIsaAnalyzer::PerformLiveRegisterAnalysis(const gtString& isa_filename,
+                                                                      const gtString& target,
+                                                                      const gtString& vgpr_output_filename,
+                                                                      const gtString& sgpr_output_filename,
+                                                                      beWaveSize      wave_size)
 {
-    std::stringstream shae_option;
-    switch (wave_size)
+    beStatus ret = kBeStatusShaeIsaFileNotFound;
+
+    // Read the ISA once for both of the register classes.
+    std::string isa_text;
+    if (KcUtils::ReadTextFile(isa_filename.asASCIICharArray(), isa_text, nullptr))
     {
-    case kUnknown:
-        // Let Shae deduce the wave size from the disassembly.
-        shae_option << kShaeOptLivereg;
-        if (is_reg_type_sgpr)
-        {
-            shae_option << " " << kShaeOptLiveregSgpr;
-        }
-        break;
-    case kWave32:
-        // Force wave32.
-        shae_option << kShaeOptLivereg;
-        if (is_reg_type_sgpr)
-        {
-            shae_option << " " << kShaeOptLiveregSgpr;
-        }
-        shae_option  << " " << kShaeOptLiveregWave32;
-        break;
-    case kWave64:
-        // Force wave64.
-        shae_option << kShaeOptLivereg;
-        if (is_reg_type_sgpr)
-        {
-            shae_option << " " << kShaeOptLiveregSgpr;
+        const bool  is_vgpr_required = !vgpr_output_filename.isEmpty();
+        const bool  is_sgpr_required = !sgpr_output_filename.isEmpty();
+        std::string vgpr_report;
+        std::string sgpr_report;
+        ret = BeLiveRegisterAnalyzer::Analyze(isa_text,
+                                              target.asASCIICharArray(),
+                                              wave_size,
+                                              is_vgpr_required ? &vgpr_report : nullptr,
+                                              is_sgpr_required ? &sgpr_report : nullptr);
+
+        if (ret == kBeStatusSuccess)
+        {
+            if ((is_vgpr_required && !KcUtils::WriteTextFile(vgpr_output_filename.asASCIICharArray(), vgpr_report, nullptr)) ||
+                (is_sgpr_required && !KcUtils::WriteTextFile(sgpr_output_filename.asASCIICharArray(), sgpr_report, nullptr)))
+            {
+                ret = kBeStatusWriteToFileFailed;
+            }
         }
-        shae_option << " " << kShaeOptLiveregWave64;
-        break;
-    default:
-        // We shouldn't get here.
-        assert(false);
-        break;
     }
 
-    return PerformAnalysis(isa_filename, target, output_filename, shae_option.str(), should_print_cmd);
+    return ret;
 }
 
-beKA::beStatus beKA::BeStaticIsaAnalyzer::GenerateControlFlowGraph(const gtString& isa_filename, const gtString& target, const gtString& output_filename,
-    bool is_per_instruction, bool should_print_cmd)
+beKA::beStatus beKA::BeStaticIsaAnalyzer::GenerateControlFlowGraph(const gtString& isa_filename, const gtString& output_filename, bool is_per_instruction)
 {
-    beStatus ret = kBeStatusGeneralFailed;
-
-    // Get the ISA analyzer's path.
-    std::string analyzer_path;
-    bool is_ok = GetLiveRegAnalyzerPath(analyzer_path);
+    beStatus ret = kBeStatusShaeIsaFileNotFound;
 
-    if (is_ok && !analyzer_path.empty())
+    std::string isa_text;
+    if (KcUtils::ReadTextFile(isa_filename.asASCIICharArray(), isa_text, nullptr))
     {
-        // Validate the input ISA file.
-        osFilePath isa_file_path(isa_filename);
-
-        if (isa_file_path.exists())
-        {
-            // Construct the command.
-            std::stringstream cmd;
-            const std::string kShaeOptCfg = is_per_instruction ? kShaeOptCfgPerInstruciton : kShaeOptCfgPerBlock;
-            cmd << analyzer_path << " " << GetShaeIsaCmd(target) << " " << kShaeOptCfg << " " << '"' << isa_filename.asASCIICharArray()
-                << "\" \"" << output_filename.asASCIICharArray() << '"';
+        ret = kBeStatusGeneralFailed;
 
-            // Cancel signal. Not in use for now.
-            bool should_cancel = false;
-
-            gtString analyzer_output;
-            BeUtils::PrintCmdLine(cmd.str(), should_print_cmd);
-            is_ok = osExecAndGrabOutput(cmd.str().c_str(), should_cancel, analyzer_output);
-
-            if (is_ok)
-            {
-                ret = kBeStatusSuccess;
-            }
-            else
-            {
-                ret = kBeStatusShaeFailedToLaunch;
-            }
-        }
-        else
+        ParserIsa parser;
+        if (parser.ParseStream(isa_text, true, true) && !parser.GetProgramGraph().GetBlocks().empty())
         {
-            ret = kBeStatusShaeIsaFileNotFound;
+            const std::string dot_graph = GenerateDotGraph(parser, is_per_instruction);
+            ret = KcUtils::WriteTextFile(output_filename.asASCIICharArray(), dot_graph, nullptr) ? kBeStatusSuccess : kBeStatusWriteToFileFailed;
         }
     }
-    else
-    {
-        ret = kBeStatusShaeCannotLocateAnalyzer;
-    }
 
     return ret;
 }
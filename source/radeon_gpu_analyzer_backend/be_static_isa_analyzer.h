@@ -24,12 +24,14 @@ namespace beKA
     static beStatus PreprocessIsaFile(const std::string& isa_filename, const std::string& output_filename);
 
     // Perform live register analysis on the ISA disassembly contained in the given file,
-    // and dump the analysis output to another file.
+    // and dump the VGPR and the SGPR analysis output to the given files.
+    // Both register classes are analyzed in a single pass. Either of the output file names can be empty if its analysis is not required.
     static beStatus PerformLiveRegisterAnalysis(const gtString& isa_filename, const gtString& target,
-        const gtString& output_filename, beWaveSize wave_size, bool should_print_cmd, bool is_reg_type_sgpr);
+        const gtString& vgpr_output_filename, const gtString& sgpr_output_filename, beWaveSize wave_size);
 
-    // Generate control flow graph for the ISA disassembly contained in the given file, and dump the analysis output to another file.
-    static beStatus GenerateControlFlowGraph(const gtString& isa_filename, const gtString& target, const gtString& output_filename, bool is_per_instruction, bool should_print_cmd);
+    // Generate control flow graph for the ISA disassembly contained in the given file, and dump it in dot format to another file.
+    // The graph has a node per basic block, or a node per instruction if is_per_instruction is true.
+    static beStatus GenerateControlFlowGraph(const gtString& isa_filename, const gtString& output_filename, bool is_per_instruction);
 
 private:
     // No instances.
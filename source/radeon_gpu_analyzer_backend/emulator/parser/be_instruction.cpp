@@ -7,7 +7,7 @@
 
 // C++.
 #include <algorithm>
-#include <sstream>
+#include <mutex>
 
 // Local.
 #include "source/radeon_gpu_analyzer_backend/emulator/parser/be_instruction.h"
@@ -573,79 +573,50 @@ std::unordered_map<std::string, int> Instruction::half_device_perf_table_;
 std::unordered_map<std::string, int> Instruction::quarter_device_perf_table_;
 std::unordered_map<std::string, int> Instruction::hybrid_device_perf_table_;
 std::unordered_map<std::string, int> Instruction::scalar_device_perf_table_;
-bool Instruction::is_perf_tables_initialized_ = false;
+std::once_flag Instruction::perf_tables_init_flag_;
 
-int Instruction::GetInstructionClockCount(const std::string& device_name) const
-{
-    int ret = 0;
+std::unordered_map<std::string_view, Instruction::OpcodeId> Instruction::opcode_ids_;
+std::vector<int> Instruction::opcode_clock_counts_;
+std::vector<Instruction::InstructionCategory> Instruction::opcode_categories_;
 
-    if (!device_name.empty())
-    {
-        // Ignore the case.
-        std::string opcode_lower_case(instruction_opcode_);
-        std::transform(opcode_lower_case.begin(), opcode_lower_case.end(), opcode_lower_case.begin(), [](const char& c) { return static_cast<char>(std::tolower(c)); });
-
-        // First look at the scalar performance table.
-        auto dev_iter = scalar_device_perf_table_.find(opcode_lower_case);
-        if (dev_iter != scalar_device_perf_table_.end())
-        {
-            ret = dev_iter->second;
-        }
-        else
-        {
-            dev_iter = hybrid_device_perf_table_.find(opcode_lower_case);
-            if (dev_iter != hybrid_device_perf_table_.end())
-            {
-                ret = dev_iter->second;
-            }
-        }
-    }
+Instruction::OpcodeId Instruction::InternOpcode(std::string_view opcode)
+{
+    SetUpPerfTables();
+    auto iter = opcode_ids_.find(opcode);
+    return (iter != opcode_ids_.end()) ? iter->second : kUnknownOpcodeId;
+}
 
-    return ret;
+int Instruction::GetInstructionClockCount(const std::string& device_name) const
+{
+    return device_name.empty() ? 0 : opcode_clock_counts_[opcode_id_];
 }
 
-void Instruction::SetInstructionStringRepresentation(const std::string& opcode, const std::string& params, const std::string& binary_representation, const std::string& offset)
+void Instruction::SetInstructionStringRepresentation(std::string_view opcode, std::string_view params, std::string_view binary_representation, std::string_view offset)
 {
     instruction_opcode_ = opcode;
-    std::transform(
-        instruction_opcode_.begin(), instruction_opcode_.end(), instruction_opcode_.begin(), [](const char& c) { return static_cast<char>(std::tolower(c)); });
-
+    opcode_id_ = InternOpcode(opcode);
     parameters_ = params;
     binary_representation_ = binary_representation;
     offset_in_bytes_ = offset;
 
-    // Deduce the instruction category.
-    if ((instruction_opcode_.find(kSoppSCondBranchPrefix) != std::string::npos) ||
-        instruction_opcode_ == kSoppSBranch || instruction_opcode_ == kSoppSSetpc ||
-        instruction_opcode_ == kSoppSSwappc)
-    {
-        Instruction_category_ = InstructionCategory::kBranch;
-    }
-    else if (instruction_opcode_ == kSoppSEndpgm ||
-             instruction_opcode_ == kOpSWaitcnt ||
-             instruction_opcode_ == kSoppSNop ||
-             instruction_opcode_ == kSoppSTrap ||
-             instruction_opcode_ == kSoppSRfe ||
-             instruction_opcode_ == kSoppSSetprio ||
-             instruction_opcode_ == kSoppSSleep ||
-             instruction_opcode_ == kSoppSSendmsg)
+    // Deduce the instruction category. The category of the known opcodes is precomputed,
+    // the only category that an unknown opcode may have is a conditional branch.
+    InstructionCategory category = opcode_categories_[opcode_id_];
+    if (opcode_id_ == kUnknownOpcodeId && instruction_opcode_.find(kSoppSCondBranchPrefix) != std::string_view::npos)
     {
-        Instruction_category_ = InstructionCategory::kInternal;
+        category = InstructionCategory::kBranch;
     }
-    else if (scalar_device_perf_table_.find(instruction_opcode_) != scalar_device_perf_table_.end())
-    {
-        Instruction_category_ = InstructionCategory::kScalarAlu;
-    }
-    else if (instruction_opcode_.compare(kExportExp) == 0)
+
+    if (category != InstructionCategory::kInstructionsCategoryCount)
     {
-        Instruction_category_ = InstructionCategory::kExport;
+        Instruction_category_ = category;
     }
 }
 
 void Instruction::SetUpPerfTables()
 {
-    if (!is_perf_tables_initialized_)
-    {
+    // The tables are shared by all parsers, which may run on several threads concurrently.
+    std::call_once(perf_tables_init_flag_, []() {
         // Scalar instructions.
         SetUpScalarPerfTables();
 
@@ -658,8 +629,83 @@ void Instruction::SetUpPerfTables()
         // Half double devices.
         SetUpHalfDevicesPerfTables();
 
-        // The tables have been initialized.
-        is_perf_tables_initialized_ = true;
+        // Opcode identifiers.
+        SetUpOpcodeTables();
+    });
+}
+
+void Instruction::SetUpOpcodeTables()
+{
+    // The opcodes that determine the instruction category on top of the performance tables.
+    static const char* kCategoryOpcodes[] = {kSoppSBranch, kSoppSSetpc, kSoppSSwappc, kSoppSEndpgm, kOpSWaitcnt, kSoppSNop, kSoppSTrap,
+                                             kSoppSRfe, kSoppSSetprio, kSoppSSleep, kSoppSSendmsg, kExportExp};
+
+    // Identifier 0 is reserved for the unknown opcodes.
+    std::vector<std::string_view> opcodes(1);
+    auto intern = [&opcodes](std::string_view opcode) {
+        if (opcode_ids_.emplace(opcode, static_cast<OpcodeId>(opcodes.size())).second)
+        {
+            opcodes.push_back(opcode);
+        }
+    };
+    for (const auto* table : {&scalar_device_perf_table_, &hybrid_device_perf_table_, &quarter_device_perf_table_, &half_device_perf_table_})
+    {
+        for (const auto& entry : *table)
+        {
+            intern(entry.first);
+        }
+    }
+    for (const char* opcode : kCategoryOpcodes)
+    {
+        intern(opcode);
+    }
+
+    opcode_clock_counts_.assign(opcodes.size(), 0);
+    opcode_categories_.assign(opcodes.size(), InstructionCategory::kInstructionsCategoryCount);
+    for (size_t id = 1; id < opcodes.size(); id++)
+    {
+        const std::string opcode(opcodes[id]);
+
+        // The scalar performance table takes precedence over the hybrid architecture table.
+        auto dev_iter = scalar_device_perf_table_.find(opcode);
+        if (dev_iter != scalar_device_perf_table_.end())
+        {
+            opcode_clock_counts_[id] = dev_iter->second;
+        }
+        else
+        {
+            dev_iter = hybrid_device_perf_table_.find(opcode);
+            if (dev_iter != hybrid_device_perf_table_.end())
+            {
+                opcode_clock_counts_[id] = dev_iter->second;
+            }
+        }
+
+        if ((opcode.find(kSoppSCondBranchPrefix) != std::string::npos) ||
+            opcode == kSoppSBranch || opcode == kSoppSSetpc ||
+            opcode == kSoppSSwappc)
+        {
+            opcode_categories_[id] = InstructionCategory::kBranch;
+        }
+        else if (opcode == kSoppSEndpgm ||
+                 opcode == kOpSWaitcnt ||
+                 opcode == kSoppSNop ||
+                 opcode == kSoppSTrap ||
+                 opcode == kSoppSRfe ||
+                 opcode == kSoppSSetprio ||
+                 opcode == kSoppSSleep ||
+                 opcode == kSoppSSendmsg)
+        {
+            opcode_categories_[id] = InstructionCategory::kInternal;
+        }
+        else if (scalar_device_perf_table_.find(opcode) != scalar_device_perf_table_.end())
+        {
+            opcode_categories_[id] = InstructionCategory::kScalarAlu;
+        }
+        else if (opcode.compare(kExportExp) == 0)
+        {
+            opcode_categories_[id] = InstructionCategory::kExport;
+        }
     }
 }
 
@@ -1861,79 +1907,55 @@ void Instruction::SetUpQuarterDevicesPerfTables()
     quarter_device_perf_table_[kVOP1VRsqF64] = 16;
 }
 
-std::string Instruction::GetFunctionalUnitAsString(InstructionCategory category)
+const char* Instruction::GetFunctionalUnitName(InstructionCategory category)
 {
-    static const char* kFunctionalUnitAtomics = "Atomics";
-
-    std::string ret;
-
-    switch (category)
+    // The functional unit names, indexed by instruction category.
+    // Internal instructions are still named "Flow Control" so that it will be meaningful for the end user.
+    static const char* kFunctionalUnitNames[kInstructionsCategoryCount] = {
+        FUNC_UNIT_SMEM,           // kScalarMemoryRead
+        FUNC_UNIT_SMEM,           // kScalarMemoryWrite
+        FUNC_UNIT_SALU,           // kScalarAlu
+        FUNC_UNIT_VMEM,           // kVectorMemoryRead
+        FUNC_UNIT_VMEM,           // kVectorMemoryWrite
+        FUNC_UNIT_VALU,           // kVectorAlu
+        FUNC_UNIT_LDS,            // kLds
+        FUNC_UNIT_GDS_EXPORT,     // kGds
+        FUNC_UNIT_GDS_EXPORT,     // kExport
+        "Atomics",                // kAtomics
+        FUNC_UNIT_INTERNAL_FLOW,  // kInternal
+        FUNC_UNIT_BRANCH          // kBranch
+    };
+
+    const char* ret = FUNC_UNIT_UNKNOWN;
+    if (category >= 0 && category < kInstructionsCategoryCount)
     {
-        case kScalarAlu:
-            ret = FUNC_UNIT_SALU;
-            break;
-
-        case kScalarMemoryRead:
-        case kScalarMemoryWrite:
-            ret = FUNC_UNIT_SMEM;
-            break;
-
-        case kVectorMemoryRead:
-        case kVectorMemoryWrite:
-            ret = FUNC_UNIT_VMEM;
-            break;
-
-        case kVectorAlu:
-            ret = FUNC_UNIT_VALU;
-            break;
-
-        case kLds:
-            ret = FUNC_UNIT_LDS;
-            break;
-
-        case kGds:
-        case kExport:
-            ret = FUNC_UNIT_GDS_EXPORT;
-            break;
-
-        case kAtomics:
-            ret = kFunctionalUnitAtomics;
-            break;
-
-        case kInternal:
-            // We will still name it "Flow Control"
-            // so that it will be meaningful for the end user.
-            ret = FUNC_UNIT_INTERNAL_FLOW;
-            break;
-
-        case kBranch:
-            ret = FUNC_UNIT_BRANCH;
-            break;
-
-        default:
-            ret = FUNC_UNIT_UNKNOWN;
-
-            // We shouldn't get here.
-            GT_ASSERT(false);
-            break;
+        ret = kFunctionalUnitNames[category];
+    }
+    else
+    {
+        // We shouldn't get here.
+        GT_ASSERT(false);
     }
 
     return ret;
 }
 
-Instruction::Instruction(const std::string& labelString)
+std::string Instruction::GetFunctionalUnitAsString(InstructionCategory category)
+{
+    return GetFunctionalUnitName(category);
+}
+
+Instruction::Instruction(std::string_view labelString, int label) :
+    Instruction_category_(kInternal), instruction_format_(kInstructionSetSopp), hw_gen_(GDT_HW_GENERATION_SOUTHERNISLAND), m_instructionWidth(0), label_(label),
+    goto_label_(kNoLabel), line_number_(0), pointing_label_string_(labelString)
 {
     // Setup the performance tables.
     SetUpPerfTables();
 
-    pointing_label_string_ = labelString;
-
-    size_t strLen = pointing_label_string_.size();
-
     // Remove terminating carriage return character from the label if it exists
-    if (!pointing_label_string_.empty() && pointing_label_string_[strLen - 1] == '\r')
+    if (!pointing_label_string_.empty() && pointing_label_string_.back() == '\r')
     {
-        pointing_label_string_.erase(strLen - 1);
+        pointing_label_string_.remove_suffix(1);
     }
 }
 
@@ -1946,56 +1968,56 @@ Instruction::Instruction(unsigned int instruction_width, InstructionCategory ins
 
 void Instruction::GetCsvString(const std::string& device_name, bool should_add_src_line_info, std::string& csv_string)const
 {
-    std::stringstream output_stream;
+    // Append the fields directly to the output string, to avoid constructing a stream per instruction.
+    csv_string.clear();
 
     if (GetLabel() == kNoLabel)
     {
-        std::string full_offset = GetInstructionOffset().c_str();
+        std::string_view full_offset = GetInstructionOffset();
         size_t len = full_offset.size() >= 6 ? full_offset.size() - 6 : 0;
 
-        output_stream << "0x" << full_offset.substr(len, 6) << COMMA_SEPARATOR;
+        csv_string.append("0x").append(full_offset.substr(len, 6)).append(COMMA_SEPARATOR);
 
         // Add the source line info.
         if (should_add_src_line_info)
         {
             auto  srcLineInfo = GetSrcLineInfo();
-            output_stream << srcLineInfo.first << COMMA_SEPARATOR;
+            csv_string.append(std::to_string(srcLineInfo.first)).append(COMMA_SEPARATOR);
         }
 
         bool is_branch = (GetInstructionCategory() == InstructionCategory::kBranch);
-        output_stream << GetInstructionOpCode() << COMMA_SEPARATOR;
-        output_stream << DOUBLE_QUOTES << GetInstructionParameters() << DOUBLE_QUOTES << COMMA_SEPARATOR;
+        csv_string.append(GetInstructionOpCode()).append(COMMA_SEPARATOR);
+        csv_string.append(DOUBLE_QUOTES).append(GetInstructionParameters()).append(DOUBLE_QUOTES).append(COMMA_SEPARATOR);
 
-        output_stream << Instruction::GetFunctionalUnitAsString(GetInstructionCategory()) << COMMA_SEPARATOR;
+        csv_string.append(Instruction::GetFunctionalUnitName(GetInstructionCategory())).append(COMMA_SEPARATOR);
 
         // Get the number of cycle that this instruction costs.
         int cycle_count = GetInstructionClockCount(device_name);
 
         if (cycle_count > 0)
         {
-            output_stream << cycle_count;
+            csv_string.append(std::to_string(cycle_count));
         }
         else
         {
             if (is_branch)
             {
-                output_stream << BRANCH_CYCLES;
+                csv_string.append(BRANCH_CYCLES);
             }
             else
             {
-                output_stream << NA_VALUE;
+                csv_string.append(NA_VALUE);
             }
         }
 
-        output_stream << COMMA_SEPARATOR;
-        output_stream << GetInstructionBinaryRep() << COMMA_SEPARATOR;
+        csv_string.append(COMMA_SEPARATOR);
+        csv_string.append(GetInstructionBinaryRep()).append(COMMA_SEPARATOR);
 
     }
     else
     {
-        output_stream << GetPointingLabelString();
+        csv_string.append(GetPointingLabelString());
     }
 
-    output_stream << NEWLINE_SEPARATOR;
-    csv_string = output_stream.str();
+    csv_string.append(NEWLINE_SEPARATOR);
 }
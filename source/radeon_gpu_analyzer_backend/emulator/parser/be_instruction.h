@@ -14,8 +14,11 @@
 
 // C++.
 #include <math.h>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 // Infra.
 #include "DeviceInfo.h"
@@ -23,6 +26,9 @@
 #include "amdt_base_tools/Include/gtAssert.h"
 #include "source/radeon_gpu_analyzer_backend/be_string_constants.h"
 
+// Local.
+#include "be_instruction_arena.h"
+
 // This value means no label in an instruction.
 const int kNoLabel = -1;
 
@@ -156,19 +162,40 @@ public:
     // Translates Instruction`s functional unit to user friendly std::string.
     static std::string GetFunctionalUnitAsString(InstructionCategory category);
 
+    // Translates Instruction`s functional unit to a user friendly name, without allocating memory.
+    static const char* GetFunctionalUnitName(InstructionCategory category);
+
     // 32 bit instructions.
     typedef uint32_t Instruction32Bit;
 
     // 64 bit instruction.
     typedef uint64_t Instruction64Bit;
 
+    // Dense identifier of an interned opcode.
+    typedef uint16_t OpcodeId;
+
+    // Identifier of the opcodes that are not known to the performance tables.
+    static const OpcodeId kUnknownOpcodeId = 0;
+
+    // Returns the identifier of the given lower case opcode, or kUnknownOpcodeId if the opcode is unknown.
+    static OpcodeId InternOpcode(std::string_view opcode);
+
     Instruction(unsigned int instructionWidth, InstructionCategory instructionFormatKind, InstructionSet instructionFormat, int label_ = kNoLabel, int iGotoLabel = kNoLabel);
 
     // ctor for label instruction
-    explicit Instruction(const std::string& labelString);
+    Instruction(std::string_view labelString, int label);
 
     virtual ~Instruction() = default;
 
+    // Instructions are allocated in the arena of the program that they belong to.
+    static void* operator new(size_t size, InstructionArena& arena) { return arena.Allocate(size); }
+
+    // Called if the constructor throws. The memory is released together with the arena.
+    static void operator delete(void*, InstructionArena&) {}
+
+    // Instructions are never deleted individually: the memory is released together with the arena.
+    static void operator delete(void*) {}
+
     // Get an instruction`s width in bits.
     // Returns the instruction`s width in bits.
     unsigned int GetInstructionWidth() const { return m_instructionWidth; }
@@ -186,10 +213,11 @@ public:
     void SetLineNumber(int iLineNumber) { line_number_ = iLineNumber; }
 
     // Get the source line (and its number) that was translated to this instructions.
-    std::pair<int, std::string>  GetSrcLineInfo() const { return { src_line_number_, src_line_ }; }
+    std::pair<int, std::string_view>  GetSrcLineInfo() const { return { src_line_number_, src_line_ }; }
 
     // Set the source line (and its number) that was translated to this instructions.
-    void SetSrcLineInfo(int lineNum, const std::string& line) { src_line_number_ = lineNum; src_line_ = line; }
+    // The text is not copied and has to outlive the instruction.
+    void SetSrcLineInfo(int lineNum, std::string_view line) { src_line_number_ = lineNum; src_line_ = line; }
 
     // Get the label if any where instruction is a branch.
     int GetGotoLabel() const { return goto_label_; }
@@ -200,40 +228,47 @@ public:
     // Get instruction cycle count for a given target.
     int GetInstructionClockCount(const std::string& deviceName) const;
 
+    // Get the identifier of the instruction's opcode.
+    OpcodeId GetOpcodeId() const { return opcode_id_; }
+
     // The Instruction Asic HW generation. default is SI
     GDT_HW_GENERATION GetHwGen() const { return hw_gen_; }
     void SetHwGen(GDT_HW_GENERATION HwGen) { hw_gen_ = HwGen; }
 
     // String representation of the instruction's opcode.
-    const std::string& GetInstructionOpCode() const { return instruction_opcode_; }
+    std::string_view GetInstructionOpCode() const { return instruction_opcode_; }
 
     // String representation of the instruction's parameters.
-    const std::string& GetInstructionParameters() const { return parameters_; }
+    std::string_view GetInstructionParameters() const { return parameters_; }
 
     // String representation of the instruction's binary representation.
-    const std::string& GetInstructionBinaryRep() const { return binary_representation_; }
+    std::string_view GetInstructionBinaryRep() const { return binary_representation_; }
 
     // String representation of the instruction's offset within the program.
-    const std::string& GetInstructionOffset() const { return offset_in_bytes_; }
+    std::string_view GetInstructionOffset() const { return offset_in_bytes_; }
+
+    // The setters below do not copy the text: it has to outlive the instruction.
+    // The parser points them into the isa text that it holds.
 
     // Sets the string representation of the instruction's opcode.
-    void SetInstructionOpCode(const std::string& opCode) { instruction_opcode_ = opCode; }
+    void SetInstructionOpCode(std::string_view opCode) { instruction_opcode_ = opCode; opcode_id_ = InternOpcode(opCode); }
 
     // Sets the string representation of the instruction's parameters.
-    void SetInstructionParameters(const std::string& params) { parameters_ = params; }
+    void SetInstructionParameters(std::string_view params) { parameters_ = params; }
 
     // Sets the string representation of the instruction's binary representation.
-    void SetInstructionBinaryRep(const std::string& binaryRep) { binary_representation_ = binaryRep; }
+    void SetInstructionBinaryRep(std::string_view binaryRep) { binary_representation_ = binaryRep; }
 
     // Sets the string representation of the instruction's offset within the program.
-    void SetInstructionOffset(const std::string& offset) { offset_in_bytes_ = offset; }
+    void SetInstructionOffset(std::string_view offset) { offset_in_bytes_ = offset; }
 
     // Sets the string representation of the instruction: opcode, parameters, binary representation and offset within the program.
-    void SetInstructionStringRepresentation(const std::string& opCode,
-        const std::string& params, const std::string& binaryRep, const std::string& offset);
+    // The opcode is expected in lower case.
+    void SetInstructionStringRepresentation(std::string_view opCode,
+        std::string_view params, std::string_view binaryRep, std::string_view offset);
 
     // Returns pointing label string
-    const std::string& GetPointingLabelString() const { return pointing_label_string_; }
+    std::string_view GetPointingLabelString() const { return pointing_label_string_; }
 
     // Generates a comma separated string representation of the instruction.
     void GetCsvString(const std::string& deviceName, bool srcLineInfo, std::string& commaSeparatedString)const;
@@ -262,7 +297,10 @@ protected:
     int line_number_;
 
     // String representation of the instruction's opcode.
-    std::string instruction_opcode_;
+    std::string_view instruction_opcode_;
+
+    // Identifier of the instruction's opcode.
+    OpcodeId opcode_id_ = kUnknownOpcodeId;
 
 private:
 
@@ -281,27 +319,30 @@ private:
     // Initializes half devices performance tables.
     static void SetUpHalfDevicesPerfTables();
 
+    // Interns the opcodes of the performance tables, and initializes the tables indexed by opcode identifier.
+    static void SetUpOpcodeTables();
+
     // String representation of the parameters.
-    std::string parameters_;
+    std::string_view parameters_;
 
     // String of the binary representation of the instruction (e.g. 0xC2078914).
-    std::string binary_representation_;
+    std::string_view binary_representation_;
 
     // String representation of the offset in bytes of the current instruction
     // from the beginning of the program.
-    std::string offset_in_bytes_;
+    std::string_view offset_in_bytes_;
 
     // If this instruction is being pointed by a label, this member will hold the label.
-    std::string pointing_label_string_;
+    std::string_view pointing_label_string_;
 
     // Corresponding source line.
-    std::string src_line_;
+    std::string_view src_line_;
 
     // Corresponding source line number.
-    int src_line_number_;
+    int src_line_number_ = 0;
 
-    // Indicates whether the performance tables were initialized or not.
-    static bool is_perf_tables_initialized_;
+    // Guards the one-time initialization of the performance tables.
+    static std::once_flag perf_tables_init_flag_;
 
     // Holds the cycles per instruction for the 1/2 device architecture.
     static std::unordered_map<std::string, int> half_device_perf_table_;
@@ -314,6 +355,16 @@ private:
 
     // Holds the cycles per instruction for the scalar instructions.
     static std::unordered_map<std::string, int> scalar_device_perf_table_;
+
+    // Maps the known opcodes to their identifiers.
+    static std::unordered_map<std::string_view, OpcodeId> opcode_ids_;
+
+    // Holds the cycles per instruction, indexed by opcode identifier.
+    static std::vector<int> opcode_clock_counts_;
+
+    // Holds the category of the instruction, indexed by opcode identifier.
+    // kInstructionsCategoryCount means that the opcode does not determine the category.
+    static std::vector<InstructionCategory> opcode_categories_;
 };
 
 #endif //RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_INSTRUCTION_H_
@@ -0,0 +1,81 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the memory arena that holds the instructions of a parsed isa program.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+
+// Local.
+#include "be_instruction_arena.h"
+
+// *****************************************
+// *** INTERNALLY LINKED SYMBOLS - START ***
+// *****************************************
+
+// Alignment of all allocations.
+static const size_t kArenaAlignment = alignof(std::max_align_t);
+
+// Size of the first block when no size was reserved.
+static const size_t kArenaMinBlockSize = 64 * 1024;
+
+static size_t AlignSize(size_t size)
+{
+    return (size + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+}
+
+// ***************************************
+// *** INTERNALLY LINKED SYMBOLS - END ***
+// ***************************************
+
+void* InstructionArena::Allocate(size_t size)
+{
+    size = AlignSize(size);
+    if (blocks_.empty() || blocks_.back().size - offset_ < size)
+    {
+        // Grow geometrically to keep the number of blocks low.
+        size_t block_size = blocks_.empty() ? kArenaMinBlockSize : 2 * blocks_.back().size;
+        AddBlock(std::max(block_size, size));
+    }
+
+    void* ret = blocks_.back().data.get() + offset_;
+    offset_ += size;
+    return ret;
+}
+
+void InstructionArena::Reserve(size_t size)
+{
+    size = AlignSize(size);
+    if (blocks_.empty() || blocks_.back().size - offset_ < size)
+    {
+        if (!blocks_.empty() && offset_ == 0)
+        {
+            // The last block is not in use: replace it with a larger one.
+            blocks_.pop_back();
+        }
+        AddBlock(size);
+    }
+}
+
+void InstructionArena::Reset()
+{
+    if (blocks_.size() > 1)
+    {
+        // Keep the largest block.
+        auto largest_block = std::max_element(blocks_.begin(), blocks_.end(), [](const Block& a, const Block& b) { return a.size < b.size; });
+        std::swap(blocks_.front(), *largest_block);
+        blocks_.resize(1);
+    }
+    offset_ = 0;
+}
+
+void InstructionArena::AddBlock(size_t min_size)
+{
+    Block block;
+    block.size = AlignSize(min_size);
+    block.data.reset(new char[block.size]);
+    blocks_.push_back(std::move(block));
+    offset_ = 0;
+}
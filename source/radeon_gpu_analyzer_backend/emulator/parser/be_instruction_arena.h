@@ -0,0 +1,56 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for the memory arena that holds the instructions of a parsed isa program.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_INSTRUCTION_ARENA_H_
+#define RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_INSTRUCTION_ARENA_H_
+
+// C++.
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for the instructions of a single isa program.
+// Objects that are allocated in the arena are never destroyed individually:
+// all of them are released at once when the arena is reset or destroyed.
+class InstructionArena
+{
+public:
+    InstructionArena() = default;
+    ~InstructionArena() = default;
+
+    InstructionArena(const InstructionArena&)            = delete;
+    InstructionArena& operator=(const InstructionArena&) = delete;
+
+    // Allocate a memory chunk of the given size, aligned for any object type.
+    void* Allocate(size_t size);
+
+    // Make sure that the arena can serve allocations of the given total size without allocating memory.
+    void Reserve(size_t size);
+
+    // Release all objects that were allocated in the arena.
+    // The largest memory block is kept to be reused by the next program.
+    void Reset();
+
+private:
+    // A single chunk of memory that allocations are served from.
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t                  size = 0;
+    };
+
+    // Append a new block that can hold at least the given number of bytes.
+    void AddBlock(size_t min_size);
+
+    // The memory blocks. Allocations are served from the last block.
+    std::vector<Block> blocks_;
+
+    // Offset of the first free byte in the last block.
+    size_t offset_ = 0;
+};
+
+#endif  // RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_INSTRUCTION_ARENA_H_
@@ -5,21 +5,16 @@
 /// @brief Implementation for Parser for the shader isa.
 //=============================================================================
 
-#define _HAS_AUTO_PTR_ETC 1
-
 // C++.
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <climits>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <string>
-
-// Boost.
-#ifdef _WIN32
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-#include <boost/regex.hpp>
-#ifdef _WIN32
-#pragma warning(pop)
-#endif
+#include <utility>
 
 #include "amdt_os_wrappers/Include/osDebugLog.h"
 
@@ -71,39 +66,440 @@ static bool ExtractRuntimeChangedNumOfGprs(const std::string& isa_line, unsigned
     return ret;
 }
 
-// Trim from the start.
-static std::string& trimStart(std::string& str_to_trim)
+// Format of the instruction encoding annotation that follows an instruction in the disassembly.
+enum IsaEncodingFormat
+{
+    // SCPC format, 64-bit instruction with 8-digit offset:  "// 00000130: D1190201 00000100".
+    kIsaEncodingScpc64,
+
+    // SCPC format, 64-bit instruction with 12-digit offset: "// 000000000130: D1190201 00000100".
+    kIsaEncodingScpc48Bit64,
+
+    // LLPC format, 64-bit instruction: "; C40008CF 02030001".
+    kIsaEncodingLlpc64,
+
+    // SCPC format, 32-bit instruction with 8-digit offset:  "// 00000138: 7E000280".
+    kIsaEncodingScpc32,
+
+    // SCPC format, 32-bit instruction with 12-digit offset: "// 000000000138: 7E000280".
+    kIsaEncodingScpc48Bit32,
+
+    // LLPC format, 32-bit instruction: "; 68000002".
+    kIsaEncodingLlpc32,
+
+    kIsaEncodingCount
+};
+
+// The number of characters in a single hex word of the instruction encoding.
+static const size_t kIsaEncodingWordLength = 8;
+
+// Offsets of the encoding words of an instruction within an ISA disassembly line.
+struct IsaEncodingWords
+{
+    // Offset of the first (low) 32-bit word. std::string::npos if the line holds no instruction.
+    size_t low_word = std::string::npos;
+
+    // Offset of the second (high) 32-bit word. std::string::npos for 32-bit instructions.
+    size_t high_word = std::string::npos;
+};
+
+// Character class lookup tables, indexed by the character value.
+struct IsaCharTables
+{
+    // Value of a hex digit, or -1 for characters that are not hex digits.
+    std::array<int8_t, 256> hex_digit_value;
+
+    // True for printable characters (the [[:print:]] class in the "C" locale).
+    std::array<bool, 256> is_printable;
+
+    IsaCharTables()
+    {
+        for (int c = 0; c < 256; c++)
+        {
+            hex_digit_value[c] = (c >= '0' && c <= '9') ? static_cast<int8_t>(c - '0')
+                               : (c >= 'a' && c <= 'f') ? static_cast<int8_t>(c - 'a' + 10)
+                               : (c >= 'A' && c <= 'F') ? static_cast<int8_t>(c - 'A' + 10) : -1;
+            is_printable[c] = (c >= 0x20 && c <= 0x7E);
+        }
+    }
+};
+
+static const IsaCharTables kIsaCharTables;
+
+static bool IsPrintable(char c)
+{
+    return kIsaCharTables.is_printable[static_cast<unsigned char>(c)];
+}
+
+static bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static bool IsHexDigit(char c)
+{
+    return kIsaCharTables.hex_digit_value[static_cast<unsigned char>(c)] >= 0;
+}
+
+// Checks that "count" characters starting at "offset" exist and belong to the given character class.
+template <typename CharPredicate>
+static bool IsCharRange(const std::string& str, size_t offset, size_t count, CharPredicate predicate)
+{
+    bool ret = (offset + count <= str.size());
+    for (size_t i = offset; ret && i < offset + count; i++)
+    {
+        ret = predicate(str[i]);
+    }
+    return ret;
+}
+
+// Returns the first character in the range [begin, end) that is not a white space.
+static const char* SkipWhiteSpaces(const char* begin, const char* end)
+{
+    while (begin < end && std::isspace(static_cast<unsigned char>(*begin)))
+    {
+        begin++;
+    }
+    return begin;
+}
+
+// Extracts a number from the text in the range [begin, end) following the rules of the formatted
+// stream extraction (operator>>): an optional sign is accepted, and a "0x" prefix is accepted for hex numbers.
+// The extraction stops at the first character that is not a digit.
+// Returns false if no digits were found. "is_overflow" is set if the magnitude exceeds "max_magnitude".
+static bool ExtractNumber(const char* begin, const char* end, bool is_hex, uint64_t max_magnitude, bool& is_negative, uint64_t& magnitude, bool& is_overflow)
+{
+    const char* pos            = begin;
+    bool        is_digit_found = false;
+    is_negative = false;
+    is_overflow = false;
+    magnitude   = 0;
+
+    if (pos < end && (*pos == '+' || *pos == '-'))
+    {
+        is_negative = (*pos == '-');
+        pos++;
+    }
+    if (is_hex && pos < end && *pos == '0')
+    {
+        is_digit_found = true;
+        if (++pos < end && (*pos == 'x' || *pos == 'X'))
+        {
+            pos++;
+        }
+    }
+
+    const uint64_t base = is_hex ? 16 : 10;
+    for (; pos < end; pos++)
+    {
+        int digit = is_hex ? kIsaCharTables.hex_digit_value[static_cast<unsigned char>(*pos)] : (IsDigit(*pos) ? *pos - '0' : -1);
+        if (digit < 0)
+        {
+            break;
+        }
+        is_digit_found = true;
+        if (!is_overflow)
+        {
+            if (magnitude > (max_magnitude - digit) / base)
+            {
+                is_overflow = true;
+            }
+            else
+            {
+                magnitude = magnitude * base + digit;
+            }
+        }
+    }
+
+    return is_digit_found;
+}
+
+// Extracts a signed integer from the text in the range [begin, end) like "std::istream >> int" does:
+// the value is left unchanged if the text is blank, it is set to 0 if no number can be extracted,
+// and it is clamped on overflow.
+static void ExtractInt(const char* begin, const char* end, bool is_hex, int& value)
 {
-    str_to_trim.erase(str_to_trim.begin(), std::find_if(str_to_trim.begin(), str_to_trim.end(), [](int c) { return !std::isspace(c); }));
-    return str_to_trim;
+    begin = SkipWhiteSpaces(begin, end);
+    if (begin < end)
+    {
+        bool     is_negative = false, is_overflow = false;
+        uint64_t magnitude   = 0;
+        value = 0;
+        if (ExtractNumber(begin, end, is_hex, static_cast<uint64_t>(INT_MAX) + 1, is_negative, magnitude, is_overflow))
+        {
+            if (is_overflow || (!is_negative && magnitude > INT_MAX))
+            {
+                value = (is_negative ? INT_MIN : INT_MAX);
+            }
+            else
+            {
+                value = (is_negative ? static_cast<int>(0 - magnitude) : static_cast<int>(magnitude));
+            }
+        }
+    }
 }
 
-// Trim from the end.
-static std::string& trimEnd(std::string& str_to_trim)
+// Extracts a signed integer from up to "count" characters of the string, starting at "offset".
+static void ExtractInt(const std::string& str, size_t offset, size_t count, bool is_hex, int& value)
 {
-    str_to_trim.erase(std::find_if(str_to_trim.rbegin(), str_to_trim.rend(), [](int c) { return !std::isspace(c); }).base(), str_to_trim.end());
-    return str_to_trim;
+    offset = std::min(offset, str.size());
+    count  = std::min(count, str.size() - offset);
+    ExtractInt(str.data() + offset, str.data() + offset + count, is_hex, value);
 }
 
-// Trim from both sides.
-static std::string trimStr(const std::string& str_to_trim)
+// Extracts an unsigned hex number from the text in the range [begin, end) like "std::istream >> std::hex >> value" does.
+template <typename T>
+static void ExtractHex(const char* begin, const char* end, T& value)
 {
-    std::string ret = str_to_trim;
-    return trimStart(trimEnd(ret));
+    begin = SkipWhiteSpaces(begin, end);
+    if (begin < end)
+    {
+        bool     is_negative = false, is_overflow = false;
+        uint64_t magnitude   = 0;
+        value = 0;
+        if (ExtractNumber(begin, end, true, std::numeric_limits<T>::max(), is_negative, magnitude, is_overflow))
+        {
+            value = is_overflow ? std::numeric_limits<T>::max() : static_cast<T>(is_negative ? 0 - magnitude : magnitude);
+        }
+    }
+}
+
+// Checks if an encoding annotation of the given format starts at "offset" of the ISA line.
+// If so, returns the offset of the first encoding word in "low_word_offset".
+static bool MatchEncodingAnnotation(const std::string& isa_line, size_t offset, IsaEncodingFormat format, size_t& low_word_offset)
+{
+    static const size_t kOffsetLengths[kIsaEncodingCount] = {8, 12, 0, 8, 12, 0};
+    const bool          is_64bit  = (format == kIsaEncodingScpc64 || format == kIsaEncodingScpc48Bit64 || format == kIsaEncodingLlpc64);
+    const bool          is_llpc   = (format == kIsaEncodingLlpc64 || format == kIsaEncodingLlpc32);
+    const size_t        size      = isa_line.size();
+    size_t              pos       = offset;
+    bool                ret       = false;
+
+    if (is_llpc)
+    {
+        // "; XXXXXXXX".
+        ret = (pos + 2 <= size && isa_line[pos] == ';' && isa_line[pos + 1] == ' ');
+        pos += 2;
+    }
+    else
+    {
+        // "// <offset>: XXXXXXXX".
+        const size_t offset_length = kOffsetLengths[format];
+        ret = (pos + 3 <= size && isa_line.compare(pos, 3, "// ") == 0);
+        ret = ret && IsCharRange(isa_line, pos + 3, offset_length, IsPrintable);
+        pos += 3 + offset_length;
+        ret = ret && (pos + 2 <= size && isa_line[pos] == ':' && isa_line[pos + 1] == ' ');
+        pos += 2;
+    }
+
+    low_word_offset = pos;
+    ret             = ret && IsCharRange(isa_line, pos, kIsaEncodingWordLength, IsPrintable);
+    pos += kIsaEncodingWordLength;
+
+    if (ret && is_64bit)
+    {
+        ret = (pos < size && isa_line[pos] == ' ') && IsCharRange(isa_line, pos + 1, kIsaEncodingWordLength, IsPrintable);
+    }
+
+    return ret;
+}
+
+// Scans the ISA line once and locates its instruction encoding words.
+// The lookup follows the rules of a leftmost, greedy "[[:print:]]*<annotation>" search: for every annotation format,
+// the last annotation within the first run of printable characters that contains such an annotation is picked.
+// The formats are then prioritized: 64-bit SCPC, 64-bit LLPC, 32-bit SCPC and 32-bit LLPC.
+static IsaEncodingWords LexEncodingWords(const std::string& isa_line, bool is_llpc_disassembly)
+{
+    size_t candidates[kIsaEncodingCount];
+    bool   is_final[kIsaEncodingCount] = {};
+    std::fill(std::begin(candidates), std::end(candidates), std::string::npos);
+
+    const size_t size = isa_line.size();
+    for (size_t i = 0; i <= size; i++)
+    {
+        if (i == size || !IsPrintable(isa_line[i]))
+        {
+            // End of the current run of printable characters.
+            for (int format = 0; format < kIsaEncodingCount; format++)
+            {
+                is_final[format] = is_final[format] || (candidates[format] != std::string::npos);
+            }
+        }
+        else if (isa_line[i] == '/' || isa_line[i] == ';')
+        {
+            for (int format = 0; format < kIsaEncodingCount; format++)
+            {
+                bool   is_llpc_format = (format == kIsaEncodingLlpc64 || format == kIsaEncodingLlpc32);
+                size_t low_word_offset = std::string::npos;
+                if (!is_final[format] && (is_llpc_disassembly || !is_llpc_format) &&
+                    MatchEncodingAnnotation(isa_line, i, static_cast<IsaEncodingFormat>(format), low_word_offset))
+                {
+                    candidates[format] = low_word_offset;
+                }
+            }
+        }
+    }
+
+    IsaEncodingWords ret;
+    for (int format = 0; format < kIsaEncodingCount; format++)
+    {
+        if (candidates[format] != std::string::npos)
+        {
+            ret.low_word = candidates[format];
+            if (format == kIsaEncodingScpc64 || format == kIsaEncodingScpc48Bit64 || format == kIsaEncodingLlpc64)
+            {
+                ret.high_word = ret.low_word + kIsaEncodingWordLength + 1;
+            }
+            break;
+        }
+    }
+
+    return ret;
+}
+
+// Looks for a "<key> = <number>" assignment in the ISA line (white spaces around '=' are optional).
+// Returns the value in "value". The value is 0 if the assignment has no digits.
+static bool FindAssignedNumber(const std::string& isa_line, const char* key, unsigned int& value)
+{
+    bool         ret        = false;
+    const size_t key_length = strlen(key);
+    for (size_t pos = isa_line.find(key); !ret && pos != std::string::npos; pos = isa_line.find(key, pos + 1))
+    {
+        size_t offset = pos + key_length;
+        while (offset < isa_line.size() && IsBlank(isa_line[offset]))
+        {
+            offset++;
+        }
+        if (offset < isa_line.size() && isa_line[offset] == '=')
+        {
+            offset++;
+            while (offset < isa_line.size() && IsBlank(isa_line[offset]))
+            {
+                offset++;
+            }
+            value = IsDigit(isa_line[offset]) ? std::atoi(isa_line.c_str() + offset) : 0;
+            ret   = true;
+        }
+    }
+    return ret;
+}
+
+// Looks for the instruction encoding annotation in the format produced by the SCPC or LLPC disassembler
+// and returns the size of the instruction in bytes:
+//   SCPC: "// 000000000130: D1190201 00000100"
+//   LLPC: "; C40008CF 02030001"
+static bool FindInstructionSize(const std::string& isa_line, int& instruction_size)
+{
+    bool ret = false;
+    for (size_t pos = isa_line.find("//"); !ret && pos != std::string::npos; pos = isa_line.find("//", pos + 1))
+    {
+        size_t offset = pos + 2;
+        while (offset < isa_line.size() && IsBlank(isa_line[offset]))
+        {
+            offset++;
+        }
+        if (IsCharRange(isa_line, offset, 12, IsHexDigit) && offset + 12 < isa_line.size() && isa_line[offset + 12] == ':')
+        {
+            offset += 13;
+            while (offset < isa_line.size() && IsBlank(isa_line[offset]))
+            {
+                offset++;
+            }
+            if (IsCharRange(isa_line, offset, kIsaEncodingWordLength, IsHexDigit))
+            {
+                offset += kIsaEncodingWordLength;
+                ret = true;
+            }
+        }
+
+        if (ret)
+        {
+            size_t high_word_offset = offset;
+            while (high_word_offset < isa_line.size() && IsBlank(isa_line[high_word_offset]))
+            {
+                high_word_offset++;
+            }
+            bool is_64bit    = (high_word_offset > offset && IsCharRange(isa_line, high_word_offset, kIsaEncodingWordLength, IsHexDigit));
+            instruction_size = is_64bit ? 8 : 4;
+        }
+    }
+
+    for (size_t pos = isa_line.find(';'); !ret && pos != std::string::npos; pos = isa_line.find(';', pos + 1))
+    {
+        size_t offset = pos + 1;
+        while (offset < isa_line.size() && IsBlank(isa_line[offset]))
+        {
+            offset++;
+        }
+        if (IsCharRange(isa_line, offset, kIsaEncodingWordLength, IsHexDigit))
+        {
+            offset += kIsaEncodingWordLength;
+            size_t high_word_offset = offset;
+            while (high_word_offset < isa_line.size() && IsBlank(isa_line[high_word_offset]))
+            {
+                high_word_offset++;
+            }
+            bool is_64bit    = (high_word_offset > offset && IsCharRange(isa_line, high_word_offset, kIsaEncodingWordLength, IsHexDigit));
+            instruction_size = is_64bit ? 8 : 4;
+            ret              = true;
+        }
+    }
+
+    return ret;
+}
+
+// Extracts the line that starts at "line_start" of the text into "line" (without the line break), and advances
+// "line_start" to the beginning of the next line. Behaves like std::getline, but reuses the line buffer.
+// "line_text" is set to the view of the line within the text.
+static bool GetNextLine(std::string_view text, size_t& line_start, std::string& line, std::string_view& line_text)
+{
+    bool ret = (line_start < text.size());
+    if (ret)
+    {
+        size_t line_end = text.find('\n', line_start);
+        if (line_end == std::string::npos)
+        {
+            line_end = text.size();
+        }
+        line_text = text.substr(line_start, line_end - line_start);
+        line.assign(line_text.data(), line_text.size());
+        line_start = line_end + 1;
+    }
+    return ret;
+}
+
+// Trim white spaces from both sides.
+static std::string_view TrimWhiteSpaces(std::string_view text)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+    {
+        text.remove_suffix(1);
+    }
+    return text;
 }
 
 // Split the given instruction into its building blocks: opcode, operands, binary representation and offset.
-static bool ExtractBuildingBlocks(const std::string& isa_instruction, std::string& instruction_opcode,
-    std::string& params, std::string& binary_representation, std::string& offset)
+// The building blocks are views into the given instruction text.
+static bool ExtractBuildingBlocks(std::string_view isa_instruction, std::string_view& instruction_opcode,
+    std::string_view& params, std::string_view& binary_representation, std::string_view& offset)
 {
     bool ret = false;
 
     // Clear the white spaces.
-    std::string trimmed_instruction = trimStr(isa_instruction);
+    std::string_view trimmed_instruction = TrimWhiteSpaces(isa_instruction);
 
     // Find the first white space.
     size_t index_start = trimmed_instruction.find(' ');
-    if (index_start != std::string::npos)
+    if (index_start != std::string_view::npos)
     {
         // Extract the instruction.
         instruction_opcode = trimmed_instruction.substr(0, index_start);
@@ -112,20 +508,18 @@ static bool ExtractBuildingBlocks(const std::string& isa_instruction, std::strin
         bool is_llpc_disassembly = false;
         size_t index_end_llpc = trimmed_instruction.find(";");
         size_t index_end = trimmed_instruction.find("//");
-        if (index_end == std::string::npos)
+        if (index_end == std::string_view::npos)
         {
             index_end = index_end_llpc;
             is_llpc_disassembly = true;
         }
-        if (index_end != std::string::npos)
+        if (index_end != std::string_view::npos)
         {
             size_t substr_length = index_end - index_start;
             if (substr_length > 0)
             {
-                params = trimmed_instruction.substr(index_start, substr_length);
-
                 // Clear white spaces.
-                trimStart(trimEnd(params));
+                params = TrimWhiteSpaces(trimmed_instruction.substr(index_start, substr_length));
 
                 if (!is_llpc_disassembly)
                 {
@@ -133,7 +527,7 @@ static bool ExtractBuildingBlocks(const std::string& isa_instruction, std::strin
                     index_start = index_end + 3;
                     index_end = trimmed_instruction.find(':', index_end);
 
-                    if (index_start != std::string::npos)
+                    if (index_start != std::string_view::npos)
                     {
                         substr_length = index_end - index_start;
                         if (substr_length > 0)
@@ -165,13 +559,37 @@ static bool ExtractBuildingBlocks(const std::string& isa_instruction, std::strin
     return ret;
 }
 
+// Set the string representation of the instruction from its isa line.
+// The opcode is converted to lower case: an opcode that contains upper case characters is copied into the arena.
+static bool SetInstructionText(Instruction& instruction, std::string_view isa_line, InstructionArena& arena)
+{
+    std::string_view opcode;
+    std::string_view params;
+    std::string_view binary_representation;
+    std::string_view offset;
+
+    bool ret = ExtractBuildingBlocks(isa_line, opcode, params, binary_representation, offset);
+    if (ret)
+    {
+        if (std::any_of(opcode.begin(), opcode.end(), [](char c) { return std::isupper(static_cast<unsigned char>(c)); }))
+        {
+            char* opcode_lower_case = static_cast<char*>(arena.Allocate(opcode.size()));
+            std::transform(opcode.begin(), opcode.end(), opcode_lower_case, [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+            opcode = std::string_view(opcode_lower_case, opcode.size());
+        }
+
+        instruction.SetInstructionStringRepresentation(opcode, params, binary_representation, offset);
+    }
+
+    return ret;
+}
+
 // ***************************************
 // *** INTERNALLY LINKED SYMBOLS - END ***
 // ***************************************
 
 ParserIsa::ParserIsa(ParserSi::LoggingCallBackFuncP log_function)
 {
-    ParserSi::SetLog(log_function);
     parser_si_[Instruction::kInstructionSetSop2] = new ParserSiSop2();
     parser_si_[Instruction::kInstructionSetSopk] = new ParserSiSopk();
     parser_si_[Instruction::kInstructionSetSop1] = new ParserSiSop1();
@@ -186,11 +604,17 @@ ParserIsa::ParserIsa(ParserSi::LoggingCallBackFuncP log_function)
     parser_si_[Instruction::kInstructionSetExp] = new ParserSiExp();
     parser_si_[Instruction::kInstructionSetVop] = new ParserSiVop();
     parser_si_[Instruction::kInstructionSetFlat] = new ParserFLAT();
+
+    // The parsed instructions are allocated in the arena of this parser.
+    for (auto& parser : parser_si_)
+    {
+        parser.second->SetInstructionArena(&instruction_arena_);
+        parser.second->SetLog(log_function);
+    }
 }
 
 ParserIsa::~ParserIsa()
 {
-    ParserSi::SetLog(NULL);
     delete parser_si_[Instruction::kInstructionSetSop2];
     delete parser_si_[Instruction::kInstructionSetSopk];
     delete parser_si_[Instruction::kInstructionSetSop1];
@@ -207,8 +631,8 @@ ParserIsa::~ParserIsa()
     delete parser_si_[Instruction::kInstructionSetFlat];
 }
 
-bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction32Bit hex_instruction,
-    const std::string& src_line, int src_line_number, bool is_literal_32b, uint32_t literal_32b,
+bool ParserIsa::Parse(std::string_view isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction32Bit hex_instruction,
+    std::string_view src_line, int src_line_number, bool is_literal_32b, uint32_t literal_32b,
     int label /*=kNoLabel*/, int goto_global /*=kNoLabel*/, int line_count/* = 0*/)
 {
     bool ret = false;
@@ -255,7 +679,7 @@ bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_genera
     {
         // Push an instruction of an arbitrary type into the collection so the ISA view can display the text of this instruction.
         // The textual part that is displayed in the ISA view is added in the next if block below.
-        instruction = new SIVOP1Instruction(32, VOPInstruction::kEncodingVop1, SIVOP1Instruction::kNOP, kNoLabel, kNoLabel);
+        instruction = new (instruction_arena_) SIVOP1Instruction(32, VOPInstruction::kEncodingVop1, SIVOP1Instruction::kNOP, kNoLabel, kNoLabel);
     }
 
     if (instruction != NULL)
@@ -264,25 +688,15 @@ bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_genera
         instruction->SetSrcLineInfo(src_line_number, src_line);
         instructions_.push_back(instruction);
 
-        std::string opcode;
-        std::string params;
-        std::string binary_representation;
-        std::string offset;
-
-        ret = ExtractBuildingBlocks(isa_line, opcode, params, binary_representation, offset);
-
-        if (ret)
-        {
-            // Set the ISA instruction's string representation.
-            instruction->SetInstructionStringRepresentation(opcode, params, binary_representation, offset);
-        }
+        // Set the ISA instruction's string representation.
+        ret = SetInstructionText(*instruction, isa_line, instruction_arena_);
     }
 
     return ret;
 }
 
-bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction64Bit hex_instruction,
-    const std::string& src_line, int src_line_number, int label /*=kNoLabel*/,
+bool ParserIsa::Parse(std::string_view isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction64Bit hex_instruction,
+    std::string_view src_line, int src_line_number, int label /*=kNoLabel*/,
     int goto_label /*=kNoLabel*/, int line_count /*= 0*/)
 {
     Instruction* instruction = nullptr;
@@ -332,7 +746,7 @@ bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_genera
     {
         // Push an instruction of an arbitrary type into the collection so the ISA view can display the text of this instruction.
         // The textual part that is displayed in the ISA view is added in the next if block below.
-        instruction = new SIVOP1Instruction(32, VOPInstruction::kEncodingVop1, SIVOP1Instruction::kNOP, kNoLabel, kNoLabel);
+        instruction = new (instruction_arena_) SIVOP1Instruction(32, VOPInstruction::kEncodingVop1, SIVOP1Instruction::kNOP, kNoLabel, kNoLabel);
     }
 
     if (instruction != NULL)
@@ -344,16 +758,7 @@ bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_genera
             instructions_.push_back(instruction);
 
             // Set the ISA instruction's string representation.
-            std::string opcode;
-            std::string params;
-            std::string binary_representation;
-            std::string offset;
-            bool ret = ExtractBuildingBlocks(isa_line, opcode, params, binary_representation, offset);
-
-            if (ret)
-            {
-                instruction->SetInstructionStringRepresentation(opcode, params, binary_representation, offset);
-            }
+            SetInstructionText(*instruction, isa_line, instruction_arena_);
         }
     }
 
@@ -361,13 +766,34 @@ bool ParserIsa::Parse(const std::string& isa_line, GDT_HW_GENERATION asic_genera
 }
 
 bool ParserIsa::Parse(const std::string& isa)
+{
+    // The instructions refer to the isa text, so keep a copy of it.
+    return Parse(std::string(isa));
+}
+
+bool ParserIsa::Parse(std::string&& isa)
+{
+    isa_text_ = std::move(isa);
+    return ParseStream(isa_text_, false, true);
+}
+
+bool ParserIsa::ParseStream(std::string_view isa, bool is_header_required, bool is_graph_required, const InstructionConsumer& consume_instruction)
 {
     ResetInstsCounters();
+    if (is_graph_required)
+    {
+        // Reserve the instruction storage up front, assuming an instruction per line.
+        const size_t kEstimatedInstructionSize = sizeof(Instruction) + 32;
+        size_t line_count = std::count(isa.begin(), isa.end(), '\n') + 1;
+        instructions_.reserve(line_count);
+        instruction_arena_.Reserve(line_count * kEstimatedInstructionSize);
+    }
 
-    bool ret = ParseToVector(isa);
+    size_t instruction_count = 0;
+    bool   ret               = ParseToVector(isa, is_header_required, is_graph_required, consume_instruction, instruction_count);
     if (ret)
     {
-        ret = isa_graph_.BuildISAProgramStructure(instructions_);
+        ret = (is_graph_required ? isa_graph_.BuildISAProgramStructure(instructions_) : instruction_count > 0);
     }
     return ret;
 }
@@ -376,45 +802,25 @@ bool ParserIsa::ParseForSize(const std::string& isa)
 {
     bool ret = false;
     ResetInstsCounters();
-    boost::regex code_len_byte_ex("([[:blank:]]*codeLenInByte[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex code_len_byte_ni("([[:blank:]]*CodeLen[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-
-    // SCPC disassembly format:
-    // v_add_u32     v1, s[2:3], v0, s0    // 000000000130: D1190201 00000100   <--- 64-bit instruction
-    // v_mov_b32     v0, 0                 // 000000000138: 7E000280            <--- 32-bit instruction
-    boost::regex instruction_annotation_scpc("//[[:blank:]]*[[:xdigit:]]{12}:[[:blank:]]*([[:xdigit:]]{8})([[:blank:]]+[[:xdigit:]]{8}){0,1}");
 
-    // LLPC disassembly format:
-    // v_add_u32_e32 v0, s2, v0; 68000002                 <--- 64-bit instruction
-    // exp pos0 v1, v0, v3, v2 done; C40008CF 02030001    <--- 32-bit instruction
-    boost::regex instruction_annotation_llpc(";[[:blank:]]*([[:xdigit:]]{8})([[:blank:]]+[[:xdigit:]]{8}){0,1}");
-
-    std::istringstream isa_stream(isa);
-    boost::smatch match_instruction;
     std::string isa_line;
+    std::string_view isa_line_text;
     int  isa_size = 0;
+    size_t line_start = 0;
 
-    while (getline(isa_stream, isa_line))
+    while (GetNextLine(isa, line_start, isa_line, isa_line_text))
     {
-        if (boost::regex_search(isa_line, match_instruction, code_len_byte_ex))
+        unsigned int code_len = 0;
+        int instruction_size = 0;
+        if (FindAssignedNumber(isa_line, "codeLenInByte", code_len) || FindAssignedNumber(isa_line, "CodeLen", code_len))
         {
-            std::string code_len_text(match_instruction[2].first, match_instruction[2].second);
-            code_len_ = atoi(code_len_text.c_str());
+            code_len_ = code_len;
             ret = true;
             break;
         }
-        else if (boost::regex_search(isa_line, match_instruction, code_len_byte_ni))
-        {
-            std::string code_len_text(match_instruction[2].first, match_instruction[2].second);
-            code_len_ = atoi(code_len_text.c_str());
-            ret = true;
-            break;
-        }
-        else if (boost::regex_search(isa_line, match_instruction, instruction_annotation_scpc) ||
-            boost::regex_search(isa_line, match_instruction, instruction_annotation_llpc))
+        else if (FindInstructionSize(isa_line, instruction_size))
         {
             // Count size of instructions "manually" if ISA size is not provided by disassembler.
-            int instruction_size = match_instruction[(int) match_instruction.size() - 1].matched ? 8 : 4;
             isa_size += instruction_size;
             ret = true;
         }
@@ -428,7 +834,7 @@ bool ParserIsa::ParseForSize(const std::string& isa)
     return ret;
 }
 
-static bool  GetSourceLineInfo(const std::string& isa_line, const std::string& prev_isa_line, std::string& src_line, int& src_line_number)
+static bool  GetSourceLineInfo(std::string_view isa_line, const std::string& prev_isa_line, std::string_view& src_line, int& src_line_number)
 {
     bool ret = false;
 
@@ -447,37 +853,32 @@ static bool  GetSourceLineInfo(const std::string& isa_line, const std::string& p
     return ret;
 }
 
-bool ParserIsa::ParseToVector(const std::string& isa)
+bool ParserIsa::ParseToVector(std::string_view isa, bool is_header_required, bool is_graph_required, const InstructionConsumer& consume_instruction,
+                              size_t& instruction_count)
 {
     int line_count = 0, src_line_number = 0;
-    Instruction::Instruction32Bit inst32;
-    Instruction::Instruction64Bit inst64;
+    Instruction::Instruction32Bit inst32 = 0;
+    Instruction::Instruction64Bit inst64 = 0;
 
-    std::istringstream isa_stream(isa);
-    std::string isa_line, src_line;
+    std::string isa_line;
+    std::string_view isa_line_text, src_line;
     bool isa_code_proc = false, parse_ok = true, gpr_proc = false, is_vgpr_found = false, is_sgpr_found = false, is_code_len_found = false;
     int label = kNoLabel, goto_label = kNoLabel;
-
-    boost::smatch match_instruction;
-
-    boost::regex regex_inst32_48("([[:print:]]*// [[:print:]]{12}: )([[:print:]]{8})");
-    boost::regex regex_inst32_48_llpc("([[:print:]]*; )([[:print:]]{8})");
-
-    boost::regex regex_inst64_48("([[:print:]]*// [[:print:]]{12}: )([[:print:]]{8})( )([[:print:]]{8})");
-    boost::regex regex_inst64_48_llpc("([[:print:]]*; )([[:print:]]{8})( )([[:print:]]{8})");
-
-    boost::regex regex_inst32("([[:print:]]*// [[:print:]]{8}: )([[:print:]]{8})");
-    boost::regex regex_inst_64("([[:print:]]*// [[:print:]]{8}: )([[:print:]]{8})( )([[:print:]]{8})");
-    boost::regex regex_vgpr("([[:blank:]]*NumVgprs[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex regex_sgprs("([[:blank:]]*NumSgprs[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex regex_code_length_bytes("([[:blank:]]*codeLenInByte[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex regex_code_length_bytes_ni("([[:blank:]]*CodeLen[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
+    size_t line_start = 0;
 
     std::string isa_start;
     std::string isa_end;
 
+    // The HSAIL disassembly header is not added to the text: the first line is prefixed with the start token when it is read.
+    // The end token that would follow the last line never matches a single line, and the lines that it adds hold no instructions.
+    std::string_view llpc_isa_start = "Disassembly for _amdgpu_";
+    if (is_header_required)
+    {
+        llpc_isa_start.remove_prefix(strlen(kStrHsailDisassemblyTokenStart));
+    }
+
     bool is_llpc_disassembly = false;
-    if (isa.rfind("Disassembly for _amdgpu_", 0) == 0)
+    if (isa.compare(0, llpc_isa_start.size(), llpc_isa_start) == 0)
     {
         is_llpc_disassembly = true;
     }
@@ -498,7 +899,7 @@ bool ParserIsa::ParseToVector(const std::string& isa)
             isa_end = "end";
         }
     }
-    else if (isa.find(kStrHsailDisassemblyTokenStart) != std::string::npos)
+    else if (is_header_required || isa.find(kStrHsailDisassemblyTokenStart) != std::string::npos)
     {
         // Shader entry point in HSAIL disassembly.
         isa_start = kStrHsailDisassemblyTokenStart;
@@ -520,12 +921,36 @@ bool ParserIsa::ParseToVector(const std::string& isa)
     const std::string kAsicGenStr("asic(");
     std::string  prev_line = "";
 
-    while (getline(isa_stream, isa_line))
+    // The instructions of each line are passed on before the next line is parsed.
+    size_t consumed_count = 0;
+    bool   is_consumed    = true;
+    auto   consume_instructions = [&]() {
+        for (; consume_instruction && is_consumed && consumed_count < instructions_.size(); consumed_count++)
+        {
+            is_consumed = consume_instruction(*instructions_[consumed_count]);
+        }
+        if (!is_graph_required)
+        {
+            instruction_count += instructions_.size();
+            instructions_.clear();
+            instruction_arena_.Reset();
+            consumed_count = 0;
+        }
+    };
+
+    while (is_consumed && GetNextLine(isa, line_start, isa_line, isa_line_text))
     {
         line_count++;
 
-        if (!isa_code_proc && !gpr_proc && strstr(isa_line.c_str(), isa_start.c_str()) == NULL ||
-            GetSourceLineInfo(isa_line, prev_line, src_line, src_line_number))
+        if (line_count == 1 && is_header_required)
+        {
+            // The first line holds no instruction, so it can be read from the line buffer.
+            isa_line.insert(0, kStrHsailDisassemblyTokenStart);
+            isa_line_text = isa_line;
+        }
+
+        if ((!isa_code_proc && !gpr_proc && strstr(isa_line.c_str(), isa_start.c_str()) == NULL) ||
+            GetSourceLineInfo(isa_line_text, prev_line, src_line, src_line_number))
         {
             continue;
         }
@@ -562,9 +987,6 @@ bool ParserIsa::ParseToVector(const std::string& isa)
                 }
             }
 
-            std::stringstream instruction_stream;
-            std::string::const_iterator isa_line_start = isa_line.begin();
-            std::string::const_iterator isa_line_end = isa_line.end();
             bool is_instruction_parsed = true;
 
             if (label == kNoLabel)
@@ -574,56 +996,47 @@ bool ParserIsa::ParseToVector(const std::string& isa)
 
             goto_label = GetGotoLabel(isa_line);
 
-            if ((boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_inst_64)) ||
-                (boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_inst64_48)) ||
-                (is_llpc_disassembly && boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_inst64_48_llpc)))
+            IsaEncodingWords encoding_words = LexEncodingWords(isa_line, is_llpc_disassembly);
+            if (encoding_words.high_word != std::string::npos)
             {
-                // This is either inst64Ex or inst64_48Ex.
-                std::string inst32_text_lower_case(match_instruction[2].first, match_instruction[2].second);
-                std::string inst32_text_upper_case(match_instruction[4].first, match_instruction[4].second);
-                instruction_stream << std::hex << inst32_text_upper_case << inst32_text_lower_case;
-                instruction_stream >> inst64;
-                is_instruction_parsed = Parse(isa_line, asicGen, inst64, src_line, src_line_number, label, goto_label, line_count);
+                // This is a 64-bit instruction: the high word is written after the low word.
+                const char* inst32_text_lower_case = isa_line.data() + encoding_words.low_word;
+                const char* inst32_text_upper_case = isa_line.data() + encoding_words.high_word;
+                char        inst64_text[2 * kIsaEncodingWordLength];
+                std::copy(inst32_text_upper_case, inst32_text_upper_case + kIsaEncodingWordLength, inst64_text);
+                std::copy(inst32_text_lower_case, inst32_text_lower_case + kIsaEncodingWordLength, inst64_text + kIsaEncodingWordLength);
+                ExtractHex(inst64_text, inst64_text + sizeof(inst64_text), inst64);
+                is_instruction_parsed = Parse(isa_line_text, asicGen, inst64, src_line, src_line_number, label, goto_label, line_count);
                 label = goto_label = kNoLabel;
 
                 if (!is_instruction_parsed)
                 {
                     uint32_t literal_32b = 0;
-                    instruction_stream.clear();
-                    instruction_stream << std::hex << inst32_text_lower_case;
-                    instruction_stream >> inst32;
-
-                    instruction_stream.clear();
-                    instruction_stream << std::hex << inst32_text_upper_case;
-                    instruction_stream >> literal_32b;
-
-                    is_instruction_parsed = Parse(isa_line, asicGen, inst32, src_line, src_line_number, true, literal_32b, label, goto_label, line_count);
+                    ExtractHex(inst32_text_lower_case, inst32_text_lower_case + kIsaEncodingWordLength, inst32);
+                    ExtractHex(inst32_text_upper_case, inst32_text_upper_case + kIsaEncodingWordLength, literal_32b);
+                    is_instruction_parsed = Parse(isa_line_text, asicGen, inst32, src_line, src_line_number, true, literal_32b, label, goto_label, line_count);
                     label = goto_label = kNoLabel;
 
                 }
             }
-            else if (is_instruction_parsed && (boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_inst32) ||
-                boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_inst32_48) ||
-                (is_llpc_disassembly && boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_inst32_48_llpc))))
+            else if (encoding_words.low_word != std::string::npos)
             {
-                // This is either inst32Ex or inst32_48Ex.
-                std::string inst32_ext(match_instruction[2].first, match_instruction[2].second);
-
-                instruction_stream << std::hex << inst32_ext;
-                instruction_stream >> inst32;
-                is_instruction_parsed = Parse(isa_line, asicGen, inst32, src_line, src_line_number, false, 0, label, goto_label, line_count);
+                // This is a 32-bit instruction.
+                const char* inst32_text = isa_line.data() + encoding_words.low_word;
+                ExtractHex(inst32_text, inst32_text + kIsaEncodingWordLength, inst32);
+                is_instruction_parsed = Parse(isa_line_text, asicGen, inst32, src_line, src_line_number, false, 0, label, goto_label, line_count);
                 label = goto_label = kNoLabel;
             }
             else if (label != kNoLabel)
             {
                 Instruction* instruction = nullptr;
-                std::string trimmed_isa_line = trimStr(isa_line);
-                instruction = new Instruction(trimmed_isa_line);
+                instruction = new (instruction_arena_) Instruction(TrimWhiteSpaces(isa_line_text), label);
                 instructions_.push_back(instruction);
                 label = goto_label = kNoLabel;
             }
 
             parse_ok &= is_instruction_parsed;
+            consume_instructions();
         }
         else if (is_sgpr_found && is_vgpr_found && is_code_len_found)
         {
@@ -631,10 +1044,8 @@ bool ParserIsa::ParseToVector(const std::string& isa)
         }
         else if (gpr_proc)
         {
-            std::string::const_iterator isa_line_start = isa_line.begin();
-            std::string::const_iterator isa_line_end   = isa_line.end();
-
-            if (boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_vgpr))
+            unsigned int gpr_count = 0;
+            if (FindAssignedNumber(isa_line, "NumVgprs", gpr_count))
             {
                 // Mark the VGPR section as found.
                 is_vgpr_found = true;
@@ -645,11 +1056,10 @@ bool ParserIsa::ParseToVector(const std::string& isa)
                 if (!is_changed_by_runtime)
                 {
                     // If the value was not changed, extract the original value.
-                    std::string vgprs_text(match_instruction[2].first, match_instruction[2].second);
-                    vgprs_ = atoi(vgprs_text.c_str());
+                    vgprs_ = gpr_count;
                 }
             }
-            else if (boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_sgprs))
+            else if (FindAssignedNumber(isa_line, "NumSgprs", gpr_count))
             {
                 // Mark the SGPR section as found.
                 is_sgpr_found = true;
@@ -660,92 +1070,77 @@ bool ParserIsa::ParseToVector(const std::string& isa)
                 if (!is_changed_by_runtime)
                 {
                     // If the value was not changed, extract the original value.
-                    std::string sgprs_text(match_instruction[2].first, match_instruction[2].second);
-                    sgprs_ = atoi(sgprs_text.c_str());
+                    sgprs_ = gpr_count;
                 }
             }
-            else if (boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_code_length_bytes))
-            {
-                is_code_len_found = true;
-                std::string code_length_text(match_instruction[2].first, match_instruction[2].second);
-                code_len_ = atoi(code_length_text.c_str());
-            }
-            else if (boost::regex_search(isa_line_start, isa_line_end, match_instruction, regex_code_length_bytes_ni))
+            else if (FindAssignedNumber(isa_line, "codeLenInByte", code_len_) || FindAssignedNumber(isa_line, "CodeLen", code_len_))
             {
                 is_code_len_found = true;
-                std::string code_length_text(match_instruction[2].first, match_instruction[2].second);
-                code_len_ = atoi(code_length_text.c_str());
             }
         }
-        prev_line = isa_line;
+        // The current line becomes the previous line, without copying its content.
+        prev_line.swap(isa_line);
     }
 
-    return parse_ok;
+    if (is_graph_required)
+    {
+        instruction_count = instructions_.size();
+    }
+
+    return parse_ok && is_consumed;
 }
 
 void ParserIsa::ResetInstsCounters()
 {
-    std::vector<Instruction*>::const_iterator instruction_begin = instructions_.begin();
-    for (; instruction_begin != instructions_.end(); ++instruction_begin)
-    {
-        if (NULL != (*instruction_begin))
-        {
-            delete *instruction_begin;
-        }
-    }
+    isa_graph_.DestroyISAProgramStructure();
 
+    // Release all instructions at once.
     instructions_.clear();
+    instruction_arena_.Reset();
     sgprs_ = 0;
     vgprs_ = 0;
-
-    isa_graph_.DestroyISAProgramStructure();
 }
 
 int ParserIsa::GetLabel(const std::string& isa_line)
 {
-    const int kHsailIsaOffset = 2;
+    const size_t kHsailIsaOffset = 2;
     int ret = kNoLabel;
-    size_t  offset = 0;
-    std::stringstream  stream;
+    size_t  offset = std::string::npos;
+
+    // The label token can only be found at the beginning of the line, or after the HSAIL prefix.
+    if (isa_line.compare(0, kIsaLabelToken1.size(), kIsaLabelToken1) == 0)
+    {
+        offset = 0;
+    }
+    else if (isa_line.size() > kHsailIsaOffset && isa_line.compare(kHsailIsaOffset, kIsaLabelToken1.size(), kIsaLabelToken1) == 0)
+    {
+        offset = kHsailIsaOffset;
+    }
 
-    if ((offset = isa_line.find(kIsaLabelToken1)) == 0 || offset == kHsailIsaOffset)
+    if (offset != std::string::npos)
     {
         size_t  labelNumLen = isa_line.size() - offset - kIsaLabelToken1.size() - 1;
-        stream << std::hex << isa_line.substr(offset + kIsaLabelToken1.size(), labelNumLen);
-        stream >> ret;
+        ExtractInt(isa_line, offset + kIsaLabelToken1.size(), labelNumLen, true, ret);
     }
-    else if ((offset = isa_line.find(kIsaLabelToken2)) == 0)
+    else if (isa_line.compare(0, kIsaLabelToken2.size(), kIsaLabelToken2) == 0)
     {
         if ((offset = isa_line.find('_')) != std::string::npos)
         {
-            stream << isa_line.substr(kIsaLabelToken2.size(), offset - kIsaLabelToken2.size()) <<
-                      isa_line.substr(offset + 1, isa_line.size() - offset - 2);
-            stream >> ret;
+            std::string label_text = isa_line.substr(kIsaLabelToken2.size(), offset - kIsaLabelToken2.size());
+            label_text.append(isa_line, offset + 1, isa_line.size() - offset - 2);
+            ExtractInt(label_text, 0, label_text.size(), false, ret);
         }
     }
     else
     {
         // Clang-15 LC generated labels have the format "L<number>:" or "_L<number>:".
-        size_t       labelNumLen     = 0;
         const size_t kLabelStartSize = 1;
         const size_t kLabelEndSize   = 1;
-        size_t       labelStartMatch = isa_line.find("_L");
-        if (labelStartMatch == std::string::npos)
+        bool is_label_start = isa_line.compare(0, 2, "_L") == 0 || (!isa_line.empty() && isa_line[0] == 'L' && isa_line.find("_L") == std::string::npos);
+        if (is_label_start && isa_line.size() > kLabelStartSize + kLabelEndSize && isa_line.find(':') != std::string::npos)
         {
-            labelStartMatch = isa_line.find("L");
-        }
-        const size_t kLabelEndMatch = isa_line.find(":");
-        if (labelStartMatch != std::string::npos)
-        {
-            if (labelStartMatch == 0 && kLabelEndMatch != std::string::npos)
-            {
-                labelNumLen = isa_line.size() - (kLabelStartSize + kLabelEndSize);
-            }
-            if (labelNumLen > 0)
-            {
-                stream << isa_line.substr(kLabelStartSize, labelNumLen);
-                stream >> ret;
-            }
+            size_t labelNumLen = isa_line.size() - (kLabelStartSize + kLabelEndSize);
+            ExtractInt(isa_line, kLabelStartSize, labelNumLen, false, ret);
         }
     }
 
@@ -756,46 +1151,43 @@ int ParserIsa::GetGotoLabel(const std::string& sISALine)
 {
     int ret = kNoLabel;
     size_t  offset = 0;
-    std::stringstream  stream;
 
-    if ((offset = sISALine.find(kIsaBranchToken)) != std::string::npos ||
-        (offset = sISALine.find(kIsaCallToken)) != std::string::npos)
+    // Only the instruction text can refer to a label. The encoding words in the comment that follows it may contain "BB".
+    const std::string instruction_text = sISALine.substr(0, sISALine.find("//"));
+
+    if ((offset = instruction_text.find(kIsaBranchToken)) != std::string::npos ||
+        (offset = instruction_text.find(kIsaCallToken)) != std::string::npos)
     {
-        if ((offset = sISALine.find(kIsaLabelToken1)) != std::string::npos)
+        if ((offset = instruction_text.find(kIsaLabelToken1)) != std::string::npos)
         {
-            size_t  labelNumLen = sISALine.find_first_of(' ', offset) - offset - kIsaLabelToken1.size();
-            stream << std::hex << sISALine.substr(offset + kIsaLabelToken1.size(), labelNumLen);
-            stream >> ret;
+            size_t  labelNumLen = instruction_text.find_first_of(' ', offset) - offset - kIsaLabelToken1.size();
+            ExtractInt(instruction_text, offset + kIsaLabelToken1.size(), labelNumLen, true, ret);
         }
-        else if ((offset = sISALine.find(kIsaLabelToken2)) != std::string::npos)
+        else if ((offset = instruction_text.find(kIsaLabelToken2)) != std::string::npos)
         {
             size_t  labelNumOffset = offset + kIsaLabelToken2.size();
-            if ((offset = sISALine.find('_', offset)) != std::string::npos)
+            if ((offset = instruction_text.find('_', offset)) != std::string::npos)
             {
-                stream << sISALine.substr(labelNumOffset, offset - labelNumOffset) <<
-                          sISALine.substr(offset + 1, sISALine.find_first_of(' ', offset) - offset - 1);
-                stream >> ret;
+                std::string label_text = instruction_text.substr(labelNumOffset, offset - labelNumOffset);
+                label_text.append(instruction_text, offset + 1, instruction_text.find_first_of(' ', offset) - offset - 1);
+                ExtractInt(label_text, 0, label_text.size(), false, ret);
             }
         }
         else
         {
-            // Clang-15 LC generated labels have the format "L<number>:".
-            size_t                    labelNumLen = 0;
-            const size_t              kLabelStartSize  = 1;
-            const size_t              kLabelEndSize    = 1;
-            const size_t              kLabelStartMatch = sISALine.find("L");
-            const size_t              kLabelEndMatch   = sISALine.find(":");
-            if (kLabelStartMatch != std::string::npos)
+            // Clang-15 LC generated labels have the format "L<number>:" or "_L<number>:", and the branches refer to them by that name, without the colon.
+            size_t opcode_start  = instruction_text.find_first_not_of(" \t");
+            size_t operand_start = instruction_text.find_first_not_of(" \t", instruction_text.find_first_of(" \t", opcode_start));
+            if (operand_start != std::string::npos && instruction_text.compare(operand_start, 2, "_L") == 0)
             {
-                if (kLabelStartMatch == 0 && kLabelEndMatch != std::string::npos)
-                {
-                    labelNumLen = sISALine.size() - (kLabelStartSize + kLabelEndSize);
-                }
-                if (labelNumLen > 0)
-                {
-                    stream << sISALine.substr(kLabelStartSize, labelNumLen);
-                    stream >> ret;
-                }
+                operand_start++;
+            }
+            if (operand_start != std::string::npos && instruction_text.compare(operand_start, 1, "L") == 0 && operand_start + 1 < instruction_text.size() &&
+                std::isdigit(static_cast<unsigned char>(instruction_text[operand_start + 1])))
+            {
+                size_t label_num_end = instruction_text.find_first_not_of("0123456789", operand_start + 1);
+                size_t labelNumLen   = std::min(label_num_end, instruction_text.size()) - operand_start - 1;
+                ExtractInt(instruction_text, operand_start + 1, labelNumLen, false, ret);
             }
         }
     }
@@ -806,5 +1198,17 @@ int ParserIsa::GetGotoLabel(const std::string& sISALine)
 bool ParserIsa::SplitIsaLine(const std::string& isaInstruction, std::string& instrOpCode,
                              std::string& params, std::string& binaryRepresentation, std::string& offset) const
 {
-    return ExtractBuildingBlocks(isaInstruction, instrOpCode, params, binaryRepresentation, offset);
+    std::string_view opcode_text;
+    std::string_view params_text;
+    std::string_view binary_representation_text;
+    std::string_view offset_text;
+    bool ret = ExtractBuildingBlocks(isaInstruction, opcode_text, params_text, binary_representation_text, offset_text);
+    if (ret)
+    {
+        instrOpCode          = opcode_text;
+        params               = params_text;
+        binaryRepresentation = binary_representation_text;
+        offset               = offset_text;
+    }
+    return ret;
 }
@@ -8,11 +8,13 @@
 #ifndef RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_ISA_PARSER_H_
 #define RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_ISA_PARSER_H_
 
+#include <functional>
 #include <iostream>
 #include <vector>
 #include <map>
 #include <sstream>
 #include <set>
+#include <string_view>
 
 #ifdef _WIN32
     #pragma warning(push)
@@ -32,24 +34,41 @@ static const char* kStrHsailDisassemblyTokenEnd = "\nend\n";
 class ParserIsa
 {
 public:
+    // Receives the parsed instructions in program order. Returns false to stop the parsing.
+    typedef std::function<bool(const Instruction& instruction)> InstructionConsumer;
+
     explicit ParserIsa(ParserSi::LoggingCallBackFuncP log_function = nullptr);
 
     // dtor
     ~ParserIsa();
 
     // Parse the 32 instruction.
-    bool Parse(const std::string& isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction32Bit instruction_hex,
-               const std::string& src_line, int srcLineNum, bool is_literal_32b = false, uint32_t literal_32b = 0,
+    // The instruction refers to the text of the isa and source lines, which has to outlive it.
+    bool Parse(std::string_view isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction32Bit instruction_hex,
+               std::string_view src_line, int srcLineNum, bool is_literal_32b = false, uint32_t literal_32b = 0,
                int label = kNoLabel, int goto_label = kNoLabel, int line_count = 0);
 
     // Parse the 64 instruction.
-    bool Parse(const std::string& isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction64Bit instruction_hex,
-               const std::string& src_line, int srcLineNum, int label = kNoLabel,
+    // The instruction refers to the text of the isa and source lines, which has to outlive it.
+    bool Parse(std::string_view isa_line, GDT_HW_GENERATION asic_generation, Instruction::Instruction64Bit instruction_hex,
+               std::string_view src_line, int srcLineNum, int label = kNoLabel,
                int goto_label = kNoLabel, int line_count = 0);
 
     // Parse the ISA.
+    // The parser keeps a copy of the isa text, which the parsed instructions refer to.
     bool Parse(const std::string& isa);
 
+    // Parse the ISA, taking ownership of the isa text without copying it.
+    bool Parse(std::string&& isa);
+
+    // Parse the ISA line by line, and pass each instruction to "consume_instruction" as soon as its line is parsed.
+    // The isa text is not copied: the instructions refer to it, so it has to outlive them.
+    // If "is_header_required" is true, the isa is parsed as if it was wrapped with the HSAIL disassembly start and end tokens.
+    // If "is_graph_required" is false, the instructions are released once they are consumed and the control flow graph is not built,
+    // so the memory use does not grow with the size of the program, and GetInstructions() and GetProgramGraph() are left empty.
+    // Returns false if the isa holds no instructions or could not be parsed, or if "consume_instruction" returned false.
+    bool ParseStream(std::string_view isa, bool is_header_required, bool is_graph_required, const InstructionConsumer& consume_instruction = nullptr);
+
     // Parse the ISA and retrieve its size.
     bool ParseForSize(const std::string& isa);
 
@@ -62,10 +81,23 @@ public:
         std::string& params, std::string& binary_representation, std::string& offset) const;
 
     // Get all ISA instructions for the program.
+    // The instructions are owned by the parser, and remain valid until the next call to Parse().
     const std::vector<Instruction*>& GetInstructions() const { return instructions_;}
 
     unsigned int GetCodeLength() const { return code_len_; }
 
+    // Set the iteration count that is assumed for loops in the control flow graph, and the iteration count of specific loops.
+    // Takes effect on the next call to Parse().
+    void SetLoopIterationCounts(int loop_iteration_count, const ISAProgramGraph::LoopIterationCounts& loop_iteration_overrides)
+    {
+        isa_graph_.SetNumOfLoopIteration(loop_iteration_count);
+        isa_graph_.SetLoopIterationOverrides(loop_iteration_overrides);
+    }
+
+    // Get the control flow graph of the program.
+    // The graph refers to the instructions, and remains valid until the next call to Parse().
+    const ISAProgramGraph& GetProgramGraph() const { return isa_graph_; }
+
 private:
     // Reset all instruction counters.
     void ResetInstsCounters();
@@ -77,7 +109,10 @@ private:
     int GetGotoLabel(const std::string& isa_line);
 
     // Parse the ISA disassembly line by line, and store the instructions internally.
-    bool ParseToVector(const std::string& isa);
+    // The instructions of each line are passed to "consume_instruction" (if set), and released afterwards unless "is_graph_required" is true.
+    // "instruction_count" is set to the number of parsed instructions.
+    bool ParseToVector(std::string_view isa, bool is_header_required, bool is_graph_required, const InstructionConsumer& consume_instruction,
+                       size_t& instruction_count);
 
     unsigned int sgprs_ = 0;
     unsigned int vgprs_ = 0;
@@ -86,6 +121,12 @@ private:
     // all instructions generated for the ISA
     std::vector<Instruction*> instructions_;
 
+    // The arena that the instructions are allocated in.
+    InstructionArena instruction_arena_;
+
+    // The text of the parsed ISA. The instructions hold views into this text.
+    std::string isa_text_;
+
     // The map between Parser`s instruction kind identifier and the parser
     std::map<Instruction::InstructionSet, ParserSi*> parser_si_;
 
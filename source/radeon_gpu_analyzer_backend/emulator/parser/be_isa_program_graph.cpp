@@ -2,481 +2,353 @@
 /// Copyright (c) 2017-2025 Advanced Micro Devices, Inc. All rights reserved.
 /// @author AMD Developer Tools Team
 /// @file
-/// @brief Implementation for Basic node in the isa program.
+/// @brief Implementation for the control flow graph of the isa program.
 //=============================================================================
 
 // C++.
-#include <sstream>
+#include <algorithm>
 #include <fstream>
-#include <iostream>
+#include <limits>
 #include <string>
 
 // Local.
 #include "be_isa_program_graph.h"
 #include "be_parser_si.h"
 
-const int kDefaultIterationCount = 10;
-const int kDefaultIterationCountHwLoops = 64;
+// *****************************************
+// *** INTERNALLY LINKED SYMBOLS - START ***
+// *****************************************
 
-ISAProgramGraph::ISAProgramGraph()
+static const int kDefaultIterationCountHwLoops = 64;
+
+// Opcodes that affect the control flow.
+static const char* kOpcodeBranch     = "s_branch";
+static const char* kOpcodeEndProgram = "s_endpgm";
+
+// Returns true if the instruction is an unconditional branch.
+static bool IsUnconditionalBranch(const Instruction& instruction)
 {
-    next_label_ = kNoLabel - 1 ;
-    isa_code_block_ = NULL;
-    loop_iteration_count_ = kDefaultIterationCount;
+    return instruction.GetInstructionOpCode() == kOpcodeBranch;
 }
 
+// Returns true if the instruction terminates the program.
+static bool IsProgramEnd(const Instruction& instruction)
+{
+    return instruction.GetInstructionOpCode() == kOpcodeEndProgram;
+}
 
-IsaCodeBlock* ISAProgramGraph::CreateNewNode(int label)
+// Returns true if the instruction is the last instruction of its basic block.
+static bool IsBlockTerminator(const Instruction& instruction)
 {
-    LabelNodeSet new_node_set;
-    IsaCodeBlock* new_node_isa = new IsaCodeBlock();
+    return instruction.GetGotoLabel() != kNoLabel || IsProgramEnd(instruction);
+}
 
-    // Case this is a chunk of instruction not under specific label.
-    if (label == kNoLabel)
+// Returns true if the instruction indicates a hardware loop.
+static bool IsHwLoopInstruction(Instruction* instruction)
+{
+    bool ret = false;
+    SIVOP1Instruction* si_vop1_instruction = dynamic_cast<SIVOP1Instruction*>(instruction);
+    if (si_vop1_instruction != nullptr)
     {
-        new_node_isa->label_ = next_label_;
-        new_node_set.label_ = next_label_;
-        next_label_--;
+        ret = (si_vop1_instruction->GetInstructionType() == SIVOP1Instruction::kEncodingVop1) &&
+              ((si_vop1_instruction->GetOp() == SIVOP1Instruction::kReadfirstlaneB32) || (si_vop1_instruction->GetOp() == SIVOP1Instruction::kMovereldB32));
     }
     else
     {
-        // There is a label parsed from the ISA.
-        new_node_set.label_ = label;
-        new_node_isa->label_ = label;
-    }
-
-    new_node_set.node_code_block_ = new_node_isa;
-    node_set_.insert(new_node_set);
-
-    // Check if this is the head of the graph- if so- save it.
-    if (NULL == isa_code_block_)
-    {
-        isa_code_block_ = new_node_isa;
-    }
-
-    return new_node_isa;
-}
-
-void ISAProgramGraph::DestroyISAProgramStructure()
-{
-
-    if (!node_set_.empty())
-    {
-        std::set<LabelNodeSet, LabelNodeSetCompare>::const_iterator iterBegin = node_set_.begin();
-
-        for (; iterBegin != node_set_.end(); ++iterBegin)
+        VIVOP1Instruction* vi_vop1_instruction = dynamic_cast<VIVOP1Instruction*>(instruction);
+        if (vi_vop1_instruction != nullptr)
         {
-            if (iterBegin->node_code_block_)
-            {
-                delete iterBegin->node_code_block_;
-            }
+            ret = (vi_vop1_instruction->GetInstructionType() == VIVOP1Instruction::kEncodingVop1) && (vi_vop1_instruction->GetOp() == VIVOP1Instruction::kReadfirstlaneB32);
         }
-
-        node_set_.clear();
-
-        isa_code_block_ = NULL;
-        next_label_ = kNoLabel - 1;
     }
-}
-
-IsaCodeBlock* ISAProgramGraph::LabelSearcher(int label)
-{
-    IsaCodeBlock* ret = NULL;
-    LabelNodeSet new_node_set;
-    new_node_set.label_ = label;
-
-    std::set<LabelNodeSet, LabelNodeSetCompare>::const_iterator iter_begin = node_set_.find(new_node_set);
-    if (iter_begin != node_set_.end())
-    {
-        ret = iter_begin->node_code_block_;
-    }
-
     return ret;
 }
 
-bool ISAProgramGraph::BuildISAProgramStructure(std::vector<Instruction*>& instructions)
+// Multiply the execution counts, saturating instead of overflowing.
+static uint64_t MultiplyExecutionCount(uint64_t execution_count, int iteration_count)
 {
-    std::vector<Instruction*>::const_iterator iIterator = instructions.begin();
-    return BuildISAProgramStructureInternal(instructions, iIterator, this->isa_code_block_);
+    const uint64_t kMaxExecutionCount = std::numeric_limits<uint64_t>::max();
+    uint64_t       factor             = static_cast<uint64_t>(std::max(iteration_count, 1));
+    return (execution_count > kMaxExecutionCount / factor) ? kMaxExecutionCount : execution_count * factor;
 }
 
-bool ISAProgramGraph::BuildISAProgramStructureInternal(std::vector<Instruction*>& instructions,
-    std::vector<Instruction*>::const_iterator instruction_iter, IsaCodeBlock* head_isa_node)
+// ***************************************
+// *** INTERNALLY LINKED SYMBOLS - END ***
+// ***************************************
+
+bool ISAProgramGraph::BuildISAProgramStructure(const std::vector<Instruction*>& instructions)
 {
-    if (instruction_iter == instructions.end())
+    DestroyISAProgramStructure();
+    if (instructions.empty())
     {
         return false;
     }
 
-    std::vector<Instruction*>::const_iterator iter = instruction_iter;
-    Instruction* curr_instruction = *instruction_iter;
-
-    // Set the label.
-    if (NULL == head_isa_node)
-    {
-        head_isa_node = CreateNewNode(curr_instruction->GetLabel());
-    }
+    instructions_ = &instructions;
 
-    // Iterate through the instructions and push them to the node.
-    for (; iter != instructions.end(); ++iter)
+    // A block starts at the first instruction, at every label and after every branch or end of program.
+    const uint32_t instruction_count = static_cast<uint32_t>(instructions.size());
+    instruction_blocks_.resize(instruction_count);
+    for (uint32_t i = 0; i < instruction_count; i++)
     {
-        // First- add it to the instructions vector of the node.
-        head_isa_node->instructions_.push_back(*iter);
-
-        // A branch.
-        if ((*iter)->GetGotoLabel() != kNoLabel)
+        const Instruction& instruction = *instructions[i];
+        if (i == 0 || instruction.GetLabel() != kNoLabel || IsBlockTerminator(*instructions[i - 1]))
         {
-            // this is the info we want to gather in order to decide how to build the graph
-            bool does_node_exist = false;
-            bool is_loop = false;
-            bool is_branch = false;
-
-            std::vector<Instruction*>::const_iterator instruction_begin = instructions.begin();
-
-            // Case 1: the label is already in the graph: search for the label in the IsaTree if found- set the true pointer if false call with the label.
-            IsaCodeBlock* loop = LabelSearcher((*iter)->GetGotoLabel());
-
-            if (loop)
-            {
-                // The node is already in the graph.
-                // This check if we have a real loop, and if so, update the num of iterations.
-                is_loop = UpdateNumOfIteration(instructions, loop, iter);
-                does_node_exist = true;
-            }
-            else // need to create a new node
+            if (!blocks_.empty())
             {
-                instruction_begin = instructions.begin();
-
-                for (; instruction_begin != instructions.end(); ++instruction_begin)
-                {
-                    if (((*instruction_begin)->GetLabel() != kNoLabel) && ((*instruction_begin)->GetLabel() == (*iter)->GetGotoLabel()))
-                    {
-                        break;
-                    }
-                }
-
-                if (instruction_begin != instructions.end())
-                {
-                    loop = CreateNewNode((*iter)->GetGotoLabel());
-
-                }
-
+                blocks_.back().end_instruction = i;
             }
 
-            // Now see if we are facing an S_Branch  or S_CBranch (unconditional branch vs. conditional).
-            curr_instruction = *iter;
+            IsaBasicBlock block;
+            block.first_instruction = i;
+            block.label             = instruction.GetLabel();
+            blocks_.push_back(block);
 
-            if (curr_instruction->GetInstructionCategory() == Instruction::kScalarAlu)
+            if (block.label != kNoLabel)
             {
-                if (curr_instruction->GetInstructionFormat() == Instruction::kInstructionSetSopp)
-                {
-                    SISOPPInstruction* instruction_si_sopp = dynamic_cast<SISOPPInstruction*>(curr_instruction);
-
-                    if (instruction_si_sopp != NULL)
-                    {
-                        SISOPPInstruction::OP opSOPP = instruction_si_sopp->GetOp();
-
-                        if (SISOPPInstruction::kBranch == opSOPP)
-                        {
-                            is_branch = true;
-                        }
-                    }
-                    else
-                    {
-                        VISOPPInstruction* instruction_vi_sopp = dynamic_cast<VISOPPInstruction*>(curr_instruction);
-
-                        if (instruction_vi_sopp != NULL)
-                        {
-                            VISOPPInstruction::OP opSOPP = instruction_vi_sopp->GetOp();
-
-                            if (VISOPPInstruction::kBranch == opSOPP)
-                            {
-                                is_branch = true;
-                            }
-                        }
-                    }
-                }
+                label_blocks_.emplace(block.label, static_cast<uint32_t>(blocks_.size() - 1));
             }
-
-            // Now we have all the information we need, just need to set the right sequential and call function again.
-            if (is_branch)
+        }
+        instruction_blocks_[i] = static_cast<uint32_t>(blocks_.size() - 1);
+    }
+    blocks_.back().end_instruction = instruction_count;
+
+    // The edges of each block are determined by its last instruction. The blocks are visited in order,
+    // so the successor edges are appended in compressed sparse row order.
+    const uint32_t block_count = static_cast<uint32_t>(blocks_.size());
+    std::vector<uint32_t> edge_sources;
+    successor_offsets_.reserve(block_count + 1);
+    successors_.reserve(2 * block_count);
+    edge_sources.reserve(2 * block_count);
+    auto add_edge = [&](uint32_t source, uint32_t target, IsaEdgeKind kind) {
+        IsaEdge edge;
+        edge.block        = target;
+        edge.kind         = kind;
+        edge.is_back_edge = (target <= source);
+        successors_.push_back(edge);
+        edge_sources.push_back(source);
+    };
+
+    for (uint32_t b = 0; b < block_count; b++)
+    {
+        successor_offsets_.push_back(static_cast<uint32_t>(successors_.size()));
+        const Instruction& last_instruction = *instructions[blocks_[b].end_instruction - 1];
+        const bool         has_next_block   = (b + 1 < block_count);
+        if (last_instruction.GetGotoLabel() != kNoLabel)
+        {
+            // Branches to labels that are not in the program have no edge.
+            uint32_t target = LabelSearcher(last_instruction.GetGotoLabel());
+            if (IsUnconditionalBranch(last_instruction))
             {
-                if (!is_loop) // this is a case where we will mark the next because this is unconditional branch and we do it always
-                {
-                    head_isa_node->SetNext(loop);
-                }
-                else
-                {
-                    // We shouldn't get it, but just in case.
-                    head_isa_node->SetNext(NULL);
-                    head_isa_node->SetFalse(NULL);
-                    head_isa_node->SetTrue(NULL);
-                }
-
-                if (!does_node_exist)
+                if (target != kNoBlock)
                 {
-                    BuildISAProgramStructureInternal(instructions, instruction_begin, loop);
+                    add_edge(b, target, IsaEdgeKind::kNext);
                 }
-
-                // We have an unconditional branch we break here because there is no false.
-                break;
             }
             else
             {
-                if (is_loop)
+                if (target != kNoBlock)
                 {
-                    // in case of a loop, we mark the TRUE=NULL because we already know it is a loop and we don't want loops in the graph
-                    head_isa_node->true_ = NULL; //pLoop;
+                    add_edge(b, target, IsaEdgeKind::kTrue);
                 }
-                else
+                if (has_next_block)
                 {
-                    // this is the case where we have a branch that points to a node which exist in the graph and it is not a loop.
-                    head_isa_node->SetTrue(loop);
+                    add_edge(b, b + 1, IsaEdgeKind::kFalse);
                 }
-
-                if (!does_node_exist)
-                {
-                    BuildISAProgramStructureInternal(instructions, instruction_begin, loop);
-                }
-
-                std::vector<Instruction*>::const_iterator next_instruction = (iter + 1);
-                if (next_instruction != instructions.end())
-                {
-                    IsaCodeBlock* pFalseIsaNode = CreateNewNode((*next_instruction)->GetLabel());
-                    head_isa_node->SetFalse(pFalseIsaNode);
-                    BuildISAProgramStructureInternal(instructions, next_instruction, pFalseIsaNode);
-                }
-
-                break;
             }
         }
-        else
+        else if (!IsProgramEnd(last_instruction) && has_next_block)
         {
-            // Not a branch- is next instruction is with a label?
-            std::vector<Instruction*>::const_iterator next_instruction = (iter + 1);
-
-            if ((next_instruction != instructions.end()) && ((*next_instruction)->GetLabel() != kNoLabel))
-            {
-                IsaCodeBlock* next_code_block = LabelSearcher((*next_instruction)->GetLabel());
-                if (next_code_block)
-                {
-                    head_isa_node->SetNext(next_code_block);
-                    return true;
-                }
-                else
-                {
-                    std::vector<Instruction*>::const_iterator instruction_begin = instructions.begin();
-
-                    for (; instruction_begin != instructions.end(); ++instruction_begin)
-                    {
-                        if (((*instruction_begin)->GetLabel() != kNoLabel) && ((*instruction_begin)->GetLabel() == (*next_instruction)->GetLabel()))
-                        {
-                            break;
-                        }
-                    }
-
-                    if (instruction_begin != instructions.end())
-                    {
-                        IsaCodeBlock* pNextIsaNode = CreateNewNode((*instruction_begin)->GetLabel());
-                        head_isa_node->SetNext(pNextIsaNode);
-                        BuildISAProgramStructureInternal(instructions, instruction_begin, pNextIsaNode);
-                        break;
-                    }
-                }
-            }
+            add_edge(b, b + 1, IsaEdgeKind::kNext);
         }
     }
+    successor_offsets_.push_back(static_cast<uint32_t>(successors_.size()));
+
+    // Build the predecessor lists by a counting sort of the edges by their target.
+    predecessor_offsets_.assign(block_count + 1, 0);
+    for (const IsaEdge& edge : successors_)
+    {
+        predecessor_offsets_[edge.block + 1]++;
+    }
+    for (uint32_t b = 0; b < block_count; b++)
+    {
+        predecessor_offsets_[b + 1] += predecessor_offsets_[b];
+    }
+    predecessors_.resize(successors_.size());
+    std::vector<uint32_t> predecessor_positions(predecessor_offsets_.begin(), predecessor_offsets_.end() - 1);
+    for (size_t e = 0; e < successors_.size(); e++)
+    {
+        IsaEdge predecessor = successors_[e];
+        predecessor.block   = edge_sources[e];
+        predecessors_[predecessor_positions[successors_[e].block]++] = predecessor;
+    }
 
+    UpdateLoopCounts();
     return true;
 }
 
+void ISAProgramGraph::DestroyISAProgramStructure()
+{
+    instructions_ = nullptr;
+    blocks_.clear();
+    successor_offsets_.clear();
+    successors_.clear();
+    predecessor_offsets_.clear();
+    predecessors_.clear();
+    label_blocks_.clear();
+    instruction_blocks_.clear();
+}
 
-bool ISAProgramGraph::UpdateNumOfIteration(std::vector<Instruction*>& instructions, IsaCodeBlock* loop, const std::vector<Instruction*>::const_iterator iter)
+uint32_t ISAProgramGraph::LabelSearcher(int label) const
 {
-    std::vector<Instruction*>::const_iterator instruction_begin = instructions.begin();
-    bool isFound = false;
+    auto iter = label_blocks_.find(label);
+    return (iter != label_blocks_.end()) ? iter->second : kNoBlock;
+}
 
-    for (; (instruction_begin != instructions.end()) && (instruction_begin < iter); ++instruction_begin)
-    {
-        if (((*instruction_begin)->GetLabel() != kNoLabel) && ((*instruction_begin)->GetLabel() == loop->label_))
-        {
-            isFound = true;
-            loop->SetIterationCount(loop_iteration_count_);
-            break;
-        }
-    }
+void ISAProgramGraph::UpdateLoopCounts()
+{
+    // The block that last marked each block as a part of its loop body.
+    const uint32_t        block_count = static_cast<uint32_t>(blocks_.size());
+    std::vector<uint32_t> loop_marks(block_count, kNoBlock);
+    std::vector<uint32_t> work_list;
 
-    // It is a loop, check if this is HW loop or regular and update num of iteration.
-    if (isFound)
+    for (uint32_t header = 0; header < block_count; header++)
     {
-        instruction_begin = loop->instructions_.begin();
-
-        for (; instruction_begin < loop->instructions_.end(); ++instruction_begin)
+        // A block is a loop header if a later block branches back to it.
+        bool is_loop_header = std::any_of(PredecessorsBegin(header), PredecessorsEnd(header), [](const IsaEdge& edge) { return edge.is_back_edge; });
+        if (is_loop_header)
         {
-            SIVOP1Instruction* curr_instruction = dynamic_cast<SIVOP1Instruction*>(*instruction_begin);
-
-            if (curr_instruction != NULL)
+            // Check if this is HW loop or regular and update num of iteration.
+            IsaBasicBlock& header_block = blocks_[header];
+            header_block.iteration_count = loop_iteration_count_;
+            for (uint32_t i = header_block.first_instruction; i < header_block.end_instruction; i++)
             {
-                if ((curr_instruction->GetInstructionType() == SIVOP1Instruction::kEncodingVop1) &&
-                    ((curr_instruction->GetOp() == SIVOP1Instruction::kReadfirstlaneB32) || (curr_instruction->GetOp() == SIVOP1Instruction::kMovereldB32)))
+                if (IsHwLoopInstruction((*instructions_)[i]))
                 {
-                    loop->SetIterationCount(kDefaultIterationCountHwLoops);
+                    header_block.iteration_count = kDefaultIterationCountHwLoops;
                     break;
                 }
             }
-            else
+
+            // The user's iteration count for this specific loop takes precedence.
+            if (!loop_iteration_overrides_.empty() && header_block.label != kNoLabel)
             {
-                VIVOP1Instruction* curr_instruction_vivo = dynamic_cast<VIVOP1Instruction*>(*instruction_begin);
+                std::string_view label_name = (*instructions_)[header_block.first_instruction]->GetPointingLabelString();
+                if (!label_name.empty() && label_name.back() == ':')
+                {
+                    label_name.remove_suffix(1);
+                }
+                auto iter = loop_iteration_overrides_.find(std::string(label_name));
+                if (iter != loop_iteration_overrides_.end() && iter->second > 0)
+                {
+                    header_block.iteration_count = iter->second;
+                }
+            }
 
-                if (curr_instruction_vivo != NULL)
+            // The loop body consists of the blocks that reach a back edge source without going through the header.
+            // Only the blocks that follow the header are considered, so that irreducible flow does not leak out of the loop.
+            loop_marks[header] = header;
+            for (const IsaEdge* edge = PredecessorsBegin(header); edge != PredecessorsEnd(header); ++edge)
+            {
+                if (edge->is_back_edge && loop_marks[edge->block] != header)
                 {
-                    if ((curr_instruction_vivo->GetInstructionType() == VIVOP1Instruction::kEncodingVop1) && (curr_instruction_vivo->GetOp() == VIVOP1Instruction::kReadfirstlaneB32))
+                    loop_marks[edge->block] = header;
+                    work_list.push_back(edge->block);
+                }
+            }
+            while (!work_list.empty())
+            {
+                uint32_t block = work_list.back();
+                work_list.pop_back();
+                for (const IsaEdge* edge = PredecessorsBegin(block); edge != PredecessorsEnd(block); ++edge)
+                {
+                    if (edge->block > header && loop_marks[edge->block] != header)
                     {
-                        loop->SetIterationCount(kDefaultIterationCountHwLoops);
-                        break;
+                        loop_marks[edge->block] = header;
+                        work_list.push_back(edge->block);
                     }
                 }
             }
+
+            for (uint32_t b = header; b < block_count; b++)
+            {
+                if (loop_marks[b] == header)
+                {
+                    blocks_[b].execution_count = MultiplyExecutionCount(blocks_[b].execution_count, header_block.iteration_count);
+                }
+            }
         }
     }
-
-    return isFound;
-}
-
-void ISAProgramGraph::GetInstructionsOfProgramPath(std::set<LabelNodeSet, LabelNodeSetCompare>& path_instruction_set, int iPath)
-{
-    GetInstructionsOfProgramPathInternal(path_instruction_set, this->isa_code_block_, iPath, 1);
 }
 
-void ISAProgramGraph::GetInstructionsOfProgramPathInternal(std::set<LabelNodeSet, LabelNodeSetCompare>& path_instruction_set, IsaCodeBlock* head_isa_code_block, int path_num, int iteration_count)
+void ISAProgramGraph::GetBlocksOfProgramPath(AnalyzeDataPath path, std::vector<bool>& is_block_in_path) const
 {
-    if (NULL == head_isa_code_block)
+    is_block_in_path.assign(blocks_.size(), false);
+    if (!blocks_.empty())
     {
-        return;
-    }
-
-    // If the node is in the set- return. we visit only once.
-    LabelNodeSet label_node_set_temp;
-    label_node_set_temp.label_ = head_isa_code_block->GetLabel();
-    if (path_instruction_set.find(label_node_set_temp) != path_instruction_set.end())
-    {
-        return;
-    }
-
-    // We got here with the node- put it in the set.
-    LabelNodeSet new_label_node_set;
-    new_label_node_set.label_ = head_isa_code_block->GetLabel();
-    new_label_node_set.iteration_count_ = iteration_count * (head_isa_code_block->GetIterationCount());
-    new_label_node_set.node_code_block_ = head_isa_code_block;
-    path_instruction_set.insert(new_label_node_set);
-
-    // Check where we go next.
-    int iteration_count_temp = new_label_node_set.iteration_count_;
-    if (head_isa_code_block->GetTrue())
-    {
-        // If this is true, we probably going out of a loop- reduce the iteration count.
-        if (head_isa_code_block->GetFalse() && (head_isa_code_block->GetIterationCount() > 1))
+        std::vector<uint32_t> work_list(1, 0);
+        is_block_in_path[0] = true;
+        while (!work_list.empty())
         {
-            if (iteration_count_temp > 1)
+            uint32_t block = work_list.back();
+            work_list.pop_back();
+
+            // Find the sides of a conditional branch, if any.
+            const IsaEdge* true_edge  = nullptr;
+            const IsaEdge* false_edge = nullptr;
+            for (const IsaEdge* edge = SuccessorsBegin(block); edge != SuccessorsEnd(block); ++edge)
             {
-                iteration_count_temp /= loop_iteration_count_;
+                true_edge  = (edge->kind == IsaEdgeKind::kTrue) ? edge : true_edge;
+                false_edge = (edge->kind == IsaEdgeKind::kFalse) ? edge : false_edge;
             }
 
-            GetInstructionsOfProgramPathInternal(path_instruction_set, head_isa_code_block->GetTrue(), path_num, iteration_count_temp);
-        }
-
-        // We do the true unless we are in the false path.
-        if (path_num != 2)
-        {
-            GetInstructionsOfProgramPathInternal(path_instruction_set, head_isa_code_block->GetTrue(), path_num, new_label_node_set.iteration_count_);
-        }
-    }
-
-    if (head_isa_code_block->GetFalse())
-    {
-        iteration_count_temp = new_label_node_set.iteration_count_;
-
-        // we do the false always if the true is null because this is probably an end of a loop
-        if (!head_isa_code_block->GetTrue())
-        {
-            if ((head_isa_code_block->GetIterationCount() > 1) && (iteration_count_temp > 1))
+            for (const IsaEdge* edge = SuccessorsBegin(block); edge != SuccessorsEnd(block); ++edge)
             {
-                iteration_count_temp /= loop_iteration_count_;
+                // The true path skips the false side, unless the true side closes a loop, in which case the false side exits it.
+                // The false path skips the true side, unless there is no false side.
+                bool is_skipped = (path == kCalcTrue && edge == false_edge && true_edge != nullptr && !true_edge->is_back_edge) ||
+                                  (path == kCalcFalse && edge == true_edge && false_edge != nullptr);
+                if (!is_skipped && !is_block_in_path[edge->block])
+                {
+                    is_block_in_path[edge->block] = true;
+                    work_list.push_back(edge->block);
+                }
             }
-
-            GetInstructionsOfProgramPathInternal(path_instruction_set, head_isa_code_block->GetFalse(), path_num, iteration_count_temp);
-        }
-        else if (path_num != 1)
-        {
-            GetInstructionsOfProgramPathInternal(path_instruction_set, head_isa_code_block->GetFalse(), path_num, iteration_count_temp);
         }
-
-    }
-
-
-    if (head_isa_code_block->GetNext())
-    {
-        // do it always
-        GetInstructionsOfProgramPathInternal(path_instruction_set, head_isa_code_block->GetNext(), path_num, new_label_node_set.iteration_count_);
     }
-
 }
 
-void ISAProgramGraph::DumpGraph(std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> path_instruction_set, std::string sFileName)
+void ISAProgramGraph::DumpGraph(const std::vector<bool>& is_block_in_path, const std::string& file_name) const
 {
-    // open the file:
+    static const char* kEdgeKindNames[] = {"N", "T", "F"};
+
     std::ofstream ofs;
-    ofs.open(sFileName.c_str(), std::ofstream::out);
+    ofs.open(file_name.c_str(), std::ofstream::out);
     ofs << "digraph G {\n";
 
-
-    std::set<LabelNodeSet, LabelNodeSetCompare>::iterator iter = path_instruction_set.begin();
-
-    for (; iter != path_instruction_set.end(); ++iter)
+    // Loops get double circle shape, and mark the number of times they will be done.
+    for (uint32_t b = 0; b < blocks_.size(); b++)
     {
-        //loops gets double circle shape, also the arrows are red and mark the number of times it will be done
-        if ((*iter).iteration_count_ > 1)
+        if (is_block_in_path[b])
         {
-            ofs << (*iter).label_ << " " << "[shape=doublecircle,style=filled,color=\".7 .3 1.0\", label=\" " << (*iter).label_ << " X " << (*iter).iteration_count_ << "\"];\n";
-        }
-        else
-        {
-            ofs << (*iter).label_ << " " << "[shape=box];\n";
-        }
-    }
-
-    for (iter = path_instruction_set.begin(); iter != path_instruction_set.end(); ++iter)
-    {
-        if ((*iter).node_code_block_->GetTrue())
-        {
-            LabelNodeSet temp;
-            temp.label_ = (*iter).node_code_block_->GetTrue()->GetLabel();
-
-            if (path_instruction_set.find(temp) != path_instruction_set.end())
+            if (blocks_[b].iteration_count > 1)
             {
-                ofs << (*iter).label_ << " -> " << (*iter).node_code_block_->GetTrue()->GetLabel() << "[label=\"T\"]" << ";\n ";
+                ofs << b << " " << "[shape=doublecircle,style=filled,color=\".7 .3 1.0\", label=\" " << blocks_[b].label << " X " << blocks_[b].iteration_count << "\"];\n";
             }
-        }
-
-        if ((*iter).node_code_block_->GetFalse())
-        {
-            LabelNodeSet temp;
-            temp.label_ = (*iter).node_code_block_->GetFalse()->GetLabel();
-
-            if (path_instruction_set.find(temp) != path_instruction_set.end())
+            else
             {
-                ofs << (*iter).label_ << " -> " << (*iter).node_code_block_->GetFalse()->GetLabel() <<  "[label=\"F\"]" << ";\n ";
+                ofs << b << " " << "[shape=box, label=\"" << blocks_[b].label << "\"];\n";
             }
         }
+    }
 
-        if ((*iter).node_code_block_->GetNext())
+    for (uint32_t b = 0; b < blocks_.size(); b++)
+    {
+        for (const IsaEdge* edge = SuccessorsBegin(b); is_block_in_path[b] && edge != SuccessorsEnd(b); ++edge)
         {
-            LabelNodeSet temp;
-            temp.label_ = (*iter).node_code_block_->GetNext()->GetLabel();
-
-            if (path_instruction_set.find(temp) != path_instruction_set.end())
+            if (is_block_in_path[edge->block])
             {
-                ofs << (*iter).label_ << " -> " << (*iter).node_code_block_->GetNext()->GetLabel() << "[label=\"N\"]" << ";\n ";
+                ofs << b << " -> " << edge->block << "[label=\"" << kEdgeKindNames[static_cast<int>(edge->kind)] << "\"]" << ";\n";
             }
         }
     }
@@ -485,42 +357,59 @@ void ISAProgramGraph::DumpGraph(std::set<ISAProgramGraph::LabelNodeSet, ISAProgr
     ofs.close();
 }
 
-void ISAProgramGraph::CountInstructions(std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> path_instruction_set,
-    ISAProgramGraph::NumOfInstructionsInCategory& category_instruction_count)
+void ISAProgramGraph::CountInstructions(const std::vector<bool>& is_block_in_path, NumOfInstructionsInCategory& instruction_category_count) const
 {
-    (void)(path_instruction_set);
-    (void)(category_instruction_count);
+    // Accumulate in 64 bits, and saturate when storing the counts.
+    uint64_t category_counts[Instruction::kInstructionsCategoryCount] = {};
+    for (uint32_t b = 0; b < blocks_.size(); b++)
+    {
+        if (is_block_in_path[b])
+        {
+            const IsaBasicBlock& block = blocks_[b];
+            for (uint32_t i = block.first_instruction; i < block.end_instruction; i++)
+            {
+                Instruction::InstructionCategory category = (*instructions_)[i]->GetInstructionCategory();
+                if (category >= 0 && category < Instruction::kInstructionsCategoryCount)
+                {
+                    category_counts[category] = std::min(category_counts[category] + block.execution_count, uint64_t(std::numeric_limits<unsigned int>::max()));
+                }
+            }
+        }
+    }
+
+    instruction_category_count.instruction_count_scalar_memory_read  = static_cast<unsigned int>(category_counts[Instruction::kScalarMemoryRead]);
+    instruction_category_count.instruction_count_scalar_memory_write = static_cast<unsigned int>(category_counts[Instruction::kScalarMemoryWrite]);
+    instruction_category_count.instruction_count_scalar_alu          = static_cast<unsigned int>(category_counts[Instruction::kScalarAlu]);
+    instruction_category_count.instruction_count_vector_memory_read  = static_cast<unsigned int>(category_counts[Instruction::kVectorMemoryRead]);
+    instruction_category_count.instruction_count_vector_memory_write = static_cast<unsigned int>(category_counts[Instruction::kVectorMemoryWrite]);
+    instruction_category_count.instruction_count_vector_alu          = static_cast<unsigned int>(category_counts[Instruction::kVectorAlu]);
+    instruction_category_count.instruction_count_lds                 = static_cast<unsigned int>(category_counts[Instruction::kLds]);
+    instruction_category_count.instruction_count_gds                 = static_cast<unsigned int>(category_counts[Instruction::kGds]);
+    instruction_category_count.instruction_count_export              = static_cast<unsigned int>(category_counts[Instruction::kExport]);
+    instruction_category_count.instruction_count_atomics             = static_cast<unsigned int>(category_counts[Instruction::kAtomics]);
 }
 
-void ISAProgramGraph::GetNumOfInstructionsInCategory(ISAProgramGraph::NumOfInstructionsInCategory instruction_category_count[kCalcPathCount], std::string graph_text)
+void ISAProgramGraph::GetNumOfInstructionsInCategory(NumOfInstructionsInCategory instruction_category_count[kCalcPathCount], const std::string& graph_file_name) const
 {
-    std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> path_instruction_set_all;
-    GetInstructionsOfProgramPath(path_instruction_set_all, kCalcAll); // ALL
-    CountInstructions(path_instruction_set_all, instruction_category_count[kCalcAll]);
-
-    std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> path_instruction_set_true;
-    GetInstructionsOfProgramPath(path_instruction_set_true, kCalcTrue); // TRUE
-    CountInstructions(path_instruction_set_true, instruction_category_count[kCalcTrue]);
-
-    std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> path_instruction_set_false;
-    GetInstructionsOfProgramPath(path_instruction_set_false, kCalcFalse); // FALSE
-    CountInstructions(path_instruction_set_false, instruction_category_count[kCalcFalse]);
+    static const char* kPathFileSuffixes[kCalcPathCount] = {"ALL.txt", "TRUE.txt", "FALSE.txt"};
 
-    if (graph_text.length() > 0)
+    std::vector<bool> is_block_in_path;
+    for (int path = kCalcAll; path < kCalcPathCount; path++)
     {
-        size_t pos = graph_text.rfind(".");
+        GetBlocksOfProgramPath(static_cast<AnalyzeDataPath>(path), is_block_in_path);
+        CountInstructions(is_block_in_path, instruction_category_count[path]);
 
-        if (pos == std::string::npos)
+        if (graph_file_name.length() > 0)
         {
-            pos  = graph_text.length() + 1;
-        }
+            size_t pos = graph_file_name.rfind(".");
 
-        std::string file_all = graph_text.substr(0, pos - 1) + "ALL.txt";
-        std::string file_true = graph_text.substr(0, pos - 1) + "TRUE.txt";
-        std::string file_false = graph_text.substr(0, pos - 1) + "FALSE.txt";
-        DumpGraph(path_instruction_set_all, file_all);
-        DumpGraph(path_instruction_set_true, file_true);
-        DumpGraph(path_instruction_set_false, file_false);
+            if (pos == std::string::npos)
+            {
+                pos = graph_file_name.length() + 1;
+            }
+
+            DumpGraph(is_block_in_path, graph_file_name.substr(0, pos - 1) + kPathFileSuffixes[path]);
+        }
     }
 }
 
@@ -532,7 +421,43 @@ void ISAProgramGraph::SetNumOfLoopIteration(int loop_iteration_count)
     }
 }
 
-int ISAProgramGraph::GetNumOfLoopIteration()
+int ISAProgramGraph::GetNumOfLoopIteration() const
 {
     return loop_iteration_count_;
 }
+
+void ISAProgramGraph::SetLoopIterationOverrides(const LoopIterationCounts& loop_iteration_overrides)
+{
+    loop_iteration_overrides_ = loop_iteration_overrides;
+}
+
+uint64_t ISAProgramGraph::GetEstimatedCycles(const std::string& device, AnalyzeDataPath path) const
+{
+    // The largest value marks an unknown estimate in the statistics, so saturate right below it.
+    const uint64_t kMaxCycles = std::numeric_limits<uint64_t>::max() - 1;
+    uint64_t       cycles     = 0;
+
+    std::vector<bool> is_block_in_path;
+    GetBlocksOfProgramPath(path, is_block_in_path);
+    for (uint32_t b = 0; b < blocks_.size(); b++)
+    {
+        if (is_block_in_path[b])
+        {
+            const IsaBasicBlock& block        = blocks_[b];
+            uint64_t             block_cycles = 0;
+            for (uint32_t i = block.first_instruction; i < block.end_instruction; i++)
+            {
+                block_cycles += static_cast<uint64_t>(std::max((*instructions_)[i]->GetInstructionClockCount(device), 0));
+            }
+
+            // Saturate instead of overflowing for deeply nested loops.
+            if (block_cycles != 0)
+            {
+                uint64_t weighted_cycles = (block.execution_count > kMaxCycles / block_cycles) ? kMaxCycles : block.execution_count * block_cycles;
+                cycles                   = (weighted_cycles > kMaxCycles - cycles) ? kMaxCycles : cycles + weighted_cycles;
+            }
+        }
+    }
+
+    return cycles;
+}
@@ -2,64 +2,68 @@
 /// Copyright (c) 2017-2025 Advanced Micro Devices, Inc. All rights reserved.
 /// @author AMD Developer Tools Team
 /// @file
-/// @brief Header for Basic node in the isa program.
+/// @brief Header for the control flow graph of the isa program.
 //=============================================================================
 
 #ifndef RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_ISA_PROGRAM_GRAPH_H_
 #define RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_ISA_PROGRAM_GRAPH_H_
 
 #include "be_instruction.h"
-#include <iostream>
-#include <vector>
-#include <map>
-#include <sstream>
-#include <fstream>
-#include <iostream>
-#include <set>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-// Basic node in the isa program.
-class IsaCodeBlock
+// Basic block of the isa program: a contiguous range of instructions with a single entry and a single exit.
+struct IsaBasicBlock
 {
-private:
-    // The label number of the loop, if any.
-    int label_ = kNoLabel;
+    // Index of the first instruction of the block in the program's instruction vector.
+    uint32_t first_instruction = 0;
+
+    // Index of one past the last instruction of the block.
+    uint32_t end_instruction = 0;
 
-    // How many times to do the loop, if applicable.
-    int iteration_count_ = 1;
+    // The label of the block, or kNoLabel if the block does not start at a label.
+    int label = kNoLabel;
 
-    // How many nodes points on me.
-    std::vector<Instruction*> instructions_;
+    // How many times the block is assumed to be executed per iteration of the enclosing loop.
+    // Greater than 1 only for loop headers.
+    int iteration_count = 1;
 
-    // Next code block.
-    IsaCodeBlock* next_ = nullptr;
+    // How many times the block is assumed to be executed per invocation of the program,
+    // taking all of the enclosing loops into account.
+    uint64_t execution_count = 1;
+};
 
-    // Next code block in case of branch is true. null if point to the upper loop to avoid loops in the graph.
-    IsaCodeBlock* true_ = nullptr;
+// Kind of a control flow edge.
+enum class IsaEdgeKind : uint8_t
+{
+    // Sequential flow, or an unconditional branch.
+    kNext,
 
-    // Next code block in case of branch is false.
-    IsaCodeBlock* false_ = nullptr;
+    // The taken path of a conditional branch.
+    kTrue,
 
-public:
-    ~IsaCodeBlock() = default;
+    // The not-taken path of a conditional branch.
+    kFalse
+};
 
-    int GetLabel() const {return label_;}
-    IsaCodeBlock* GetNext() {return next_;}
-    IsaCodeBlock* GetTrue() {return true_;}
-    IsaCodeBlock* GetFalse() {return false_;}
-    int GetIterationCount() const {return iteration_count_;}
-    const std::vector<Instruction*>& GetIsaCodeBlockInstructions() const { return instructions_;}
+// Control flow edge. Stored in the successor list of its source block, or in the predecessor list of its target block.
+struct IsaEdge
+{
+    // The block at the other end of the edge.
+    uint32_t block = 0;
 
-    void SetNext(IsaCodeBlock* p) { next_ = p; }
-    void SetTrue(IsaCodeBlock*  p)  { true_ = p; }
-    void SetFalse(IsaCodeBlock* p) { false_ = p; }
-    void SetIterationCount(int iteration_count) { iteration_count_ = iteration_count; }
+    // The kind of the edge.
+    IsaEdgeKind kind = IsaEdgeKind::kNext;
 
-    friend class ISAProgramGraph;
+    // True if the edge closes a loop (its target does not come after its source in program order).
+    bool is_back_edge = false;
 };
 
-// This class is a utility class that can build, destroy, search and traverse ISAProgramGraph.
-// The LabelNodeSet is saved as well so finding a label will be efficient
+// Control flow graph of the isa program.
+// The blocks are stored in program order, block 0 being the entry block, and the edges are stored in compressed
+// sparse row form, so the graph can be traversed in O(V+E) without recursion. The graph is built in one linear pass.
 class ISAProgramGraph
 {
 public:
@@ -86,108 +90,99 @@ public:
         unsigned int instruction_count_atomics = 0;
         unsigned int calculated_cycles = 0;
         unsigned int calculated_cycles_per_wavefront = 0;
-
-        NumOfInstructionsInCategory& operator=(const NumOfInstructionsInCategory& original)
-        {
-            instruction_count_scalar_memory_read = original.instruction_count_scalar_memory_read;
-            instruction_count_scalar_memory_write = original.instruction_count_scalar_memory_write;
-            instruction_count_scalar_alu = original.instruction_count_scalar_alu;
-            instruction_count_vector_memory_read = original.instruction_count_vector_memory_read;
-            instruction_count_vector_memory_write = original.instruction_count_vector_memory_write;
-            instruction_count_vector_alu = original.instruction_count_vector_alu;
-            instruction_count_lds = original.instruction_count_lds;
-            instruction_count_gds = original.instruction_count_gds;
-            instruction_count_export = original.instruction_count_export;
-            instruction_count_atomics = original.instruction_count_atomics;
-            calculated_cycles = original.calculated_cycles;
-            calculated_cycles_per_wavefront = original.calculated_cycles_per_wavefront;
-            return *this;
-        };
     };
 
-private:
-    class LabelNodeSet
-    {
-    public:
-        int label_;
-        int iteration_count_;
-        IsaCodeBlock* node_code_block_;
-
-        LabelNodeSet()
-        {
-            label_ = kNoLabel;
-            node_code_block_ = NULL;
-            iteration_count_ = 1;
-        }
-    };
+    // Sentinel for a missing block.
+    static const uint32_t kNoBlock = UINT32_MAX;
 
-    class LabelNodeSetCompare
-    {
-    public:
-        bool operator()(const LabelNodeSet& lhs, const LabelNodeSet& rhs) const
-        {
-            if (lhs.label_ < rhs.label_)
-            {
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-    };
+    // The iteration count that is assumed for loops by default.
+    static const int kDefaultIterationCount = 10;
 
-private:
-    // Head of the entire ISA graph.
-    IsaCodeBlock* isa_code_block_;
+    // Iteration counts of specific loops, by the label of the loop header block (without the trailing colon).
+    typedef std::unordered_map<std::string, int> LoopIterationCounts;
 
-    // Container for quick node search.
-    std::set<LabelNodeSet, LabelNodeSetCompare> node_set_;
+    ISAProgramGraph() = default;
+    ~ISAProgramGraph() = default;
 
-    // Fake label for nodes with no original label in the ISA.
-    int next_label_;
-    int loop_iteration_count_;
+    // Go through the instructions parsed in ParseToVector and build the ISA program graph.
+    // The graph refers to the instructions by index, so it remains valid as long as the instruction vector is unchanged.
+    // Returns false if there are no instructions.
+    bool BuildISAProgramStructure(const std::vector<Instruction*>& instructions);
 
-    // Internal function that builds the graph out of the instruction vector.
-    bool BuildISAProgramStructureInternal(std::vector<Instruction*>& Instructions, std::vector<Instruction*>::const_iterator instIterator, IsaCodeBlock* pHeadIsaNode);
+    // Destroy ALL the program graph.
+    void DestroyISAProgramStructure();
 
-    // Part of ISA program graph. when a loop is discovered update the default num of iteration.
-    bool UpdateNumOfIteration(std::vector<Instruction*>& Instructions, IsaCodeBlock* pLoop, const std::vector<Instruction*>::const_iterator iIterator);
+    // The basic blocks, in program order.
+    const std::vector<IsaBasicBlock>& GetBlocks() const { return blocks_; }
 
-    // Internal recursive search.
-    void GetInstructionsOfProgramPathInternal(std::set<LabelNodeSet, LabelNodeSetCompare>& PathInstructionsSet, IsaCodeBlock* pHeadISACodeBlock, int iPath, int iNumOfIterations);
+    // The outgoing edges of the given block.
+    const IsaEdge* SuccessorsBegin(uint32_t block) const { return successors_.data() + successor_offsets_[block]; }
+    const IsaEdge* SuccessorsEnd(uint32_t block) const { return successors_.data() + successor_offsets_[block + 1]; }
 
+    // The incoming edges of the given block.
+    const IsaEdge* PredecessorsBegin(uint32_t block) const { return predecessors_.data() + predecessor_offsets_[block]; }
+    const IsaEdge* PredecessorsEnd(uint32_t block) const { return predecessors_.data() + predecessor_offsets_[block + 1]; }
 
-    // Create a new node, updates it's label and update the node set.
-    IsaCodeBlock* CreateNewNode(int label_);
+    // Return the index of the block with the desired label, or kNoBlock if there is no such block.
+    uint32_t LabelSearcher(int label) const;
 
-    // The main function that counts the instruction in the specific ISA graph. this is the main idea of the entire analysis.
-    void CountInstructions(std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> PathInstructionsSet, ISAProgramGraph::NumOfInstructionsInCategory& NumOfInstructionsInCategory);
+    // Return the index of the block that contains the given instruction.
+    uint32_t GetInstructionBlock(size_t instruction_index) const { return instruction_blocks_[instruction_index]; }
 
-public:
-    ISAProgramGraph();
-    ~ISAProgramGraph() = default;
+    // Mark the blocks that are visited in a specific path (all/true/false), starting from the entry block.
+    // In the true path the not-taken side of conditional branches is skipped, and in the false path the taken side.
+    void GetBlocksOfProgramPath(AnalyzeDataPath path, std::vector<bool>& is_block_in_path) const;
 
-    // Go through the instructions parsed in ParseToVector and build the ISA program graph.
-    bool BuildISAProgramStructure(std::vector<Instruction*>& Instructions);
+    // Save the blocks of the given path in GRAPHVIZ format.
+    void DumpGraph(const std::vector<bool>& is_block_in_path, const std::string& file_name) const;
 
-     // Destroy ALL the program graph.
-    void DestroyISAProgramStructure();
+    // Traverse through all Graph Paths (ALL/TRUE/FALSE) and count the instructions, weighted by the blocks' execution count.
+    // If "graph_file_name" is not empty, the graph of each path is saved next to it.
+    void GetNumOfInstructionsInCategory(NumOfInstructionsInCategory instruction_category_count[kCalcPathCount], const std::string& graph_file_name) const;
+
+    // The iteration count that is assumed for loops.
+    void SetNumOfLoopIteration(int loop_iteration_count);
+    int GetNumOfLoopIteration() const;
+
+    // Override the iteration count of specific loops. Takes effect when the graph is built.
+    void SetLoopIterationOverrides(const LoopIterationCounts& loop_iteration_overrides);
+
+    // Estimate the number of cycles that it takes to execute the blocks of the given path on the given device.
+    // The cycles of each instruction are multiplied by the execution count of its block, so loop bodies are weighted by their iteration count.
+    uint64_t GetEstimatedCycles(const std::string& device, AnalyzeDataPath path = kCalcAll) const;
+
+private:
+    // Identify the loops by their back edges, and update the iteration and execution count of the blocks.
+    void UpdateLoopCounts();
+
+    // Count the instructions in the given blocks, by category.
+    void CountInstructions(const std::vector<bool>& is_block_in_path, NumOfInstructionsInCategory& instruction_category_count) const;
+
+    // The program's instructions, which the blocks refer to.
+    const std::vector<Instruction*>* instructions_ = nullptr;
+
+    // The basic blocks, in program order.
+    std::vector<IsaBasicBlock> blocks_;
+
+    // The successor edges of block i are successors_[successor_offsets_[i]] .. successors_[successor_offsets_[i + 1] - 1].
+    std::vector<uint32_t> successor_offsets_;
+    std::vector<IsaEdge>  successors_;
 
-    // Return the node with the desired label
-    IsaCodeBlock* LabelSearcher(int label_);
+    // The predecessor edges of block i are predecessors_[predecessor_offsets_[i]] .. predecessors_[predecessor_offsets_[i + 1] - 1].
+    std::vector<uint32_t> predecessor_offsets_;
+    std::vector<IsaEdge>  predecessors_;
 
-    // Return the vector of instruction in a specific path (all/true/false)
-    void GetInstructionsOfProgramPath(std::set<LabelNodeSet, LabelNodeSetCompare>& PathInstructionsSet, int iPath);
+    // Maps the labels to their block index.
+    std::unordered_map<int, uint32_t> label_blocks_;
 
-    // Save the graph in GRAPHVIZ format.
-    void DumpGraph(std::set<ISAProgramGraph::LabelNodeSet, ISAProgramGraph::LabelNodeSetCompare> PathInstructionsSet, std::string sFileName);
+    // The index of the block of each instruction.
+    std::vector<uint32_t> instruction_blocks_;
 
-    // Traverse through all Graph Paths (ALL/TRUE/FALSE) and count the instructions.
-    void GetNumOfInstructionsInCategory(ISAProgramGraph::NumOfInstructionsInCategory NumOfInstructionsInCategory[kCalcPathCount], std::string sDumpGraph);
+    // The iteration count that is assumed for loops.
+    int loop_iteration_count_ = kDefaultIterationCount;
 
-    void SetNumOfLoopIteration(int iNumOfLoopIteration);
-    int GetNumOfLoopIteration();
+    // The iteration count of specific loops, which takes precedence over the assumed iteration count.
+    LoopIterationCounts loop_iteration_overrides_;
 };
 
 #endif // RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_ISA_PROGRAM_GRAPH_H_
@@ -113,10 +113,3 @@ ParserSi::InstructionEncoding ParserSi::GetInstructionEncoding(Instruction::Inst
     // If no legal InstructionEncoding found return kInstructionEncodingIllegal
     return kInstructionEncodingIllegal;
 }
-
-void ParserSi::SetLog(ParserSi::LoggingCallBackFuncP callback)
-{
-    log_callback_ = callback;
-}
-
-ParserSi::LoggingCallBackFuncP ParserSi::log_callback_;
@@ -143,12 +143,20 @@ public:
     // 2)Unrecognized Instruction fields
     // 3)Memory allocation failures
     // 4)Report of start/end of parsing
+    // The callback is set per parser, so that parsers can run on different threads.
     // \param[in] callback a pointer to callback function.
-    static void SetLog(LoggingCallBackFuncP callback);
+    void SetLog(LoggingCallBackFuncP callback) { log_callback_ = callback; }
+
+    // Set the arena that the parsed instructions are allocated in.
+    void SetInstructionArena(InstructionArena* arena) { instruction_arena_ = arena; }
+
+protected:
+    // The arena that the parsed instructions are allocated in.
+    InstructionArena* instruction_arena_ = nullptr;
 
 private:
     // Stream for diagnostic output.
-    static LoggingCallBackFuncP log_callback_;
+    LoggingCallBackFuncP log_callback_ = nullptr;
 };
 
 #endif //RGA_RADEONGPUANALYZERBACKEND_SRC_EMULATOR_PARSER_BE_PARSER_SI_H_
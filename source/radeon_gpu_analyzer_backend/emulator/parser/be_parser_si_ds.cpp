@@ -108,17 +108,17 @@ ParserSi::kaStatus ParserSiDs::Parse(GDT_HW_GENERATION hw_generation, Instructio
     if ((hw_generation == GDT_HW_GENERATION_SEAISLAND) || (hw_generation == GDT_HW_GENERATION_SOUTHERNISLAND))
     {
         SIDSInstruction::OP op = GetSIDSOp(hex_instruction);
-        instruction = new SIDSInstruction(offset0, offset1, gds, op, addr, data0, data1, vdst, label, goto_label);
+        instruction = new (*instruction_arena_) SIDSInstruction(offset0, offset1, gds, op, addr, data0, data1, vdst, label, goto_label);
     }
     else if (hw_generation == GDT_HW_GENERATION_VOLCANICISLAND)
     {
         VIDSInstruction::OP op = GetVIDSOp(hex_instruction);
-        instruction = new VIDSInstruction(offset0, offset1, gds, op, addr, data0, data1, vdst, label, goto_label);
+        instruction = new (*instruction_arena_) VIDSInstruction(offset0, offset1, gds, op, addr, data0, data1, vdst, label, goto_label);
     }
     else if (hw_generation == GDT_HW_GENERATION_GFX9)
     {
         G9DSInstruction::OP op = GetG9DSOp(hex_instruction);
-        instruction = new G9DSInstruction(offset0, offset1, gds, op, addr, data0, data1, vdst, label, goto_label);
+        instruction = new (*instruction_arena_) G9DSInstruction(offset0, offset1, gds, op, addr, data0, data1, vdst, label, goto_label);
     }
     else
     {
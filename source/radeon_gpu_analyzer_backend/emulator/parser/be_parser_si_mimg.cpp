@@ -163,13 +163,13 @@ ParserSi::kaStatus ParserSiMimg::Parse(GDT_HW_GENERATION hw_generation, Instruct
     if ((hw_generation == GDT_HW_GENERATION_SEAISLAND) || (hw_generation == GDT_HW_GENERATION_SOUTHERNISLAND))
     {
         SIMIMGInstruction::OP op = GetOpSimimg(hex_instructions, instruction_kind);
-        instruction = new SIMIMGInstruction(dmask, unorm, glc, da, r128, tfe, lwe, op, vaddr, vdata, srsrc, slc,
+        instruction = new (*instruction_arena_) SIMIMGInstruction(dmask, unorm, glc, da, r128, tfe, lwe, op, vaddr, vdata, srsrc, slc,
                                             ssamp, instruction_kind, label, goto_label);
     }
     else
     {
         VIMIMGInstruction::OP op = GetOpVimimg(hex_instructions, instruction_kind);
-        instruction = new VIMIMGInstruction(dmask, unorm, glc, da, r128, tfe, lwe, op, vaddr, vdata, srsrc, slc,
+        instruction = new (*instruction_arena_) VIMIMGInstruction(dmask, unorm, glc, da, r128, tfe, lwe, op, vaddr, vdata, srsrc, slc,
                                             ssamp, instruction_kind, label, goto_label);
     }
 
@@ -97,7 +97,7 @@ ParserSi::kaStatus ParserSiSmrd::Parse(GDT_HW_GENERATION hw_generation, Instruct
     SMRDInstruction::SBASE sbase  = GetSBase(hex_instruction);
     SMRDInstruction::SDST sdst = GetSdst(hex_instruction, ridx);
     SISMRDInstruction::OP op = GetSiSmrdOp(hex_instruction);
-    instruction = new SISMRDInstruction(offset, imm, sbase, sdst, ridx, op, label, goto_label);
+    instruction = new (*instruction_arena_) SISMRDInstruction(offset, imm, sbase, sdst, ridx, op, label, goto_label);
 
     return ParserSi::kStatusSuccess;
 }
@@ -115,7 +115,7 @@ ParserSi::kaStatus ParserSiSmrd::Parse(GDT_HW_GENERATION hw_generation, Instruct
     SMRDInstruction::SBASE sbase = GetSBase(Instruction::Instruction32Bit(hex_instruction & 0xffff));
     SMRDInstruction::SDST sdst = GetSdst(Instruction::Instruction32Bit(hex_instruction & 0xffff), ridx);
     VISMEMInstruction::OP op = GetViSmrdOp(hex_instruction);
-    instruction = new VISMEMInstruction(offset, imm, sbase, sdst, ridx, op, label, goto_label);
+    instruction = new (*instruction_arena_) VISMEMInstruction(offset, imm, sbase, sdst, ridx, op, label, goto_label);
 
     return ParserSi::kStatusSuccess;
 }
@@ -0,0 +1,126 @@
+; Code object fixture for the in-process reader of AMDGPU code objects (BeAmdgpuElfReader).
+; Two kernels with their kernel descriptors, and the NT_AMDGPU_METADATA note of the kernels.
+; The note is written as MessagePack bytes, since llvm-mc does not encode the floating-point
+; values of the .amdgpu_metadata directive. The decoded note is in kernels_gfx900.readobj.txt.
+; See README.md for the commands that generate the object and the expected output.
+	.text
+	.amdgcn_target "amdgcn-amd-amdhsa--gfx900"
+	.globl	add_one
+	.p2align	8
+	.type	add_one,@function
+add_one:
+	s_load_dwordx2 s[0:1], s[4:5], 0x0
+	v_lshlrev_b32_e32 v0, 2, v0
+	s_waitcnt lgkmcnt(0)
+	v_mov_b32_e32 v1, s1
+	v_add_co_u32_e32 v0, vcc, s0, v0
+	v_addc_co_u32_e32 v1, vcc, 0, v1, vcc
+	global_load_dword v2, v[0:1], off
+	s_waitcnt vmcnt(0)
+	v_add_f32_e32 v2, 1.0, v2
+	global_store_dword v[0:1], v2, off
+	s_endpgm
+.Lfunc_end0:
+	.size	add_one, .Lfunc_end0-add_one
+
+	.globl	clear
+	.p2align	8
+	.type	clear,@function
+clear:
+	s_load_dwordx2 s[0:1], s[4:5], 0x0
+	v_mov_b32_e32 v0, 0
+	s_waitcnt lgkmcnt(0)
+	global_store_dword v0, v0, s[0:1]
+	s_endpgm
+.Lfunc_end1:
+	.size	clear, .Lfunc_end1-clear
+
+	.rodata
+	.p2align	6
+	.globl	add_one.kd
+	.type	add_one.kd,@object
+add_one.kd:
+	.zero	64
+	.size	add_one.kd, 64
+	.globl	clear.kd
+	.type	clear.kd,@object
+clear.kd:
+	.zero	64
+	.size	clear.kd, 64
+
+	.section	.note,"a",@note
+	.p2align	2
+	.long	7
+	.long	.Lmetadata_end-.Lmetadata
+	.long	32
+	.asciz	"AMDGPU"
+	.p2align	2
+.Lmetadata:
+	; The MessagePack document of the metadata.
+	.byte	0x83, 0xae, 0x61, 0x6d, 0x64, 0x68, 0x73, 0x61, 0x2e, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x73
+	.byte	0x92, 0xde, 0x00, 0x13, 0xa5, 0x2e, 0x61, 0x72, 0x67, 0x73, 0x92, 0x85, 0xae, 0x2e, 0x61, 0x64
+	.byte	0x64, 0x72, 0x65, 0x73, 0x73, 0x5f, 0x73, 0x70, 0x61, 0x63, 0x65, 0xa6, 0x67, 0x6c, 0x6f, 0x62
+	.byte	0x61, 0x6c, 0xa5, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0xa4, 0x64, 0x61, 0x74, 0x61, 0xa7, 0x2e, 0x6f
+	.byte	0x66, 0x66, 0x73, 0x65, 0x74, 0x00, 0xa5, 0x2e, 0x73, 0x69, 0x7a, 0x65, 0x08, 0xab, 0x2e, 0x76
+	.byte	0x61, 0x6c, 0x75, 0x65, 0x5f, 0x6b, 0x69, 0x6e, 0x64, 0xad, 0x67, 0x6c, 0x6f, 0x62, 0x61, 0x6c
+	.byte	0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x84, 0xa5, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0xa4, 0x62
+	.byte	0x69, 0x61, 0x73, 0xa7, 0x2e, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x08, 0xa5, 0x2e, 0x73, 0x69
+	.byte	0x7a, 0x65, 0x04, 0xab, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x5f, 0x6b, 0x69, 0x6e, 0x64, 0xa8
+	.byte	0x62, 0x79, 0x5f, 0x76, 0x61, 0x6c, 0x75, 0x65, 0xa5, 0x2e, 0x62, 0x69, 0x61, 0x73, 0xca, 0xbe
+	.byte	0x80, 0x00, 0x00, 0xb9, 0x2e, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x5f, 0x73, 0x65, 0x67, 0x6d, 0x65
+	.byte	0x6e, 0x74, 0x5f, 0x66, 0x69, 0x78, 0x65, 0x64, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x00, 0xb6, 0x2e
+	.byte	0x6b, 0x65, 0x72, 0x6e, 0x61, 0x72, 0x67, 0x5f, 0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x5f
+	.byte	0x61, 0x6c, 0x69, 0x67, 0x6e, 0x08, 0xb5, 0x2e, 0x6b, 0x65, 0x72, 0x6e, 0x61, 0x72, 0x67, 0x5f
+	.byte	0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x0c, 0xb8, 0x2e, 0x6d
+	.byte	0x61, 0x78, 0x5f, 0x66, 0x6c, 0x61, 0x74, 0x5f, 0x77, 0x6f, 0x72, 0x6b, 0x67, 0x72, 0x6f, 0x75
+	.byte	0x70, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0xcd, 0x01, 0x00, 0xa5, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0xa7
+	.byte	0x61, 0x64, 0x64, 0x5f, 0x6f, 0x6e, 0x65, 0xbb, 0x2e, 0x70, 0x72, 0x69, 0x76, 0x61, 0x74, 0x65
+	.byte	0x5f, 0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x5f, 0x66, 0x69, 0x78, 0x65, 0x64, 0x5f, 0x73
+	.byte	0x69, 0x7a, 0x65, 0x00, 0xa6, 0x2e, 0x73, 0x63, 0x61, 0x6c, 0x65, 0xcb, 0x3f, 0xf0, 0x00, 0x00
+	.byte	0x00, 0x00, 0x00, 0x00, 0xab, 0x2e, 0x73, 0x67, 0x70, 0x72, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74
+	.byte	0x08, 0xb1, 0x2e, 0x73, 0x67, 0x70, 0x72, 0x5f, 0x73, 0x70, 0x69, 0x6c, 0x6c, 0x5f, 0x63, 0x6f
+	.byte	0x75, 0x6e, 0x74, 0x00, 0xa5, 0x2e, 0x73, 0x74, 0x65, 0x70, 0xcb, 0x3f, 0xb9, 0x99, 0x99, 0x99
+	.byte	0x99, 0x99, 0x9a, 0xa7, 0x2e, 0x73, 0x79, 0x6d, 0x62, 0x6f, 0x6c, 0xaa, 0x61, 0x64, 0x64, 0x5f
+	.byte	0x6f, 0x6e, 0x65, 0x2e, 0x6b, 0x64, 0xb8, 0x2e, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x5f
+	.byte	0x77, 0x6f, 0x72, 0x6b, 0x5f, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0xc3
+	.byte	0xb3, 0x2e, 0x75, 0x73, 0x65, 0x73, 0x5f, 0x64, 0x79, 0x6e, 0x61, 0x6d, 0x69, 0x63, 0x5f, 0x73
+	.byte	0x74, 0x61, 0x63, 0x6b, 0xc2, 0xab, 0x2e, 0x76, 0x67, 0x70, 0x72, 0x5f, 0x63, 0x6f, 0x75, 0x6e
+	.byte	0x74, 0x03, 0xb1, 0x2e, 0x76, 0x67, 0x70, 0x72, 0x5f, 0x73, 0x70, 0x69, 0x6c, 0x6c, 0x5f, 0x63
+	.byte	0x6f, 0x75, 0x6e, 0x74, 0x00, 0xaf, 0x2e, 0x77, 0x61, 0x76, 0x65, 0x66, 0x72, 0x6f, 0x6e, 0x74
+	.byte	0x5f, 0x73, 0x69, 0x7a, 0x65, 0x40, 0xa9, 0x2e, 0x78, 0x5f, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74
+	.byte	0xfd, 0xde, 0x00, 0x13, 0xa5, 0x2e, 0x61, 0x72, 0x67, 0x73, 0x92, 0x85, 0xae, 0x2e, 0x61, 0x64
+	.byte	0x64, 0x72, 0x65, 0x73, 0x73, 0x5f, 0x73, 0x70, 0x61, 0x63, 0x65, 0xa6, 0x67, 0x6c, 0x6f, 0x62
+	.byte	0x61, 0x6c, 0xa5, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0xa4, 0x64, 0x61, 0x74, 0x61, 0xa7, 0x2e, 0x6f
+	.byte	0x66, 0x66, 0x73, 0x65, 0x74, 0x00, 0xa5, 0x2e, 0x73, 0x69, 0x7a, 0x65, 0x08, 0xab, 0x2e, 0x76
+	.byte	0x61, 0x6c, 0x75, 0x65, 0x5f, 0x6b, 0x69, 0x6e, 0x64, 0xad, 0x67, 0x6c, 0x6f, 0x62, 0x61, 0x6c
+	.byte	0x5f, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x84, 0xa5, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0xa4, 0x62
+	.byte	0x69, 0x61, 0x73, 0xa7, 0x2e, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x08, 0xa5, 0x2e, 0x73, 0x69
+	.byte	0x7a, 0x65, 0x04, 0xab, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x5f, 0x6b, 0x69, 0x6e, 0x64, 0xa8
+	.byte	0x62, 0x79, 0x5f, 0x76, 0x61, 0x6c, 0x75, 0x65, 0xa5, 0x2e, 0x62, 0x69, 0x61, 0x73, 0xca, 0xbe
+	.byte	0x80, 0x00, 0x00, 0xb9, 0x2e, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x5f, 0x73, 0x65, 0x67, 0x6d, 0x65
+	.byte	0x6e, 0x74, 0x5f, 0x66, 0x69, 0x78, 0x65, 0x64, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x00, 0xb6, 0x2e
+	.byte	0x6b, 0x65, 0x72, 0x6e, 0x61, 0x72, 0x67, 0x5f, 0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x5f
+	.byte	0x61, 0x6c, 0x69, 0x67, 0x6e, 0x08, 0xb5, 0x2e, 0x6b, 0x65, 0x72, 0x6e, 0x61, 0x72, 0x67, 0x5f
+	.byte	0x73, 0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0x0c, 0xb8, 0x2e, 0x6d
+	.byte	0x61, 0x78, 0x5f, 0x66, 0x6c, 0x61, 0x74, 0x5f, 0x77, 0x6f, 0x72, 0x6b, 0x67, 0x72, 0x6f, 0x75
+	.byte	0x70, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0xcd, 0x01, 0x00, 0xa5, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0xa5
+	.byte	0x63, 0x6c, 0x65, 0x61, 0x72, 0xbb, 0x2e, 0x70, 0x72, 0x69, 0x76, 0x61, 0x74, 0x65, 0x5f, 0x73
+	.byte	0x65, 0x67, 0x6d, 0x65, 0x6e, 0x74, 0x5f, 0x66, 0x69, 0x78, 0x65, 0x64, 0x5f, 0x73, 0x69, 0x7a
+	.byte	0x65, 0x00, 0xa6, 0x2e, 0x73, 0x63, 0x61, 0x6c, 0x65, 0xcb, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00
+	.byte	0x00, 0x00, 0xab, 0x2e, 0x73, 0x67, 0x70, 0x72, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x08, 0xb1
+	.byte	0x2e, 0x73, 0x67, 0x70, 0x72, 0x5f, 0x73, 0x70, 0x69, 0x6c, 0x6c, 0x5f, 0x63, 0x6f, 0x75, 0x6e
+	.byte	0x74, 0x00, 0xa5, 0x2e, 0x73, 0x74, 0x65, 0x70, 0xcb, 0x3f, 0xb9, 0x99, 0x99, 0x99, 0x99, 0x99
+	.byte	0x9a, 0xa7, 0x2e, 0x73, 0x79, 0x6d, 0x62, 0x6f, 0x6c, 0xa8, 0x63, 0x6c, 0x65, 0x61, 0x72, 0x2e
+	.byte	0x6b, 0x64, 0xb8, 0x2e, 0x75, 0x6e, 0x69, 0x66, 0x6f, 0x72, 0x6d, 0x5f, 0x77, 0x6f, 0x72, 0x6b
+	.byte	0x5f, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x5f, 0x73, 0x69, 0x7a, 0x65, 0xc3, 0xb3, 0x2e, 0x75, 0x73
+	.byte	0x65, 0x73, 0x5f, 0x64, 0x79, 0x6e, 0x61, 0x6d, 0x69, 0x63, 0x5f, 0x73, 0x74, 0x61, 0x63, 0x6b
+	.byte	0xc2, 0xab, 0x2e, 0x76, 0x67, 0x70, 0x72, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x01, 0xb1, 0x2e
+	.byte	0x76, 0x67, 0x70, 0x72, 0x5f, 0x73, 0x70, 0x69, 0x6c, 0x6c, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74
+	.byte	0x00, 0xaf, 0x2e, 0x77, 0x61, 0x76, 0x65, 0x66, 0x72, 0x6f, 0x6e, 0x74, 0x5f, 0x73, 0x69, 0x7a
+	.byte	0x65, 0x40, 0xa9, 0x2e, 0x78, 0x5f, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0xfd, 0xad, 0x61, 0x6d
+	.byte	0x64, 0x68, 0x73, 0x61, 0x2e, 0x74, 0x61, 0x72, 0x67, 0x65, 0x74, 0xb9, 0x61, 0x6d, 0x64, 0x67
+	.byte	0x63, 0x6e, 0x2d, 0x61, 0x6d, 0x64, 0x2d, 0x61, 0x6d, 0x64, 0x68, 0x73, 0x61, 0x2d, 0x2d, 0x67
+	.byte	0x66, 0x78, 0x39, 0x30, 0x30, 0xae, 0x61, 0x6d, 0x64, 0x68, 0x73, 0x61, 0x2e, 0x76, 0x65, 0x72
+	.byte	0x73, 0x69, 0x6f, 0x6e, 0x92, 0x01, 0x01
+.Lmetadata_end:
+	.p2align	2
@@ -0,0 +1,57 @@
+target triple = "amdgcn-amd-amdhsa"
+
+declare i32 @llvm.amdgcn.workitem.id.x()
+declare i32 @llvm.amdgcn.workgroup.id.x()
+
+@lds = internal addrspace(3) global [1024 x float] poison, align 4
+
+define amdgpu_kernel void @blur(ptr addrspace(1) %out, ptr addrspace(1) %in, i32 %n, float %w) {
+entry:
+  %tid = call i32 @llvm.amdgcn.workitem.id.x()
+  %gid = call i32 @llvm.amdgcn.workgroup.id.x()
+  %base = shl i32 %gid, 8
+  %idx = add i32 %base, %tid
+  %p = getelementptr float, ptr addrspace(1) %in, i32 %idx
+  %v = load float, ptr addrspace(1) %p, align 4
+  %lp = getelementptr [1024 x float], ptr addrspace(3) @lds, i32 0, i32 %tid
+  store float %v, ptr addrspace(3) %lp, align 4
+  fence syncscope("workgroup") release
+  call void @llvm.amdgcn.s.barrier()
+  fence syncscope("workgroup") acquire
+  %cmp0 = icmp sgt i32 %n, 0
+  br i1 %cmp0, label %loop, label %done
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %inext, %cont ]
+  %acc = phi float [ 0.0, %entry ], [ %acc2, %cont ]
+  %acc_b = phi float [ 1.0, %entry ], [ %accb2, %cont ]
+  %j = add i32 %tid, %i
+  %jm = and i32 %j, 1023
+  %q = getelementptr [1024 x float], ptr addrspace(3) @lds, i32 0, i32 %jm
+  %x = load float, ptr addrspace(3) %q, align 4
+  %pos = fcmp ogt float %x, 0.0
+  br i1 %pos, label %then, label %cont
+
+then:
+  %xw = fmul float %x, %w
+  %acc1 = fadd float %acc, %xw
+  %accb1 = fmul float %acc_b, %x
+  br label %cont
+
+cont:
+  %acc2 = phi float [ %acc1, %then ], [ %acc, %loop ]
+  %accb2 = phi float [ %accb1, %then ], [ %acc_b, %loop ]
+  %inext = add i32 %i, 1
+  %c = icmp slt i32 %inext, %n
+  br i1 %c, label %loop, label %done
+
+done:
+  %r = phi float [ 0.0, %entry ], [ %acc2, %cont ]
+  %rb = phi float [ 0.0, %entry ], [ %accb2, %cont ]
+  %s = fadd float %r, %rb
+  %o = getelementptr float, ptr addrspace(1) %out, i32 %idx
+  store float %s, ptr addrspace(1) %o, align 4
+  ret void
+}
+
+declare void @llvm.amdgcn.s.barrier()
@@ -0,0 +1,51 @@
+	.text
+	.amdgcn_target "amdgcn-amd-amdhsa--gfx900"
+	.globl	mix
+	.p2align	8
+	.type	mix,@function
+mix:
+	s_load_dwordx2 s[0:1], s[4:5], 0x0
+	s_load_dwordx8 s[8:15], s[4:5], 0x10
+	v_mov_b32_e32 v1, 0
+	v_lshlrev_b32_e32 v2, 2, v0
+	s_waitcnt lgkmcnt(0)
+	v_mov_b32_e32 v3, s1
+	v_add_co_u32_e32 v4, vcc, s0, v2
+	v_addc_co_u32_e32 v5, vcc, 0, v3, vcc
+	global_load_dwordx2 v[6:7], v[4:5], off offset:16
+	flat_load_dword v8, v[4:5] glc
+	buffer_load_dword v9, v0, s[8:11], 0 offen
+	ds_read_b32 v10, v2 offset:64
+	ds_write_b32 v2, v1
+	ds_add_rtn_u32 v11, v2, v1
+	ds_add_u32 v2, v1
+	s_waitcnt vmcnt(0) lgkmcnt(0)
+	v_add_f32_e32 v12, v6, v7
+	v_mov_b32_dpp v13, v8 quad_perm:[1,0,3,2] row_mask:0xf bank_mask:0xf
+	v_mac_f32_e32 v13, v9, v10
+	v_mad_u64_u32 v[14:15], s[2:3], v11, v12, v[6:7]
+	v_cndmask_b32_e64 v16, v13, v14, s[2:3]
+	v_cmp_lt_f32_e32 vcc, v16, v15
+	v_cmp_gt_u32_e64 s[16:17], v2, 64
+	v_cndmask_b32_e32 v17, 0, v16, vcc
+	v_readfirstlane_b32 s18, v17
+	v_mov_b32_e32 v1, s18
+	v_readlane_b32 s19, v1, 1
+	s_add_u32 s20, s18, s19
+	s_addc_u32 s21, s20, 0
+	s_lshl_b64 s[22:23], s[20:21], 2
+	s_and_saveexec_b64 s[24:25], s[16:17]
+	v_fma_f32 v18, v17, 2.0, -v16 clamp
+	v_add_f32_e64 v19, -v18, v17 mul:2
+	v_pk_add_f16 v20, v18, v19 op_sel_hi:[0,1]
+	global_atomic_add v21, v[4:5], v18, off glc
+	s_or_b64 exec, exec, s[24:25]
+	buffer_store_dword v20, v0, s[12:15], 0 offen
+	global_store_dwordx2 v[4:5], v[20:21], off
+	s_getpc_b64 s[26:27]
+	s_add_u32 s26, s26, s22
+	s_addc_u32 s27, s27, s23
+	s_setpc_b64 s[26:27]
+	s_endpgm
+.Lfunc_end0:
+	.size	mix, .Lfunc_end0-mix
@@ -0,0 +1,449 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Golden output tests for the in-process analyses of the backend.
+///
+/// Each suite runs an analysis on the fixtures in its data folder, and compares
+/// the results with the expected output of the reference tool that the analysis
+/// replaces (see golden_tests/README.md).
+///
+/// Usage: rga_golden_tests <suite> <data folder>
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Yaml.
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4127)
+#endif
+#include "yaml-cpp/yaml.h"
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+// Shared.
+#include "common/rga_shared_utils.h"
+
+// Backend.
+#include "radeon_gpu_analyzer_backend/be_amdgpu_elf_reader.h"
+#include "radeon_gpu_analyzer_backend/be_live_register_analyzer.h"
+#include "radeon_gpu_analyzer_backend/be_static_isa_analyzer.h"
+
+// Static constants.
+
+// The extension of the code object fixtures, and of the llvm-readobj output that is expected for them.
+static const char* kStrCodeObjectExtension  = ".o";
+static const char* kStrReadobjExtension     = ".readobj.txt";
+
+// The extension of the ISA disassembly fixtures, and of the shae livereg output that is expected for them.
+// The fixtures are named "<name>_<target>.isa".
+static const char* kStrIsaExtension         = ".isa";
+static const char* kStrVgprLiveregExtension = ".vgpr.txt";
+static const char* kStrSgprLiveregExtension = ".sgpr.txt";
+
+// The extension of the shae per-block and per-instruction control flow graphs that are expected for the ISA disassembly fixtures.
+static const char* kStrBlockCfgExtension       = ".bb.dot";
+static const char* kStrInstructionCfgExtension = ".pi.dot";
+
+// The tokens of the llvm-readobj output.
+static const char* kStrReadobjSymbolStart   = "Symbol {";
+static const char* kStrReadobjBlockEnd      = "}";
+static const char* kStrReadobjMetadataStart = "AMDGPU Metadata: ";
+static const char* kStrReadobjMetadataEnd   = "...";
+
+// The section indices that do not refer to a section (SHN_UNDEF, and SHN_LORESERVE and above).
+static const unsigned long kSectionIndexUndefined = 0;
+static const unsigned long kSectionIndexReserved  = 0xff00;
+
+// The size of the header of the metadata note: the sizes, the type and the padded "AMDGPU" owner name.
+static const size_t kMetadataNoteHeaderSize = 3 * sizeof(uint32_t) + 8;
+
+// A test suite: checks the fixtures in the given folder, and returns false if any of the checks fails.
+struct GoldenSuite
+{
+    const char*                                    name;
+    std::function<bool(const std::string& folder)> run;
+};
+
+// *** INTERNALLY LINKED SYMBOLS - START ***
+
+static bool ReadTextFile(const std::string& filename, std::string& text)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    text = content.str();
+    text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+    return file.good();
+}
+
+static std::string Trim(const std::string& text)
+{
+    const size_t start = text.find_first_not_of(" \t");
+    const size_t end   = text.find_last_not_of(" \t");
+    return (start == std::string::npos ? std::string() : text.substr(start, end - start + 1));
+}
+
+// Split a llvm-readobj field value of the form "<text> (<number>)" to its parts.
+static void SplitReadobjValue(const std::string& value, std::string& text, unsigned long& number)
+{
+    const size_t open_pos = value.rfind(" (");
+    text                  = Trim(value.substr(0, open_pos));
+    number                = (open_pos != std::string::npos ? std::strtoul(value.c_str() + open_pos + 2, nullptr, 0) : 0);
+}
+
+// Parse the symbols of the "--symbols" output of llvm-readobj.
+static void ParseReadobjSymbols(const std::string& readobj_text, std::vector<BeAmdgpuElfReader::Symbol>& symbols)
+{
+    std::istringstream           lines(readobj_text);
+    std::string                  line;
+    BeAmdgpuElfReader::Symbol*   symbol = nullptr;
+    while (std::getline(lines, line))
+    {
+        const std::string  field = Trim(line);
+        const size_t       colon = field.find(':');
+        const std::string  key   = field.substr(0, colon);
+        const std::string  value = (colon != std::string::npos ? field.substr(colon + 1) : "");
+        std::string        text;
+        unsigned long      number = 0;
+        if (field == kStrReadobjSymbolStart)
+        {
+            symbols.push_back(BeAmdgpuElfReader::Symbol());
+            symbol = &symbols.back();
+        }
+        else if (symbol != nullptr && field == kStrReadobjBlockEnd)
+        {
+            symbol = nullptr;
+        }
+        else if (symbol != nullptr && key == "Name")
+        {
+            SplitReadobjValue(value, symbol->name, number);
+        }
+        else if (symbol != nullptr && key == "Value")
+        {
+            symbol->value = std::strtoull(value.c_str(), nullptr, 0);
+        }
+        else if (symbol != nullptr && key == "Size")
+        {
+            symbol->size = std::strtoull(value.c_str(), nullptr, 0);
+        }
+        else if (symbol != nullptr && key == "Type")
+        {
+            SplitReadobjValue(value, text, number);
+            symbol->type = static_cast<unsigned>(number);
+        }
+        else if (symbol != nullptr && key == "Section")
+        {
+            SplitReadobjValue(value, text, number);
+            symbol->section = (number == kSectionIndexUndefined || number >= kSectionIndexReserved ? "" : text);
+        }
+    }
+}
+
+// Extract the metadata document of the "--notes" output of llvm-readobj.
+static bool ParseReadobjMetadata(const std::string& readobj_text, YAML::Node& metadata)
+{
+    const size_t start = readobj_text.find(kStrReadobjMetadataStart);
+    const size_t end   = (start != std::string::npos ? readobj_text.find(std::string("\n") + kStrReadobjMetadataEnd + "\n", start) : std::string::npos);
+    bool         ret   = (end != std::string::npos);
+    if (ret)
+    {
+        const size_t doc_start = start + strlen(kStrReadobjMetadataStart);
+        metadata               = YAML::Load(readobj_text.substr(doc_start, end - doc_start));
+    }
+    return ret;
+}
+
+// Compare two YAML documents. The keys of the maps may be in any order.
+// Prints the path of the first difference.
+static bool CompareYaml(const YAML::Node& expected, const YAML::Node& actual, const std::string& path)
+{
+    bool ret = (expected.Type() == actual.Type());
+    if (!ret)
+    {
+        std::cerr << "  " << path << ": the node types differ." << std::endl;
+    }
+    else if (expected.IsScalar() && expected.Scalar() != actual.Scalar())
+    {
+        std::cerr << "  " << path << ": expected \"" << expected.Scalar() << "\", got \"" << actual.Scalar() << "\"." << std::endl;
+        ret = false;
+    }
+    else if (expected.IsSequence() || expected.IsMap())
+    {
+        ret = (expected.size() == actual.size());
+        if (!ret)
+        {
+            std::cerr << "  " << path << ": expected " << expected.size() << " elements, got " << actual.size() << "." << std::endl;
+        }
+        if (expected.IsSequence())
+        {
+            for (size_t i = 0; ret && i < expected.size(); i++)
+            {
+                ret = CompareYaml(expected[i], actual[i], path + "[" + std::to_string(i) + "]");
+            }
+        }
+        else
+        {
+            for (auto iter = expected.begin(); ret && iter != expected.end(); ++iter)
+            {
+                const std::string key = iter->first.Scalar();
+                ret                   = CompareYaml(iter->second, actual[key], path + "/" + key);
+            }
+        }
+    }
+    return ret;
+}
+
+// Compare the symbols and the metadata that BeAmdgpuElfReader reads from a code object with the llvm-readobj output.
+static bool CheckCodeObject(const std::string& code_object_file, const std::string& readobj_file)
+{
+    BeAmdgpuElfReader                      reader;
+    std::vector<BeAmdgpuElfReader::Symbol> symbols, expected_symbols;
+    std::string                            readobj_text;
+    YAML::Node                             metadata, expected_metadata;
+
+    bool ret = ReadTextFile(readobj_file, readobj_text) && reader.Load(code_object_file);
+    if (!ret)
+    {
+        std::cerr << "  Cannot read the fixture." << std::endl;
+    }
+
+    // The symbols, with their sizes.
+    if (ret)
+    {
+        ParseReadobjSymbols(readobj_text, expected_symbols);
+        ret = reader.GetSymbols(symbols) && symbols.size() == expected_symbols.size();
+        if (!ret)
+        {
+            std::cerr << "  Expected " << expected_symbols.size() << " symbols, got " << symbols.size() << "." << std::endl;
+        }
+        for (size_t i = 0; ret && i < symbols.size(); i++)
+        {
+            const BeAmdgpuElfReader::Symbol& expected = expected_symbols[i];
+            const BeAmdgpuElfReader::Symbol& actual   = symbols[i];
+            ret = (actual.name == expected.name && actual.section == expected.section && actual.value == expected.value &&
+                   actual.size == expected.size && actual.type == expected.type);
+            if (!ret)
+            {
+                std::cerr << "  Symbol " << i << ": expected " << expected.name << " " << expected.section << " " << expected.value << " "
+                          << expected.size << " " << expected.type << ", got " << actual.name << " " << actual.section << " "
+                          << actual.value << " " << actual.size << " " << actual.type << "." << std::endl;
+            }
+        }
+    }
+
+    // The metadata note.
+    if (ret)
+    {
+        ret = ParseReadobjMetadata(readobj_text, expected_metadata) && reader.GetMetadata(metadata);
+        if (!ret)
+        {
+            std::cerr << "  Cannot read the metadata." << std::endl;
+        }
+        ret = ret && CompareYaml(expected_metadata, metadata, "");
+    }
+
+    // A truncated metadata document is rejected.
+    if (ret)
+    {
+        std::vector<char> note;
+        ret = reader.GetSectionData(".note", note) && note.size() > kMetadataNoteHeaderSize;
+        if (ret)
+        {
+            YAML::Node        truncated_metadata;
+            std::vector<char> truncated_msgpack(note.begin() + kMetadataNoteHeaderSize, note.end());
+            truncated_msgpack.resize(truncated_msgpack.size() / 2);
+            ret = !BeAmdgpuElfReader::DecodeMsgPack(truncated_msgpack, truncated_metadata);
+        }
+        if (!ret)
+        {
+            std::cerr << "  A truncated metadata document was not rejected." << std::endl;
+        }
+    }
+    return ret;
+}
+
+// Check the code objects of the folder against their llvm-readobj output.
+static bool RunElfReaderSuite(const std::string& folder)
+{
+    bool ret   = true;
+    int  count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(folder))
+    {
+        if (entry.path().extension() == kStrCodeObjectExtension)
+        {
+            std::filesystem::path readobj_file = entry.path();
+            readobj_file.replace_extension(kStrReadobjExtension);
+            std::cout << "Checking " << entry.path().filename().string() << std::endl;
+            ret = CheckCodeObject(entry.path().string(), readobj_file.string()) && ret;
+            count++;
+        }
+    }
+    return ret && count > 0;
+}
+
+// Compare a report with the expected output, line by line. Prints the first line that differs.
+static bool CompareText(const std::string& expected, const std::string& actual, const std::string& name)
+{
+    std::istringstream expected_lines(expected);
+    std::istringstream actual_lines(actual);
+    std::string        expected_line, actual_line;
+    bool               is_expected_line = true;
+    bool               is_actual_line   = true;
+    int                line_number      = 0;
+    bool               ret              = true;
+    while (ret && (is_expected_line || is_actual_line))
+    {
+        is_expected_line = static_cast<bool>(std::getline(expected_lines, expected_line));
+        is_actual_line   = static_cast<bool>(std::getline(actual_lines, actual_line));
+        line_number++;
+        ret = (is_expected_line == is_actual_line && expected_line == actual_line);
+        if (!ret)
+        {
+            std::cerr << "  " << name << ", line " << line_number << ": expected \"" << (is_expected_line ? expected_line : "<end of file>")
+                      << "\", got \"" << (is_actual_line ? actual_line : "<end of file>") << "\"." << std::endl;
+        }
+        expected_line.clear();
+        actual_line.clear();
+    }
+    return ret;
+}
+
+// Compare the VGPR and SGPR livereg reports of an ISA disassembly with the shae output.
+static bool CheckLiveRegisters(const std::filesystem::path& isa_file)
+{
+    const std::string stem   = isa_file.stem().string();
+    const std::string target = stem.substr(stem.rfind('_') + 1);
+
+    // The RDNA fixtures are wave32, like the shaders that RGA compiles for these targets by default.
+    const beWaveSize wave_size = RgaSharedUtils::IsNaviTarget(target) ? kWave32 : kWave64;
+
+    std::filesystem::path vgpr_file = isa_file;
+    std::filesystem::path sgpr_file = isa_file;
+    vgpr_file.replace_extension(kStrVgprLiveregExtension);
+    sgpr_file.replace_extension(kStrSgprLiveregExtension);
+
+    std::string isa_text, expected_vgpr_report, expected_sgpr_report, vgpr_report, sgpr_report;
+    bool ret = ReadTextFile(isa_file.string(), isa_text) && ReadTextFile(vgpr_file.string(), expected_vgpr_report) &&
+               ReadTextFile(sgpr_file.string(), expected_sgpr_report);
+    if (!ret)
+    {
+        std::cerr << "  Cannot read the fixture." << std::endl;
+    }
+    else if (beKA::BeLiveRegisterAnalyzer::Analyze(isa_text, target, wave_size, &vgpr_report, &sgpr_report) != beKA::kBeStatusSuccess)
+    {
+        std::cerr << "  The analysis failed." << std::endl;
+        ret = false;
+    }
+    else
+    {
+        // Check both of the reports, even if the first one differs.
+        ret = CompareText(expected_vgpr_report, vgpr_report, vgpr_file.filename().string());
+        ret = CompareText(expected_sgpr_report, sgpr_report, sgpr_file.filename().string()) && ret;
+    }
+    return ret;
+}
+
+// Compare the per-block and the per-instruction control flow graphs of an ISA disassembly with the shae output.
+static bool CheckControlFlowGraph(const std::filesystem::path& isa_file)
+{
+    bool ret = true;
+    for (bool is_per_instruction : {false, true})
+    {
+        std::filesystem::path dot_file = isa_file;
+        dot_file.replace_extension(is_per_instruction ? kStrInstructionCfgExtension : kStrBlockCfgExtension);
+        const std::filesystem::path output_file = std::filesystem::temp_directory_path() / ("rga_golden_" + dot_file.filename().string());
+
+        gtString isa_filename, output_filename;
+        isa_filename << isa_file.string().c_str();
+        output_filename << output_file.string().c_str();
+
+        std::string expected_graph, graph;
+        if (beKA::BeStaticIsaAnalyzer::GenerateControlFlowGraph(isa_filename, output_filename, is_per_instruction) != beKA::kBeStatusSuccess ||
+            !ReadTextFile(dot_file.string(), expected_graph) || !ReadTextFile(output_file.string(), graph))
+        {
+            std::cerr << "  Cannot generate the graph of " << dot_file.filename().string() << "." << std::endl;
+            ret = false;
+        }
+        else
+        {
+            // Check both of the graphs, even if the first one differs.
+            ret = CompareText(expected_graph, graph, dot_file.filename().string()) && ret;
+        }
+
+        std::error_code error;
+        std::filesystem::remove(output_file, error);
+    }
+    return ret;
+}
+
+// Run the check on each of the ISA disassembly fixtures of the folder.
+static bool RunIsaSuite(const std::string& folder, const std::function<bool(const std::filesystem::path& isa_file)>& check)
+{
+    bool ret   = true;
+    int  count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(folder))
+    {
+        if (entry.path().extension() == kStrIsaExtension)
+        {
+            std::cout << "Checking " << entry.path().filename().string() << std::endl;
+            ret = check(entry.path()) && ret;
+            count++;
+        }
+    }
+    return ret && count > 0;
+}
+
+// Check the live register analysis of the ISA disassembly fixtures of the folder against their shae output.
+static bool RunLiveRegistersSuite(const std::string& folder)
+{
+    return RunIsaSuite(folder, CheckLiveRegisters);
+}
+
+// Check the control flow graphs of the ISA disassembly fixtures of the folder against their shae output.
+static bool RunCfgSuite(const std::string& folder)
+{
+    return RunIsaSuite(folder, CheckControlFlowGraph);
+}
+
+// *** INTERNALLY LINKED SYMBOLS - END ***
+
+static const GoldenSuite kGoldenSuites[] = {
+    {"elf_reader", RunElfReaderSuite},
+    {"live_registers", RunLiveRegistersSuite},
+    {"cfg", RunCfgSuite},
+};
+
+int main(int argc, char* argv[])
+{
+    int ret = EXIT_FAILURE;
+    if (argc == 3)
+    {
+        for (const GoldenSuite& suite : kGoldenSuites)
+        {
+            if (suite.name == std::string(argv[1]))
+            {
+                ret = suite.run(argv[2]) ? EXIT_SUCCESS : EXIT_FAILURE;
+                std::cout << suite.name << (ret == EXIT_SUCCESS ? ": passed." : ": FAILED.") << std::endl;
+            }
+        }
+    }
+    else
+    {
+        std::cerr << "Usage: rga_golden_tests <suite> <data folder>" << std::endl;
+    }
+    return ret;
+}
@@ -0,0 +1,256 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the on-disk cache of compiled code objects.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_build_cache.h"
+
+// The files of a cache entry.
+static const char* kCacheEntryBinaryFile         = "code_object.bin";
+static const char* kCacheEntryCompilerOutputFile = "compiler_output.txt";
+static const char* kCacheEntryIsaFile            = "isa.txt";
+static const char* kCacheEntryKernelNamesFile    = "kernel_names.txt";
+
+// The extension of the entries that are being written.
+static const char* kCacheEntryTempExtension = ".tmp";
+
+// The age after which an entry that is being written is considered to be left by a compilation that did not complete.
+static const std::chrono::hours kCacheTempEntryGracePeriod(1);
+
+// FNV-1a parameters. The key is made of two 64-bit hashes with different offset bases.
+static const uint64_t kFnvPrime        = 0x100000001b3ULL;
+static const uint64_t kFnvOffsetBasisA = 0xcbf29ce484222325ULL;
+static const uint64_t kFnvOffsetBasisB = 0x84222325cbf29ce4ULL;
+
+static void UpdateHash(uint64_t& hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= kFnvPrime;
+    }
+}
+
+// Read the whole content of a file, as is.
+static bool ReadFileContent(const std::filesystem::path& path, std::string& content)
+{
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    bool          ret = input.is_open();
+    if (ret)
+    {
+        std::stringstream content_stream;
+        content_stream << input.rdbuf();
+        content = content_stream.str();
+    }
+    return ret;
+}
+
+// Write the given content to a file, as is.
+static bool WriteFileContent(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream output(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    bool          ret = output.is_open();
+    if (ret)
+    {
+        output.write(content.data(), content.size());
+        ret = output.good();
+    }
+    return ret;
+}
+
+// The total size of the files in the given directory.
+static uint64_t GetDirectorySize(const std::filesystem::path& dir)
+{
+    uint64_t        size = 0;
+    std::error_code error;
+    for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(dir, error))
+    {
+        const uintmax_t file_size = (file.is_regular_file(error) ? file.file_size(error) : 0);
+        size += (error ? 0 : file_size);
+    }
+    return size;
+}
+
+KcBuildCache::KcBuildCache(const std::string& cache_dir, uint64_t max_size)
+    : cache_dir_(cache_dir)
+    , max_size_(max_size)
+{
+}
+
+bool KcBuildCache::Init()
+{
+    std::error_code error;
+    std::filesystem::create_directories(cache_dir_, error);
+    bool ret = std::filesystem::is_directory(cache_dir_, error);
+    if (ret)
+    {
+        std::lock_guard<std::mutex> lock(size_lock_);
+        Evict();
+    }
+    return ret;
+}
+
+std::string KcBuildCache::ComputeKey(const std::vector<std::string>& key_parts)
+{
+    uint64_t hash_a = kFnvOffsetBasisA;
+    uint64_t hash_b = kFnvOffsetBasisB;
+    for (const std::string& part : key_parts)
+    {
+        // Hash the size of each part as well, so that the boundaries between the parts are part of the key.
+        const uint64_t part_size = part.size();
+        UpdateHash(hash_a, reinterpret_cast<const char*>(&part_size), sizeof(part_size));
+        UpdateHash(hash_b, reinterpret_cast<const char*>(&part_size), sizeof(part_size));
+        UpdateHash(hash_a, part.data(), part.size());
+        UpdateHash(hash_b, part.data(), part.size());
+    }
+
+    std::stringstream key;
+    key << std::hex << std::setfill('0') << std::setw(16) << hash_a << std::setw(16) << hash_b;
+    return key.str();
+}
+
+bool KcBuildCache::Load(const std::string& key, const std::string& bin_filename, Entry& entry) const
+{
+    const std::filesystem::path entry_dir = std::filesystem::path(cache_dir_) / key;
+    std::error_code             error;
+    bool                        ret = std::filesystem::is_regular_file(entry_dir / kCacheEntryBinaryFile, error);
+
+    if (ret)
+    {
+        ret = std::filesystem::copy_file(entry_dir / kCacheEntryBinaryFile, bin_filename, std::filesystem::copy_options::overwrite_existing, error) &&
+              ReadFileContent(entry_dir / kCacheEntryCompilerOutputFile, entry.compiler_output);
+    }
+
+    if (ret)
+    {
+        std::string kernel_names;
+        entry.is_disassembled = ReadFileContent(entry_dir / kCacheEntryIsaFile, entry.isa_text) &&
+                                ReadFileContent(entry_dir / kCacheEntryKernelNamesFile, kernel_names);
+        entry.kernel_names.clear();
+        if (entry.is_disassembled)
+        {
+            std::stringstream kernel_names_stream(kernel_names);
+            std::string       kernel_name;
+            while (std::getline(kernel_names_stream, kernel_name))
+            {
+                entry.kernel_names.push_back(kernel_name);
+            }
+        }
+
+        // Mark the entry as recently used.
+        std::filesystem::last_write_time(entry_dir, std::filesystem::file_time_type::clock::now(), error);
+    }
+
+    return ret;
+}
+
+void KcBuildCache::Store(const std::string& key, const std::string& bin_filename, const Entry& entry)
+{
+    // Write the entry to a directory with a unique name, and then move it to its place, so that concurrent compilations
+    // never see a partially written entry.
+    std::random_device random;
+    std::stringstream  temp_name;
+    temp_name << key << "." << std::hex << random() << random() << kCacheEntryTempExtension;
+    const std::filesystem::path temp_dir  = std::filesystem::path(cache_dir_) / temp_name.str();
+    const std::filesystem::path entry_dir = std::filesystem::path(cache_dir_) / key;
+
+    std::error_code error;
+    uint64_t        entry_size = 0;
+    bool            is_written = std::filesystem::create_directory(temp_dir, error) &&
+                      std::filesystem::copy_file(bin_filename, temp_dir / kCacheEntryBinaryFile, error) &&
+                      WriteFileContent(temp_dir / kCacheEntryCompilerOutputFile, entry.compiler_output);
+
+    if (is_written && entry.is_disassembled)
+    {
+        std::stringstream kernel_names;
+        for (const std::string& kernel_name : entry.kernel_names)
+        {
+            kernel_names << kernel_name << "\n";
+        }
+        is_written = WriteFileContent(temp_dir / kCacheEntryIsaFile, entry.isa_text) &&
+                     WriteFileContent(temp_dir / kCacheEntryKernelNamesFile, kernel_names.str());
+    }
+
+    if (is_written)
+    {
+        // Replace the previous entry, which may lack some of the artifacts.
+        // The size of the previous entry is still counted until the next scan, which only makes the scan happen earlier.
+        entry_size = GetDirectorySize(temp_dir);
+        std::filesystem::remove_all(entry_dir, error);
+        std::filesystem::rename(temp_dir, entry_dir, error);
+    }
+    std::filesystem::remove_all(temp_dir, error);
+
+    std::lock_guard<std::mutex> lock(size_lock_);
+    size_ += entry_size;
+    if (size_ > max_size_)
+    {
+        Evict();
+    }
+}
+
+void KcBuildCache::Evict()
+{
+    struct EntryInfo
+    {
+        std::filesystem::path           path;
+        std::filesystem::file_time_type last_used;
+        uint64_t                        size = 0;
+    };
+    std::vector<EntryInfo> entries;
+    uint64_t               total_size = 0;
+
+    std::error_code                       error;
+    const std::filesystem::file_time_type now = std::filesystem::file_time_type::clock::now();
+    std::vector<std::filesystem::path>    stale_temp_dirs;
+    for (const std::filesystem::directory_entry& dir_entry : std::filesystem::directory_iterator(cache_dir_, error))
+    {
+        if (dir_entry.is_directory(error))
+        {
+            const std::filesystem::file_time_type last_write = std::filesystem::last_write_time(dir_entry.path(), error);
+            if (dir_entry.path().extension() != kCacheEntryTempExtension)
+            {
+                EntryInfo info;
+                info.path      = dir_entry.path();
+                info.last_used = last_write;
+                info.size      = GetDirectorySize(info.path);
+                total_size += info.size;
+                entries.push_back(info);
+            }
+            else if (!error && now - last_write > kCacheTempEntryGracePeriod)
+            {
+                // Skip the entries that are being written, but remove the ones that were left by compilations that did not complete.
+                stale_temp_dirs.push_back(dir_entry.path());
+            }
+        }
+    }
+
+    for (const std::filesystem::path& stale_temp_dir : stale_temp_dirs)
+    {
+        std::filesystem::remove_all(stale_temp_dir, error);
+    }
+
+    if (total_size > max_size_)
+    {
+        std::sort(entries.begin(), entries.end(), [](const EntryInfo& a, const EntryInfo& b) { return a.last_used < b.last_used; });
+        for (auto iter = entries.cbegin(); iter != entries.cend() && total_size > max_size_; ++iter)
+        {
+            std::filesystem::remove_all(iter->path, error);
+            total_size -= iter->size;
+        }
+    }
+    size_ = total_size;
+}
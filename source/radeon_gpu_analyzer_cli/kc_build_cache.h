@@ -0,0 +1,70 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for the on-disk cache of compiled code objects.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERCLI_SRC_KC_BUILD_CACHE_H_
+#define RGA_RADEONGPUANALYZERCLI_SRC_KC_BUILD_CACHE_H_
+
+// C++.
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// An on-disk cache of compiled code objects and of the artifacts that are derived from them by external tools.
+// The entries are addressed by a hash of everything that determines the build (see ComputeKey()), so an entry never
+// has to be invalidated: a change in the sources, options or compiler leads to a different key.
+// When the total size of the entries exceeds the limit, the least recently used entries are removed.
+// The cache can be shared by concurrent compilations, including compilations in other processes. The size of the cache
+// is tracked as the entries are stored, and the directory is only scanned on Init() and when the size exceeds the limit,
+// so the entries that other processes store are counted at the next scan.
+class KcBuildCache
+{
+public:
+    // The artifacts of a build, other than the code object itself.
+    struct Entry
+    {
+        std::string              compiler_output;         ///< The messages (warnings) that the compiler printed.
+        bool                     is_disassembled = false; ///< True if the disassembly of the code object is stored.
+        std::string              isa_text;                ///< The ISA disassembly of the code object.
+        std::vector<std::string> kernel_names;            ///< The names of the kernels in the code object.
+    };
+
+    // Create a cache in "cache_dir", with up to "max_size" bytes of entries.
+    KcBuildCache(const std::string& cache_dir, uint64_t max_size);
+
+    // Create the cache directory if it does not exist, and scan it for the size of the entries.
+    // Returns false if the directory cannot be used.
+    bool Init();
+
+    // Compute the key of a build from the parts that determine it, such as the preprocessed sources, the compiler options,
+    // the target device and the compiler version.
+    static std::string ComputeKey(const std::vector<std::string>& key_parts);
+
+    // Look up the entry with the given key. On a hit, the code object is copied to "bin_filename" and the other
+    // artifacts are returned in "entry".
+    bool Load(const std::string& key, const std::string& bin_filename, Entry& entry) const;
+
+    // Store the code object "bin_filename" and the artifacts in "entry" with the given key, replacing the previous
+    // entry with that key (if any). Failures are ignored, since the cache only speeds up later compilations.
+    void Store(const std::string& key, const std::string& bin_filename, const Entry& entry);
+
+private:
+    // Scan the cache directory for the size of the entries, and remove the least recently used entries until the size
+    // of the cache is within the limit. Must be called with "size_lock_" held.
+    void Evict();
+
+    std::string cache_dir_;
+    uint64_t    max_size_ = 0;
+
+    // The size of the entries, as of the last scan plus the entries that were stored since.
+    uint64_t size_ = 0;
+
+    // Serializes the updates of the size and the eviction within this process.
+    std::mutex size_lock_;
+};
+
+#endif  // RGA_RADEONGPUANALYZERCLI_SRC_KC_BUILD_CACHE_H_
@@ -28,23 +28,23 @@
 #include "radeon_gpu_analyzer_cli/kc_utils_binary_raytracing.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_binary_graphics.h"
 
-beKA::beStatus KcCliBinaryAnalysis::AnalyzeCodeObject(const Config& config, const std::string& amdgpu_dis_output)
+beKA::beStatus KcCliBinaryAnalysis::AnalyzeCodeObject(const Config& config, const std::string& amdgpu_dis_output, std::ostream& out)
 {
     const bool     verbose = config.print_process_cmd_line;
     beKA::beStatus status  = beKA::beStatus::kBeStatusSuccess;
 
     if (status == beKA::beStatus::kBeStatusSuccess)
     {
-        status = WriteFullDisassemblyText(config, amdgpu_dis_output);
+        status = WriteFullDisassemblyText(config, amdgpu_dis_output, out);
         if (status == beKA::beStatus::kBeStatusSuccess)
         {
-            status = DetectAndSetWorkflowStrategy(amdgpu_dis_output, verbose);
+            status = DetectAndSetWorkflowStrategy(amdgpu_dis_output, verbose, out);
             if (status == beKA::beStatus::kBeStatusSuccess)
             {
-                status = ParseDisassembly(config, amdgpu_dis_output);
+                status = ParseDisassembly(config, amdgpu_dis_output, out);
                 if (status == beKA::beStatus::kBeStatusSuccess)
                 {
-                    RunPostProcessingSteps(config);
+                    RunPostProcessingSteps(config, out);
                 }
             }
         }
@@ -64,49 +64,49 @@ bool KcCliBinaryAnalysis::GenerateSessionMetadataFile(const Config& config) cons
     return ret;
 }
 
-void KcCliBinaryAnalysis::LogPreStep(const std::string& msg, const std::string& device)
+void KcCliBinaryAnalysis::LogPreStep(std::ostream& out, const std::string& msg, const std::string& device)
 {
-    RgLog::stdOut << msg << device << "... " << std::flush;
+    out << msg << device << "... " << std::flush;
 }
 
-void KcCliBinaryAnalysis::LogResult(bool result)
+void KcCliBinaryAnalysis::LogResult(std::ostream& out, bool result)
 {
-    RgLog::stdOut << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
+    out << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
 }
 
-void KcCliBinaryAnalysis::LogErrorStatus(beStatus status, const std::string& err_msg)
+void KcCliBinaryAnalysis::LogErrorStatus(std::ostream& out, beStatus status, const std::string& err_msg)
 {
     switch (status)
     {
     case beKA::beStatus::kBeStatusSuccess:
         break;
     case beKA::beStatus::kBeStatusNoDeviceFound:
-        RgLog::stdOut << kStrErrorNoDeviceFound << err_msg << std::endl;
+        out << kStrErrorNoDeviceFound << err_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusUnknownDevice:
-        RgLog::stdOut << kStrErrorUnknownDevice << err_msg << std::endl;
+        out << kStrErrorUnknownDevice << err_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusBinaryInvalidInput:
-        RgLog::stdOut << kStrErrorCannotReadFile << err_msg << std::endl;
+        out << kStrErrorCannotReadFile << err_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusVulkanAmdgpudisLaunchFailed:
-        RgLog::stdOut << kStrErrorFailedAmdGpuDisStatus << err_msg << std::endl;
+        out << kStrErrorFailedAmdGpuDisStatus << err_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusWriteToFileFailed:
     case beKA::beStatus::kBeStatusWriteParsedIsaFileFailed:
-        RgLog::stdOut << kErrCannotWriteDisassemblyFile << err_msg << std::endl;
+        out << kErrCannotWriteDisassemblyFile << err_msg << std::endl;
         break;
     default:
-        RgLog::stdOut << std::endl << (err_msg.empty() ? kStrErrorUnknownAmdGpuDisStatus : err_msg) << std::endl;
+        out << std::endl << (err_msg.empty() ? kStrErrorUnknownAmdGpuDisStatus : err_msg) << std::endl;
         break;
     }
 }
 
-beKA::beStatus KcCliBinaryAnalysis::DetectAndSetWorkflowStrategy(const std::string& amdgpu_dis_output, bool verbose)
+beKA::beStatus KcCliBinaryAnalysis::DetectAndSetWorkflowStrategy(const std::string& amdgpu_dis_output, bool verbose, std::ostream& out)
 {
     if (verbose)
     {
-        KcCliBinaryAnalysis::LogPreStep(kStrInfoDetectBinWorkflowType, binary_codeobj_file_);
+        KcCliBinaryAnalysis::LogPreStep(out, kStrInfoDetectBinWorkflowType, binary_codeobj_file_);
     }
 
     // TODO: use std::make_unique function - currently incompatible with gcc7.
@@ -138,14 +138,15 @@ beKA::beStatus KcCliBinaryAnalysis::DetectAndSetWorkflowStrategy(const std::stri
 
     if (verbose)
     {
-        KcCliBinaryAnalysis::LogResult(status == beKA::beStatus::kBeStatusSuccess);
-        KcCliBinaryAnalysis::LogErrorStatus(status, binary_codeobj_file_);
+        KcCliBinaryAnalysis::LogResult(out, status == beKA::beStatus::kBeStatusSuccess);
+        KcCliBinaryAnalysis::LogErrorStatus(out, status, binary_codeobj_file_);
     }
     return status;
 }
 
-beKA::beStatus KcCliBinaryAnalysis::WriteFullDisassemblyText(const Config& config,
-                                                             const std::string& amdgpu_dis_output)
+beKA::beStatus KcCliBinaryAnalysis::WriteFullDisassemblyText(const Config&      config,
+                                                             const std::string& amdgpu_dis_output,
+                                                             std::ostream&      out)
 {
     beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
     if (!amdgpu_dis_output.empty() && !config.binary_text_disassembly.empty())
@@ -162,14 +163,14 @@ beKA::beStatus KcCliBinaryAnalysis::WriteFullDisassemblyText(const Config& confi
         {
             status = beKA::beStatus::kBeStatusWriteToFileFailed;
         }
-        LogErrorStatus(status, binary_codeobj_file_);
+        LogErrorStatus(out, status, binary_codeobj_file_);
     }
     return status;
 }
 
-beKA::beStatus KcCliBinaryAnalysis::ParseDisassembly(const Config& config, const std::string& amdgpu_dis_output) const
+beKA::beStatus KcCliBinaryAnalysis::ParseDisassembly(const Config& config, const std::string& amdgpu_dis_output, std::ostream& out) const
 {
-    LogPreStep(kStrInfoExtractingIsaForDevice, asic_);
+    LogPreStep(out, kStrInfoExtractingIsaForDevice, asic_);
 
     beKA::beStatus                     status = beKA::beStatus::kBeStatusGeneralFailed;
     std::map<std::string, std::string> kernel_to_disassembly;
@@ -185,8 +186,8 @@ beKA::beStatus KcCliBinaryAnalysis::ParseDisassembly(const Config& config, const
         status = beKA::beStatus::kBeStatusWriteParsedIsaFileFailed;
     }
 
-    LogResult(status == beKA::beStatus::kBeStatusSuccess);
-    LogErrorStatus(status, binary_codeobj_file_ + "\n" + error_msg);
+    LogResult(out, status == beKA::beStatus::kBeStatusSuccess);
+    LogErrorStatus(out, status, binary_codeobj_file_ + "\n" + error_msg);
 
     return status;
 }
@@ -215,10 +216,10 @@ beKA::beStatus KcCliBinaryAnalysis::WriteOutputFiles(const Config&
     return ret;
 }
 
-void KcCliBinaryAnalysis::RunPostProcessingSteps(const Config& config) const
+void KcCliBinaryAnalysis::RunPostProcessingSteps(const Config& config, std::ostream& out) const
 {
     if (workflow_strategy_ != nullptr)
     {
-        workflow_strategy_->RunPostProcessingSteps(config, amdpal_pipeline_md_);
+        workflow_strategy_->RunPostProcessingSteps(config, amdpal_pipeline_md_, out);
     }
 }
@@ -9,6 +9,7 @@
 
 //C++.
 #include <memory>
+#include <ostream>
 
 // Backend.
 #include "radeon_gpu_analyzer_backend/be_program_builder_vulkan.h"
@@ -38,31 +39,31 @@ public:
     }
 
 public:
-    // Analyze disassembled codeobject.
-    beKA::beStatus AnalyzeCodeObject(const Config& config, const std::string& amdgpu_dis_output);
+    // Analyze disassembled codeobject. The console output of the analysis is written to "out".
+    beKA::beStatus AnalyzeCodeObject(const Config& config, const std::string& amdgpu_dis_output, std::ostream& out);
 
     // Generates the RGA CLI metadata for Binary Analysis mode that contains the list of output
     // files generated by RGA CLI for that binary.
     bool GenerateSessionMetadataFile(const Config& config) const;
 
     // Logging Pre Step for binary analysis.
-    static void LogPreStep(const std::string& msg, const std::string& device = "");
+    static void LogPreStep(std::ostream& out, const std::string& msg, const std::string& device = "");
 
     // Logging Result for binary analysis.
-    static void LogResult(bool result);
+    static void LogResult(std::ostream& out, bool result);
 
     // LoggingBinary analysis error status.
-    static void LogErrorStatus(beStatus status, const std::string& err_msg);
+    static void LogErrorStatus(std::ostream& out, beStatus status, const std::string& err_msg);
 
 private:
     // Parses amdgpu-dis output and detects workflow type (graphics or compute).
-    beKA::beStatus DetectAndSetWorkflowStrategy(const std::string& amdgpu_dis_output, bool verbose);
+    beKA::beStatus DetectAndSetWorkflowStrategy(const std::string& amdgpu_dis_output, bool verbose, std::ostream& out);
 
     // Write text disassembly to disk.
-    beKA::beStatus WriteFullDisassemblyText(const Config& config, const std::string& amdgpu_dis_output);
+    beKA::beStatus WriteFullDisassemblyText(const Config& config, const std::string& amdgpu_dis_output, std::ostream& out);
 
     // Parse text disassembly to ISA disassembly file(s).
-    beKA::beStatus ParseDisassembly(const Config& config, const std::string& amdgpu_dis_output) const;
+    beKA::beStatus ParseDisassembly(const Config& config, const std::string& amdgpu_dis_output, std::ostream& out) const;
 
     // Parses amdgpu-dis output and extracts a table with
     // the amdgpu kernel name being the key and that shader stage's disassembly the value.
@@ -74,7 +75,7 @@ private:
     beKA::beStatus WriteOutputFiles(const Config& config, const std::map<std::string, std::string>& kernel_to_disassembly, std::string& error_msg) const;
 
     // Perform post-processing actions.
-    void RunPostProcessingSteps(const Config& config) const;
+    void RunPostProcessingSteps(const Config& config, std::ostream& out) const;
 
     // Target GPU extracted from dissassembly.
     std::string asic_;
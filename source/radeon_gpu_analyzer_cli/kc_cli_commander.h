@@ -14,6 +14,7 @@
 
 // Local.
 #include "radeon_gpu_analyzer_cli/kc_config.h"
+#include "radeon_gpu_analyzer_cli/kc_data_types.h"
 #include "radeon_gpu_analyzer_cli/kc_utils.h"
 
 class KcCliCommander
@@ -47,6 +48,13 @@ public:
     // Dump the extracted entry points to stdout.
     virtual bool ListEntries(const Config& config, LoggingCallbackFunction callback);
 
+    // Get the output files of the last compilation, mapped by {device, entry}.
+    // Modes that do not track their output files return an empty map.
+    virtual void GetOutputFiles(RgClOutputMetadata& output_files) const
+    {
+        output_files.clear();
+    }
+
 protected:
     // -- Functions --
 
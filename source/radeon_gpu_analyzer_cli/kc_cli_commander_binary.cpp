@@ -6,8 +6,14 @@
 //=============================================================================
 
 // C++.
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
 #include <string>
+#include <vector>
 
 // Shared.
 #include "common/rga_cli_defs.h"
@@ -21,10 +27,29 @@
 // Local.
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_binary.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_string_constants.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 #include "radeon_gpu_analyzer_cli/kc_xml_writer.h"
 
 const char kMultipleBinaryFolderNumberWildcardToken = '*';
 
+// The prefix of an input file that lists the code object files, one per line.
+const char kBinaryListFilePrefix = '@';
+
+// The comment prefix of a line in a list file.
+const char kBinaryListFileCommentToken = '#';
+
+// The result of the analysis of a single input code object.
+struct BinaryAnalysisResult
+{
+    std::string         bin_file_name;
+    Config              config;
+    bool                is_duplicate = false;
+    std::string         device;
+    beKA::beStatus      status = beKA::beStatus::kBeStatusGeneralFailed;
+    KcCliBinaryAnalysis analysis;
+};
+
 std::string create_folder_with_wildcard(const std::string& path, size_t folder_number)
 {
     std::string result        = path;
@@ -58,42 +83,226 @@ Config create_updated_config_for_binary(const Config& config, size_t binary_inde
     return config_updated;
 }
 
-void KcCliCommanderBinary::RunCompileCommands(const Config& config, LoggingCallbackFunction log_callback)
+// Append the given code object file, or all of the files under the given directory in alphabetical order.
+bool append_binary_input_path(const std::filesystem::path& path, std::vector<std::string>& binary_files)
+{
+    bool            ret = true;
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error))
+    {
+        std::vector<std::string> dir_files;
+        for (std::filesystem::recursive_directory_iterator iter(path, error), end; !error && iter != end; iter.increment(error))
+        {
+            if (iter->is_regular_file(error))
+            {
+                dir_files.push_back(iter->path().string());
+            }
+        }
+
+        if (error)
+        {
+            RgLog::stdErr << kStrErrorCannotReadBinaryDirectory << path.string() << std::endl;
+            ret = false;
+        }
+        else
+        {
+            std::sort(dir_files.begin(), dir_files.end());
+            binary_files.insert(binary_files.end(), dir_files.begin(), dir_files.end());
+        }
+    }
+    else
+    {
+        binary_files.push_back(path.string());
+    }
+    return ret;
+}
+
+// Expand the input files to the list of code object files.
+// An input directory stands for all of the files under it, and "@<file>" for the files or directories that are listed in <file>,
+// one per line. Relative paths in a list file are relative to the directory of the list file.
+bool expand_binary_input_files(const std::vector<std::string>& input_files, std::vector<std::string>& binary_files)
 {
-    const bool            verbose = config.print_process_cmd_line;
-    std::set<std::string> devices;
-    beKA::beStatus        status = GetSupportedTargets(devices);
-    if (status == beKA::beStatus::kBeStatusSuccess)
+    bool ret = true;
+    for (const std::string& input_file : input_files)
     {
-        for (size_t i = 0; i < config.input_files.size(); i++)
+        if (input_file.size() > 1 && input_file[0] == kBinaryListFilePrefix)
         {
-            Config             config_updated  = create_updated_config_for_binary(config, i);
-            const auto&        input_file_name = config.input_files[i];
-            const std::string& bin_file_name   = KcUtils::Quote(input_file_name);
-            auto               found           = binary_file_to_binary_analysis_map_.find(bin_file_name);
-            if (found == binary_file_to_binary_analysis_map_.end())
+            const std::filesystem::path list_file(input_file.substr(1));
+            std::ifstream               list_stream(list_file);
+            if (list_stream.is_open())
             {
-                status = IsBinaryInputValid(config_updated, verbose, bin_file_name);
-                std::string amdgpu_dis_stdout;
-                std::string amdgpu_dis_stderr;
-                if (status == beKA::beStatus::kBeStatusSuccess)
+                std::string line;
+                while (std::getline(list_stream, line))
                 {
-                    status = DisassembleBinary(bin_file_name, verbose, amdgpu_dis_stdout, amdgpu_dis_stderr);
-                    assert(status == beKA::beStatus::kBeStatusSuccess);
+                    // Skip empty lines and comments.
+                    const size_t begin = line.find_first_not_of(" \t\r");
+                    if (begin != std::string::npos && line[begin] != kBinaryListFileCommentToken)
+                    {
+                        const size_t          end = line.find_last_not_of(" \t\r");
+                        std::filesystem::path listed_path(line.substr(begin, end - begin + 1));
+                        if (listed_path.is_relative())
+                        {
+                            listed_path = list_file.parent_path() / listed_path;
+                        }
+                        ret = append_binary_input_path(listed_path, binary_files) && ret;
+                    }
                 }
+            }
+            else
+            {
+                RgLog::stdErr << kStrErrorCannotReadBinaryList << list_file.string() << std::endl;
+                ret = false;
+            }
+        }
+        else
+        {
+            ret = append_binary_input_path(input_file, binary_files) && ret;
+        }
+    }
+    return ret;
+}
+
+// Print the number of the code objects that were analyzed successfully per device, and the list of code objects that failed.
+void print_binary_summary(const std::vector<BinaryAnalysisResult>& results)
+{
+    const char* kStrUnknownDevice = "unknown";
+    const int   kDeviceColumnWidth = 16;
+    const int   kCountColumnWidth  = 14;
+
+    // Device name => {succeeded, failed}.
+    std::map<std::string, std::pair<size_t, size_t>> device_counts;
+    size_t                                           succeeded_count = 0;
+    size_t                                           failed_count    = 0;
+    size_t                                           duplicate_count = 0;
+    for (const BinaryAnalysisResult& result : results)
+    {
+        if (result.is_duplicate)
+        {
+            duplicate_count++;
+        }
+        else
+        {
+            auto& counts = device_counts[result.device.empty() ? kStrUnknownDevice : result.device];
+            if (result.status == beKA::beStatus::kBeStatusSuccess)
+            {
+                counts.first++;
+                succeeded_count++;
+            }
+            else
+            {
+                counts.second++;
+                failed_count++;
+            }
+        }
+    }
+
+    std::stringstream summary;
+    summary << std::endl << kStrInfoBinarySummary << results.size() << " code objects, " << succeeded_count << " succeeded, " << failed_count << " failed";
+    if (duplicate_count > 0)
+    {
+        summary << ", " << duplicate_count << " duplicates skipped";
+    }
+    summary << "." << std::endl;
+
+    summary << std::left << std::setw(kDeviceColumnWidth) << "Device" << std::setw(kCountColumnWidth) << "Succeeded" << "Failed" << std::endl;
+    for (const auto& [device, counts] : device_counts)
+    {
+        summary << std::left << std::setw(kDeviceColumnWidth) << device << std::setw(kCountColumnWidth) << counts.first << counts.second << std::endl;
+    }
+
+    if (failed_count > 0)
+    {
+        summary << kStrInfoBinarySummaryFailedFiles << std::endl;
+        for (const BinaryAnalysisResult& result : results)
+        {
+            if (!result.is_duplicate && result.status != beKA::beStatus::kBeStatusSuccess)
+            {
+                summary << "    " << result.bin_file_name << std::endl;
+            }
+        }
+    }
+
+    RgLog::stdOut << summary.str() << std::flush;
+}
 
-                if (status == beKA::beStatus::kBeStatusSuccess)
+void KcCliCommanderBinary::RunCompileCommands(const Config& config, LoggingCallbackFunction log_callback)
+{
+    const bool               verbose = config.print_process_cmd_line;
+    std::set<std::string>    devices;
+    std::vector<std::string> input_files;
+    beKA::beStatus           status = GetSupportedTargets(devices);
+    if (status == beKA::beStatus::kBeStatusSuccess && expand_binary_input_files(config.input_files, input_files))
+    {
+        if (input_files.empty() && !config.input_files.empty())
+        {
+            RgLog::stdErr << kStrErrorNoInputFile << std::endl;
+        }
+
+        // Prepare the analysis of each of the code objects.
+        // The numbered output folders are created here, so that their numbers follow the order of the input files.
+        std::vector<BinaryAnalysisResult> results(input_files.size());
+        std::set<std::string>             unique_bin_file_names;
+        for (size_t i = 0; i < input_files.size(); i++)
+        {
+            BinaryAnalysisResult& result = results[i];
+            result.config                = create_updated_config_for_binary(config, i);
+            result.bin_file_name         = KcUtils::Quote(input_files[i]);
+            result.is_duplicate          = (binary_file_to_binary_analysis_map_.find(result.bin_file_name) != binary_file_to_binary_analysis_map_.end()) ||
+                                           !unique_bin_file_names.insert(result.bin_file_name).second;
+        }
+
+        // Analyze the code objects concurrently.
+        // The console output of each of them is written to its device output, which is printed in the order of the input files.
+        const bool is_multiple_binaries = (results.size() > 1);
+        KcDeviceExecutor::Run(
+            results.size(),
+            (verbose ? 1 : config.jobs),
+            [&](size_t i, KcDeviceOutput& output) {
+                BinaryAnalysisResult& result = results[i];
+                if (!result.is_duplicate)
                 {
-                    std::set<std::string> matched_devices;
-                    status = InitRequestedAsicBinary(config_updated, verbose, devices, bin_file_name, amdgpu_dis_stdout, matched_devices);
-                    if (status == beKA::beStatus::kBeStatusSuccess && matched_devices.size() == 1)
+                    if (is_multiple_binaries)
                     {
-                        std::vector<std::string> asics(matched_devices.begin(), matched_devices.end());
-                        binary_file_to_binary_analysis_map_[bin_file_name] = KcCliBinaryAnalysis{asics[0], bin_file_name, log_callback};
-                        status = binary_file_to_binary_analysis_map_[bin_file_name].AnalyzeCodeObject(config_updated, amdgpu_dis_stdout);
+                        output.Out() << kStrInfoAnalyzingBinary << (i + 1) << "/" << results.size() << ": " << result.bin_file_name << std::endl;
+                    }
+
+                    result.status = IsBinaryInputValid(result.config, verbose, result.bin_file_name, output.Out());
+                    std::string amdgpu_dis_stdout;
+                    std::string amdgpu_dis_stderr;
+                    if (result.status == beKA::beStatus::kBeStatusSuccess)
+                    {
+                        result.status = DisassembleBinary(result.bin_file_name, verbose, amdgpu_dis_stdout, amdgpu_dis_stderr, output.Out());
+                        assert(result.status == beKA::beStatus::kBeStatusSuccess);
+                    }
+
+                    if (result.status == beKA::beStatus::kBeStatusSuccess)
+                    {
+                        std::set<std::string> matched_devices;
+                        result.status = InitRequestedAsicBinary(
+                            result.config, verbose, devices, result.bin_file_name, amdgpu_dis_stdout, matched_devices, output.Out());
+                        if (result.status == beKA::beStatus::kBeStatusSuccess && matched_devices.size() == 1)
+                        {
+                            result.device   = *matched_devices.begin();
+                            result.analysis = KcCliBinaryAnalysis{result.device, result.bin_file_name, log_callback};
+
+                            // The spans of the analysis are tagged with the device of the code object.
+                            KcTrace::Context trace_context(result.device);
+                            result.status = result.analysis.AnalyzeCodeObject(result.config, amdgpu_dis_stdout, output.Out());
+                        }
                     }
                 }
-            }
+            },
+            [&](size_t i) {
+                BinaryAnalysisResult& result = results[i];
+                if (!result.device.empty())
+                {
+                    binary_file_to_binary_analysis_map_[result.bin_file_name] = std::move(result.analysis);
+                }
+            });
+
+        if (is_multiple_binaries)
+        {
+            print_binary_summary(results);
         }
     }
 }
@@ -143,11 +352,11 @@ beKA::beStatus KcCliCommanderBinary::GetSupportedTargets(std::set<std::string>&
     return status;
 }
 
-beKA::beStatus KcCliCommanderBinary::IsBinaryInputValid(const Config& config, bool verbose, const std::string& binary_codeobj_file) const
+beKA::beStatus KcCliCommanderBinary::IsBinaryInputValid(const Config& config, bool verbose, const std::string& binary_codeobj_file, std::ostream& out) const
 {
     if (verbose)
     {
-        KcCliBinaryAnalysis::LogPreStep(kStrInfoValidateBinFile, binary_codeobj_file);
+        KcCliBinaryAnalysis::LogPreStep(out, kStrInfoValidateBinFile, binary_codeobj_file);
     }
 
     beKA::beStatus ret = beKA::beStatus::kBeStatusGeneralFailed;
@@ -175,17 +384,22 @@ beKA::beStatus KcCliCommanderBinary::IsBinaryInputValid(const Config& config, bo
 
     if (verbose)
     {
-        KcCliBinaryAnalysis::LogResult(ret == beKA::beStatus::kBeStatusSuccess);
+        KcCliBinaryAnalysis::LogResult(out, ret == beKA::beStatus::kBeStatusSuccess);
     }
 
-    KcCliBinaryAnalysis::LogErrorStatus(ret, binary_codeobj_file);
+    KcCliBinaryAnalysis::LogErrorStatus(out, ret, binary_codeobj_file);
 
     return ret;
 }
 
-beKA::beStatus KcCliCommanderBinary::DisassembleBinary(const std::string& bin_file, bool verbose, std::string& out_text, std::string& error_txt) const
+beKA::beStatus KcCliCommanderBinary::DisassembleBinary(const std::string& bin_file,
+                                                       bool               verbose,
+                                                       std::string&       out_text,
+                                                       std::string&       error_txt,
+                                                       std::ostream&      out) const
 {
-    KcCliBinaryAnalysis::LogPreStep(kStrInfoDisassemblingBinary, bin_file);
+    KcTrace::Span span(kTraceCategoryPhase, "Disassembly");
+    KcCliBinaryAnalysis::LogPreStep(out, kStrInfoDisassemblingBinary, bin_file);
 
     beKA::beStatus ret = KcUtils::InvokeAmdgpudis(bin_file, verbose, out_text, error_txt) ? beKA::beStatus::kBeStatusSuccess
                                                                                           : beKA::beStatus::kBeStatusVulkanAmdgpudisLaunchFailed;
@@ -194,8 +408,8 @@ beKA::beStatus KcCliCommanderBinary::DisassembleBinary(const std::string& bin_fi
         ret = beKA::beStatus::kBeStatusVulkanAmdgpudisLaunchFailed;
     }
 
-    KcCliBinaryAnalysis::LogResult(ret == beKA::beStatus::kBeStatusSuccess);
-    KcCliBinaryAnalysis::LogErrorStatus(ret, error_txt);
+    KcCliBinaryAnalysis::LogResult(out, ret == beKA::beStatus::kBeStatusSuccess);
+    KcCliBinaryAnalysis::LogErrorStatus(out, ret, error_txt);
     return ret;
 }
 
@@ -226,13 +440,15 @@ beKA::beStatus KcCliCommanderBinary::InitRequestedAsicBinary(const Config&
                                                              const std::set<std::string>& supported_devices,
                                                              const std::string&           binary_codeobj_file,
                                                              const std::string&           amdgpu_dis_output,
-                                                             std::set<std::string>&       matched_targets)
+                                                             std::set<std::string>&       matched_targets,
+                                                             std::ostream&                out)
 {
+    KcTrace::Span  span(kTraceCategoryPhase, "Device resolution");
     beKA::beStatus result = beKA::beStatus::kBeStatusSuccess;
 
     if (verbose)
     {
-        KcCliBinaryAnalysis::LogPreStep(kStrInfoDetectBinTargetDevice, binary_codeobj_file);
+        KcCliBinaryAnalysis::LogPreStep(out, kStrInfoDetectBinTargetDevice, binary_codeobj_file);
     }
 
     std::string device;
@@ -254,8 +470,8 @@ beKA::beStatus KcCliCommanderBinary::InitRequestedAsicBinary(const Config&
 
     if (verbose)
     {
-        KcCliBinaryAnalysis::LogResult(result == beKA::beStatus::kBeStatusSuccess);
-        KcCliBinaryAnalysis::LogErrorStatus(result, binary_codeobj_file);
+        KcCliBinaryAnalysis::LogResult(out, result == beKA::beStatus::kBeStatusSuccess);
+        KcCliBinaryAnalysis::LogErrorStatus(out, result, binary_codeobj_file);
     }
 
     return result;
@@ -36,22 +36,23 @@ public:
     static beKA::beStatus GetSupportedTargets(std::set<std::string>& targets);
 
 private:
-    // Validate .bin input file.
-    beKA::beStatus IsBinaryInputValid(const Config& config, bool verbose, const std::string& binary_codeobj_file) const;
+    // Validate .bin input file. The console output is written to "out".
+    beKA::beStatus IsBinaryInputValid(const Config& config, bool verbose, const std::string& binary_codeobj_file, std::ostream& out) const;
 
-    // Invoke the amdgpu-dis executable and write out-text to a file on disk.
-    beKA::beStatus DisassembleBinary(const std::string& bin_file, bool verbose, std::string& out_text, std::string& error_txt) const;
+    // Invoke the amdgpu-dis executable and write out-text to a file on disk. The console output is written to "out".
+    beKA::beStatus DisassembleBinary(const std::string& bin_file, bool verbose, std::string& out_text, std::string& error_txt, std::ostream& out) const;
 
     // Extract target device from ISA disassembly.
     static bool ExtractDeviceFromAmdgpudisOutput(const std::string& amdgpu_dis_output, std::string& device);
 
-    // Identify the devices requested by user.
+    // Identify the devices requested by user. The console output is written to "out".
     beKA::beStatus InitRequestedAsicBinary(const Config&                config,
                                            bool                         verbose,
                                            const std::set<std::string>& supported_devices,
                                            const std::string&           binary_codeobj_file,
                                            const std::string&           amdgpu_dis_output,
-                                           std::set<std::string>&       matched_targets);
+                                           std::set<std::string>&       matched_targets,
+                                           std::ostream&                out);
 
     // Maps input binary file to its binary analysis.
     KcCliBinaryAnalysis::Map binary_file_to_binary_analysis_map_;
@@ -503,7 +503,7 @@ void KcCliCommanderCL::GetISAText(const Config& config)
 
                                 // Call the kcUtils routine to analyze <generatedFileName> and write the analysis file.
                                 KcUtils::PerformLiveRegisterAnalysis(isa_output_filename, device_name_gt_str, liveRegAnalysisOutputFileName,
-                                    log_callback_, config.print_process_cmd_line);
+                                    log_callback_);
                             }
                             else
                             {
@@ -528,7 +528,7 @@ void KcCliCommanderCL::GetISAText(const Config& config)
                                     // Call the kcUtils routine to analyze <generatedFileName> and write
                                     // the analysis file.
                                     KcUtils::GenerateControlFlowGraph(isa_output_filename, device_name_gt_str, cfg_output_filename, log_callback_,
-                                        !config.inst_cfg_file.empty(), config.print_process_cmd_line);
+                                        !config.inst_cfg_file.empty());
                                 }
                             }
                             else
@@ -579,8 +579,7 @@ void KcCliCommanderCL::GetISAText(const Config& config)
                                         bool is_livereg_performed = KcUtils::PerformLiveRegisterAnalysis(isa_output_filename,
                                                                                                          device_name_gt_str,
                                                                                                          livereg_analysis_output_filename,
-                                                                                                         log_callback_,
-                                                                                                         config.print_process_cmd_line);
+                                                                                                         log_callback_);
 
                                         if (is_livereg_performed)
                                         {
@@ -618,7 +617,7 @@ void KcCliCommanderCL::GetISAText(const Config& config)
                                         // Call the kcUtils routine to analyze <generatedFileName> and write
                                         // the analysis file.
                                         bool is_cfg_generated =  KcUtils::GenerateControlFlowGraph(isa_output_filename, device_name_gt_str, cfg_output_filename, log_callback_,
-                                            !config.inst_cfg_file.empty(), config.print_process_cmd_line);
+                                            !config.inst_cfg_file.empty());
 
                                         if (is_cfg_generated)
                                         {
@@ -851,7 +850,8 @@ void KcCliCommanderCL::WriteAnalysisFile(const Config& config, const std::string
     file_content << doNAFormat(analysis.num_threads_per_group_x, kCalValue64Na, kCalValue64Error, csv_separator);
     file_content << doNAFormat(analysis.num_threads_per_group_y, kCalValue64Na, kCalValue64Error, csv_separator);
     file_content << doNAFormat(analysis.num_threads_per_group_z, kCalValue64Na, kCalValue64Error, csv_separator);
-    file_content << doNAFormat(analysis.isa_size, (CALuint64)0, kCalValue64Error, csv_separator, false);
+    file_content << doNAFormat(analysis.isa_size, (CALuint64)0, kCalValue64Error, csv_separator, true);
+    file_content << beKA::AnalysisData::na_or(analysis.estimated_cycles);
     file_content << std::endl;
 
     // Write the file.
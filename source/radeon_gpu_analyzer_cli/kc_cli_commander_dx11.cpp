@@ -119,7 +119,8 @@ void KcCliCommanderDX::ExtractISA(const std::string& device_name,
                                   size_t&            isa_size_in_bytes,
                                   std::string        isa_buffer,
                                   bool&              is_isa_size_detected,
-                                  bool&              should_detect_isa_size)
+                                  bool&              should_detect_isa_size,
+                                  uint64_t&          estimated_cycles)
 {
     BeProgramBuilderDx11* program_builder_dx = backend_handler_ != nullptr ? backend_handler_->theOpenDXBuilder() : nullptr;
     beStatus backend_rc = kBeStatusInvalid;
@@ -145,11 +146,21 @@ void KcCliCommanderDX::ExtractISA(const std::string& device_name,
             }
             KcUtils::WriteTextFile(isa_output_filename.asASCIICharArray(), isa_buffer, log_callback_);
 
-            // Save parsed ISA to a CSV file if it's requested
+            // Save parsed ISA to a CSV file if it's requested.
+            // The cycles of the statistics are estimated from the same parse, or from a parse of their own if there is no CSV file.
+            const bool is_stats_required = !config.analysis_file.empty();
             if (config.is_parsed_isa_required)
             {
                 std::string  parsedIsa, parsedIsaFileName;
-                backend_rc = BeProgramBuilder::ParseIsaToCsv(isa_buffer, device_name, parsedIsa);
+                if (is_stats_required)
+                {
+                    backend_rc = BeProgramBuilder::ParseIsaToCsv(isa_buffer, device_name, parsedIsa, false, false, config.loop_iteration_count,
+                                                                 config.loop_iteration_overrides, estimated_cycles);
+                }
+                else
+                {
+                    backend_rc = BeProgramBuilder::ParseIsaToCsv(isa_buffer, device_name, parsedIsa);
+                }
 
                 if (backend_rc == beKA::kBeStatusSuccess)
                 {
@@ -161,6 +172,10 @@ void KcCliCommanderDX::ExtractISA(const std::string& device_name,
                     KcUtils::WriteTextFile(parsedIsaFileName, parsedIsa, log_callback_);
                 }
             }
+            else if (is_stats_required)
+            {
+                estimated_cycles = KcUtils::EstimateIsaCycles(config, isa_buffer, device_name, false);
+            }
 
             // Detect the ISA size.
             is_isa_size_detected = program_builder_dx->GetIsaSize(isa_buffer, isa_size_in_bytes);
@@ -178,7 +193,7 @@ void KcCliCommanderDX::ExtractISA(const std::string& device_name,
 
                 // Call the kcUtils routine to analyze <generatedFileName> and write the analysis file.
                 KcUtils::PerformLiveRegisterAnalysis(isa_output_filename.asASCIICharArray(), device_name, liveRegAnalysisOutputFileName.asASCIICharArray(),
-                    log_callback_, config.print_process_cmd_line);
+                    log_callback_);
             }
 
             if (!config.sgpr_livereg_analysis_file.empty())
@@ -196,8 +211,7 @@ void KcCliCommanderDX::ExtractISA(const std::string& device_name,
                 KcUtils::PerformLiveRegisterAnalysis(isa_output_filename.asASCIICharArray(),
                                                      device_name,
                                                      liveRegAnalysisOutputFileName.asASCIICharArray(),
-                                                     log_callback_,
-                                                     config.print_process_cmd_line, true);
+                                                     log_callback_, true);
             }
 
             if (!config.inst_cfg_file.empty() || !config.block_cfg_file.empty())
@@ -208,7 +222,7 @@ void KcCliCommanderDX::ExtractISA(const std::string& device_name,
                     config.function, device_name, cfg_output_ilename);
 
                 KcUtils::GenerateControlFlowGraph(isa_output_filename.asASCIICharArray(), device_name, cfg_output_ilename.asASCIICharArray(), log_callback_,
-                    !config.inst_cfg_file.empty(), config.print_process_cmd_line);
+                    !config.inst_cfg_file.empty());
             }
 
             // Delete temporary ISA file.
@@ -287,6 +301,7 @@ bool KcCliCommanderDX::ExtractStats(const std::string&         device_name,
                                     std::string                isaBuffer,
                                     bool                       is_isa_size_detected,
                                     size_t                     isa_size_in_bytes,
+                                    uint64_t                   estimated_cycles,
                                     std::vector<beKA::AnalysisData>& analysis_data,
                                     std::vector<std::string>&  device_analysis_data)
 {
@@ -325,6 +340,9 @@ bool KcCliCommanderDX::ExtractStats(const std::string&         device_name,
             LogCallback("Warning: wavefrontSize size not available.\n");
         }
 
+        // The cycles were estimated when the ISA was extracted.
+        analysis.estimated_cycles = estimated_cycles;
+
         analysis_data.push_back(analysis);
         device_analysis_data.push_back(device_name);
         std::stringstream s_Log;
@@ -434,9 +452,10 @@ void KcCliCommanderDX::RunCompileCommands(const Config& config, LoggingCallBackF
                     bool   is_isa_size_detected   = false;
                     bool   should_detect_isa_size = true;
                     size_t isa_size_bytes(0);
+                    uint64_t estimated_cycles = static_cast<uint64_t>(-1);
                     if (is_isa_required || is_statistics_required || is_livereg_required || is_livereg_sgpr_required || is_cfg_required)
                     {
-                        ExtractISA(device_name, config, isa_size_bytes, isa_buffer, is_isa_size_detected, should_detect_isa_size);
+                        ExtractISA(device_name, config, isa_size_bytes, isa_buffer, is_isa_size_detected, should_detect_isa_size, estimated_cycles);
                     }
                     if (is_il_required)
                     {
@@ -445,7 +464,7 @@ void KcCliCommanderDX::RunCompileCommands(const Config& config, LoggingCallBackF
                     if (is_statistics_required)
                     {
                         is_isa_size_detected = ExtractStats(
-                            device_name, config, should_detect_isa_size, isa_buffer, is_isa_size_detected, isa_size_bytes, analysis_data, device_analysis_data);
+                            device_name, config, should_detect_isa_size, isa_buffer, is_isa_size_detected, isa_size_bytes, estimated_cycles, analysis_data, device_analysis_data);
                     }
                 }
             }
@@ -586,7 +605,10 @@ bool KcCliCommanderDX::WriteAnalysisDataForDX(const Config&
                 output << ad.num_threads_per_group_z << csv_separator;
 
                 // ISA size.
-                output << ad.isa_size;
+                output << ad.isa_size << csv_separator;
+
+                // Estimated cycles.
+                output << beKA::AnalysisData::na_or(ad.estimated_cycles);
 
                 output << std::endl;
             }
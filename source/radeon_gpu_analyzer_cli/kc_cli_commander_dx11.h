@@ -36,11 +36,12 @@ private:
                                 const std::string&                     analysis_file, 
                                 std::stringstream&                     log);
     void ExtractISA(const std::string& device_name, const Config& config, size_t& isa_size_in_bytes,
-                    std::string isa_buffer, bool& is_isa_size_detected, bool& should_detect_isa_size);
+                    std::string isa_buffer, bool& is_isa_size_detected, bool& should_detect_isa_size, uint64_t& estimated_cycles);
     void ExtractIL(const std::string& device_name, const Config& config);
     bool ExtractStats(const  std::string& device_name, const Config& config, bool should_detect_isa_size, std::string isa_buffer,
                       bool                             is_isa_size_detected,
                       size_t                           isa_size_in_bytes,
+                      uint64_t                         estimated_cycles,
                       std::vector<beKA::AnalysisData>& analysis_data,
                       std::vector<std::string>&        device_analysis_data);
     void ExtractBinary(const std::string& device_name, const Config& config);
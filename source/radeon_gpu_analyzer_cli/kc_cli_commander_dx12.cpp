@@ -8,6 +8,7 @@
 
 // C++.
 #include <cassert>
+#include <fstream>
 #include <memory>
 
 // Infra.
@@ -30,6 +31,7 @@
 #include "radeon_gpu_analyzer_cli/kc_cli_string_constants.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_binary_parser.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_binary_raytracing.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 
 // Device info.
 #include "DeviceInfoUtils.h"
@@ -84,6 +86,21 @@ const char* kStrDefaultDxrShaderModel = "lib_6_3";
 
 static const char* kAmdgpuDisShaderIdentifiersToken = "_amdgpu_shader_identifiers";
 
+// Append the cycles that are estimated from the given ISA file to the given resource usage statistics file.
+static void AppendEstimatedCycles(const Config& config, const std::string& device, const std::string& isa_file, const std::string& stats_file)
+{
+    std::string isa_text;
+    if (!isa_file.empty() && !stats_file.empty() && KcUtils::ReadTextFile(isa_file, isa_text, nullptr))
+    {
+        uint64_t      estimated_cycles = KcUtils::EstimateIsaCycles(config, isa_text, device, true);
+        std::ofstream stats_stream(stats_file, std::ofstream::app);
+        if (stats_stream.is_open())
+        {
+            stats_stream << "    - estimatedCycles                           = " << beKA::AnalysisData::na_or(estimated_cycles) << std::endl;
+        }
+    }
+}
+
 // Update the user provided configuration if necessary.
 static void UpdateConfig(const Config& user_input, Config& updated_config)
 {
@@ -301,7 +318,10 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
                         was_asic_list_auto_generated = true;
 
                         std::set<std::string> device_list;
-                        is_ok = GetDX12DriverAsicList(config, device_list);
+                        {
+                            KcTrace::Span span(kTraceCategoryPhase, "Device resolution");
+                            is_ok = GetDX12DriverAsicList(config, device_list);
+                        }
                         assert(is_ok);
                         assert(!device_list.empty());
                         if (is_ok && !device_list.empty())
@@ -357,6 +377,7 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
                             {
                                 // Mark as covered.
                                 completed_targets.push_back(target);
+                                KcTrace::Context trace_context(target);
 
                                 std::string out_text;
                                 std::string error_msg;
@@ -366,7 +387,10 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
                                 if (is_dxr)
                                 {
                                     std::vector<RgDxrPipelineResults> output_mapping;
-                                    rc = dx12_backend_.CompileDXRPipeline(config_updated, target, out_text, output_mapping, error_msg);
+                                    {
+                                        KcTrace::Span span(kTraceCategoryPhase, "Pipeline compile");
+                                        rc = dx12_backend_.CompileDXRPipeline(config_updated, target, out_text, output_mapping, error_msg);
+                                    }
                                     is_ok = (rc == kBeStatusSuccess);
                                     assert(is_ok);
                                     if (!out_text.empty())
@@ -426,8 +450,11 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
                                     BeVkPipelineFiles stats_files;
                                     std::string binary_file;
                                     
-                                    rc = dx12_backend_.CompileDX12Pipeline(
-                                        config_updated, target, out_text, error_msg, isa_files, amdil_files, stats_files, binary_file);
+                                    {
+                                        KcTrace::Span span(kTraceCategoryPhase, "Pipeline compile");
+                                        rc = dx12_backend_.CompileDX12Pipeline(
+                                            config_updated, target, out_text, error_msg, isa_files, amdil_files, stats_files, binary_file);
+                                    }
 
                                     is_ok = (rc == kBeStatusSuccess);
                                     if (!out_text.empty())
@@ -483,6 +510,17 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
                                         if (is_success)
                                         {
                                             std::cout << kStrInfoSuccess << std::endl;
+
+                                            // Add the estimated cycles to the resource usage statistics.
+                                            if (!config_updated.analysis_file.empty())
+                                            {
+                                                KcTrace::Span span(kTraceCategoryPhase, "Statistics");
+                                                for (int stage = 0; stage < BePipelineStage::kCount; stage++)
+                                                {
+                                                    AppendEstimatedCycles(config_updated, target, isa_files[stage], stats_files[stage]);
+                                                }
+                                            }
+
                                             if (!config_updated.livereg_analysis_file.empty() 
                                                 || !config_updated.sgpr_livereg_analysis_file.empty()
                                                 || !config_updated.inst_cfg_file.empty() 
@@ -495,6 +533,7 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
 
                                                 if (!config_updated.livereg_analysis_file.empty())
                                                 {
+                                                    KcTrace::Span span(kTraceCategoryPhase, "Liveness");
                                                     // Live register analysis files.
                                                     for (int stage = 0; stage < BePipelineStage::kCount; stage++)
                                                     {
@@ -505,6 +544,7 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
 
                                                 if (!config_updated.sgpr_livereg_analysis_file.empty())
                                                 {
+                                                    KcTrace::Span span(kTraceCategoryPhase, "Liveness");
                                                     // Live register analysis files.
                                                     for (int stage = 0; stage < BePipelineStage::kCount; stage++)
                                                     {
@@ -514,6 +554,7 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
 
                                                 if (!config_updated.block_cfg_file.empty())
                                                 {
+                                                    KcTrace::Span span(kTraceCategoryPhase, "CFG");
                                                     // Per-block control-flow graphs.
                                                     for (int stage = 0; stage < BePipelineStage::kCount; stage++)
                                                     {
@@ -524,6 +565,7 @@ void KcCliCommanderDX12::RunCompileCommands(const Config& config, LoggingCallbac
 
                                                 if (!config_updated.inst_cfg_file.empty())
                                                 {
+                                                    KcTrace::Span span(kTraceCategoryPhase, "CFG");
                                                     // Per-instruction control-flow graphs.
                                                     for (int stage = 0; stage < BePipelineStage::kCount; stage++)
                                                     {
@@ -625,6 +667,7 @@ bool KcCliCommanderDX12::DisassembleElfBinary(const Config&      config,
                                               std::string&       error_msg,
                                               bool               verbose) const
 {
+    KcTrace::Span span(kTraceCategoryPhase, "Disassembly");
     if (verbose)
     {
         std::cout << kStrInfoDisassemblingBinaryElfContainer << pipeline_elf << "... "
@@ -10,6 +10,7 @@
 #include <utility>
 #include <sstream>
 #include <algorithm>
+#include <filesystem>
 #include <iterator>
 #include <cassert>
 #include <regex>
@@ -31,6 +32,7 @@
 #include "radeon_gpu_analyzer_cli/kc_utils_lightning.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_lightning.h"
 #include "radeon_gpu_analyzer_cli/kc_statistics_device_props.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 
 // Backend.
 #include "radeon_gpu_analyzer_backend/be_program_builder_lightning.h"
@@ -84,6 +86,14 @@ kLcDeviceInfoToClangDeviceMap = { {"ellesmere", "polaris10"},
                                   {"baffin",    "polaris11"},
                                   {"gfx804",    "gfx803"} };
 
+// Get the LLVM target that the given DeviceInfo device is compiled for. The devices with the same LLVM target get identical builds.
+static std::string GetLlvmTarget(const std::string& device)
+{
+    auto llvm_device = std::find_if(kLcLlvmTargetsToDeviceInfoTargets.cbegin(), kLcLlvmTargetsToDeviceInfoTargets.cend(),
+                                    [&](const std::pair<std::string, std::string>& d) { return (d.second == device); });
+    return (llvm_device != kLcLlvmTargetsToDeviceInfoTargets.cend() ? llvm_device->first : device);
+}
+
 // Default target for Lightning Compiler (the latest supported target).
 static const std::string  kLcDefaultTarget = kLcLlvmTargetsToDeviceInfoTargets.rbegin()->second;
 
@@ -160,14 +170,22 @@ static std::vector<std::string> GetExtraTargetList()
     return device_list;
 }
 
-static void  LogPreStep(const std::string& msg, const std::string& device = "")
+// True if the requested outputs need the ISA text of the kernels.
+// The statistics alone are read from the code object metadata and symbol table, so they do not need the disassembly.
+static bool IsDisassemblyRequired(const Config& config)
+{
+    return !config.isa_file.empty() || config.is_parsed_isa_required || !config.livereg_analysis_file.empty() ||
+           !config.sgpr_livereg_analysis_file.empty() || !config.block_cfg_file.empty() || !config.inst_cfg_file.empty();
+}
+
+static void  LogPreStep(std::ostream& out, const std::string& msg, const std::string& device = "")
 {
-    std::cout << msg << device << "... ";
+    out << msg << device << "... ";
 }
 
-static void  LogResult(bool result)
+static void  LogResult(std::ostream& out, bool result)
 {
-    std::cout << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
+    out << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
 }
 
 beKA::beStatus KcCLICommanderLightning::Init(const Config& config, LoggingCallbackFunction log_callback)
@@ -244,11 +262,17 @@ bool KcCLICommanderLightning::InitRequestedAsicListLC(const Config& config)
     return !targets_.empty();
 }
 
-bool KcCLICommanderLightning::Compile(const Config& config)
+bool KcCLICommanderLightning::Compile(const Config& config, const std::function<void(const std::string&)>& on_device_compiled)
 {
     bool ret = false;
 
-    if (InitRequestedAsicListLC(config))
+    bool is_device_resolved = false;
+    {
+        KcTrace::Span span(kTraceCategoryPhase, "Device resolution");
+        is_device_resolved = InitRequestedAsicListLC(config);
+    }
+
+    if (is_device_resolved)
     {
         beKA::beStatus result = beKA::kBeStatusSuccess;
 
@@ -266,20 +290,13 @@ bool KcCLICommanderLightning::Compile(const Config& config)
         switch (config.mode)
         {
         case beKA::kModeOpenclOffline:
-            result = CompileOpenCL(config, options);
+            result = CompileOpenCL(config, options, on_device_compiled);
             break;
         default:
             result = beKA::kBeStatusGeneralFailed;
             break;
         }
 
-        // Generate CSV files with parsed ISA if required.
-        if (config.is_parsed_isa_required && (result == beKA::kBeStatusSuccess || targets_.size() > 1))
-        {
-            KcUtilsLightning util(output_metadata_, should_print_cmd_, log_callback_);
-            result = util.ParseIsaFilesToCSV(config.is_line_numbers_required) ? beKA::beStatus::kBeStatusSuccess : beKA::beStatus::kBeStatusParseIsaToCsvFailed;
-        }
-
         ret = (result == beKA::kBeStatusSuccess);
     }
 
@@ -359,55 +376,143 @@ bool KcCLICommanderLightning::PrintAsicList(const Config&)
     return ret;
 }
 
-// Print warnings reported by compiler to stderr.
-static bool DumpCompilerWarnings(const std::string& compiler_std_err)
+beKA::beStatus KcCLICommanderLightning::CompileOpenCL(const Config&                                   config,
+                                                      const OpenCLOptions&                            ocl_options,
+                                                      const std::function<void(const std::string&)>& on_device_compiled)
 {
-    bool found_warnings = compiler_std_err.find(kCompilerWarningToken) != std::string::npos;
-    if (found_warnings)
+    beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
+
+    // The devices are reported in the order of the selected devices.
+    const std::vector<std::string> devices(ocl_options.selected_devices.begin(), ocl_options.selected_devices.end());
+    std::vector<beKA::beStatus>     device_statuses(devices.size(), beKA::beStatus::kBeStatusSuccess);
+    std::vector<RgClOutputMetadata> device_output_metadata(devices.size());
+
+    // The devices with the same LLVM target are compiled and disassembled once: the first device of each target builds it,
+    // and the other devices wait for its build and reuse it. The devices are started in order, so the first device of a target
+    // is always running or done when the other devices wait for it.
+    std::vector<std::unique_ptr<std::promise<TargetBuild>>> target_build_promises(devices.size());
+    std::vector<std::shared_future<TargetBuild>>            shared_builds(devices.size());
+    std::map<std::string, size_t>                           first_target_devices;
+    for (size_t i = 0; i < devices.size(); i++)
     {
-        RgLog::stdErr << std::endl << compiler_std_err << std::endl;
+        auto first_target_device = first_target_devices.emplace(GetLlvmTarget(devices[i]), i);
+        if (!first_target_device.second)
+        {
+            std::unique_ptr<std::promise<TargetBuild>>& promise = target_build_promises[first_target_device.first->second];
+            if (promise == nullptr)
+            {
+                promise = std::make_unique<std::promise<TargetBuild>>();
+                shared_builds[first_target_device.first->second] = promise->get_future().share();
+            }
+            shared_builds[i] = shared_builds[first_target_device.first->second];
+        }
     }
-    return found_warnings;
+
+    // The command lines of the launched processes are printed by the processes themselves, so they would be
+    // mixed up if the devices were compiled concurrently.
+    const int jobs = (should_print_cmd_ ? 1 : config.jobs);
+
+    InitBuildCache(config);
+
+    KcDeviceExecutor::Run(
+        devices.size(),
+        jobs,
+        [&](size_t i, KcDeviceOutput& output) {
+            const bool  is_first_target_device = (target_build_promises[i] != nullptr || !shared_builds[i].valid());
+            TargetBuild target_build;
+            device_statuses[i] = CompileOpenCLDevice(
+                config, ocl_options, devices[i], (is_first_target_device ? nullptr : &shared_builds[i]), device_output_metadata[i], output, target_build);
+            if (target_build_promises[i] != nullptr)
+            {
+                target_build_promises[i]->set_value(std::move(target_build));
+            }
+        },
+        [&](size_t i) {
+            output_metadata_.insert(device_output_metadata[i].begin(), device_output_metadata[i].end());
+            status = (device_statuses[i] == beKA::beStatus::kBeStatusSuccess ? status : device_statuses[i]);
+            if (on_device_compiled)
+            {
+                on_device_compiled(devices[i]);
+            }
+        });
+
+    return status;
 }
 
-beKA::beStatus KcCLICommanderLightning::CompileOpenCL(const Config& config, const OpenCLOptions& ocl_options)
+beKA::beStatus KcCLICommanderLightning::CompileOpenCLDevice(const Config&                          config,
+                                                            const OpenCLOptions&                   ocl_options,
+                                                            const std::string&                     device,
+                                                            const std::shared_future<TargetBuild>* shared_build,
+                                                            RgClOutputMetadata&                    output_metadata,
+                                                            KcDeviceOutput&                        output,
+                                                            TargetBuild&                           target_build)
 {
-    beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
-
-    // Run LC compiler for all requested devices
-    for (const std::string& device : ocl_options.selected_devices)
+    KcTrace::Context trace_context(device);
+    std::string  error_text;
+    LogPreStep(output.Out(), kStrInfoCompiling, device);
+    std::string  bin_filename;
+
+    // Adjust the device name if necessary.
+    std::string clang_device = device;
+    if (kLcDeviceInfoToClangDeviceMap.count(clang_device) > 0)
     {
-        std::string  error_text;
-        LogPreStep(kStrInfoCompiling, device);
-        std::string  bin_filename;
+        clang_device = kLcDeviceInfoToClangDeviceMap.at(device);
+    }
 
-        // Adjust the device name if necessary.
-        std::string clang_device = device;
-        if (kLcDeviceInfoToClangDeviceMap.count(clang_device) > 0)
-        {
-            clang_device = kLcDeviceInfoToClangDeviceMap.at(device);
-        }
+    // Update the binary and ISA names for current device.
+    beKA::beStatus current_status = AdjustBinaryFileName(config, device, bin_filename);
 
-        // Update the binary and ISA names for current device.
-        beKA::beStatus current_status = AdjustBinaryFileName(config, device, bin_filename);
+    // If file with the same name exist, delete it.
+    KcUtils::DeleteFile(bin_filename);
 
-        // If file with the same name exist, delete it.
-        KcUtils::DeleteFile(bin_filename);
+    // Prepare a list of source files.
+    std::vector<std::string>  src_filenames;
+    for (const std::string& input_file : config.input_files)
+    {
+        src_filenames.push_back(input_file);
+    }
 
-        // Prepare a list of source files.
-        std::vector<std::string>  src_filenames;
-        for (const std::string& input_file : config.input_files)
-        {
-            src_filenames.push_back(input_file);
-        }
+    if (current_status != beKA::beStatus::kBeStatusSuccess)
+    {
+        // Skip the device without failing the compilation of the other devices.
+        KcUtilsLightning::LogErrorStatus(current_status, error_text, output.Out());
+        return beKA::beStatus::kBeStatusSuccess;
+    }
 
-        if (current_status != beKA::beStatus::kBeStatusSuccess)
+    // Reuse the build of another device with the same LLVM target.
+    std::string         cache_key;
+    KcBuildCache::Entry build;
+    bool                is_cached = false;
+    bool                is_shared = false;
+    if (shared_build != nullptr)
+    {
+        KcTrace::Span      span(kTraceCategoryPhase, "Shared target build");
+        const TargetBuild& shared_target_build = shared_build->get();
+        std::error_code    error;
+        is_shared = shared_target_build.is_ok &&
+                    std::filesystem::copy_file(shared_target_build.bin_filename, bin_filename, std::filesystem::copy_options::overwrite_existing, error);
+        if (is_shared)
         {
-            KcUtilsLightning::LogErrorStatus(current_status, error_text);
-            continue;
+            build = shared_target_build.build;
         }
+    }
 
+    // Look the build up in the build cache.
+    if (!is_shared && build_cache_ != nullptr)
+    {
+        KcTrace::Span span(kTraceCategoryPhase, "Build cache lookup");
+        cache_key = GetBuildCacheKey(ocl_options, src_filenames, clang_device);
+        is_cached = !cache_key.empty() && build_cache_->Load(cache_key, bin_filename, build);
+    }
+
+    if (is_cached || is_shared)
+    {
+        error_text = build.compiler_output;
+    }
+    else
+    {
         // Compile source to binary.
+        KcTrace::Span span(kTraceCategoryPhase, "Front-end compile");
         current_status = BeProgramBuilderLightning::CompileOpenCLToBinary(compiler_paths_,
                                                                          ocl_options,
                                                                          src_filenames,
@@ -415,66 +520,79 @@ beKA::beStatus KcCLICommanderLightning::CompileOpenCL(const Config& config, cons
                                                                          clang_device,
                                                                          should_print_cmd_,
                                                                          error_text);
-        LogResult(current_status == beKA::beStatus::kBeStatusSuccess);
+        build.compiler_output = error_text;
+    }
+    LogResult(output.Out(), current_status == beKA::beStatus::kBeStatusSuccess);
+    const bool was_disassembled = build.is_disassembled;
 
-        if (current_status == beKA::beStatus::kBeStatusSuccess)
+    if (current_status == beKA::beStatus::kBeStatusSuccess)
+    {
+        // If "dump IL" option is passed to the Lightning Compiler, it should dump the IL to stderr.
+        if (ocl_options.should_dump_il)
         {
-            // If "dump IL" option is passed to the Lightning Compiler, it should dump the IL to stderr.
-            if (ocl_options.should_dump_il)
-            {
-                current_status = DumpIL(config, ocl_options, src_filenames, device, clang_device, error_text);
-            }
-            else if (config.is_warnings_required)
-            {
-                // Pass the warnings printed by the compiler to RGA stderr.
-                DumpCompilerWarnings(error_text);
-            }
+            current_status = DumpIL(config, ocl_options, src_filenames, device, clang_device, error_text);
+        }
+        else if (config.is_warnings_required && error_text.find(kCompilerWarningToken) != std::string::npos)
+        {
+            // Pass the warnings printed by the compiler to RGA stderr.
+            output.Err(error_text);
+        }
 
-            // Disassemble binary to ISA text.
-            if (!config.isa_file.empty() ||
-                !config.analysis_file.empty() ||
-                !config.livereg_analysis_file.empty() || 
-                !config.sgpr_livereg_analysis_file.empty() || 
-                !config.block_cfg_file.empty() ||
-                !config.inst_cfg_file.empty())
+        // Disassemble binary to ISA text.
+        if (IsDisassemblyRequired(config))
+        {
+            LogPreStep(output.Out(), kStrInfoExtractingIsaForDevice, device);
+            current_status = DisassembleBinary(bin_filename, config.isa_file, clang_device, device, config.function, config.is_line_numbers_required,
+                                               output_metadata, build, error_text);
+            LogResult(output.Out(), current_status == beKA::beStatus::kBeStatusSuccess);
+
+            assert(current_status == beKA::beStatus::kBeStatusSuccess);
+            // Propagate the binary file name to the Output Files Metadata table.
+            if (current_status == beKA::beStatus::kBeStatusSuccess)
             {
-                LogPreStep(kStrInfoExtractingIsaForDevice, device);
-                current_status = DisassembleBinary(bin_filename, config.isa_file, clang_device, device, config.function, config.is_line_numbers_required, error_text);
-                LogResult(current_status == beKA::beStatus::kBeStatusSuccess);
-
-                assert(current_status == beKA::beStatus::kBeStatusSuccess);
-                // Propagate the binary file name to the Output Files Metadata table.
-                if (current_status == beKA::beStatus::kBeStatusSuccess)
+                for (auto& output_md_node : output_metadata)
                 {
-                    for (auto& output_md_node : output_metadata_)
+                    const std::string& md_device = output_md_node.first.first;
+                    if (md_device == device)
                     {
-                        const std::string& md_device = output_md_node.first.first;
-                        if (md_device == device)
-                        {
-                            output_md_node.second.bin_file = bin_filename;
-                            output_md_node.second.is_bin_file_temp = config.binary_output_file.empty();
-                        }
+                        output_md_node.second.bin_file = bin_filename;
+                        output_md_node.second.is_bin_file_temp = config.binary_output_file.empty();
                     }
                 }
             }
-            else
-            {
-                output_metadata_[{device, ""}] = RgOutputFiles(RgaEntryType::kOpenclKernel, "", bin_filename);
-            }
+        }
+        else if (!config.analysis_file.empty())
+        {
+            // Statistics only: skip the disassembly.
+            current_status = AddBinaryKernels(config, bin_filename, device, output_metadata, error_text);
         }
         else
         {
-            // Store error status to the metadata.
-            RgOutputFiles output(RgaEntryType::kOpenclKernel, "", "");
-            output.status = false;
-            output_metadata_[{device, ""}] = output;
+            output_metadata[{device, ""}] = RgOutputFiles(RgaEntryType::kOpenclKernel, "", bin_filename);
         }
 
-        status = (current_status == beKA::beStatus::kBeStatusSuccess ? status : current_status);
-        KcUtilsLightning::LogErrorStatus(current_status, error_text);
+        // Store the new build, or the disassembly of a cached build, in the build cache.
+        if (!cache_key.empty() && (!is_cached || (build.is_disassembled && !was_disassembled)))
+        {
+            build_cache_->Store(cache_key, bin_filename, build);
+        }
+
+        // The binary can be reused by the other devices with the same LLVM target. If its disassembly failed, they disassemble it themselves.
+        target_build.is_ok        = true;
+        target_build.bin_filename = bin_filename;
+        target_build.build        = build;
+    }
+    else
+    {
+        // Store error status to the metadata.
+        RgOutputFiles output_files(RgaEntryType::kOpenclKernel, "", "");
+        output_files.status = false;
+        output_metadata[{device, ""}] = output_files;
     }
 
-    return status;
+    KcUtilsLightning::LogErrorStatus(current_status, error_text, output.Out());
+
+    return current_status;
 }
 
 beKA::beStatus KcCLICommanderLightning::DisassembleBinary(const std::string& binFileName,
@@ -483,24 +601,45 @@ beKA::beStatus KcCLICommanderLightning::DisassembleBinary(const std::string& bin
                                                           const std::string& rgaDevice,
                                                           const std::string& kernel,
                                                           bool lineNumbers,
+                                                          RgClOutputMetadata& output_metadata,
+                                                          KcBuildCache::Entry& build,
                                                           std::string& error_text)
 {
     std::string  out_isa_text;
     std::vector<std::string>  kernel_names;
-    beKA::beStatus status = BeProgramBuilderLightning::DisassembleBinary(compiler_paths_.bin, binFileName,
-        clangDevice, lineNumbers, should_print_cmd_, out_isa_text, error_text);
+    beKA::beStatus status = beKA::kBeStatusSuccess;
 
-    if (status == beKA::kBeStatusSuccess)
+    if (build.is_disassembled)
     {
-        status = BeProgramBuilderLightning::ExtractKernelNames(compiler_paths_.bin, binFileName,
-            should_print_cmd_, kernel_names);
+        // The disassembly was loaded from the build cache.
+        out_isa_text = build.isa_text;
+        kernel_names = build.kernel_names;
     }
     else
     {
-        // Store error status to the metadata.
-        RgOutputFiles output(RgaEntryType::kOpenclKernel, "", "");
-        output.status = false;
-        output_metadata_[{rgaDevice, ""}] = output;
+        KcTrace::Span span(kTraceCategoryPhase, "Disassembly");
+        status = BeProgramBuilderLightning::DisassembleBinary(compiler_paths_.bin, binFileName,
+            clangDevice, lineNumbers, should_print_cmd_, out_isa_text, error_text);
+
+        if (status == beKA::kBeStatusSuccess)
+        {
+            status = BeProgramBuilderLightning::ExtractKernelNames(compiler_paths_.bin, binFileName,
+                should_print_cmd_, kernel_names);
+        }
+        else
+        {
+            // Store error status to the metadata.
+            RgOutputFiles output(RgaEntryType::kOpenclKernel, "", "");
+            output.status = false;
+            output_metadata[{rgaDevice, ""}] = output;
+        }
+
+        if (status == beKA::kBeStatusSuccess)
+        {
+            build.is_disassembled = true;
+            build.isa_text        = out_isa_text;
+            build.kernel_names    = kernel_names;
+        }
     }
 
     if (status == beKA::kBeStatusSuccess)
@@ -512,7 +651,8 @@ beKA::beStatus KcCLICommanderLightning::DisassembleBinary(const std::string& bin
         }
         else
         {
-            status = SplitISA(binFileName, out_isa_text, userIsaFileName, rgaDevice, kernel, kernel_names) ?
+            KcTrace::Span span(kTraceCategoryPhase, "ISA split/reduce");
+            status = SplitISA(binFileName, out_isa_text, userIsaFileName, rgaDevice, kernel, kernel_names, output_metadata) ?
                          beKA::kBeStatusSuccess : beKA::kBeStatusLightningSplitIsaFailed;
         }
     }
@@ -520,53 +660,122 @@ beKA::beStatus KcCLICommanderLightning::DisassembleBinary(const std::string& bin
     return status;
 }
 
-void KcCLICommanderLightning::RunCompileCommands(const Config& config, LoggingCallbackFunction)
+beKA::beStatus KcCLICommanderLightning::AddBinaryKernels(const Config&       config,
+                                                         const std::string&  bin_filename,
+                                                         const std::string&  device,
+                                                         RgClOutputMetadata& output_metadata,
+                                                         std::string&        error_text)
 {
-    bool is_multiple_devices = (config.asics.size() > 1);
-    bool status = Compile(config);
-    KcUtilsLightning util(output_metadata_, should_print_cmd_, log_callback_);
-    
-    // Extract Statistics if required.
-    if (status || is_multiple_devices)
+    std::vector<std::string> kernel_names;
+    beKA::beStatus           status = BeProgramBuilderLightning::ExtractKernelNames(compiler_paths_.bin, bin_filename, should_print_cmd_, kernel_names);
+    if (status != beKA::kBeStatusSuccess)
     {
-        util.ExtractStatistics(config);
+        // Store error status to the metadata.
+        RgOutputFiles output(RgaEntryType::kOpenclKernel, "", "");
+        output.status = false;
+        output_metadata[{device, ""}] = output;
     }
-
-    // Block post-processing until quality of analysis engine improves when processing llvm disassembly.
-    bool is_livereg_required = !config.livereg_analysis_file.empty();
-    if (is_livereg_required)
+    else if (!config.function.empty() && std::find(kernel_names.cbegin(), kernel_names.cend(), config.function) == kernel_names.cend())
+    {
+        error_text = std::string(kStrErrorOpenclOfflineCannotFindKernel) + config.function;
+        status     = beKA::kBeStatusWrongKernelName;
+    }
+    else
     {
-        // Perform Live Registers analysis if required.
-        if (status || is_multiple_devices)
+        // Without the disassembly, the ISA sizes of the kernels are taken from the symbol table.
+        SymbolSizeMap symbol_sizes;
+        BeProgramBuilderLightning::ExtractSymbolSizes(compiler_paths_.bin, bin_filename, should_print_cmd_, symbol_sizes);
+        for (const std::string& kernel_name : kernel_names)
         {
-            util.PerformLiveVgprAnalysis(config);
+            if (config.function.empty() || config.function == kernel_name)
+            {
+                RgOutputFiles output_files(RgaEntryType::kOpenclKernel, "", bin_filename);
+                auto          symbol_size              = symbol_sizes.find(kernel_name);
+                output_files.code_size                 = (symbol_size != symbol_sizes.end() ? symbol_size->second : -1);
+                output_files.is_bin_file_temp          = config.binary_output_file.empty();
+                output_metadata[{device, kernel_name}] = output_files;
+            }
         }
     }
 
-    bool is_sgpr_livereg_required = !config.sgpr_livereg_analysis_file.empty();
-    if (is_sgpr_livereg_required)
+    return status;
+}
+
+void KcCLICommanderLightning::InitBuildCache(const Config& config)
+{
+    build_cache_.reset();
+    if (!config.cache_dir.empty())
     {
-        // Perform Live Registers analysis if required.
-        if (status || is_multiple_devices)
+        const uint64_t                kBytesPerMegabyte = 1024 * 1024;
+        std::unique_ptr<KcBuildCache> build_cache = std::make_unique<KcBuildCache>(config.cache_dir, std::max(config.cache_size, 0) * kBytesPerMegabyte);
+
+        // The compiler version is a part of the cache keys, so that the cached builds of other compilers are not used.
+        if (build_cache->Init() &&
+            BeProgramBuilderLightning::GetCompilerVersion(beKA::RgaMode::kModeOpenclOffline, compiler_paths_.bin, should_print_cmd_, compiler_version_) ==
+                beKA::kBeStatusSuccess)
         {
-            util.PerformLiveSgprAnalysis(config);
+            build_cache_ = std::move(build_cache);
+        }
+        else
+        {
+            RgLog::stdErr << kStrWarningCannotUseBuildCache << config.cache_dir << std::endl;
         }
     }
+}
 
-    bool is_cfg_required = (!config.block_cfg_file.empty() || !config.inst_cfg_file.empty());
-    if (is_cfg_required)
+std::string KcCLICommanderLightning::GetBuildCacheKey(const OpenCLOptions&            ocl_options,
+                                                      const std::vector<std::string>& src_filenames,
+                                                      const std::string&              clang_device) const
+{
+    std::vector<std::string> key_parts = {compiler_version_, clang_device};
+    std::string              options;
+    bool                     ret = (BeProgramBuilderLightning::GetOpenCLCompilerOptions(compiler_paths_, ocl_options, clang_device, options) == beKA::kBeStatusSuccess);
+    key_parts.push_back(options);
+
+    // The sources are preprocessed for the device, so that the content of the included files is a part of the key,
+    // as well as the code that is only compiled for some of the devices.
+    std::stringstream preprocessor_args;
+    for (const std::string& option : ocl_options.opencl_compile_options)
     {
-        // Extract Control Flow Graph.
-        if (status || is_multiple_devices)
-        {
-            util.ExtractCFG(config);
-        }
+        preprocessor_args << option << " ";
+    }
+    for (const std::string& include_path : ocl_options.include_paths)
+    {
+        preprocessor_args << "-I" << KcUtils::Quote(include_path) << " ";
+    }
+    for (const std::string& def : ocl_options.defines)
+    {
+        size_t assignment_offset = def.find('=');
+        preprocessor_args << "-D" << (assignment_offset == std::string::npos ? def : def.substr(0, assignment_offset + 1) + KcUtils::Quote(def.substr(assignment_offset + 1))) << " ";
     }
 
-    // Extract CodeObj metadata if required.
-    if ((status || is_multiple_devices) && !config.metadata_file.empty())
+    for (auto iter = src_filenames.cbegin(); ret && iter != src_filenames.cend(); ++iter)
     {
-        util.ExtractMetadata(compiler_paths_, config.metadata_file);
+        std::string preprocessed_src;
+        ret = (BeProgramBuilderLightning::PreprocessOpencl(compiler_paths_, *iter, preprocessor_args.str(), should_print_cmd_, preprocessed_src, clang_device) ==
+               beKA::kBeStatusSuccess);
+        key_parts.push_back(preprocessed_src);
+    }
+
+    return (ret ? KcBuildCache::ComputeKey(key_parts) : "");
+}
+
+void KcCLICommanderLightning::RunCompileCommands(const Config& config, LoggingCallbackFunction)
+{
+    bool is_multiple_devices = (config.asics.size() > 1);
+
+    // The post-processing steps of each device (parsed ISA, statistics, live register analysis, CFG and metadata)
+    // are added to the task graph as soon as the device is compiled, so they overlap the compilation of the other devices.
+    // The tasks only write files. Their console output is held and printed in order once all of them are done.
+    // The graph takes its threads from the threads that the devices share, so that at most "jobs" threads are busy at once.
+    KcTaskGraph              post_processing_graph(should_print_cmd_ ? 1 : config.jobs, true);
+    KcPostProcessorLightning post_processor(config, compiler_paths_, should_print_cmd_, log_callback_);
+    bool status = Compile(config, [&](const std::string& device) { post_processor.AddDeviceTasks(device, output_metadata_, post_processing_graph); });
+    post_processing_graph.Wait();
+
+    if (status || is_multiple_devices)
+    {
+        post_processor.Report(std::cout);
     }
 }
 
@@ -695,108 +904,123 @@ static void  FilterISALine(std::string & isa_line)
 // The Lightning Compiler may append useless code for some library functions to the ISA disassembly.
 // This function eliminates such code.
 // It also also removes unreferenced labels and non-standard instruction suffixes.
-bool  KcCLICommanderLightning::ReduceISA(const std::string& binFile, IsaMap& kernel_isa_text)
+bool  KcCLICommanderLightning::ReduceISA(const std::string& binFile, IsaMap& kernel_isa_text, SymbolSizeMap& symbol_sizes)
 {
     bool  ret = false;
+
+    // Read the symbol table of the binary once for all of the kernels.
+    BeProgramBuilderLightning::ExtractSymbolSizes(compiler_paths_.bin, binFile, should_print_cmd_, symbol_sizes);
+
     for (auto& kernel_isa : kernel_isa_text)
     {
-        int  code_size = BeProgramBuilderLightning::GetKernelCodeSize(compiler_paths_.bin, binFile, kernel_isa.first, should_print_cmd_);
+        auto  symbol = symbol_sizes.find(kernel_isa.first);
+        int   code_size = (symbol != symbol_sizes.end() ? symbol->second : -1);
         assert(code_size != -1);
         if (code_size != -1)
         {
-            // Copy ISA lines to new stream. Stop when found an instruction with address > codeSize.
-            std::stringstream  old_isa, new_isa, address_stream;
-            old_isa.str(kernel_isa.second);
-            std::string  isa_line;
-            int  address, address_offset = -1;
-
-            // Gather the target labels of all branch instructions.
-            std::unordered_map<std::string, bool>  branch_targets;
-            branch_targets.clear();
-            GatherBranchTargets(old_isa, branch_targets);
-
-            // Skip lines before the actual ISA code.
-            while (std::getline(old_isa, isa_line) && new_isa << isa_line << std::endl &&
-                isa_line.find(kLcKernelIsaHeader3) == std::string::npos) {}
-
-            while (std::getline(old_isa, isa_line))
+            ret = ReduceKernelISA(code_size, kernel_isa.second) || ret;
+        }
+    }
+
+    return ret;
+}
+
+bool  KcCLICommanderLightning::ReduceKernelISA(int code_size, std::string& kernel_isa_text)
+{
+    bool  ret = false;
+
+    // Copy ISA lines to new stream. Stop when found an instruction with address > codeSize.
+    std::stringstream  old_isa, new_isa, address_stream;
+    old_isa.str(kernel_isa_text);
+    std::string  isa_line;
+    int  address, address_offset = -1;
+
+    // Gather the target labels of all branch instructions.
+    std::unordered_map<std::string, bool>  branch_targets;
+    GatherBranchTargets(old_isa, branch_targets);
+
+    // Skip lines before the actual ISA code.
+    while (std::getline(old_isa, isa_line) && new_isa << isa_line << std::endl &&
+        isa_line.find(kLcKernelIsaHeader3) == std::string::npos) {}
+
+    while (std::getline(old_isa, isa_line))
+    {
+        // Add the ISA line to the new ISA text if it's not an unreferenced label.
+        if (!IsUnreferencedLabel(isa_line, branch_targets))
+        {
+            if (isa_line.find(" <") != 0)
             {
-                // Add the ISA line to the new ISA text if it's not an unreferenced label.
-                if (!IsUnreferencedLabel(isa_line, branch_targets))
+                size_t branch_label_start = isa_line.find(" <") + 2;
+                size_t branch_label_end = isa_line.find(">:");
+                size_t address_end = isa_line.find_first_of(" ");
+                if (branch_label_end != std::string::npos)
                 {
-                    if (isa_line.find(" <") != 0)
-                    {
-                        size_t branch_label_start = isa_line.find(" <") + 2;
-                        size_t branch_label_end = isa_line.find(">:");
-                        size_t address_end = isa_line.find_first_of(" ");
-                        if (branch_label_end != std::string::npos)
-                        {
-                            // If this is a branch label, reformat and add the string so the RGA GUI recognizes the syntax.
-                            std::string new_branch_label = isa_line.substr(0, address_end + 1) + isa_line.substr(branch_label_start, branch_label_end - (branch_label_start)) + ":";
-                            new_isa << new_branch_label << std::endl;
-                        }
-                        else
-                        {
-                            // Add the line as is.
-                            new_isa << isa_line << std::endl;
-                        }
-                    }
+                    // If this is a branch label, reformat and add the string so the RGA GUI recognizes the syntax.
+                    std::string new_branch_label = isa_line.substr(0, address_end + 1) + isa_line.substr(branch_label_start, branch_label_end - (branch_label_start)) + ":";
+                    new_isa << new_branch_label << std::endl;
                 }
-
-                // Check if this instruction is the last one and we have to stop here.
-                // Skip comment lines generated by disassembler.
-                if (isa_line.find(kIsaCommentStartToken, 0) != 0)
+                else
                 {
+                    // Add the line as is.
+                    new_isa << isa_line << std::endl;
+                }
+            }
+        }
+
+        // Check if this instruction is the last one and we have to stop here.
+        // Skip comment lines generated by disassembler.
+        if (isa_line.find(kIsaCommentStartToken, 0) != 0)
+        {
 
-                    // Format of ISA disassembly instruction (64-bit and 32-bit):
-                    //  s_load_dwordx2 s[0:1], s[6:7], 0x0     // 000000001108: C0060003 00000000
-                    //  v_add_u32 v0, s8, v0                   // 000000001134: 68000008
-                    //                                            `-- addr --'
-                    size_t  address_start, address_end;
+            // Format of ISA disassembly instruction (64-bit and 32-bit):
+            //  s_load_dwordx2 s[0:1], s[6:7], 0x0     // 000000001108: C0060003 00000000
+            //  v_add_u32 v0, s8, v0                   // 000000001134: 68000008
+            //                                            `-- addr --'
+            size_t  address_start, address_end;
 
-                    FilterISALine(isa_line);
+            FilterISALine(isa_line);
 
-                    if ((address_start = isa_line.find(kIsaInstructionAddressStartToken)) != std::string::npos &&
-                        (address_end = isa_line.find(kIsaInstructionAddressEndToken, address_start)) != std::string::npos)
+            if ((address_start = isa_line.find(kIsaInstructionAddressStartToken)) != std::string::npos &&
+                (address_end = isa_line.find(kIsaInstructionAddressEndToken, address_start)) != std::string::npos)
+            {
+                address_start += (kIsaInstructionAddressStartToken.size());
+                address_stream.str(isa_line.substr(address_start, address_end - address_start));
+                address_stream.clear();
+                int inst_size = (isa_line.size() - address_end < kIsaInstruction64BitCodeTextSize) ? kIsaInstruction32BitBytes : kIsaInstruction64BitBytes;
+                if (address_stream >> std::hex >> address)
+                {
+                    // address_offset is the binary address of 1st instruction.
+                    address_offset = (address_offset == -1 ? address : address_offset);
+                    if ((address - address_offset + inst_size) >= code_size)
                     {
-                        address_start += (kIsaInstructionAddressStartToken.size());
-                        address_stream.str(isa_line.substr(address_start, address_end - address_start));
-                        address_stream.clear();
-                        int inst_size = (isa_line.size() - address_end < kIsaInstruction64BitCodeTextSize) ? kIsaInstruction32BitBytes : kIsaInstruction64BitBytes;
-                        if (address_stream >> std::hex >> address)
-                        {
-                            // address_offset is the binary address of 1st instruction.
-                            address_offset = (address_offset == -1 ? address : address_offset);
-                            if ((address - address_offset + inst_size) >= code_size)
-                            {
-                                ret = true;
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            break;
-                        }
+                        ret = true;
+                        break;
                     }
                 }
-            }
-
-            if (ret)
-            {
-                kernel_isa.second = new_isa.str();
+                else
+                {
+                    break;
+                }
             }
         }
     }
 
+    if (ret)
+    {
+        kernel_isa_text = new_isa.str();
+    }
+
     return ret;
 }
 
 bool KcCLICommanderLightning::SplitISA(const std::string& bin_file, const std::string& isa_text,
                                        const std::string& user_isa_file_name, const std::string& device,
-                                       const std::string& kernel, const std::vector<std::string>& kernel_names)
+                                       const std::string& kernel, const std::vector<std::string>& kernel_names,
+                                       RgClOutputMetadata& output_metadata)
 {
     // kernelIsaTextMap maps kernel name --> kernel ISA text.
     IsaMap kernel_isa_text_map;
+    SymbolSizeMap symbol_sizes;
     bool ret, is_isa_file_temp = user_isa_file_name.empty();
 
     // Replace labels of format "address   <label_name>:" with
@@ -811,7 +1035,7 @@ bool KcCLICommanderLightning::SplitISA(const std::string& bin_file, const std::s
     ret = SplitISAText(new_isa_text, kernel_names, kernel_isa_text_map);
 
     // Eliminate the useless code.
-    ret = ret && ReduceISA(bin_file, kernel_isa_text_map);
+    ret = ret && ReduceISA(bin_file, kernel_isa_text_map, symbol_sizes);
 
     // Store per-kernel ISA texts to separate files and launch livereg tool for each file.
     if (ret)
@@ -845,7 +1069,11 @@ bool KcCLICommanderLightning::SplitISA(const std::string& bin_file, const std::s
                 {
                     RgOutputFiles  outFiles = RgOutputFiles(RgaEntryType::kOpenclKernel, isa_filename.asASCIICharArray());
                     outFiles.is_isa_file_temp = is_isa_file_temp;
-                    output_metadata_[{device, isa_text_map_item.first}] = outFiles;
+
+                    // Keep the code size of the kernel for the statistics, so that the symbol table is not read again.
+                    auto symbol_size = symbol_sizes.find(function_name);
+                    outFiles.code_size = (symbol_size != symbol_sizes.end() ? symbol_size->second : -1);
+                    output_metadata[{device, isa_text_map_item.first}] = outFiles;
                 }
             }
             else
@@ -863,7 +1091,7 @@ bool KcCLICommanderLightning::SplitISA(const std::string& bin_file, const std::s
 
 bool KcCLICommanderLightning::SplitISAText(const std::string& isa_text,
                                            const std::vector<std::string>& kernel_names,
-                                           IsaMap& kernel_isa_map) const
+                                           IsaMap& kernel_isa_map)
 {
     bool  status = true;
     const std::string  LABEL_NAME_END_TOKEN = ":\n";
@@ -990,6 +1218,7 @@ bool KcCLICommanderLightning::RunPostCompileSteps(const Config& config)
 
     if (!config.session_metadata_file.empty())
     {
+        KcTrace::Span span(kTraceCategoryPhase, "Session metadata");
         ret = GenerateSessionMetadata(config, compiler_paths_);
         if (!ret)
         {
@@ -1004,6 +1233,11 @@ bool KcCLICommanderLightning::RunPostCompileSteps(const Config& config)
     return ret;
 }
 
+void KcCLICommanderLightning::GetOutputFiles(RgClOutputMetadata& output_files) const
+{
+    output_files = output_metadata_;
+}
+
 beKA::beStatus KcCLICommanderLightning::DumpIL(const Config&                   config,
                                          const OpenCLOptions&            user_options,
                                          const std::vector<std::string>& src_file_names,
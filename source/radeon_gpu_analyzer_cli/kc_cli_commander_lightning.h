@@ -11,10 +11,14 @@
 #include <string>
 #include <set>
 #include <memory>
+#include <functional>
+#include <future>
 #include <unordered_map>
 
 // Local.
+#include "radeon_gpu_analyzer_cli/kc_build_cache.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_commander.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
 
 // Backend.
 #include "source/radeon_gpu_analyzer_backend/be_program_builder_lightning.h"
@@ -46,6 +50,9 @@ public:
     // Perform post-compile actions.
     bool RunPostCompileSteps(const Config& config) override;
 
+    // Get the output files of the last compilation, mapped by {device, kernel}.
+    void GetOutputFiles(RgClOutputMetadata& output_files) const override;
+
     // Initialize the Commander object.
     beKA::beStatus Init(const Config& config, LoggingCallbackFunction log_callback);
 
@@ -56,27 +63,83 @@ public:
     // Get the list of names of supported targets in DeviceInfo format.
     static bool GetSupportedTargets(std::set<std::string>& targets, bool printCmd = false);
 
-private:
     // Map  device or kernel name <--> kernel ISA text.
     typedef std::unordered_map<std::string, std::string>  IsaMap;
 
+    // Split ISA text into separate per-kernel ISA fragments. The fragments are returned in the
+    // "kernelIsaTextMap" map.
+    static bool  SplitISAText(const std::string& isa_text,
+                              const std::vector<std::string>& kernel_names,
+                              IsaMap& kernel_isa_text_map);
+
+    // Remove the code that follows the first "code_size" bytes of the kernel, unreferenced labels and
+    // non-standard instruction suffixes from the ISA disassembly of a single kernel.
+    // Returns false if the end of the kernel code was not found in the disassembly.
+    static bool  ReduceKernelISA(int code_size, std::string& kernel_isa_text);
+
+private:
     // Identify the devices requested by user.
     bool  InitRequestedAsicListLC(const Config& config);
 
     // Perform requested compilation.
-    bool  Compile(const Config& config);
+    // "on_device_compiled" is called with each device once its outputs are in the output metadata, in the order of the devices.
+    bool  Compile(const Config& config, const std::function<void(const std::string&)>& on_device_compiled);
 
     // Perform OpenCL compilation.
-    beKA::beStatus CompileOpenCL(const Config& config, const OpenCLOptions& ocl_options);
+    // The devices are compiled concurrently on up to "config.jobs" worker threads.
+    beKA::beStatus CompileOpenCL(const Config&                                   config,
+                                 const OpenCLOptions&                            ocl_options,
+                                 const std::function<void(const std::string&)>& on_device_compiled);
+
+    // The build of an LLVM target, which is shared by the requested devices that resolve to the same target.
+    struct TargetBuild
+    {
+        bool                is_ok = false;
+        std::string         bin_filename;  ///< The binary of the device that built the target.
+        KcBuildCache::Entry build;         ///< The compiler output and the disassembly.
+    };
+
+    // Compile and disassemble the program for a single device.
+    // If "shared_build" is not null, the build of another device with the same LLVM target is reused instead of
+    // compiling and disassembling again (unless that build failed). The build of the device is returned in "target_build".
+    // The output files of the device are stored in "output_metadata", and the console output is written to "output".
+    beKA::beStatus CompileOpenCLDevice(const Config&                          config,
+                                       const OpenCLOptions&                   ocl_options,
+                                       const std::string&                     device,
+                                       const std::shared_future<TargetBuild>* shared_build,
+                                       RgClOutputMetadata&                    output_metadata,
+                                       KcDeviceOutput&                        output,
+                                       TargetBuild&                           target_build);
+
+    // Set up the build cache in "config.cache_dir", if specified.
+    void InitBuildCache(const Config& config);
+
+    // Compute the key of the build cache for compiling the given sources for the given device.
+    // Returns an empty string if the key cannot be computed, for example if the sources cannot be preprocessed.
+    std::string GetBuildCacheKey(const OpenCLOptions&            ocl_options,
+                                 const std::vector<std::string>& src_filenames,
+                                 const std::string&              clang_device) const;
 
     // Disassemble binary file.
     // The disassembled ISA text are be divided into per-kernel parts and stored in separate files.
     // The names of ISA files are generated based on provided user ISA file name.
+    // The names of the generated ISA files are stored in "output_metadata".
+    // If "build" already holds the disassembly (loaded from the build cache), it is used instead of disassembling
+    // the binary. Otherwise, the disassembly is stored in "build".
     beKA::beStatus DisassembleBinary(const std::string& bin_filename,
                                      const std::string& user_isa_filename,
                                      const std::string& clang_device,
                                      const std::string& rga_device,
-                                const std::string& kernel, bool line_numbers, std::string& error_text);
+                                const std::string& kernel, bool line_numbers, RgClOutputMetadata& output_metadata,
+                                KcBuildCache::Entry& build, std::string& error_text);
+
+    // Add the kernels of the binary to "output_metadata" without disassembling it, for the outputs that do not need
+    // the ISA text (the statistics are read from the code object metadata and symbol table).
+    beKA::beStatus AddBinaryKernels(const Config&       config,
+                                    const std::string&  bin_filename,
+                                    const std::string&  device,
+                                    RgClOutputMetadata& output_metadata,
+                                    std::string&        error_text);
 
     // Add the device name to the output file name provided in "outFileName" string.
     beKA::beStatus AdjustBinaryFileName(const Config& config,
@@ -84,19 +147,15 @@ private:
                                    std::string&        bin_filename);
 
     // Split ISA text into separate per-kernel ISA fragments and store them into separate files.
-    // Puts the names of generated ISA files into output metadata (kcCLICommander::m_outputMetadata).
+    // Puts the names of generated ISA files into "output_metadata".
     bool  SplitISA(const std::string& bin_file, const std::string& isa_text,
                    const std::string& user_isa_filename, const std::string& device,
-                   const std::string& kernel, const std::vector<std::string>& kernel_names);
-
-    // Split ISA text into separate per-kernel ISA fragments. The fragments are returned in the
-    // "kernelIsaTextMap" map.
-    bool  SplitISAText(const std::string& isa_text,
-                       const std::vector<std::string>& kernel_names,
-                       IsaMap& kernel_isa_text_map) const;
+                   const std::string& kernel, const std::vector<std::string>& kernel_names,
+                   RgClOutputMetadata& output_metadata);
 
     // Remove unused code from the ISA disassembly.
-    bool  ReduceISA(const std::string& bin_file, IsaMap& kernel_isa_texts);
+    // The sizes of the symbols of the binary, which are used to find the end of each kernel, are returned in "symbol_sizes".
+    bool  ReduceISA(const std::string& bin_file, IsaMap& kernel_isa_texts, SymbolSizeMap& symbol_sizes);
 
     // Dump IL file.
     beKA::beStatus DumpIL(const Config&             config,
@@ -122,6 +181,12 @@ private:
 
     // Specifies whether the "-#" option (print commands) is enabled.
     bool  should_print_cmd_;
+
+    // The cache of compiled code objects (null if the cache is not used).
+    std::unique_ptr<KcBuildCache> build_cache_;
+
+    // The version reported by the compiler, which is a part of the build cache keys.
+    std::string  compiler_version_;
 };
 
 #endif // RGA_RADEONGPUANALYZERCLI_SRC_KC_CLI_COMMANDER_LIGHTNING_H_
@@ -20,7 +20,9 @@
 // Local.
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_opengl.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_string_constants.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
 #include "radeon_gpu_analyzer_cli/kc_statistics_parser_opengl.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 #include "radeon_gpu_analyzer_cli/kc_utils.h"
 #include "radeon_gpu_analyzer_backend/be_utils.h"
 
@@ -50,6 +52,14 @@ static const std::set<std::string> kUnsupportedDevicesOpengl = {"gfx900",
                                                                 "gfx1034",
                                                                 "gfx1035"};
 
+// The build of the pipeline for a single device.
+struct OpenglDeviceBuild
+{
+    std::string       device;
+    OpenglOptions     gl_options;
+    std::stringstream log_msg;
+};
+
 void KcCliCommanderOpenGL::GlcStatsToString(const beKA::AnalysisData& stats, std::stringstream& serialized_stats)
 {
     serialized_stats << "Statistics:" << std::endl;
@@ -61,6 +71,7 @@ void KcCliCommanderOpenGL::GlcStatsToString(const beKA::AnalysisData& stats, std
     serialized_stats << "    - AVAILABLE_VGPRs                         = 256" << std::endl;
     serialized_stats << "    - AVAILABLE_SGPRs                         = 106" << std::endl;
     serialized_stats << "    - ISA_SIZE                                = " << stats.isa_size << std::endl;
+    serialized_stats << "    - ESTIMATED_CYCLES                        = " << beKA::AnalysisData::na_or(stats.estimated_cycles) << std::endl;
 }
 
 bool KcCliCommanderOpenGL::WriteTextFile(const gtString& filename, const std::string& content)
@@ -83,16 +94,30 @@ bool KcCliCommanderOpenGL::WriteTextFile(const gtString& filename, const std::st
     return ret;
 }
 
-void KcCliCommanderOpenGL::CreateStatisticsFile(const gtString&         statistics_file,
-                                 const Config&           ,
-                                 const std::string&      device,
-                                 IStatisticsParser&      stats_parser,
-                                 LoggingCallbackFunction )
+void KcCliCommanderOpenGL::CreateStatisticsFile(const gtString&                        statistics_file,
+                                                const gtString&                        isa_file,
+                                                const Config&                          config,
+                                                const std::string&                     device,
+                                                const std::map<std::string, uint64_t>& isa_estimated_cycles,
+                                                IStatisticsParser&                     stats_parser,
+                                                LoggingCallbackFunction )
 {
     // Parse the backend statistics.
     beKA::AnalysisData statistics;
     stats_parser.ParseStatistics(device, statistics_file, statistics);
 
+    // Take the cycles that were estimated when the ISA was converted to CSV, or estimate them from the ISA.
+    std::string isa_text;
+    auto        estimated_cycles = isa_estimated_cycles.find(isa_file.asASCIICharArray());
+    if (estimated_cycles != isa_estimated_cycles.end())
+    {
+        statistics.estimated_cycles = estimated_cycles->second;
+    }
+    else if (!isa_file.isEmpty() && KcUtils::ReadTextFile(isa_file.asASCIICharArray(), isa_text, nullptr))
+    {
+        statistics.estimated_cycles = KcUtils::EstimateIsaCycles(config, isa_text, device, false);
+    }
+
     // Delete the older statistics file.
     DeleteFile(statistics_file);
 
@@ -162,6 +187,18 @@ bool KcCliCommanderOpenGL::PrintAsicList(const Config&)
 }
 
 // Helper function to remove unnecessary file paths.
+// The output of the device that the calling thread compiles for.
+static thread_local std::ostream* device_output_stream = nullptr;
+
+// Logging callback that writes the message to the output of the device that the calling thread compiles for.
+static void LogToDeviceOutput(const std::string& msg)
+{
+    if (device_output_stream != nullptr)
+    {
+        *device_output_stream << msg;
+    }
+}
+
 static bool GenerateRenderingPipelineOutputPaths(const Config& config, const std::string& base_output_filename, const std::string& default_suffix,
                                                  const std::string& default_ext, const std::string& device, BeProgramPipeline& pipeline_to_adjust)
 {
@@ -392,135 +429,192 @@ void KcCliCommanderOpenGL::RunCompileCommands(const Config& config, LoggingCallb
 
         if (!should_abort)
         {
-            InitRequestedAsicList(config.asics, config.mode, supported_devices_cache_, target_devices, false);
+            {
+                KcTrace::Span span(kTraceCategoryPhase, "Device resolution");
+                InitRequestedAsicList(config.asics, config.mode, supported_devices_cache_, target_devices, false);
+            }
 
             // Sort the targets.
             std::set<std::string, decltype(&BeUtils::DeviceNameLessThan)> sorted_unique_names(target_devices.begin(),
                 target_devices.end(), BeUtils::DeviceNameLessThan);
 
+            // Prepare the build options for each of the devices.
+            // Each device gets its own temp directory, so that the outputs of the compiler cannot collide.
+            std::vector<OpenglDeviceBuild> device_builds;
             for (const std::string& device : sorted_unique_names)
             {
-                if (!should_abort && kUnsupportedDevicesOpengl.find(device) == kUnsupportedDevicesOpengl.end())
+                if (kUnsupportedDevicesOpengl.find(device) == kUnsupportedDevicesOpengl.end())
                 {
-                    // Generate the output message.
-                    log_msg << kStrInfoCompiling << device << "... ";
+                    OpenglDeviceBuild device_build;
+                    device_build.device     = device;
+                    device_build.gl_options = gl_options;
+                    OpenglOptions& device_options = device_build.gl_options;
 
-                    gtString device_gt_str;
-                    device_gt_str << device.c_str();
+                    // Generate the output message.
+                    device_build.log_msg << kStrInfoCompiling << device << "... ";
 
                     // Set the target device info for the backend.
-                    gl_options.device_name = device;
+                    device_options.device_name = device;
+                    status = KcUtils::CreateDeviceTempDir(device, device_options.temp_dir);
 
                     // Adjust the output file names to the device and shader type.
                     if (is_isa_required)
                     {
-                        gl_options.is_amd_isa_disassembly_required = true;
+                        device_options.is_amd_isa_disassembly_required = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameIsaDisassembly(config.isa_file, device);
-                        status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, "", kStrDefaultExtensionIsa, device, gl_options.isa_disassembly_output_files);
+                        status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, "", kStrDefaultExtensionIsa, device, device_options.isa_disassembly_output_files);
                     }
 
                     if (is_il_required)
                     {
-                        gl_options.is_il_disassembly_required = true;
+                        device_options.is_il_disassembly_required = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameIlDisassembly(config.il_file, device);
-                        status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, "", kStrDefaultExtensionAmdil, device, gl_options.il_disassembly_output_files);
+                        status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, "", kStrDefaultExtensionAmdil, device, device_options.il_disassembly_output_files);
                     }
 
                     if (is_livereg_analysis_required)
                     {
-                        gl_options.is_livereg_required = true;
+                        device_options.is_livereg_required = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameLivereg(config.livereg_analysis_file, device);
                         status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, kStrDefaultExtensionLivereg,
-                            kStrDefaultExtensionText, device, gl_options.livereg_output_files);
+                            kStrDefaultExtensionText, device, device_options.livereg_output_files);
                     }
 
                     if (is_livereg_sgpr_analysis_required)
                     {
-                        gl_options.is_livereg_sgpr_required  = true;
+                        device_options.is_livereg_sgpr_required  = true;
                         std::string adjustedIsaFileName     = KcUtils::AdjustBaseFileNameLiveregSgpr(config.sgpr_livereg_analysis_file, device);
                         status &= GenerateRenderingPipelineOutputPaths(
-                            config, adjustedIsaFileName, kStrDefaultExtensionLiveregSgpr, kStrDefaultExtensionText, device, gl_options.livereg_sgpr_output_files);
+                            config, adjustedIsaFileName, kStrDefaultExtensionLiveregSgpr, kStrDefaultExtensionText, device, device_options.livereg_sgpr_output_files);
                     }
 
                     if (is_block_cfg_required)
                     {
-                        gl_options.is_cfg_required = true;
+                        device_options.is_cfg_required = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameCfg(config.block_cfg_file, device);
                         status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, KC_STR_DEFAULT_CFG_SUFFIX,
-                                                                       kStrDefaultExtensionDot, device, gl_options.cfg_output_files);
+                                                                       kStrDefaultExtensionDot, device, device_options.cfg_output_files);
                     }
 
                     if (is_inst_cfg_required)
                     {
-                        gl_options.is_cfg_required = true;
+                        device_options.is_cfg_required = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameCfg(config.inst_cfg_file, device);
                         status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, KC_STR_DEFAULT_CFG_SUFFIX,
-                                                                       kStrDefaultExtensionDot, device, gl_options.cfg_output_files);
+                                                                       kStrDefaultExtensionDot, device, device_options.cfg_output_files);
                     }
 
                     if (is_stats_required)
                     {
-                        gl_options.is_stats_required = true;
+                        device_options.is_stats_required = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameStats(config.analysis_file, device);
                         status &= GenerateRenderingPipelineOutputPaths(config, adjustedIsaFileName, kStrDefaultExtensionStats,
-                                                                       kStrDefaultExtensionText, device, gl_options.stats_output_files);
+                                                                       kStrDefaultExtensionText, device, device_options.stats_output_files);
                     }
 
                     if (is_isa_binary)
                     {
-                        gl_options.is_pipeline_binary_required  = true;
+                        device_options.is_pipeline_binary_required  = true;
                         std::string adjustedIsaFileName = KcUtils::AdjustBaseFileNameBinary(config.binary_output_file, device);
                         KcUtils::ConstructOutputFileName(adjustedIsaFileName, "", kStrDefaultExtensionBin,
-                                                         "", device, gl_options.program_binary_filename);
+                                                         "", device, device_options.program_binary_filename);
                     }
 
                     if (!status)
                     {
-                        log_msg << kStrErrorFailedToAdjustFileName << std::endl;
+                        log_msg << device_build.log_msg.str() << kStrErrorFailedToAdjustFileName << std::endl;
+                        KcUtils::DeleteDeviceTempDir(device_options.temp_dir);
                         should_abort = true;
                         break;
                     }
 
+                    device_builds.push_back(std::move(device_build));
+                }
+            }
+
+            // Compile the devices concurrently. The messages are printed in the order of the devices.
+            KcDeviceExecutor::Run(
+                device_builds.size(),
+                (config.print_process_cmd_line ? 1 : config.jobs),
+                [&](size_t i, KcDeviceOutput& output) {
+                    const std::string& device         = device_builds[i].device;
+                    OpenglOptions&     device_options = device_builds[i].gl_options;
+                    KcTrace::Context   trace_context(device);
+
+                    // All of the messages of the device are written to its output, so that they are printed in the order of the devices.
+                    std::ostream&           device_log_msg  = output.Out();
+                    LoggingCallbackFunction device_callback = LogToDeviceOutput;
+                    device_output_stream                    = &device_log_msg;
+                    device_log_msg << device_builds[i].log_msg.str();
+
+                    gtString device_gt_str;
+                    device_gt_str << device.c_str();
+
+
                     // A handle for canceling the build. Currently not in use.
                     bool should_cancel = false;
 
                     // Compile.
                     gtString glc_output;
                     gtString build_log;
-                    beKA::beStatus buildStatus = ogl_builder_->Compile(gl_options, should_cancel, config.print_process_cmd_line, glc_output, build_log);
+                    beKA::beStatus buildStatus = beKA::beStatus::kBeStatusGeneralFailed;
+                    {
+                        KcTrace::Span span(kTraceCategoryPhase, "Pipeline compile");
+                        buildStatus = ogl_builder_->Compile(device_options, should_cancel, config.print_process_cmd_line, glc_output, build_log);
+                    }
                     if (buildStatus == beKA::beStatus::kBeStatusSuccess)
                     {
-                        log_msg << kStrInfoSuccess << std::endl;
+                        device_log_msg << kStrInfoSuccess << std::endl;
 
                         // Parse and replace the statistics files.
                         beKA::AnalysisData statistics;
                         KcOpenGLStatisticsParser stats_parser;
 
                         // Parse ISA and write it to a csv file if required.
+                        // The cycles of the statistics are estimated from the same parse.
+                        std::map<std::string, uint64_t> isa_estimated_cycles;
                         if (is_isa_required && config.is_parsed_isa_required)
                         {
+                            KcTrace::Span      span(kTraceCategoryPhase, "CSV conversion");
                             std::string  isa_text, parsed_isa_text, parsed_isa_file_name;
-                            BeProgramPipeline  isa_files = gl_options.isa_disassembly_output_files;
+                            bool         is_parsed = false;
+                            BeProgramPipeline  isa_files = device_options.isa_disassembly_output_files;
                             for (const gtString& isa_filename : { isa_files.compute_shader, isa_files.fragment_shader, isa_files.geometry_shader,
                                                                 isa_files.tessellation_control_shader, isa_files.tessellation_evaluation_shader, isa_files.vertex_shader })
                             {
                                 if (!isa_filename.isEmpty())
                                 {
-                                    if ((status = KcUtils::ReadTextFile(isa_filename.asASCIICharArray(), isa_text, log_callback_)) == true)
+                                    if ((is_parsed = KcUtils::ReadTextFile(isa_filename.asASCIICharArray(), isa_text, device_callback)) == true)
                                     {
-                                        status = (BeProgramBuilder::ParseIsaToCsv(isa_text, device, parsed_isa_text) == beKA::beStatus::kBeStatusSuccess);
-                                        if (status)
+                                        if (is_stats_required)
+                                        {
+                                            uint64_t& estimated_cycles = isa_estimated_cycles[isa_filename.asASCIICharArray()];
+                                            estimated_cycles           = static_cast<uint64_t>(-1);
+                                            is_parsed                  = (BeProgramBuilder::ParseIsaToCsv(isa_text,
+                                                                                         device,
+                                                                                         parsed_isa_text,
+                                                                                         false,
+                                                                                         false,
+                                                                                         config.loop_iteration_count,
+                                                                                         config.loop_iteration_overrides,
+                                                                                         estimated_cycles) == beKA::beStatus::kBeStatusSuccess);
+                                        }
+                                        else
                                         {
-                                            status = KcUtils::GetParsedISAFileName(isa_filename.asASCIICharArray(), parsed_isa_file_name);
+                                            is_parsed = (BeProgramBuilder::ParseIsaToCsv(isa_text, device, parsed_isa_text) == beKA::beStatus::kBeStatusSuccess);
                                         }
-                                        if (status)
+                                        if (is_parsed)
                                         {
-                                            status = KcUtils::WriteTextFile(parsed_isa_file_name, parsed_isa_text, log_callback_);
+                                            is_parsed = KcUtils::GetParsedISAFileName(isa_filename.asASCIICharArray(), parsed_isa_file_name);
+                                        }
+                                        if (is_parsed)
+                                        {
+                                            is_parsed = KcUtils::WriteTextFile(parsed_isa_file_name, parsed_isa_text, device_callback);
                                         }
                                     }
-                                    if (!status)
+                                    if (!is_parsed)
                                     {
-                                        log_msg << kStrErrorOpenglIsaParsingFailed << std::endl;
+                                        device_log_msg << kStrErrorOpenglIsaParsingFailed << std::endl;
                                     }
                                 }
                             }
@@ -528,248 +622,237 @@ void KcCliCommanderOpenGL::RunCompileCommands(const Config& config, LoggingCallb
 
                         if (is_stats_required)
                         {
+                            KcTrace::Span span(kTraceCategoryPhase, "Statistics");
                             if (is_vert_shader_present)
                             {
-                                CreateStatisticsFile(gl_options.stats_output_files.vertex_shader, config, device, stats_parser, callback);
+                                CreateStatisticsFile(device_options.stats_output_files.vertex_shader, device_options.isa_disassembly_output_files.vertex_shader, config, device, isa_estimated_cycles, stats_parser, device_callback);
                             }
 
                             if (is_tess_control_shader_present)
                             {
-                                CreateStatisticsFile(gl_options.stats_output_files.tessellation_control_shader, config, device, stats_parser, callback);
+                                CreateStatisticsFile(device_options.stats_output_files.tessellation_control_shader, device_options.isa_disassembly_output_files.tessellation_control_shader, config, device, isa_estimated_cycles, stats_parser, device_callback);
                             }
 
                             if (is_tess_evaluation_shader_present)
                             {
-                                CreateStatisticsFile(gl_options.stats_output_files.tessellation_evaluation_shader, config, device, stats_parser, callback);
+                                CreateStatisticsFile(device_options.stats_output_files.tessellation_evaluation_shader, device_options.isa_disassembly_output_files.tessellation_evaluation_shader, config, device, isa_estimated_cycles, stats_parser, device_callback);
                             }
 
                             if (is_geom_shader_present)
                             {
-                                CreateStatisticsFile(gl_options.stats_output_files.geometry_shader, config, device, stats_parser, callback);
+                                CreateStatisticsFile(device_options.stats_output_files.geometry_shader, device_options.isa_disassembly_output_files.geometry_shader, config, device, isa_estimated_cycles, stats_parser, device_callback);
                             }
 
                             if (is_frag_shader_present)
                             {
-                                CreateStatisticsFile(gl_options.stats_output_files.fragment_shader, config, device, stats_parser, callback);
+                                CreateStatisticsFile(device_options.stats_output_files.fragment_shader, device_options.isa_disassembly_output_files.fragment_shader, config, device, isa_estimated_cycles, stats_parser, device_callback);
                             }
 
                             if (is_comp_shader_present)
                             {
-                                CreateStatisticsFile(gl_options.stats_output_files.compute_shader, config, device, stats_parser, callback);
+                                CreateStatisticsFile(device_options.stats_output_files.compute_shader, device_options.isa_disassembly_output_files.compute_shader, config, device, isa_estimated_cycles, stats_parser, device_callback);
                             }
                         }
 
                         // Perform live register analysis if required.
                         if (is_livereg_analysis_required)
                         {
+                            KcTrace::Span span(kTraceCategoryPhase, "Liveness");
                             if (is_vert_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.vertex_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.vertex_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_output_files.vertex_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line);
+                                                                     device_options.livereg_output_files.vertex_shader,
+                                                                     device_callback);
                             }
 
                             if (is_tess_control_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.tessellation_control_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.tessellation_control_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_output_files.tessellation_control_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line);
+                                                                     device_options.livereg_output_files.tessellation_control_shader,
+                                                                     device_callback);
                             }
 
                             if (is_tess_evaluation_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.tessellation_evaluation_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.tessellation_evaluation_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_output_files.tessellation_evaluation_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line);
+                                                                     device_options.livereg_output_files.tessellation_evaluation_shader,
+                                                                     device_callback);
                             }
 
                             if (is_geom_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.geometry_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.geometry_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_output_files.geometry_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line);
+                                                                     device_options.livereg_output_files.geometry_shader,
+                                                                     device_callback);
                             }
 
                             if (is_frag_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.fragment_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.fragment_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_output_files.fragment_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line);
+                                                                     device_options.livereg_output_files.fragment_shader,
+                                                                     device_callback);
                             }
 
                             if (is_comp_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.compute_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.compute_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_output_files.compute_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line);
+                                                                     device_options.livereg_output_files.compute_shader,
+                                                                     device_callback);
                             }
                         }
 
                         // Perform live register analysis (sgpr) if required.
                         if (is_livereg_sgpr_analysis_required)
                         {
+                            KcTrace::Span span(kTraceCategoryPhase, "Liveness");
                             if (is_vert_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.vertex_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.vertex_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_sgpr_output_files.vertex_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line, true);
+                                                                     device_options.livereg_sgpr_output_files.vertex_shader,
+                                                                     device_callback, true);
                             }
 
                             if (is_tess_control_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.tessellation_control_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.tessellation_control_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_sgpr_output_files.tessellation_control_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line, true);
+                                                                     device_options.livereg_sgpr_output_files.tessellation_control_shader,
+                                                                     device_callback, true);
                             }
 
                             if (is_tess_evaluation_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.tessellation_evaluation_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.tessellation_evaluation_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_sgpr_output_files.tessellation_evaluation_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line, true);
+                                                                     device_options.livereg_sgpr_output_files.tessellation_evaluation_shader,
+                                                                     device_callback, true);
                             }
 
                             if (is_geom_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.geometry_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.geometry_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_sgpr_output_files.geometry_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line, true);
+                                                                     device_options.livereg_sgpr_output_files.geometry_shader,
+                                                                     device_callback, true);
                             }
 
                             if (is_frag_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.fragment_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.fragment_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_sgpr_output_files.fragment_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line, true);
+                                                                     device_options.livereg_sgpr_output_files.fragment_shader,
+                                                                     device_callback, true);
                             }
 
                             if (is_comp_shader_present)
                             {
-                                KcUtils::PerformLiveRegisterAnalysis(gl_options.isa_disassembly_output_files.compute_shader,
+                                KcUtils::PerformLiveRegisterAnalysis(device_options.isa_disassembly_output_files.compute_shader,
                                                                      device_gt_str,
-                                                                     gl_options.livereg_sgpr_output_files.compute_shader,
-                                                                     callback,
-                                                                     config.print_process_cmd_line, true);
+                                                                     device_options.livereg_sgpr_output_files.compute_shader,
+                                                                     device_callback, true);
                             }
                         }
 
                         // Generate control flow graph if required.
                         if (is_block_cfg_required || is_inst_cfg_required)
                         {
+                            KcTrace::Span span(kTraceCategoryPhase, "CFG");
                             if (is_vert_shader_present)
                             {
-                                KcUtils::GenerateControlFlowGraph(gl_options.isa_disassembly_output_files.vertex_shader,
+                                KcUtils::GenerateControlFlowGraph(device_options.isa_disassembly_output_files.vertex_shader,
                                                                   device_gt_str,
-                                                                  gl_options.cfg_output_files.vertex_shader,
-                                                                  callback,
-                                                                  is_inst_cfg_required,
-                                                                  config.print_process_cmd_line);
+                                                                  device_options.cfg_output_files.vertex_shader,
+                                                                  device_callback,
+                                                                  is_inst_cfg_required);
                             }
 
                             if (is_tess_control_shader_present)
                             {
-                                KcUtils::GenerateControlFlowGraph(gl_options.isa_disassembly_output_files.tessellation_control_shader,
+                                KcUtils::GenerateControlFlowGraph(device_options.isa_disassembly_output_files.tessellation_control_shader,
                                                                   device_gt_str,
-                                                                  gl_options.cfg_output_files.tessellation_control_shader,
-                                                                  callback,
-                                                                  is_inst_cfg_required,
-                                                                  config.print_process_cmd_line);
+                                                                  device_options.cfg_output_files.tessellation_control_shader,
+                                                                  device_callback,
+                                                                  is_inst_cfg_required);
                             }
 
                             if (is_tess_control_shader_present)
                             {
-                                KcUtils::GenerateControlFlowGraph(gl_options.isa_disassembly_output_files.tessellation_evaluation_shader,
+                                KcUtils::GenerateControlFlowGraph(device_options.isa_disassembly_output_files.tessellation_evaluation_shader,
                                                                   device_gt_str,
-                                                                  gl_options.cfg_output_files.tessellation_evaluation_shader,
-                                                                  callback,
-                                                                  is_inst_cfg_required,
-                                                                  config.print_process_cmd_line);
+                                                                  device_options.cfg_output_files.tessellation_evaluation_shader,
+                                                                  device_callback,
+                                                                  is_inst_cfg_required);
                             }
 
                             if (is_geom_shader_present)
                             {
-                                KcUtils::GenerateControlFlowGraph(gl_options.isa_disassembly_output_files.geometry_shader,
+                                KcUtils::GenerateControlFlowGraph(device_options.isa_disassembly_output_files.geometry_shader,
                                                                   device_gt_str,
-                                                                  gl_options.cfg_output_files.geometry_shader,
-                                                                  callback,
-                                                                  is_inst_cfg_required,
-                                                                  config.print_process_cmd_line);
+                                                                  device_options.cfg_output_files.geometry_shader,
+                                                                  device_callback,
+                                                                  is_inst_cfg_required);
                             }
 
                             if (is_frag_shader_present)
                             {
-                                KcUtils::GenerateControlFlowGraph(gl_options.isa_disassembly_output_files.fragment_shader,
+                                KcUtils::GenerateControlFlowGraph(device_options.isa_disassembly_output_files.fragment_shader,
                                                                   device_gt_str,
-                                                                  gl_options.cfg_output_files.fragment_shader,
-                                                                  callback,
-                                                                  is_inst_cfg_required,
-                                                                  config.print_process_cmd_line);
+                                                                  device_options.cfg_output_files.fragment_shader,
+                                                                  device_callback,
+                                                                  is_inst_cfg_required);
                             }
 
                             if (is_comp_shader_present)
                             {
-                                KcUtils::GenerateControlFlowGraph(gl_options.isa_disassembly_output_files.compute_shader,
+                                KcUtils::GenerateControlFlowGraph(device_options.isa_disassembly_output_files.compute_shader,
                                                                   device_gt_str,
-                                                                  gl_options.cfg_output_files.compute_shader,
-                                                                  callback,
-                                                                  is_inst_cfg_required,
-                                                                  config.print_process_cmd_line);
+                                                                  device_options.cfg_output_files.compute_shader,
+                                                                  device_callback,
+                                                                  is_inst_cfg_required);
                             }
                         }
                     }
                     else
                     {
-                        log_msg << kStrInfoFailed << std::endl;
+                        device_log_msg << kStrInfoFailed << std::endl;
                         if (buildStatus == beKA::kBeStatusOpenglVirtualContextLaunchFailed)
                         {
-                            log_msg << kStrErrorCannotInvokeCompiler << std::endl;
+                            device_log_msg << kStrErrorCannotInvokeCompiler << std::endl;
                         }
                         else if (buildStatus == beKA::kBeStatusFailedOutputVerification)
                         {
-                            log_msg << kStrErrorOutputFileVerificationFailed << std::endl;
+                            device_log_msg << kStrErrorOutputFileVerificationFailed << std::endl;
                         }
                     }
 
                     // Delete temporary files
                     if (is_isa_required && config.isa_file.empty())
                     {
-                        KcUtils::DeletePipelineFiles(gl_options.isa_disassembly_output_files);
+                        KcUtils::DeletePipelineFiles(device_options.isa_disassembly_output_files);
                     }
 
                     // Notify the user about build errors if any.
                     if (!glc_output.isEmpty())
                     {
-                        log_msg << glc_output.asASCIICharArray() << std::endl;
+                        device_log_msg << glc_output.asASCIICharArray() << std::endl;
                     }
 
-                    // Print the message for the current device.
-                    callback(log_msg.str());
+                    device_output_stream = nullptr;
+                },
+                [](size_t) {
+                    // The messages were printed with the output of the device.
+                });
 
-                    // Clear the output stream for the next iteration.
-                    log_msg.str("");
-                }
+            for (const OpenglDeviceBuild& device_build : device_builds)
+            {
+                KcUtils::DeleteDeviceTempDir(device_build.gl_options.temp_dir);
             }
         }
     }
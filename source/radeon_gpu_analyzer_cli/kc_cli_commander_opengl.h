@@ -36,12 +36,16 @@ private:
     // Write glc stats to text output file.
     bool WriteTextFile(const gtString& filename, const std::string& content);
 
-    // Create glc stats file.
-    void CreateStatisticsFile(const gtString&         statistics_file,
-                                     const Config&           config,
-                                     const std::string&      device,
-                                     IStatisticsParser&      stats_parser,
-                                     LoggingCallbackFunction log_cb);
+    // Create glc stats file, with the cycles estimated from the given ISA file.
+    // "isa_estimated_cycles" holds the cycles that were estimated when the ISA files were converted to CSV, by the name of the ISA file.
+    // The ISA files that were not converted are parsed to estimate their cycles.
+    void CreateStatisticsFile(const gtString&                        statistics_file,
+                              const gtString&                        isa_file,
+                              const Config&                          config,
+                              const std::string&                     device,
+                              const std::map<std::string, uint64_t>& isa_estimated_cycles,
+                              IStatisticsParser&                     stats_parser,
+                              LoggingCallbackFunction                log_cb);
 
     // Delete the specified file.
     bool DeleteFile(const gtString& file_full_path);
@@ -14,6 +14,8 @@
 #include "radeon_gpu_analyzer_cli/kc_utils.h"
 #include "radeon_gpu_analyzer_cli/kc_statistics_parser_vulkan.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_vulkan.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 
 // Backend.
 #include "radeon_gpu_analyzer_backend/be_backend.h"
@@ -434,6 +436,17 @@ void AdjustRenderingPipelineOutputFileNames(const Config&                   conf
     {
         KcUtils::ConstructOutputFileName(config.binary_output_file, "", "bin", "", device, vulkan_options.pipeline_binary);
     }
+    else if (!vulkan_options.temp_dir.empty())
+    {
+        // Keep the temporary binary in the temp directory of the device, so that the devices can be compiled concurrently.
+        gtString temp_dir;
+        temp_dir << vulkan_options.temp_dir.c_str();
+        osFilePath temp_bin_path;
+        temp_bin_path.setFileDirectory(temp_dir);
+        temp_bin_path.setFileName(L"rga-temp-out");
+        temp_bin_path.setFileExtension(L"bin");
+        vulkan_options.pipeline_binary = temp_bin_path.asString().asASCIICharArray();
+    }
     else
     {
         vulkan_options.pipeline_binary = KcUtils::ConstructTempFileName("rga-temp-out", "bin");
@@ -663,6 +676,60 @@ void GetBeVkPipelineFileNames(const Config&           config,
     }
 }
 
+// The build of the pipeline for a single device.
+struct VkOfflineDeviceBuild
+{
+    std::string                        device;
+    VkOfflineOptions                   vulkan_options{beKA::RgaMode::kModeVkOffline};
+    beKA::beStatus                     status = kBeStatusGeneralFailed;
+    BeVkPipelineFiles                  spv_files;
+    BeVkPipelineFiles                  isa_files;
+    BeVkPipelineFiles                  stats_files;
+    BeVkPipelineWaveSizes              wave_sizes;
+    std::string                        amdgpu_dis_stdout;
+    std::map<std::string, std::string> shader_to_disassembly;
+    std::stringstream                  log_msg;
+};
+
+// Compile the pipeline for a single device with amdllpc and disassemble the pipeline binary.
+// This function can run concurrently for different devices, so it only updates "device_build".
+// The builder does not keep per-build state, so it can be shared by the devices.
+void BuildForDevice(BeProgramBuilderVkOffline& builder, const Config& config, VkOfflineDeviceBuild& device_build)
+{
+    KcTrace::Context trace_context(device_build.device);
+
+    // A handle for canceling the build. Currently not in use.
+    bool should_cancel = false;
+
+    // Compile.
+    gtString build_error_log;
+    {
+        KcTrace::Span span(kTraceCategoryPhase, "Pipeline compile");
+        device_build.status = builder.CompileWithAmdllpc(device_build.vulkan_options, should_cancel, config.print_process_cmd_line, build_error_log);
+    }
+    if (device_build.status == kBeStatusSuccess)
+    {
+        device_build.log_msg << kStrInfoSuccess << std::endl;
+
+        std::string error_msg;
+        GetBeVkPipelineFileNames(config, device_build.vulkan_options, device_build.spv_files, device_build.isa_files, device_build.stats_files);
+        device_build.wave_sizes.fill(beWaveSize::kWave64);
+
+        KcTrace::Span span(kTraceCategoryPhase, "Disassembly");
+        device_build.status = beProgramBuilderVulkan::AmdgpudisBinaryToDisassembly(device_build.vulkan_options.pipeline_binary,
+                                                                                   device_build.isa_files,
+                                                                                   config.print_process_cmd_line,
+                                                                                   device_build.amdgpu_dis_stdout,
+                                                                                   device_build.shader_to_disassembly,
+                                                                                   device_build.wave_sizes,
+                                                                                   error_msg);
+    }
+    else
+    {
+        LogErrorStatus(device_build.status, build_error_log, device_build.log_msg);
+    }
+}
+
 void KcCLICommanderVkOffline::RunCompileCommands(const Config& config, LoggingCallbackFunction callback)
 {
     log_callback_ = callback;
@@ -717,7 +784,10 @@ void KcCLICommanderVkOffline::RunCompileCommands(const Config& config, LoggingCa
 
         if (!should_abort)
         {
-            InitRequestedAsicList(config.asics, config.mode, supported_devices_cache_, target_devices_tmp, false);
+            {
+                KcTrace::Span span(kTraceCategoryPhase, "Device resolution");
+                InitRequestedAsicList(config.asics, config.mode, supported_devices_cache_, target_devices_tmp, false);
+            }
 
             // Filter unsupported targets.
             for (const std::string device_name : target_devices_tmp)
@@ -730,76 +800,68 @@ void KcCLICommanderVkOffline::RunCompileCommands(const Config& config, LoggingCa
 
             KcUtilsVulkan vk_util(output_metadata_, "", log_callback_, kVulkanStageFileSuffix);
 
+            // Prepare the build options for each of the devices.
+            // Each device gets its own temp directory, so that the outputs of the compiler cannot collide.
+            std::vector<VkOfflineDeviceBuild> device_builds;
             for (const std::string& device : target_devices)
             {
-                // Generate the output message.
-                log_msg << kStrInfoCompiling << device << "... ";
-                
+                VkOfflineDeviceBuild device_build;
+                device_build.device         = device;
+                device_build.vulkan_options = vulkan_options;
+                device_build.log_msg << kStrInfoCompiling << device << "... ";
+
+                status = KcUtils::CreateDeviceTempDir(device, device_build.vulkan_options.temp_dir);
+
                 // Adjust Rendering Pipeline Output FileNames.
-                AdjustRenderingPipelineOutputFileNames(config, device, vulkan_options, warning_msg, status);
+                if (status)
+                {
+                    AdjustRenderingPipelineOutputFileNames(config, device, device_build.vulkan_options, warning_msg, status);
+                }
                 if (!status)
                 {
-                    log_msg << kStrErrorFailedToAdjustFileName << std::endl;
+                    log_msg << device_build.log_msg.str() << kStrErrorFailedToAdjustFileName << std::endl;
+                    KcUtils::DeleteDeviceTempDir(device_build.vulkan_options.temp_dir);
                     should_abort = true;
                     break;
                 }
 
-                // A handle for canceling the build. Currently not in use.
-                bool should_cancel = false;
+                device_builds.push_back(std::move(device_build));
+            }
 
-                // Compile.
-                gtString build_error_log;
-                beKA::beStatus compilation_status = kBeStatusGeneralFailed;
-                compilation_status = vulkan_builder_->CompileWithAmdllpc(vulkan_options, should_cancel, config.print_process_cmd_line, build_error_log);
-                if (compilation_status == kBeStatusSuccess)
-                {
-                    log_msg << kStrInfoSuccess << std::endl;
-                    
-                    std::string       error_msg;
-                    BeVkPipelineFiles spv_files, isa_files, stats_files;
-                    GetBeVkPipelineFileNames(config, vulkan_options, spv_files, isa_files, stats_files);
-
-                    std::string                        amdgpu_dis_stdout;
-                    std::map<std::string, std::string> shader_to_disassembly;
-                    BeVkPipelineWaveSizes              wave_sizes;
-                    wave_sizes.fill(beWaveSize::kWave64);
-
-                    compilation_status = beProgramBuilderVulkan::AmdgpudisBinaryToDisassembly(vulkan_options.pipeline_binary,
-                                                                                              isa_files,
-                                                                                              config.print_process_cmd_line,
-                                                                                              amdgpu_dis_stdout,
-                                                                                              shader_to_disassembly,
-                                                                                              wave_sizes,
-                                                                                              error_msg);
-                    if (compilation_status == kBeStatusSuccess)
+            // Compile the devices concurrently. The results are stored and printed in the order of the devices.
+            KcDeviceExecutor::Run(
+                device_builds.size(),
+                (config.print_process_cmd_line ? 1 : config.jobs),
+                [&](size_t i, KcDeviceOutput&) { BuildForDevice(*vulkan_builder_, config, device_builds[i]); },
+                [&](size_t i) {
+                    VkOfflineDeviceBuild& device_build = device_builds[i];
+                    if (device_build.status == kBeStatusSuccess)
                     {
-                        StoreOutputFilesToOutputMD(device, spv_files, isa_files, stats_files, wave_sizes);
+                        StoreOutputFilesToOutputMD(
+                            device_build.device, device_build.spv_files, device_build.isa_files, device_build.stats_files, device_build.wave_sizes);
 
                         BeAmdPalMetaData::PipelineMetaData pipeline;
-                        auto                               md_status = BeAmdPalMetaData::ParseAmdgpudisMetadata(amdgpu_dis_stdout, pipeline);
+                        auto md_status = BeAmdPalMetaData::ParseAmdgpudisMetadata(device_build.amdgpu_dis_stdout, pipeline);
                         assert(md_status == beKA::beStatus::kBeStatusGraphicsCodeObjMetaDataSuccess);
                         if (md_status == beKA::beStatus::kBeStatusGraphicsCodeObjMetaDataSuccess)
                         {
-                            vk_util.ExtractStatistics(config, device, pipeline, shader_to_disassembly);
+                            KcTrace::Context trace_context(device_build.device);
+                            KcTrace::Span    span(kTraceCategoryPhase, "Statistics");
+                            vk_util.ExtractStatistics(config, device_build.device, pipeline, device_build.shader_to_disassembly);
                         }
                     }
 
-                }
-                else
-                {
-                    LogErrorStatus(compilation_status, build_error_log, log_msg);
-                }
-
-                // Print the message for the current device.
-                callback(log_msg.str());
-
-                // Clear the output stream for the next iteration.
-                log_msg.str("");
-            }
+                    // Print the message for the current device.
+                    callback(device_build.log_msg.str());
+                });
 
             vk_util.RunPostProcessingSteps(config);
 
-            DeleteTempFiles(config, vulkan_options);
+            for (const VkOfflineDeviceBuild& device_build : device_builds)
+            {
+                DeleteTempFiles(config, device_build.vulkan_options);
+                KcUtils::DeleteDeviceTempDir(device_build.vulkan_options.temp_dir);
+            }
 
         }
     }
@@ -816,6 +878,11 @@ void KcCLICommanderVkOffline::RunCompileCommands(const Config& config, LoggingCa
     }
 }
 
+void KcCLICommanderVkOffline::GetOutputFiles(RgClOutputMetadata& output_files) const
+{
+    KcUtilsVulkan::GetOutputFiles(output_metadata_, kVulkanStageFileSuffix, output_files);
+}
+
 bool KcCLICommanderVkOffline::PrintAsicList(const Config&)
 {
     std::set<std::string> targets;
@@ -34,6 +34,9 @@ public:
     // Execute the build.
     virtual void RunCompileCommands(const Config& config, LoggingCallbackFunction callback) override;
 
+    // Get the output files of the last compilation, mapped by {device, stage}.
+    virtual void GetOutputFiles(RgClOutputMetadata& output_files) const override;
+
 private:
 
     // Caches the supported devices.
@@ -35,6 +35,7 @@
 #include "radeon_gpu_analyzer_cli/kc_xml_writer.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_string_constants.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_vulkan.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 
 using namespace beKA;
 
@@ -387,51 +388,68 @@ static void LogPreStep(const std::string& msg, const std::string& device = "")
     RgLog::stdOut << msg << device << "... " << std::flush;
 }
 
+static void LogPreStep(std::ostream& out, const std::string& msg, const std::string& device = "")
+{
+    out << msg << device << "... " << std::flush;
+}
+
 static void LogResult(bool result)
 {
     RgLog::stdOut << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
 }
 
-static void LogErrorStatus(beStatus status, const std::string& errMsg)
+static void LogResult(std::ostream& out, bool result)
+{
+    out << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
+}
+
+static void LogErrorStatus(std::ostream& out, beStatus status, const std::string& errMsg)
 {
     switch (status)
     {
     case kBeStatusSuccess:
         break;
     case kBeStatusVulkanGlslangLaunchFailed:
-        RgLog::stdOut << kStrErrorVulkanFailedToLaunchGlslang << std::endl;
+        out << kStrErrorVulkanFailedToLaunchGlslang << std::endl;
         break;
     case kBeStatusVulkanFrontendCompileFailed:
-        RgLog::stdOut << kStrErrorVulkanFrontendCompilationFailed << std::endl;
+        out << kStrErrorVulkanFrontendCompilationFailed << std::endl;
         if (!errMsg.empty())
         {
-            RgLog::stdOut << RgLog::noflush << kStrErrorVulkanGlslangErrorMessage << std::endl;
-            RgLog::stdOut << errMsg << std::endl << RgLog::flush;
+            out << kStrErrorVulkanGlslangErrorMessage << std::endl;
+            out << errMsg << std::endl;
         }
         break;
     case kBeStatusVulkanBackendLaunchFailed:
-        RgLog::stdOut << kStrErrorVulkanFailedToLaunchBackend << std::endl;
+        out << kStrErrorVulkanFailedToLaunchBackend << std::endl;
         break;
     case kBeStatusVulkanBackendCompileFailed:
-        RgLog::stdOut << kStrErrorVulkanBackendFailure << std::endl;
+        out << kStrErrorVulkanBackendFailure << std::endl;
         if (!errMsg.empty())
         {
-            RgLog::stdOut << RgLog::noflush << kStrErrorVulkanBackendErrorMessage << std::endl;
-            RgLog::stdOut << errMsg << std::endl << RgLog::flush;
+            out << kStrErrorVulkanBackendErrorMessage << std::endl;
+            out << errMsg << std::endl;
         }
         break;
     case kBeStatusConstructIsaFileNameFailed:
-        RgLog::stdOut << kStrErrorFailedToAdjustFileName << std::endl;
+        out << kStrErrorFailedToAdjustFileName << std::endl;
         break;
     case kBeStatusVulkanParseStatsFailed:
-        RgLog::stdOut << kStrErrorVulkanFailedToConvertStats << std::endl;
+        out << kStrErrorVulkanFailedToConvertStats << std::endl;
         break;
     default:
-        std::cout << std::endl << (errMsg.empty() ? kStrErrorUnknownCompilationStatus : errMsg) << std::endl;
+        out << std::endl << (errMsg.empty() ? kStrErrorUnknownCompilationStatus : errMsg) << std::endl;
         break;
     }
 }
 
+static void LogErrorStatus(beStatus status, const std::string& errMsg)
+{
+    std::stringstream msg;
+    LogErrorStatus(msg, status, errMsg);
+    RgLog::stdOut << msg.str() << std::flush;
+}
+
 // Checks if specified file path is a SPIR-V binary file.
 static bool IsSpvBinFile(const std::string& file_path)
 {
@@ -739,7 +757,12 @@ void KcCliCommanderVulkan::RunCompileCommands(const Config& config, LoggingCallb
         }
         else
         {
-            if ((status = InitRequestedAsicListVulkan(config)) == true)
+            {
+                KcTrace::Span span(kTraceCategoryPhase, "Device resolution");
+                status = InitRequestedAsicListVulkan(config);
+            }
+
+            if (status)
             {
                 // Detect the type of input files.
                 auto input_file_types = DetectInputFiles(config);
@@ -799,19 +822,29 @@ void KcCliCommanderVulkan::RunCompileCommands(const Config& config, LoggingCallb
                 }
                 else
                 {
-                    // Compile per-device.
-                    for (const std::string& target : asics_)
+                    // Create a per-device copy of the build configuration for each of the targets.
+                    const std::vector<std::string> targets(asics_.begin(), asics_.end());
+                    std::vector<Config>            device_configs(targets.size(), config);
+                    for (size_t i = 0; i < targets.size(); i++)
                     {
-                        // Compile for the specific target.
-                        configPerDevice.asics.clear();
-                        configPerDevice.asics.push_back(target);
+                        device_configs[i].asics.clear();
+                        device_configs[i].asics.push_back(targets[i]);
+                    }
+                    configPerDevice = device_configs.back();
 
-                        // Now, compile the SPIR-V binaries.
-                        if (status)
-                        {
-                            // Perform back-end compilation from a SPIR-V binary to ISA disassembly & statistics.
-                            CompileSpvToIsaForDevice(configPerDevice, spv_files, target);
-                        }
+                    // Now, compile the SPIR-V binaries.
+                    if (status)
+                    {
+                        // Perform back-end compilation from a SPIR-V binary to ISA disassembly & statistics.
+                        // The targets are compiled concurrently, and the per-device results are merged in the order of the targets.
+                        std::vector<DeviceCompileResult> device_results(targets.size());
+                        KcDeviceExecutor::Run(
+                            targets.size(),
+                            (config.print_process_cmd_line ? 1 : config.jobs),
+                            [&](size_t i, KcDeviceOutput& output) {
+                                CompileSpvToIsaForDevice(device_configs[i], spv_files, targets[i], output, device_results[i]);
+                            },
+                            [&](size_t i) { CompleteDeviceCompilation(device_configs[i], spv_files, targets[i], device_results[i]); });
                     }
 
                     KcUtilsVulkan util(output_metadata_, physical_adapter_name_, log_callback_, kVulkanStageFileSuffix);
@@ -845,6 +878,11 @@ bool KcCliCommanderVulkan::RunPostCompileSteps(const Config& config)
     return ret;
 }
 
+void KcCliCommanderVulkan::GetOutputFiles(RgClOutputMetadata& output_files) const
+{
+    KcUtilsVulkan::GetOutputFiles(output_metadata_, kStrPipelineStageNames, output_files);
+}
+
 bool KcCliCommanderVulkan::PrintAsicList(const Config& config)
 {
     std::set<std::string> all_gpus, matched_devices;
@@ -1118,15 +1156,19 @@ bool KcCliCommanderVulkan::CompileSourceToSpv(const Config&            conf,
 void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            config,
                                                     const BeVkPipelineFiles& spv_files,
                                                     const std::string&       device,
-                                                    bool                     is_physical_adapter)
+                                                    KcDeviceOutput&          output,
+                                                    DeviceCompileResult&     result,
+                                                    bool                     is_physical_adapter) const
 {
+    KcTrace::Context   trace_context(device);
     const std::string& device_suffix = (is_physical_adapter ? "" : device);
-    LogPreStep(kStrInfoCompiling, device);
-    BeVkPipelineFiles     isa_files, stats_files;
-    BeVkPipelineWaveSizes wave_sizes;
+    LogPreStep(output.Out(), kStrInfoCompiling, device);
+    BeVkPipelineFiles&     isa_files   = result.isa_files;
+    BeVkPipelineFiles&     stats_files = result.stats_files;
+    BeVkPipelineWaveSizes& wave_sizes  = result.wave_sizes;
     wave_sizes.fill(beWaveSize::kWave64);
 
-    bool        result               = false;
+    bool        is_file_names_ready  = false;
     std::string isa_file_base_name   = config.isa_file;
     std::string stats_file_base_name = config.analysis_file;
     std::string bin_file_base_name   = config.binary_output_file;
@@ -1134,20 +1176,18 @@ void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            con
     beStatus    status = kBeStatusGeneralFailed;
 
     // Construct names for output files.
-    result = ConstructVkOutputFileNames(
+    is_file_names_ready = ConstructVkOutputFileNames(
         config, bin_file_base_name, isa_file_base_name, stats_file_base_name, device_suffix, spv_files, bin_file_name, isa_files, stats_files);
 
-    if (result && !config.vulkan_validation.empty())
+    if (is_file_names_ready && !config.vulkan_validation.empty())
     {
         // Construct name for Vulkan validation info output file.
-        validation_filename = KcUtils::ConstructTempFileName(kStrVulkanTempValidationInfoFilename, kStrVulkanValidationInfoFileExtension);
-        result              = !validation_filename.empty();
+        // The name includes the device, since the devices can be compiled concurrently.
+        validation_filename = KcUtils::ConstructTempFileName(kStrVulkanTempValidationInfoFilename + device_suffix, kStrVulkanValidationInfoFileExtension);
+        is_file_names_ready = !validation_filename.empty();
     }
 
-    // A flag that indicates if we fell back to vk-spv-offline mode.
-    bool is_vk_offline = false;
-
-    if (result)
+    if (is_file_names_ready)
     {
         // If the Vulkan driver uses non-standard name for this device, convert it back to the driver format.
         auto corrected_device = std::find_if(
@@ -1174,73 +1214,38 @@ void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            con
         }
 
         // Perform the compilation.
-        status = beProgramBuilderVulkan::CompileSpirv(config.loader_debug,
-                                                      spv_files,
-                                                      isa_files,
-                                                      stats_files,
-                                                      bin_file_name,
-                                                      config.pso,
-                                                      config.icd_file,
-                                                      validation_filename,
-                                                      config.vulkan_validation,
-                                                      (is_physical_adapter ? "" : vulkan_device),
-                                                      config.print_process_cmd_line,
-                                                      wave_sizes,
-                                                      error_msg);
+        {
+            KcTrace::Span span(kTraceCategoryPhase, "Pipeline compile");
+            status = beProgramBuilderVulkan::CompileSpirv(config.loader_debug,
+                                                          spv_files,
+                                                          isa_files,
+                                                          stats_files,
+                                                          bin_file_name,
+                                                          config.pso,
+                                                          config.icd_file,
+                                                          validation_filename,
+                                                          config.vulkan_validation,
+                                                          (is_physical_adapter ? "" : vulkan_device),
+                                                          config.print_process_cmd_line,
+                                                          wave_sizes,
+                                                          error_msg);
+        }
 
         if (status != kBeStatusSuccess)
         {
             // Report the backend error.
-            std::cout << std::endl << error_msg << std::endl;
+            output.Out() << std::endl << error_msg << std::endl;
             error_msg.clear();
 
             // Warn the user.
-            std::cout << kStrWarningVulkanFallbackToVkOfflineMode << std::endl << std::endl;
-            std::cout << kStrInfoVulkanFallingBackToOfflineMode << std::endl;
-            is_vk_offline = true;
-
-            // Adjust the config file to the vk-spv-offline mode, and target only the current device.
-            Config vk_offline_config = config;
-            vk_offline_config.mode   = RgaMode::kModeVkOfflineSpv;
-            vk_offline_config.input_files.clear();
-            vk_offline_config.asics.clear();
-            vk_offline_config.asics.push_back(device);
-
-            // Adjust the configuration structure to reference the compiled SPIR-V binaries.
-            vk_offline_config.vertex_shader          = spv_files[BePipelineStage::kVertex];
-            vk_offline_config.tess_control_shader    = spv_files[BePipelineStage::kTessellationControl];
-            vk_offline_config.tess_evaluation_shader = spv_files[BePipelineStage::kTessellationEvaluation];
-            vk_offline_config.geometry_shader        = spv_files[BePipelineStage::kGeometry];
-            vk_offline_config.fragment_shader        = spv_files[BePipelineStage::kFragment];
-            vk_offline_config.compute_shader         = spv_files[BePipelineStage::kCompute];
-
-            // Fallback to using vk-spv-offline.
-            KcCLICommanderVkOffline commander;
-            commander.RunCompileCommands(vk_offline_config, LoggingCallback);
-
-            // Verify that the compilation succeeded.
-            bool is_build_success = true;
-            for (int stage = 0; stage < BePipelineStage::kCount; stage++)
-            {
-                if (!spv_files[stage].empty())
-                {
-                    if ((!vk_offline_config.isa_file.empty() && !KcUtils::FileNotEmpty(isa_files[stage])) ||
-                        (!vk_offline_config.analysis_file.empty() && !KcUtils::FileNotEmpty(stats_files[stage])))
-                    {
-                        is_build_success = false;
-                        break;
-                    }
-                }
-            }
+            output.Out() << kStrWarningVulkanFallbackToVkOfflineMode << std::endl << std::endl;
+            output.Out() << kStrInfoVulkanFallingBackToOfflineMode << std::endl;
 
-            // If the compilation succeeded - mark this as a success.
-            if (is_build_success)
-            {
-                status = kBeStatusSuccess;
-            }
+            // The fallback compilation is performed by CompleteDeviceCompilation, one device at a time.
+            result.is_vk_offline = true;
         }
 
-        if (!is_vk_offline && status == kBeStatusSuccess)
+        if (!result.is_vk_offline && status == kBeStatusSuccess)
         {
             // Notify the user about shader merge if happened.
             if (RgaSharedUtils::IsNaviTarget(device) || RgaSharedUtils::IsVegaTarget(device))
@@ -1252,10 +1257,10 @@ void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            con
                     {
                         if (is_first_msg)
                         {
-                            std::cout << std::endl;
+                            output.Out() << std::endl;
                             is_first_msg = false;
                         }
-                        std::cout << kStrInfoVulkanMergedShadersGeometryVertex << std::endl;
+                        output.Out() << kStrInfoVulkanMergedShadersGeometryVertex << std::endl;
                     }
                     is_first_msg = true;
                 }
@@ -1265,10 +1270,10 @@ void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            con
                     {
                         if (is_first_msg)
                         {
-                            std::cout << std::endl;
+                            output.Out() << std::endl;
                             is_first_msg = false;
                         }
-                        std::cout << kStrInfoVulkanMergedShadersGeometryTessellationEvaluation << std::endl;
+                        output.Out() << kStrInfoVulkanMergedShadersGeometryTessellationEvaluation << std::endl;
                     }
                 }
 
@@ -1278,30 +1283,26 @@ void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            con
                     {
                         if (is_first_msg)
                         {
-                            std::cout << std::endl;
+                            output.Out() << std::endl;
                             is_first_msg = false;
                         }
-                        std::cout << kStrInfoVulkanMergedShadersTessellationControlVertex << std::endl;
+                        output.Out() << kStrInfoVulkanMergedShadersTessellationControlVertex << std::endl;
                     }
                 }
             }
 
+            KcTrace::Span span(kTraceCategoryPhase, "Statistics");
             status = KcUtilsVulkan::ConvertStats(isa_files, stats_files, config, device);
         }
 
-        if (status == kBeStatusSuccess)
-        {
-            StoreOutputFilesToOutputMD(device, spv_files, isa_files, stats_files, wave_sizes);
-        }
-
         // If temporary ISA files are used, add their paths to the list of temporary files.
-        if (!is_vk_offline && isa_file_base_name.empty())
+        if (!result.is_vk_offline && isa_file_base_name.empty())
         {
-            std::copy_if(isa_files.cbegin(), isa_files.cend(), std::back_inserter(temp_files_), [&](const std::string& s) { return !s.empty(); });
+            std::copy_if(isa_files.cbegin(), isa_files.cend(), std::back_inserter(result.temp_files), [&](const std::string& s) { return !s.empty(); });
 
             if (RgaSharedUtils::IsNavi3AndBeyond(device))
             {
-                temp_files_.push_back(bin_file_name);
+                result.temp_files.push_back(bin_file_name);
             }
         }
     }
@@ -1310,13 +1311,71 @@ void KcCliCommanderVulkan::CompileSpvToIsaForDevice(const Config&            con
         status = kBeStatusConstructIsaFileNameFailed;
     }
 
+    result.status = status;
+
     // Only print the status messages if we did not fall back
     // to vk-spv-offline mode, since otherwise logging happens in that mode.
-    if (!is_vk_offline)
+    if (!result.is_vk_offline)
+    {
+        LogResult(output.Out(), status == kBeStatusSuccess);
+        LogErrorStatus(output.Out(), status, error_msg);
+    }
+}
+
+void KcCliCommanderVulkan::CompleteDeviceCompilation(const Config&            config,
+                                                     const BeVkPipelineFiles& spv_files,
+                                                     const std::string&       device,
+                                                     DeviceCompileResult&     result)
+{
+    if (result.is_vk_offline)
+    {
+        // Adjust the config file to the vk-spv-offline mode, and target only the current device.
+        Config vk_offline_config = config;
+        vk_offline_config.mode   = RgaMode::kModeVkOfflineSpv;
+        vk_offline_config.input_files.clear();
+        vk_offline_config.asics.clear();
+        vk_offline_config.asics.push_back(device);
+
+        // Adjust the configuration structure to reference the compiled SPIR-V binaries.
+        vk_offline_config.vertex_shader          = spv_files[BePipelineStage::kVertex];
+        vk_offline_config.tess_control_shader    = spv_files[BePipelineStage::kTessellationControl];
+        vk_offline_config.tess_evaluation_shader = spv_files[BePipelineStage::kTessellationEvaluation];
+        vk_offline_config.geometry_shader        = spv_files[BePipelineStage::kGeometry];
+        vk_offline_config.fragment_shader        = spv_files[BePipelineStage::kFragment];
+        vk_offline_config.compute_shader         = spv_files[BePipelineStage::kCompute];
+
+        // Fallback to using vk-spv-offline.
+        KcCLICommanderVkOffline commander;
+        commander.RunCompileCommands(vk_offline_config, LoggingCallback);
+
+        // Verify that the compilation succeeded.
+        bool is_build_success = true;
+        for (int stage = 0; stage < BePipelineStage::kCount; stage++)
+        {
+            if (!spv_files[stage].empty())
+            {
+                if ((!vk_offline_config.isa_file.empty() && !KcUtils::FileNotEmpty(result.isa_files[stage])) ||
+                    (!vk_offline_config.analysis_file.empty() && !KcUtils::FileNotEmpty(result.stats_files[stage])))
+                {
+                    is_build_success = false;
+                    break;
+                }
+            }
+        }
+
+        // If the compilation succeeded - mark this as a success.
+        if (is_build_success)
+        {
+            result.status = kBeStatusSuccess;
+        }
+    }
+
+    if (result.status == kBeStatusSuccess)
     {
-        LogResult(status == kBeStatusSuccess);
-        LogErrorStatus(status, error_msg);
+        StoreOutputFilesToOutputMD(device, spv_files, result.isa_files, result.stats_files, result.wave_sizes);
     }
+
+    temp_files_.insert(temp_files_.end(), result.temp_files.begin(), result.temp_files.end());
 }
 
 bool KcCliCommanderVulkan::AssembleSpv(const Config& conf)
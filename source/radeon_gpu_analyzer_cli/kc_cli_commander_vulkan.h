@@ -9,6 +9,7 @@
 
 // Local.
 #include "radeon_gpu_analyzer_cli/kc_cli_commander.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
 
 class KcCliCommanderVulkan : public KcCliCommander
 {
@@ -22,6 +23,9 @@ public:
     // Perform post-compile actions.
     virtual bool RunPostCompileSteps(const Config& config) override;
 
+    // Get the output files of the last compilation, mapped by {device, stage}.
+    virtual void GetOutputFiles(RgClOutputMetadata& output_files) const override;
+
     // Print the list of supported Vulkan target GPUs.
     virtual bool PrintAsicList(const Config& config) override;
 
@@ -51,10 +55,33 @@ private:
     // (This function calls glslang compiler).
     bool CompileSourceToSpv(const Config& conf, const BeVkPipelineFiles& glsl_files, const BeVkPipelineFiles& hlsl_files, BeVkPipelineFiles& out_spv_files);
 
+    // The results of compiling a SPIR-V binary file for a single device.
+    struct DeviceCompileResult
+    {
+        beKA::beStatus           status        = beKA::beStatus::kBeStatusGeneralFailed;
+        bool                     is_vk_offline = false;  ///< True if the compilation must fall back to vk-spv-offline mode.
+        BeVkPipelineFiles        isa_files;
+        BeVkPipelineFiles        stats_files;
+        BeVkPipelineWaveSizes    wave_sizes;
+        std::vector<std::string> temp_files;
+    };
+
     // Compile a SPIR-V binary file to ISA disassembly file(s) and shader statistics file(s) for specified device.
     // (This function invokes VulkanBackend executable).
-    // is_vk_offline is set to true, if compilation fell back to vk-spv-offline mode.
-    void CompileSpvToIsaForDevice(const Config& config, const BeVkPipelineFiles& spv_files, const std::string& device, bool is_physical_adapter = false);
+    // The devices can be compiled concurrently, so the console output is written to "output" and the results are
+    // returned in "result" instead of being stored to the commander.
+    // result.is_vk_offline is set to true, if compilation must fall back to vk-spv-offline mode.
+    void CompileSpvToIsaForDevice(const Config&            config,
+                                  const BeVkPipelineFiles& spv_files,
+                                  const std::string&       device,
+                                  KcDeviceOutput&          output,
+                                  DeviceCompileResult&     result,
+                                  bool                     is_physical_adapter = false) const;
+
+    // Complete the compilation for specified device: fall back to vk-spv-offline mode if required, and store
+    // the output files and the temporary files of the device.
+    // The devices are completed one at a time, in the order of the devices.
+    void CompleteDeviceCompilation(const Config& config, const BeVkPipelineFiles& spv_files, const std::string& device, DeviceCompileResult& result);
 
     // Assemble a SPIR-V text file to SPIR-V binary file.
     // (This function invokes spv-as from SPIR-V Tools.)
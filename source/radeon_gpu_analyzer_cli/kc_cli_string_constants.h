@@ -25,6 +25,15 @@ static const char* kStrErrorGraphicsMeshMix = "Error: cannot mix mesh shaders wi
 static const char* kStrErrorCannotFindOutputDir = "Error: output directory does not exist: ";
 static const char* kStrErrorCannotInvokeCompiler = "Error: unable to invoke the compiler.";
 static const char* kStrErrorCannotReadFile = "Error: unable to read: ";
+static const char* kStrErrorCannotWriteTraceFile = "Error: unable to write the trace file: ";
+static const char* kStrErrorCannotServeOnSocket = "Error: unable to serve requests on the socket: ";
+static const char* kStrErrorServeSocketNotSupported = "Error: serving requests on a socket is only supported on Linux.";
+static const char* kStrErrorServeInvalidRequest = "Error: invalid request: expected a JSON object with an \"args\" array of strings.";
+static const char* kStrErrorServeNestedServe = "Error: a request cannot start another server or batch.";
+static const char* kStrErrorServeModeNotSupported = "Error: only the opencl, vulkan, vk-offline, vk-spv-offline and vk-spv-txt-offline modes are supported in a request.";
+static const char* kStrErrorServeLoaderDebugNotSupported = "Error: \"--loader-debug\" is not supported in a request, since it would change the environment of the server.";
+static const char* kStrErrorCannotCreateOutputDir = "Error: unable to create the output directory: ";
+static const char* kStrErrorInvalidBatchFile = "Error: invalid batch file (expected a JSON object with a \"jobs\" array of job objects with a \"mode\" string): ";
 static const char* kStrErrorCannotCopyFileA = "Error: unable to copy file: ";
 static const char* kStrErrorCannotCopyFileB = "to file: ";
 static const char* kStrErrorCannotOpenFileForWriteA = "Error: unable to open ";
@@ -49,6 +58,8 @@ static const char* kStrErrorFailedCreateOutputFilename = "Error: failed to const
 static const char* kStrErrorFailedToGenerateSessionMetdata = "Error: failed to generate Session Metadata file.";
 static const char* kStrErrorFailedToWriteIsaFile = "Error: failed to write ISA file: ";
 static const char* kStrErrorFailedToConvertToCsvFormat = "Error: CSV conversion failed in file: ";
+static const char* kStrErrorCannotReadBinaryList = "Error: unable to read the list of code object files: ";
+static const char* kStrErrorCannotReadBinaryDirectory = "Error: unable to read the directory of code object files: ";
 
 // Warnings.
 static const char* kStrWarningDx11MinSupportedVersion = "Warning: AMD DirectX driver supports DX10 and above.";
@@ -60,6 +71,7 @@ static const char* kStrWarningOpenclMetadataNotSupported2 = " is not supported."
 static const char* kStrWarningLiveregNotSupported = "Warning: live register analysis is disabled in this mode ";
 static const char* kStrWarningCfgNotSupported = "Warning: control-flow graph generation is disabled in this mode ";
 static const char* kStrWarningSkipping = "- skipping.";
+static const char* kStrWarningCannotUseBuildCache = "Warning: unable to use the cache directory, compiling without the cache: ";
 static const char* kStrWarningPso1 = "Warning: no pipeline state file provided. Compilation may fail or produce inaccurate results.";
 static const char* kStrWarningPso2 = " Use --pso option to provide full path to ";
 static const char* kStrWarningPsoGraphics = ".gpso (graphics)";
@@ -77,10 +89,19 @@ static const char* kStrInfoContructingPerBlockCfg1 = "Generating per-block contr
 static const char* kStrInfoContructingPerBlockCfg2 = " shader...";
 static const char* kStrInfoContructingPerInstructionCfg1 = "Generating per-instruction control-flow graph for ";
 static const char* kStrInfoContructingPerInstructionCfg2 = " shader...";
+static const char* kStrInfoBatchJobA = "Batch job ";
+static const char* kStrInfoBatchJobSucceeded = " succeeded.";
+static const char* kStrInfoBatchJobFailed = " failed.";
+static const char* kStrInfoBatchSummaryA = "Batch finished: ";
+static const char* kStrInfoBatchSummaryB = " of ";
+static const char* kStrInfoBatchSummaryC = " jobs succeeded.";
 static const char* kStrInfoValidateBinFile = "Info: validating input code object: ";
 static const char* kStrInfoDisassemblingBinary = "Info: disassembling input code object ";
 static const char* kStrInfoDetectBinWorkflowType  = "Info: identifying workflow type for input code object: ";
 static const char* kStrInfoDetectBinTargetDevice  = "Info: extracting device information from: ";
+static const char* kStrInfoAnalyzingBinary = "Info: analyzing input code object ";
+static const char* kStrInfoBinarySummary = "Summary: ";
+static const char* kStrInfoBinarySummaryFailedFiles = "Failed code objects:";
 
 
 // Build output.
@@ -127,6 +148,10 @@ static const char* kStrDefaultFilenameBin = "bin";
 static const char* kStrDefaultFilenamePreprocessedIsa = "preprocessed_isa";
 static const char* kStrDefaultFilenameOutputBinaryFileName = "codeobj.bin";
 
+// Parsed ISA CSV headers.
+static const char* kStrCsvParsedIsaHeader = "Address, Opcode, Operands, Functional Unit, Cycles, Binary Encoding\n";
+static const char* kStrCsvParsedIsaHeaderLineNumbers = "Address, Source Line Number, Opcode, Operands, Functional Unit, Cycles, Binary Encoding\n";
+
 // RGA Mode API Name Strings.
 static const char* kStrRgaModeOpenclOffline    = "OpenCL";
 static const char* kStrRgaModeOpengl           = "OpenGL";
@@ -9,6 +9,7 @@
 
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "radeon_gpu_analyzer_backend/be_backend.h"
@@ -43,7 +44,9 @@ public:
         kVersion,
         kGenVersionInfoFile,
         kGenTemplateFile,
-        kUpdate
+        kUpdate,
+        kServe,
+        kBatch
     };
 
     Config();
@@ -52,6 +55,13 @@ public:
     ConfigCommand            requested_command;                 ///< What the user requested to do
     std::vector<std::string> input_files;                       ///< Source file for processing.
     std::string              analysis_file;                     ///< Output analysis file.
+    int                      loop_iteration_count = 0;          ///< Iteration count assumed for loops in the analysis cycle estimate (0 for the default).
+    std::string              loop_iteration_file;               ///< File with the iteration counts of specific loops for the analysis cycle estimate.
+    std::unordered_map<std::string, int> loop_iteration_overrides;  ///< The iteration counts that were read from the loop iteration file, by loop header label.
+    int                      jobs = 1;                          ///< Maximum number of concurrent compilations (0 for the number of hardware threads).
+    std::string              trace_file;                        ///< Output Chrome trace file with the time spent in each phase (empty to disable).
+    std::string              serve_socket;                      ///< Unix domain socket to serve requests on (empty to serve requests from stdin).
+    std::string              batch_file;                        ///< JSON manifest of the compile jobs to run in a single process.
     std::string              il_file;                           ///< Output IL Text file template.
     std::string              isa_file;                          ///< Output ISA Text file template.
     std::string              livereg_analysis_file;             ///< VGPR Live register analysis output file.
@@ -70,6 +80,8 @@ public:
     std::vector<std::string> asics;                             ///< Target GPUs for compilation.
     std::vector<std::string> suppress_section;                  ///< List of sections to suppress in generated binary files.
     std::vector<std::string> opencl_options;                    ///< Options to be added to OpenCL compile.
+    std::string              cache_dir;                         ///< Directory of the OpenCL build cache (empty to disable the cache).
+    int                      cache_size = 1024;                 ///< Maximum size of the OpenCL build cache in MB.
     std::vector<std::string> defines;                           ///< Macros to be added to compile.
     std::vector<std::string> include_path;                      ///< Additional Include paths
     bool                     should_avoid_binary_device_prefix; ///< If true then CLI will not add the asic name to the generated binary output file.
@@ -47,6 +47,7 @@ struct RgOutputFiles
     std::string  livereg_sgpr_file;
     std::string  cfg_file;
     std::string  entry_abbreviation;
+    int          code_size        = -1;  // Size of the kernel code from the symbol table of the binary, -1 if not known.
     beWaveSize   wave_size        = beWaveSize::kWave64;
     bool         is_bin_file_temp = false;
     bool         is_isa_file_temp = false;
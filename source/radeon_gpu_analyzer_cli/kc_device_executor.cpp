@@ -0,0 +1,322 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the executor of concurrent per-device compilation tasks.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Shared.
+#include "common/rg_log.h"
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
+
+// The buffered output of the task that runs on the calling thread (nullptr if none).
+static thread_local KcDeviceOutput* thread_output = nullptr;
+
+// Serializes the writes of the threads to the console (see KcConsoleRedirect).
+static std::mutex console_lock;
+
+// The threads that are shared by the executors (see KcDeviceExecutor::SetSharedThreadCount()).
+static std::mutex              shared_threads_lock;
+static std::condition_variable shared_thread_returned;
+static size_t                  shared_thread_count      = 0;
+static size_t                  free_shared_thread_count = 0;
+
+// True if the calling thread holds one of the shared threads (see KcDeviceExecutor::SharedThread).
+static thread_local bool is_shared_thread_held = false;
+
+// Take up to "count" threads from the shared threads that are free.
+// Returns the number of the threads that were taken, which is "count" if the threads are not shared.
+static size_t TakeSharedThreads(size_t count)
+{
+    std::lock_guard<std::mutex> lock(shared_threads_lock);
+    if (shared_thread_count > 0)
+    {
+        count = std::min(count, free_shared_thread_count);
+        free_shared_thread_count -= count;
+    }
+    return count;
+}
+
+// Return threads that were taken with TakeSharedThreads().
+static void ReturnSharedThreads(size_t count)
+{
+    {
+        std::lock_guard<std::mutex> lock(shared_threads_lock);
+        if (shared_thread_count > 0)
+        {
+            free_shared_thread_count = std::min(free_shared_thread_count + count, shared_thread_count);
+        }
+    }
+    shared_thread_returned.notify_all();
+}
+
+KcDeviceOutput::KcDeviceOutput(bool is_buffered)
+    : is_buffered_(is_buffered)
+{
+}
+
+std::ostream& KcDeviceOutput::Out()
+{
+    return is_buffered_ ? static_cast<std::ostream&>(out_) : std::cout;
+}
+
+void KcDeviceOutput::Err(const std::string& text)
+{
+    if (is_buffered_)
+    {
+        chunks_.push_back({ChunkKind::kStdout, out_.str()});
+        chunks_.push_back({ChunkKind::kStderrMessage, text});
+        out_.str("");
+    }
+    else
+    {
+        RgLog::stdErr << std::endl << text << std::endl;
+    }
+}
+
+void KcDeviceOutput::Write(bool is_stderr, const char* text, size_t size)
+{
+    if (!is_stderr)
+    {
+        out_.write(text, static_cast<std::streamsize>(size));
+    }
+    else
+    {
+        // A message is usually written in several pieces, so the pieces that follow each other are joined.
+        if (out_.tellp() > 0 || chunks_.empty() || chunks_.back().first != ChunkKind::kStderr)
+        {
+            chunks_.push_back({ChunkKind::kStdout, out_.str()});
+            chunks_.push_back({ChunkKind::kStderr, std::string()});
+            out_.str("");
+        }
+        chunks_.back().second.append(text, size);
+    }
+}
+
+void KcDeviceOutput::Flush()
+{
+    chunks_.push_back({ChunkKind::kStdout, out_.str()});
+    out_.str("");
+    for (const auto& chunk : chunks_)
+    {
+        if (chunk.first == ChunkKind::kStderrMessage)
+        {
+            RgLog::stdErr << std::endl << chunk.second << std::endl;
+        }
+        else if (chunk.first == ChunkKind::kStderr)
+        {
+            std::cerr << chunk.second;
+        }
+        else
+        {
+            std::cout << chunk.second;
+        }
+    }
+    std::cout.flush();
+    chunks_.clear();
+}
+
+KcDeviceOutput* KcDeviceOutput::GetThreadOutput()
+{
+    return thread_output;
+}
+
+// A stream buffer that holds the text that is written on a thread with a buffered output in that output,
+// and forwards the text of the other threads to the console buffer that it replaced.
+// The buffer has no put area, so every write reaches it and is routed by the thread that makes it.
+class KcConsoleRedirect::StreamBuf : public std::streambuf
+{
+public:
+    StreamBuf(std::ostream& stream, bool is_stderr)
+        : stream_(stream)
+        , is_stderr_(is_stderr)
+        , console_buf_(stream.rdbuf(this))
+    {
+    }
+
+    ~StreamBuf() override
+    {
+        stream_.rdbuf(console_buf_);
+    }
+
+protected:
+    std::streamsize xsputn(const char* text, std::streamsize count) override
+    {
+        if (thread_output != nullptr)
+        {
+            thread_output->Write(is_stderr_, text, static_cast<size_t>(count));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(console_lock);
+            count = console_buf_->sputn(text, count);
+        }
+        return count;
+    }
+
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            const char text = traits_type::to_char_type(ch);
+            xsputn(&text, 1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override
+    {
+        int ret = 0;
+        if (thread_output == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(console_lock);
+            ret = console_buf_->pubsync();
+        }
+        return ret;
+    }
+
+private:
+    std::ostream&   stream_;
+    bool            is_stderr_   = false;
+    std::streambuf* console_buf_ = nullptr;
+};
+
+KcConsoleRedirect::KcConsoleRedirect()
+    : stdout_buf_(new StreamBuf(std::cout, false))
+    , stderr_buf_(new StreamBuf(std::cerr, true))
+{
+}
+
+KcConsoleRedirect::~KcConsoleRedirect() = default;
+
+void KcDeviceExecutor::Run(size_t device_count, int jobs, const DeviceTask& task, const DeviceResultCallback& on_result)
+{
+    unsigned int thread_count = (jobs < 0 ? 1 : static_cast<unsigned int>(jobs));
+    if (thread_count == 0)
+    {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    // The calling thread lends the shared thread that it holds to the workers.
+    const size_t requested_count = std::min(static_cast<size_t>(thread_count), device_count);
+    const size_t lent_count      = (is_shared_thread_held && requested_count > 0 ? 1 : 0);
+    const size_t taken_count     = TakeSharedThreads(requested_count - lent_count);
+    const size_t worker_count    = taken_count + lent_count;
+
+    if (worker_count <= 1)
+    {
+        for (size_t i = 0; i < device_count; i++)
+        {
+            KcDeviceOutput output(false);
+            task(i, output);
+            on_result(i);
+        }
+        ReturnSharedThreads(taken_count);
+    }
+    else
+    {
+        // The output of each device is stored in its own slot, and is reported in the order of the devices.
+        std::vector<std::unique_ptr<KcDeviceOutput>> outputs(device_count);
+        std::vector<bool>                            is_done(device_count, false);
+        for (std::unique_ptr<KcDeviceOutput>& output : outputs)
+        {
+            output.reset(new KcDeviceOutput(true));
+        }
+
+        std::mutex              results_lock;
+        std::condition_variable device_done;
+        std::atomic<size_t>     next_device(0);
+
+        // The workers release their log slots when they are done, since the number of the slots is limited.
+        // The workers that took a shared thread return it as soon as no devices are left, so that other tasks can use it
+        // while the remaining devices are compiled.
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < worker_count; i++)
+        {
+            const bool is_taken = (i < taken_count);
+            workers.emplace_back([&, is_taken]() {
+                for (size_t device = next_device++; device < device_count; device = next_device++)
+                {
+                    thread_output = outputs[device].get();
+                    task(device, *outputs[device]);
+                    thread_output = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(results_lock);
+                        is_done[device] = true;
+                    }
+                    device_done.notify_one();
+                }
+                if (is_taken)
+                {
+                    ReturnSharedThreads(1);
+                }
+                RgLog::CloseThreadLog();
+            });
+        }
+
+        // Report the results on the calling thread as soon as the preceding devices are reported,
+        // so that the output reaches the console (or the request) of the caller.
+        for (size_t i = 0; i < device_count; i++)
+        {
+            {
+                std::unique_lock<std::mutex> lock(results_lock);
+                device_done.wait(lock, [&]() { return static_cast<bool>(is_done[i]); });
+            }
+            outputs[i]->Flush();
+            on_result(i);
+        }
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
+
+void KcDeviceExecutor::SetSharedThreadCount(int thread_count)
+{
+    std::lock_guard<std::mutex> lock(shared_threads_lock);
+    shared_thread_count      = static_cast<size_t>(std::max(thread_count, 0));
+    free_shared_thread_count = shared_thread_count;
+}
+
+bool KcDeviceExecutor::TryTakeSharedThread()
+{
+    return (TakeSharedThreads(1) == 1);
+}
+
+void KcDeviceExecutor::ReturnSharedThread()
+{
+    ReturnSharedThreads(1);
+}
+
+KcDeviceExecutor::SharedThread::SharedThread()
+{
+    std::unique_lock<std::mutex> lock(shared_threads_lock);
+    if (shared_thread_count > 0 && !is_shared_thread_held)
+    {
+        shared_thread_returned.wait(lock, []() { return free_shared_thread_count > 0; });
+        free_shared_thread_count--;
+        is_held_              = true;
+        is_shared_thread_held = true;
+    }
+}
+
+KcDeviceExecutor::SharedThread::~SharedThread()
+{
+    if (is_held_)
+    {
+        is_shared_thread_held = false;
+        ReturnSharedThreads(1);
+    }
+}
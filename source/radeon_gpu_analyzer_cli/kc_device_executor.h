@@ -0,0 +1,122 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for the executor of concurrent per-device compilation tasks.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERCLI_SRC_KC_DEVICE_EXECUTOR_H_
+#define RGA_RADEONGPUANALYZERCLI_SRC_KC_DEVICE_EXECUTOR_H_
+
+// C++.
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Console output of the compilation for a single device.
+// When the devices are compiled concurrently, the output is buffered and printed once all of the preceding devices are
+// printed, so that the console output does not depend on the order in which the devices are compiled.
+class KcDeviceOutput
+{
+public:
+    explicit KcDeviceOutput(bool is_buffered);
+
+    // The stream for the standard output.
+    std::ostream& Out();
+
+    // Print the given text (such as the warnings reported by the compiler) to stderr.
+    void Err(const std::string& text);
+
+    // Hold text that was written to std::cout or std::cerr while a task of a buffered output ran (see GetThreadOutput()).
+    void Write(bool is_stderr, const char* text, size_t size);
+
+    // Print the buffered output.
+    void Flush();
+
+    // The buffered output of the task that runs on the calling thread (nullptr if none).
+    // The console output that is not written to the output of a task, such as the output of the backend, can be redirected to it.
+    static KcDeviceOutput* GetThreadOutput();
+
+private:
+    // The kinds of the buffered output.
+    enum class ChunkKind
+    {
+        kStdout,
+        kStderrMessage,
+        kStderr
+    };
+
+    bool              is_buffered_;
+    std::stringstream out_;
+
+    // The buffered output: pairs of {kind, text}.
+    std::vector<std::pair<ChunkKind, std::string>> chunks_;
+};
+
+// Redirects the text that a task with a buffered output writes to std::cout or std::cerr, such as the console output
+// of the backend and the RgLog console messages, to the output of the task (see KcDeviceOutput::GetThreadOutput()),
+// while in scope. The text that the other threads write reaches the console.
+class KcConsoleRedirect
+{
+public:
+    KcConsoleRedirect();
+    ~KcConsoleRedirect();
+
+private:
+    class StreamBuf;
+
+    std::unique_ptr<StreamBuf> stdout_buf_;
+    std::unique_ptr<StreamBuf> stderr_buf_;
+};
+
+// Executor of per-device compilation tasks on a bounded pool of threads.
+class KcDeviceExecutor
+{
+public:
+    // Compile for the device with the given index.
+    // The task may run concurrently with the tasks of other devices, so the console output must be written to "output".
+    typedef std::function<void(size_t device_index, KcDeviceOutput& output)> DeviceTask;
+
+    // Called for each device in the order of the devices, after the console output of its task was printed.
+    // The calls are serialized, so the callback can update state that is shared by the devices.
+    typedef std::function<void(size_t device_index)> DeviceResultCallback;
+
+    // Run "task" for "device_count" devices on up to "jobs" threads (0 for the number of hardware threads).
+    // With a single thread, the tasks run on the calling thread and their console output is printed directly.
+    // Otherwise, the console output is printed and "on_result" is called on the calling thread.
+    static void Run(size_t device_count, int jobs, const DeviceTask& task, const DeviceResultCallback& on_result);
+
+    // Share "thread_count" threads between the executors that run at once (0 to remove the limit), such as the executors
+    // of the requests that a server serves concurrently. Each executor takes the threads that are free when it starts,
+    // besides the one that its calling thread holds (see SharedThread), and runs its tasks on the calling thread if none are free.
+    static void SetSharedThreadCount(int thread_count);
+
+    // Take one of the shared threads if one is free, for a thread that runs tasks besides the executors (see KcTaskGraph).
+    // Returns true if a thread was taken, which is always the case if the threads are not shared.
+    static bool TryTakeSharedThread();
+
+    // Return a thread that was taken with TryTakeSharedThread().
+    static void ReturnSharedThread();
+
+    // Holds one of the shared threads for the calling thread while in scope, waiting for one to be free.
+    // The executors that run on the calling thread use it as one of their threads.
+    class SharedThread
+    {
+    public:
+        SharedThread();
+        ~SharedThread();
+
+    private:
+        bool is_held_ = false;
+    };
+
+private:
+    KcDeviceExecutor()  = delete;
+    ~KcDeviceExecutor() = delete;
+};
+
+#endif // RGA_RADEONGPUANALYZERCLI_SRC_KC_DEVICE_EXECUTOR_H_
@@ -6,10 +6,12 @@
 //=============================================================================
 
 // C++.
+#include <algorithm>
 #include <memory>
 #include <map>
 #include <utility>
 #include <sstream>
+#include <thread>
 
 // Infra.
 #include "external/amdt_os_wrappers/Include/osEnvironmentVariable.h"
@@ -27,8 +29,11 @@
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_vk_offline.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_vulkan.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_binary.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
 #include "radeon_gpu_analyzer_cli/kc_utils.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_lightning.h"
+#include "radeon_gpu_analyzer_cli/kc_server.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 #ifdef _WIN32
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_dx11.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_commander_dx12.h"
@@ -52,33 +57,24 @@ static void LoggingCallback(const std::string& s)
 }
 
 // Perform finalizing actions before exiting.
-static void Shutdown()
+static void Shutdown(const Config& config)
 {
+    if (!KcTrace::Finish())
+    {
+        RgLog::stdErr << kStrErrorCannotWriteTraceFile << config.trace_file << std::endl;
+    }
     RgLog::file << kStrRgaCliLogsEnd << std::endl;
     RgLog::Close();
 }
 
-int main(int argc, char* argv[])
+// Create the Commander object for the requested mode and perform the requested command with it.
+// The Commander object is returned in "commander".
+static bool RunCommand(Config& config, std::shared_ptr<KcCliCommander>& commander)
 {
     bool status = true;
-    Config config;
-    std::stringstream msg;
-
-#ifdef _WIN64
-
-    // Update the PATH environment variable so that spawned processes inherit the VC++ runtime libraries path.
-    KcUtils::UpdatePathEnvVar();
-
-    // Enable 64-bit build for OpenCL.
-    osEnvironmentVariable envVar64Bit(kStrOpenclEnvVarGpuForce64BitPtrName, kStrOpenclEnvVarGpuForce64BitPtrValue);
-    osSetCurrentProcessEnvVariable(envVar64Bit);
-#endif // _WIN64
-
-    status = status && ParseCmdLine(argc, argv, config);
-    status = status && KcUtils::InitCLILogFile(config);
 
     // Create corresponding Commander object.
-    std::shared_ptr<KcCliCommander> commander = nullptr;
+    commander = nullptr;
     if (status)
     {
         switch (config.mode)
@@ -132,10 +128,16 @@ int main(int argc, char* argv[])
         {
         case Config::kCompile:
         case Config::kGenTemplateFile:
-            commander->RunCompileCommands(config, LoggingCallback);
+        {
+            {
+                KcTrace::Span compile_span(kTraceCategoryPhase, "Compile");
+                commander->RunCompileCommands(config, LoggingCallback);
+            }
             // Perform post-compile steps
+            KcTrace::Span post_compile_span(kTraceCategoryPhase, "Post-compile steps");
             commander->RunPostCompileSteps(config);
             break;
+        }
         case Config::kListEntries:
             commander->ListEntries(config, LoggingCallback);
             break;
@@ -156,6 +158,12 @@ int main(int argc, char* argv[])
             RgLog::stdOut << kStrErrorNoValidCommandDetected << std::endl;
             status = false;
             break;
+        case Config::kServe:
+        case Config::kBatch:
+            // The server is started by main(), and the server rejects these commands in its requests.
+            RgLog::stdErr << kStrErrorServeNestedServe << std::endl;
+            status = false;
+            break;
         }
     }
     else if (status && config.requested_command == Config::kGenVersionInfoFile)
@@ -163,6 +171,52 @@ int main(int argc, char* argv[])
         KcCliCommander::GenerateVersionInfoFile(config);
     }
 
-    Shutdown();
+    return status;
+}
+
+int main(int argc, char* argv[])
+{
+    bool status = true;
+    Config config;
+    std::stringstream msg;
+
+#ifdef _WIN64
+
+    // Update the PATH environment variable so that spawned processes inherit the VC++ runtime libraries path.
+    KcUtils::UpdatePathEnvVar();
+
+    // Enable 64-bit build for OpenCL.
+    osEnvironmentVariable envVar64Bit(kStrOpenclEnvVarGpuForce64BitPtrName, kStrOpenclEnvVarGpuForce64BitPtrValue);
+    osSetCurrentProcessEnvVariable(envVar64Bit);
+#endif // _WIN64
+
+    status = status && ParseCmdLine(argc, argv, config);
+    status = status && KcUtils::InitCLILogFile(config);
+
+    if (status && !config.trace_file.empty())
+    {
+        KcTrace::Start(config.trace_file);
+    }
+
+    if (status && (config.requested_command == Config::kServe || config.requested_command == Config::kBatch))
+    {
+        KcServer server(config, RunCommand);
+        status = server.Run();
+    }
+    else if (status)
+    {
+        // The devices of the command and their post-processing tasks share the threads of the --jobs option.
+        // The console output of the devices that are compiled concurrently is held, and printed in the order of the devices.
+        KcDeviceExecutor::SetSharedThreadCount(config.jobs > 0 ? config.jobs : static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u)));
+        {
+            KcConsoleRedirect               console_redirect;
+            KcDeviceExecutor::SharedThread  main_thread;
+            std::shared_ptr<KcCliCommander> commander = nullptr;
+            status = RunCommand(config, commander);
+        }
+        KcDeviceExecutor::SetSharedThreadCount(0);
+    }
+
+    Shutdown(config);
     return 0;
 }
@@ -39,6 +39,7 @@ namespace po = cxxopts;
 
 // Constants.
 static const char* kStrErrorBothCfgAndCfgiSpecified = "Error: only one of \"--cfg\" and \"--cfg-i\" options can be specified.";
+static const char* kStrErrorNegativeLoopIterations = "Error: the number of loop iterations (\"--loop-iterations\") cannot be negative.";
 static const char* kStrErrorNoModeSpecified = "No mode specified. Please specify mode using - s <arg>.";
 static const char* kStrDxAdaptersHelpCommonText = "This is only relevant if you have multiple display adapters installed on your system, and you would like RGA to use the driver which is associated with "
 "a non-primary display adapter.By default RGA will use the driver that is associated with the primary display adapter.";
@@ -79,6 +80,32 @@ static const char* kStrOptionHelp          = "h,help";
 static const char* kStrDescriptionHelp     = "Produce this help message.";
 static const char* kStrOptionAnalysis      = "a,analysis";
 static const char* kStrDescriptionAnalysis = "Path to output analysis file.";
+static const char* kStrOptionLoopIterations          = "loop-iterations";
+static const char* kStrDescriptionLoopIterations     = "The number of iterations that is assumed for loops when estimating the cycles for the analysis file. "
+                                                       "The default is 10.";
+static const char* kStrOptionLoopIterationsFile      = "loop-iterations-file";
+static const char* kStrDescriptionLoopIterationsFile = "Path to a text file with the number of iterations of specific loops, which overrides "
+                                                       "--loop-iterations when estimating the cycles for the analysis file. Each line holds the label "
+                                                       "of the loop header block as it appears in the ISA disassembly, followed by the number of iterations.";
+static const char* kStrOptionJobs                     = "j,jobs";
+static const char* kStrDescriptionJobs                = "The maximum number of target devices that are compiled concurrently. "
+                                                       "0 uses the number of hardware threads. The default is 1.";
+static const char* kStrOptionTraceFile                = "trace-file";
+static const char* kStrDescriptionTraceFile           = "Path to an output trace file that records the time spent in each phase and in each launched process, "
+                                                       "in the Chrome trace event format (can be opened with chrome://tracing or Perfetto).";
+static const char* kStrOptionServe                    = "serve";
+static const char* kStrDescriptionServe               = "Serve compile and analysis requests until stdin is closed, instead of performing a single command. "
+                                                       "Each request is a line with a JSON object: {\"id\": <any value>, \"args\": [<the command line arguments "
+                                                       "of an RGA invocation>]}. Each response is a line with a JSON object with the id of the request, its status, "
+                                                       "its console output and its output files and statistics. Up to --jobs requests are served concurrently. "
+                                                       "The requests can compile in the opencl, vulkan, vk-offline, vk-spv-offline and vk-spv-txt-offline modes.";
+static const char* kStrOptionServeSocket              = "serve-socket";
+static const char* kStrDescriptionServeSocket         = "Same as --serve, but serve the clients that connect to the Unix domain socket at the given path (Linux only).";
+static const char* kStrOptionBatch                    = "batch";
+static const char* kStrDescriptionBatch               = "Path to a JSON manifest of compile jobs to run in a single process: {\"jobs\": [{\"id\": <any value>, "
+                                                       "\"mode\": <mode>, \"inputs\": [<input files>], \"asics\": [<target devices>], \"options\": [<other "
+                                                       "command line arguments>], \"output_dir\": <directory for relative output file names>}]}. "
+                                                       "The longest jobs are started first, and up to --jobs jobs run concurrently.";
 static const char* kStrOptionBinary        = "b,binary";
 static const char* kStrDescriptionBinary   = "Path to ELF binary output file.";
 static const char* kStrOptionIsa           = "isa";
@@ -100,7 +127,9 @@ static const char* kStrDescriptionUpdates  = "Check for available updates.";
 static const char* kStrOptionVerbose       = "v,verbose";
 static const char* kStrDescriptionVerbose  = "Print command line strings that RGA uses to launch external processes.";
 static const char* kStrOptionCO            = "co";
-static const char* kStrDescriptionCO       = "Full path to the code object input file.";
+static const char* kStrDescriptionCO       = "Full path to the code object input file. The input can also be a directory, for all of the code object files under it, "
+                                             "or @<file>, for the code object files or directories that are listed in <file> (one per line). "
+                                             "Multiple code objects are analyzed concurrently, according to --jobs.";
 static const char* kStrOptionDisTxt        = "disassemble";
 static const char* kStrDescriptionDisTxt   = "Path to output text file where text disassembly of the binary would be saved.";
 static const char* kStrOptionIl            = "il";
@@ -139,6 +168,13 @@ bool ParseCmdLine(int argc, char* argv[], Config& config)
             (kStrOptionVersion, kStrDescriptionVersion)
             (kStrOptionHelp, kStrDescriptionHelp)
             (kStrOptionAnalysis, kStrDescriptionAnalysis, po::value<std::string>(config.analysis_file))
+            (kStrOptionLoopIterations, kStrDescriptionLoopIterations, po::value<int>(config.loop_iteration_count))
+            (kStrOptionLoopIterationsFile, kStrDescriptionLoopIterationsFile, po::value<std::string>(config.loop_iteration_file))
+            (kStrOptionJobs, kStrDescriptionJobs, po::value<int>(config.jobs))
+            (kStrOptionTraceFile, kStrDescriptionTraceFile, po::value<std::string>(config.trace_file))
+            (kStrOptionServe, kStrDescriptionServe)
+            (kStrOptionServeSocket, kStrDescriptionServeSocket, po::value<std::string>(config.serve_socket))
+            (kStrOptionBatch, kStrDescriptionBatch, po::value<std::string>(config.batch_file))
             (kStrOptionBinary, kStrDescriptionBinary, po::value<std::string>(config.binary_output_file))
             (kStrOptionIsa, kStrDescriptionIsa, po::value<std::string>(config.isa_file))
             (kStrOptionLivereg, kStrDescriptionLivereg, po::value<std::string>(config.livereg_analysis_file))
@@ -191,6 +227,11 @@ bool ParseCmdLine(int argc, char* argv[], Config& config)
                 "a Code Object type binary, the ISA would be generated for the entire program, since the binary has no per-kernel code sections.\n",
               po::value<std::string>(config.function))
             ("OpenCLoption", "OpenCL compiler options.  Repeatable.", po::value<std::vector<std::string>>(config.opencl_options))
+            ("cache-dir", "Path to a directory for caching compiled code objects and their disassembly. Compilations with the same sources, "
+                "options, target and compiler are loaded from the cache instead of being compiled again. The cache can be shared by "
+                "concurrent runs of RGA.", po::value<std::string>(config.cache_dir))
+            ("cache-size", "The maximum size of the cache directory in MB. The least recently used entries are removed once the size "
+                "is exceeded. The default is 1024.", po::value<int>(config.cache_size))
             ;
 
         // Vulkan shader type.
@@ -551,6 +592,18 @@ bool ParseCmdLine(int argc, char* argv[], Config& config)
             do_work = false;
         }
 
+        if (config.loop_iteration_count < 0)
+        {
+            std::cerr << kStrErrorNegativeLoopIterations << std::endl;
+            do_work = false;
+        }
+
+        // The loop iteration file is read once, and its counts are shared by the cycle estimates of all of the shaders and devices.
+        if (!config.loop_iteration_file.empty())
+        {
+            KcUtils::ReadLoopIterationFile(config.loop_iteration_file, config.loop_iteration_overrides, [](const std::string& s) { std::cerr << s; });
+        }
+
         // Set the optimization level.
         if (result.count("O0"))
         {
@@ -604,6 +657,14 @@ bool ParseCmdLine(int argc, char* argv[], Config& config)
         {
             config.requested_command = Config::kUpdate;
         }
+        else if (result.count("serve") || !config.serve_socket.empty())
+        {
+            config.requested_command = Config::kServe;
+        }
+        else if (!config.batch_file.empty())
+        {
+            config.requested_command = Config::kBatch;
+        }
         else if (!config.analysis_file.empty() || 
                  !config.il_file.empty() || 
                  !config.isa_file.empty() ||
@@ -640,6 +701,8 @@ bool ParseCmdLine(int argc, char* argv[], Config& config)
             if (config.requested_command != Config::kHelp &&
                 config.requested_command != Config::kVersion &&
                 config.requested_command != Config::kUpdate &&
+                config.requested_command != Config::kServe &&
+                config.requested_command != Config::kBatch &&
                 config.requested_command != Config::kGenVersionInfoFile)
             {
                 std::cout << kStrErrorNoModeSpecified << std::endl;
@@ -1078,6 +1141,9 @@ bool ParseCmdLine(int argc, char* argv[], Config& config)
                 (kStrOptionVersion, kStrDescriptionVersion)
                 (kStrOptionHelp, kStrDescriptionHelp)
                 (kStrOptionAnalysis, kStrDescriptionAnalysis, po::value<std::string>())
+                (kStrOptionLoopIterations, kStrDescriptionLoopIterations, po::value<int>())
+                (kStrOptionLoopIterationsFile, kStrDescriptionLoopIterationsFile, po::value<std::string>())
+                (kStrOptionJobs, kStrDescriptionJobs, po::value<int>())
                 (kStrOptionIsa, kStrDescriptionIsa, po::value<std::string>())
                 (kStrOptionLivereg, kStrDescriptionLivereg, po::value<std::string>())
                 (kStrOptionSgpr, kStrDescriptionSgpr, po::value<std::string>())
@@ -0,0 +1,740 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the server and batch modes of the CLI.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+// Linux.
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// JSON.
+#include "json/json-3.11.3/single_include/nlohmann/json.hpp"
+
+// Infra.
+#include "common/rg_log.h"
+
+// Backend.
+#include "radeon_gpu_analyzer_backend/be_utils.h"
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_cli_commander.h"
+#include "radeon_gpu_analyzer_cli/kc_cli_string_constants.h"
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
+#include "radeon_gpu_analyzer_cli/kc_parse_cmd_line.h"
+#include "radeon_gpu_analyzer_cli/kc_server.h"
+#include "radeon_gpu_analyzer_cli/kc_task_graph.h"
+#include "radeon_gpu_analyzer_cli/kc_utils.h"
+
+// The program name that is passed to the command line parser with the arguments of a request.
+static const char* kStrServeProgramName = "rga";
+
+// Request and response fields.
+static const char* kStrServeFieldId     = "id";
+static const char* kStrServeFieldArgs   = "args";
+static const char* kStrServeFieldStatus = "status";
+static const char* kStrServeFieldStdout = "stdout";
+static const char* kStrServeFieldStderr = "stderr";
+static const char* kStrServeFieldFiles  = "files";
+static const char* kStrServeFieldStats  = "stats";
+static const char* kStrServeFieldOutDir = "output_dir";
+
+// Batch job fields.
+static const char* kStrBatchFieldJobs    = "jobs";
+static const char* kStrBatchFieldMode    = "mode";
+static const char* kStrBatchFieldInputs  = "inputs";
+static const char* kStrBatchFieldAsics   = "asics";
+static const char* kStrBatchFieldOptions = "options";
+
+// Status values.
+static const char* kStrServeStatusSuccess = "success";
+static const char* kStrServeStatusFailure = "failure";
+
+#ifndef _WIN32
+// The size of the chunks that are read from the socket of a client.
+static const size_t kSocketReadChunkSize = 4096;
+#endif
+
+// The console output of the request that is being served on the calling thread (nullptr if none).
+static thread_local std::string* request_stdout = nullptr;
+static thread_local std::string* request_stderr = nullptr;
+
+// Serializes the writes to the console of the server.
+static std::mutex console_lock;
+
+// A stream buffer that holds the console output of the request that is being served on the calling thread,
+// or of the device task that runs on it for a request (see KcDeviceOutput::GetThreadOutput()),
+// and forwards the output of the other threads to the given buffer.
+// The buffer has no put area, so every write reaches it and is routed by the thread that makes it.
+class RequestStreamBuf : public std::streambuf
+{
+public:
+    RequestStreamBuf(bool is_stderr, std::streambuf* forward_buf)
+        : is_stderr_(is_stderr)
+        , forward_buf_(forward_buf)
+    {
+    }
+
+protected:
+    std::streamsize xsputn(const char* text, std::streamsize count) override
+    {
+        std::string*    capture       = (is_stderr_ ? request_stderr : request_stdout);
+        KcDeviceOutput* device_output = KcDeviceOutput::GetThreadOutput();
+        if (device_output != nullptr)
+        {
+            device_output->Write(is_stderr_, text, static_cast<size_t>(count));
+        }
+        else if (capture != nullptr)
+        {
+            capture->append(text, static_cast<size_t>(count));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(console_lock);
+            count = forward_buf_->sputn(text, count);
+        }
+        return count;
+    }
+
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            const char text = traits_type::to_char_type(ch);
+            xsputn(&text, 1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override
+    {
+        int ret = 0;
+        if (KcDeviceOutput::GetThreadOutput() == nullptr && (is_stderr_ ? request_stderr : request_stdout) == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(console_lock);
+            ret = forward_buf_->pubsync();
+        }
+        return ret;
+    }
+
+private:
+    bool            is_stderr_   = false;
+    std::streambuf* forward_buf_ = nullptr;
+};
+
+// Write a response line to the given console buffer.
+static void WriteConsoleLine(std::streambuf* console_buf, const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(console_lock);
+    console_buf->sputn(line.data(), static_cast<std::streamsize>(line.size()));
+    console_buf->sputc('\n');
+    console_buf->pubsync();
+}
+
+// Write text to the given console buffer.
+static void WriteConsoleText(std::streambuf* console_buf, const std::string& text)
+{
+    if (!text.empty())
+    {
+        std::lock_guard<std::mutex> lock(console_lock);
+        console_buf->sputn(text.data(), static_cast<std::streamsize>(text.size()));
+        console_buf->pubsync();
+    }
+}
+
+// Convert a statistics value to a JSON number if it is one, or to a JSON string otherwise.
+static nlohmann::json StatisticsValueToJson(const std::string& value)
+{
+    nlohmann::json ret   = value;
+    char*          end   = nullptr;
+    const char*    begin = value.c_str();
+    if (!value.empty())
+    {
+        const long long integer_value = std::strtoll(begin, &end, 10);
+        if (*end == '\0')
+        {
+            ret = integer_value;
+        }
+        else
+        {
+            const double real_value = std::strtod(begin, &end);
+            if (*end == '\0')
+            {
+                ret = real_value;
+            }
+        }
+    }
+    return ret;
+}
+
+// Read the statistics of an entry from its CSV file (a header line and a line of values) as {column: value}.
+static bool ReadStatistics(const std::string& stats_file, char csv_separator, nlohmann::json& stats)
+{
+    std::ifstream input(stats_file);
+    std::string   header_line, values_line;
+    bool          ret = static_cast<bool>(std::getline(input, header_line)) && static_cast<bool>(std::getline(input, values_line));
+    if (ret)
+    {
+        std::vector<std::string> columns, values;
+        BeUtils::SplitString(header_line, csv_separator, columns);
+        BeUtils::SplitString(values_line, csv_separator, values);
+        stats = nlohmann::json::object();
+        for (size_t i = 0; i < std::min(columns.size(), values.size()); i++)
+        {
+            stats[columns[i]] = StatisticsValueToJson(values[i]);
+        }
+    }
+    return ret;
+}
+
+// Describe the output files of a request, with the statistics of each entry inlined.
+static nlohmann::json OutputFilesToJson(const Config& config, const RgClOutputMetadata& output_files)
+{
+    nlohmann::json ret           = nlohmann::json::array();
+    const char     csv_separator = KcUtils::GetCsvSeparator(config);
+    for (const auto& entry : output_files)
+    {
+        const RgOutputFiles& outputs = entry.second;
+        nlohmann::json       file    = {{"device", entry.first.first},
+                                        {"entry", entry.first.second},
+                                        {kStrServeFieldStatus, (outputs.status ? kStrServeStatusSuccess : kStrServeStatusFailure)}};
+
+        auto add_path = [&file](const char* name, const std::string& path) {
+            if (!path.empty())
+            {
+                file[name] = path;
+            }
+        };
+
+        // The temporary files are deleted by the post-compile steps.
+        add_path("isa", (outputs.is_isa_file_temp ? "" : outputs.isa_file));
+        add_path("bin", (outputs.is_bin_file_temp ? "" : outputs.bin_file));
+        add_path("isa_csv", outputs.isa_csv_file);
+        add_path("stats_file", outputs.stats_file);
+        add_path("livereg", outputs.livereg_file);
+        add_path("livereg_sgpr", outputs.livereg_sgpr_file);
+        add_path("cfg", outputs.cfg_file);
+
+        nlohmann::json stats;
+        if (!outputs.stats_file.empty() && ReadStatistics(outputs.stats_file, csv_separator, stats))
+        {
+            file[kStrServeFieldStats] = stats;
+        }
+        ret.push_back(file);
+    }
+    return ret;
+}
+
+#ifndef _WIN32
+// Reads the lines of the socket of a client.
+class SocketLineReader
+{
+public:
+    explicit SocketLineReader(int socket_fd)
+        : socket_fd_(socket_fd)
+    {
+    }
+
+    // Read the next line. Returns false when the client closes the socket.
+    bool ReadLine(std::string& line)
+    {
+        size_t newline_pos = std::string::npos;
+        bool   ret         = true;
+        while (ret && (newline_pos = buffer_.find('\n')) == std::string::npos)
+        {
+            char          chunk[kSocketReadChunkSize];
+            const ssize_t count = recv(socket_fd_, chunk, sizeof(chunk), 0);
+            if (count > 0)
+            {
+                buffer_.append(chunk, static_cast<size_t>(count));
+            }
+            else if (count == 0 || errno != EINTR)
+            {
+                ret = false;
+            }
+        }
+
+        if (ret)
+        {
+            line = buffer_.substr(0, newline_pos);
+            buffer_.erase(0, newline_pos + 1);
+        }
+        else if (!buffer_.empty())
+        {
+            // Serve the last request even if it is not terminated.
+            line.swap(buffer_);
+            buffer_.clear();
+            ret = true;
+        }
+        return ret;
+    }
+
+private:
+    int         socket_fd_ = -1;
+    std::string buffer_;
+};
+
+// Write a response line to the socket of a client.
+static void SendLine(int socket_fd, const std::string& line)
+{
+    const std::string data   = line + "\n";
+    size_t            offset = 0;
+    while (offset < data.size())
+    {
+        // MSG_NOSIGNAL: a client that went away must not kill the server with SIGPIPE.
+        const ssize_t count = send(socket_fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (count > 0)
+        {
+            offset += static_cast<size_t>(count);
+        }
+        else if (count < 0 && errno != EINTR)
+        {
+            break;
+        }
+    }
+}
+#endif
+
+// Resolve the relative output file names of a request against its output directory.
+static bool ApplyOutputDir(const std::string& output_dir, Config& config)
+{
+    std::error_code error;
+    std::filesystem::create_directories(output_dir, error);
+    bool ret = std::filesystem::is_directory(output_dir, error);
+    if (ret)
+    {
+        for (std::string* output_file : {&config.analysis_file,
+                                         &config.il_file,
+                                         &config.isa_file,
+                                         &config.livereg_analysis_file,
+                                         &config.sgpr_livereg_analysis_file,
+                                         &config.block_cfg_file,
+                                         &config.inst_cfg_file,
+                                         &config.binary_output_file,
+                                         &config.metadata_file,
+                                         &config.session_metadata_file})
+        {
+            if (!output_file->empty() && std::filesystem::path(*output_file).is_relative())
+            {
+                *output_file = (std::filesystem::path(output_dir) / *output_file).string();
+            }
+        }
+    }
+    else
+    {
+        RgLog::stdErr << kStrErrorCannotCreateOutputDir << output_dir << std::endl;
+    }
+    return ret;
+}
+
+// True if the output files of the mode are reported by its commander (see KcCliCommander::GetOutputFiles()).
+static bool IsRequestModeSupported(beKA::RgaMode mode)
+{
+    return mode == beKA::RgaMode::kModeOpenclOffline || mode == beKA::RgaMode::kModeVulkan || mode == beKA::RgaMode::kModeVkOffline ||
+           mode == beKA::RgaMode::kModeVkOfflineSpv || mode == beKA::RgaMode::kModeVkOfflineSpvTxt;
+}
+
+// Perform a single request with up to "jobs" threads for its devices, and describe its status, console output and output files
+// in "response". Returns true if the request succeeded.
+static bool PerformRequest(const KcServer::RunCommandFunction& run_command, const nlohmann::json& request, int jobs, nlohmann::json& response)
+{
+    std::string std_out, std_err;
+    bool        ret = false;
+    response        = nlohmann::json::object();
+
+    // Hold the console output of the request.
+    request_stdout = &std_out;
+    request_stderr = &std_err;
+
+    const bool is_object = request.is_object();
+    if (is_object && request.contains(kStrServeFieldId))
+    {
+        response[kStrServeFieldId] = request[kStrServeFieldId];
+    }
+
+    // Build the command line of the request.
+    std::vector<std::string> args     = {kStrServeProgramName};
+    bool                     is_valid = is_object && request.contains(kStrServeFieldArgs) && request[kStrServeFieldArgs].is_array() &&
+                                        (!request.contains(kStrServeFieldOutDir) || request[kStrServeFieldOutDir].is_string());
+    if (is_valid)
+    {
+        for (const nlohmann::json& arg : request[kStrServeFieldArgs])
+        {
+            is_valid = is_valid && arg.is_string();
+            if (is_valid)
+            {
+                args.push_back(arg.get<std::string>());
+            }
+        }
+    }
+
+    if (!is_valid)
+    {
+        RgLog::stdErr << kStrErrorServeInvalidRequest << std::endl;
+    }
+    else
+    {
+        std::vector<char*> argv;
+        for (std::string& arg : args)
+        {
+            argv.push_back(&arg[0]);
+        }
+        argv.push_back(nullptr);
+
+        Config config;
+        ret = ParseCmdLine(static_cast<int>(args.size()), argv.data(), config);
+        if (ret && (config.requested_command == Config::kServe || config.requested_command == Config::kBatch))
+        {
+            RgLog::stdErr << kStrErrorServeNestedServe << std::endl;
+            ret = false;
+        }
+
+        if (ret && config.requested_command == Config::kCompile && !IsRequestModeSupported(config.mode))
+        {
+            RgLog::stdErr << kStrErrorServeModeNotSupported << std::endl;
+            ret = false;
+        }
+
+        // The Vulkan mode passes the loader debug level to the driver through the environment of the process.
+        if (ret && !config.loader_debug.empty())
+        {
+            RgLog::stdErr << kStrErrorServeLoaderDebugNotSupported << std::endl;
+            ret = false;
+        }
+
+        if (ret && request.contains(kStrServeFieldOutDir))
+        {
+            ret = ApplyOutputDir(request[kStrServeFieldOutDir].get<std::string>(), config);
+        }
+
+        if (ret)
+        {
+            // The request holds one of the threads of the server, and its devices take the threads that are free.
+            KcDeviceExecutor::SharedThread request_thread;
+            config.jobs = jobs;
+
+            std::shared_ptr<KcCliCommander> commander = nullptr;
+            ret                                        = run_command(config, commander);
+            if (commander != nullptr)
+            {
+                RgClOutputMetadata output_files;
+                commander->GetOutputFiles(output_files);
+                response[kStrServeFieldFiles] = OutputFilesToJson(config, output_files);
+            }
+        }
+    }
+
+    request_stdout = nullptr;
+    request_stderr = nullptr;
+
+    response[kStrServeFieldStatus] = (ret ? kStrServeStatusSuccess : kStrServeStatusFailure);
+    response[kStrServeFieldStdout] = std_out;
+    response[kStrServeFieldStderr] = std_err;
+    return ret;
+}
+
+// A job of a batch, converted to a request.
+struct BatchJob
+{
+    std::string    name;
+    nlohmann::json request;
+    uint64_t       cost = 0;
+};
+
+// Append the strings of a JSON array field of a job to "args", with the given prefix before each of them.
+// Returns false if the field is present but is not an array of strings.
+static bool AppendJobArgs(const nlohmann::json& job, const char* field, const char* prefix, std::vector<std::string>& args)
+{
+    bool ret = !job.contains(field) || job[field].is_array();
+    if (ret && job.contains(field))
+    {
+        for (const nlohmann::json& value : job[field])
+        {
+            ret = ret && value.is_string();
+            if (ret)
+            {
+                if (prefix != nullptr)
+                {
+                    args.push_back(prefix);
+                }
+                args.push_back(value.get<std::string>());
+            }
+        }
+    }
+    return ret;
+}
+
+// Convert a job of a batch to a request, and estimate its cost from the size of its inputs and the number of its target devices.
+// A job without devices targets all of the "all_device_count" supported devices.
+static bool JobToRequest(const nlohmann::json& job, size_t job_index, size_t all_device_count, BatchJob& batch_job)
+{
+    std::vector<std::string> args;
+    bool                     ret = job.is_object() && job.contains(kStrBatchFieldMode) && job[kStrBatchFieldMode].is_string();
+    if (ret)
+    {
+        args = {"-s", job[kStrBatchFieldMode].get<std::string>()};
+        ret  = AppendJobArgs(job, kStrBatchFieldAsics, "-c", args) && AppendJobArgs(job, kStrBatchFieldOptions, nullptr, args);
+    }
+
+    std::vector<std::string> inputs;
+    ret = ret && AppendJobArgs(job, kStrBatchFieldInputs, nullptr, inputs);
+    if (ret)
+    {
+        args.insert(args.end(), inputs.begin(), inputs.end());
+        batch_job.request = {{kStrServeFieldArgs, args}};
+        if (job.contains(kStrServeFieldOutDir))
+        {
+            batch_job.request[kStrServeFieldOutDir] = job[kStrServeFieldOutDir];
+        }
+
+        // Name the job by its id, or by its position in the batch.
+        if (job.contains(kStrServeFieldId))
+        {
+            batch_job.name = (job[kStrServeFieldId].is_string() ? job[kStrServeFieldId].get<std::string>() : job[kStrServeFieldId].dump());
+        }
+        else
+        {
+            batch_job.name = std::to_string(job_index);
+        }
+
+        uint64_t input_size = 0;
+        for (const std::string& input : inputs)
+        {
+            std::error_code error;
+            const uintmax_t file_size = std::filesystem::file_size(input, error);
+            input_size += (error ? 0 : file_size);
+        }
+        const size_t device_count = (job.contains(kStrBatchFieldAsics) && !job[kStrBatchFieldAsics].empty() ? job[kStrBatchFieldAsics].size() : all_device_count);
+        batch_job.cost            = std::max<uint64_t>(input_size, 1) * std::max<size_t>(device_count, 1);
+    }
+    return ret;
+}
+
+KcServer::KcServer(const Config& config, const RunCommandFunction& run_command)
+    : config_(config)
+    , run_command_(run_command)
+{
+    request_jobs_ = (config.jobs > 0 ? config.jobs : static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u)));
+}
+
+bool KcServer::Run()
+{
+    // Hold the console output of each request, and of the devices that are compiled for it on other threads,
+    // so that it is returned in the response.
+    // When serving stdin, the output of the other threads goes to stderr, so that it does not corrupt the responses.
+    const bool      is_stdin_served = (config_.requested_command == Config::kServe && config_.serve_socket.empty());
+    std::streambuf* stdout_buf      = std::cout.rdbuf();
+    std::streambuf* stderr_buf      = std::cerr.rdbuf();
+    RequestStreamBuf request_stdout_buf(false, (is_stdin_served ? stderr_buf : stdout_buf));
+    RequestStreamBuf request_stderr_buf(true, stderr_buf);
+    std::cout.rdbuf(&request_stdout_buf);
+    std::cerr.rdbuf(&request_stderr_buf);
+    std::ostream* stdin_tie = std::cin.tie(nullptr);
+
+    // The requests and their devices share the threads of the server.
+    KcDeviceExecutor::SetSharedThreadCount(request_jobs_);
+
+    bool ret = true;
+    if (config_.requested_command == Config::kBatch)
+    {
+        ret = RunBatch(stdout_buf, stderr_buf);
+    }
+    else if (is_stdin_served)
+    {
+        ServeClient([](std::string& line) { return static_cast<bool>(std::getline(std::cin, line)); },
+                    [stdout_buf](const std::string& line) { WriteConsoleLine(stdout_buf, line); });
+    }
+    else
+    {
+        ret = ServeSocket();
+    }
+
+    KcDeviceExecutor::SetSharedThreadCount(0);
+    std::cin.tie(stdin_tie);
+    std::cout.rdbuf(stdout_buf);
+    std::cerr.rdbuf(stderr_buf);
+    return ret;
+}
+
+void KcServer::ServeClient(const ReadLineFunction& read_line, const WriteLineFunction& write_line)
+{
+    // The calling thread only reads the requests, so it is not counted as one of the request threads.
+    KcTaskGraph request_graph(request_jobs_ + 1);
+    std::string request_line;
+    while (read_line(request_line))
+    {
+        if (!request_line.empty() && request_line.back() == '\r')
+        {
+            request_line.pop_back();
+        }
+
+        if (!request_line.empty())
+        {
+            request_graph.AddTask([this, request_line, &write_line]() { write_line(HandleRequest(request_line)); });
+        }
+    }
+    request_graph.Wait();
+}
+
+bool KcServer::ServeSocket()
+{
+#ifdef _WIN32
+    RgLog::stdErr << kStrErrorServeSocketNotSupported << std::endl;
+    return false;
+#else
+    sockaddr_un address = {};
+    address.sun_family  = AF_UNIX;
+    int  listen_fd      = -1;
+    bool ret            = (config_.serve_socket.size() < sizeof(address.sun_path));
+    if (ret)
+    {
+        std::memcpy(address.sun_path, config_.serve_socket.c_str(), config_.serve_socket.size() + 1);
+
+        // Remove the socket of a previous server, but never a file of another kind.
+        struct stat path_stat;
+        if (lstat(address.sun_path, &path_stat) == 0 && S_ISSOCK(path_stat.st_mode))
+        {
+            unlink(address.sun_path);
+        }
+
+        listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        ret       = (listen_fd != -1 && bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 &&
+               listen(listen_fd, SOMAXCONN) == 0);
+    }
+
+    if (ret)
+    {
+        // Serve each client on its own thread, until the socket fails.
+        std::vector<std::thread> client_threads;
+        for (;;)
+        {
+            const int client_fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client_fd == -1)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                {
+                    continue;
+                }
+                break;
+            }
+
+            client_threads.emplace_back([this, client_fd]() {
+                SocketLineReader reader(client_fd);
+                std::mutex       write_lock;
+                ServeClient([&reader](std::string& line) { return reader.ReadLine(line); },
+                            [client_fd, &write_lock](const std::string& line) {
+                                std::lock_guard<std::mutex> lock(write_lock);
+                                SendLine(client_fd, line);
+                            });
+                close(client_fd);
+                RgLog::CloseThreadLog();
+            });
+        }
+
+        for (std::thread& client_thread : client_threads)
+        {
+            client_thread.join();
+        }
+        ret = false;
+    }
+
+    if (!ret)
+    {
+        RgLog::stdErr << kStrErrorCannotServeOnSocket << config_.serve_socket << std::endl;
+    }
+
+    if (listen_fd != -1)
+    {
+        close(listen_fd);
+    }
+    return ret;
+#endif
+}
+
+std::string KcServer::HandleRequest(const std::string& request_line)
+{
+    nlohmann::json response;
+    PerformRequest(run_command_, nlohmann::json::parse(request_line, nullptr, false), request_jobs_, response);
+
+    // The compiler output may not be valid UTF-8.
+    return response.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+bool KcServer::RunBatch(std::streambuf* stdout_buf, std::streambuf* stderr_buf)
+{
+    // Convert the jobs to requests, with the estimated cost of each job.
+    std::ifstream         batch_input(config_.batch_file);
+    const nlohmann::json  batch = nlohmann::json::parse(batch_input, nullptr, false);
+    std::vector<BatchJob> jobs;
+    bool                  ret = batch.is_object() && batch.contains(kStrBatchFieldJobs) && batch[kStrBatchFieldJobs].is_array();
+    if (ret)
+    {
+        std::vector<GDT_GfxCardInfo> card_list;
+        std::set<std::string>        all_devices;
+        BeUtils::GetAllGraphicsCards(card_list, all_devices);
+        for (const nlohmann::json& job : batch[kStrBatchFieldJobs])
+        {
+            BatchJob batch_job;
+            ret = ret && JobToRequest(job, jobs.size(), all_devices.size(), batch_job);
+            jobs.push_back(batch_job);
+        }
+    }
+
+    if (!ret)
+    {
+        RgLog::stdErr << kStrErrorInvalidBatchFile << config_.batch_file << std::endl;
+    }
+    else
+    {
+        // Start the longest jobs first, so that the short ones fill the gaps at the end instead of a long one running alone.
+        std::stable_sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) { return a.cost > b.cost; });
+
+        std::atomic<size_t> succeeded_count(0);
+        {
+            KcTaskGraph job_graph(request_jobs_);
+            for (const BatchJob& job : jobs)
+            {
+                job_graph.AddTask([&, job]() {
+                    nlohmann::json response;
+                    const bool     is_succeeded = PerformRequest(run_command_, job.request, request_jobs_, response);
+                    succeeded_count += (is_succeeded ? 1 : 0);
+
+                    // Print the console output of each job in one piece.
+                    std::stringstream job_status;
+                    job_status << kStrInfoBatchJobA << job.name << (is_succeeded ? kStrInfoBatchJobSucceeded : kStrInfoBatchJobFailed) << std::endl;
+                    WriteConsoleText(stdout_buf, response[kStrServeFieldStdout].get<std::string>() + job_status.str());
+                    WriteConsoleText(stderr_buf, response[kStrServeFieldStderr].get<std::string>());
+                });
+            }
+            job_graph.Wait();
+        }
+
+        std::stringstream summary;
+        summary << kStrInfoBatchSummaryA << succeeded_count << kStrInfoBatchSummaryB << jobs.size() << kStrInfoBatchSummaryC << std::endl;
+        WriteConsoleText(stdout_buf, summary.str());
+        ret = (succeeded_count == jobs.size());
+    }
+
+    return ret;
+}
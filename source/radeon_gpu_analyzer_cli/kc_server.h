@@ -0,0 +1,77 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for the server and batch modes of the CLI.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERCLI_SRC_KC_SERVER_H_
+#define RGA_RADEONGPUANALYZERCLI_SRC_KC_SERVER_H_
+
+// C++.
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_config.h"
+
+class KcCliCommander;
+
+// Serves compile and analysis requests in a single long-lived process, so that the state that is built by the first
+// request (the device tables, the compiler versions and the performance tables of the ISA analysis) is reused by the
+// following ones instead of being rebuilt by a new process for each invocation.
+//
+// Each request is a line with a JSON object: {"id": <any value>, "args": [<the command line arguments of an RGA invocation>]}.
+// Each response is a line with a JSON object: {"id": <the id of the request>, "status": "success" | "failure",
+// "stdout": <console output>, "stderr": <console errors>, "files": [<the output files and the statistics of each entry>]}.
+// The requests of a client are served concurrently, so the responses may arrive in a different order.
+// The devices of the requests are compiled on the same threads, which the requests take when they are free.
+//
+// In batch mode, the jobs of a JSON manifest are converted to requests and run on a single pool of threads,
+// with the console output of each job printed in one piece when it is done.
+class KcServer
+{
+public:
+    // Performs the command of a parsed request, and returns the commander that performed it (if any).
+    // Returns false on failure.
+    typedef std::function<bool(Config&, std::shared_ptr<KcCliCommander>&)> RunCommandFunction;
+
+    KcServer(const Config& config, const RunCommandFunction& run_command);
+
+    // Serve the requests from stdin until it is closed, or the clients of the configured socket until the socket fails,
+    // or run the jobs of the configured batch file.
+    // Returns false if the requests cannot be served, or if a job of the batch fails.
+    bool Run();
+
+private:
+    // Reads the next request line of a client. Returns false at the end of the requests.
+    typedef std::function<bool(std::string&)> ReadLineFunction;
+
+    // Writes a response line to a client. Must be safe to call from any thread.
+    typedef std::function<void(const std::string&)> WriteLineFunction;
+
+    // Serve the requests of a single client until "read_line" fails, and wait for the requests that are in progress.
+    void ServeClient(const ReadLineFunction& read_line, const WriteLineFunction& write_line);
+
+    // Serve the clients that connect to the configured Unix domain socket.
+    bool ServeSocket();
+
+    // Perform a single request and return its response.
+    std::string HandleRequest(const std::string& request_line);
+
+    // Run the jobs of the configured batch file, and print their console output to the given console buffers.
+    bool RunBatch(std::streambuf* stdout_buf, std::streambuf* stderr_buf);
+
+    // The configuration of the server.
+    Config config_;
+
+    // Performs the command of a request.
+    RunCommandFunction run_command_;
+
+    // The maximum number of requests of a client (or jobs of a batch) that are served concurrently.
+    int request_jobs_ = 1;
+};
+
+#endif  // RGA_RADEONGPUANALYZERCLI_SRC_KC_SERVER_H_
@@ -19,42 +19,48 @@ struct DeviceProps
     uint64_t available_lds_bytes;
     uint64_t min_sgprs;
     uint64_t min_vgprs;
+
+    // The VGPRs of a wave64 are allocated in blocks of this many registers. A wave32 gets blocks of twice as many.
+    uint64_t vgpr_granularity;
+
+    // The SGPRs of a wave are allocated in blocks of this many registers, or 0 if every wave gets all of the available SGPRs.
+    uint64_t sgpr_granularity;
 };
 
 static const std::map<std::string, DeviceProps> kRgaDeviceProps = {
-    {"carrizo", {102, 256, 65536, 16, 4}},   
-    {"tonga", {102, 256, 65536, 16, 64}},  
-    {"fiji", {102, 256, 65536, 16, 4}},
-    {"ellesmere", {102, 256, 65536, 16, 4}}, 
-    {"baffin", {102, 256, 65536, 16, 4}},  
-    {"polaris10", {102, 256, 65536, 16, 4}},
-    {"polaris11", {102, 256, 65536, 16, 4}}, 
-    {"gfx804", {102, 256, 65536, 16, 4}},  
-    {"gfx900", {102, 256, 65536, 16, 4}},
-    {"gfx902", {102, 256, 65536, 16, 4}},    
-    {"gfx904", {102, 256, 65536, 16, 4}},  
-    {"gfx906", {102, 256, 65536, 16, 4}},
-    {"gfx908", {102, 256, 65536, 16, 4}},    
-    {"gfx90a", {102, 256, 65536, 16, 4}},  
-    {"gfx90c", {102, 256, 65536, 16, 4}},
-    {"gfx942", {102, 256, 65536, 16, 8}},    
-    {"gfx950", {102, 256, 163840, 16, 8}},
-    {"gfx1010", {106, 256, 65536, 16, 4}}, 
-    {"gfx1011", {106, 256, 65536, 16, 4}},
-    {"gfx1012", {106, 256, 65536, 16, 4}},  
-    {"gfx1030", {106, 256, 65536, 16, 4}}, 
-    {"gfx1031", {106, 256, 65536, 16, 4}},
-    {"gfx1032", {106, 256, 65536, 16, 4}},   
-    {"gfx1034", {106, 256, 65536, 16, 4}}, 
-    {"gfx1035", {106, 256, 65536, 16, 4}},
-    {"gfx1100", {106, 256, 65536, 16, 4}},   
-    {"gfx1101", {106, 256, 65536, 16, 4}}, 
-    {"gfx1102", {106, 256, 65536, 16, 4}},
-    {"gfx1103", {106, 256, 65536, 16, 4}},   
-    {"gfx1150", {106, 256, 65536, 16, 4}}, 
-    {"gfx1151", {106, 256, 65536, 16, 4}},
-    {"gfx1152", {106, 256, 65536, 16, 4}},
-    {"gfx1153", {106, 256, 65536, 16, 4}},
-    {"gfx1200", {106, 256, 65536, 16, 4}},
-    {"gfx1201", {106, 256, 65536, 16, 4}}
+    {"carrizo", {102, 256, 65536, 16, 4, 4, 16}},
+    {"tonga", {102, 256, 65536, 16, 64, 4, 16}},
+    {"fiji", {102, 256, 65536, 16, 4, 4, 16}},
+    {"ellesmere", {102, 256, 65536, 16, 4, 4, 16}},
+    {"baffin", {102, 256, 65536, 16, 4, 4, 16}},
+    {"polaris10", {102, 256, 65536, 16, 4, 4, 16}},
+    {"polaris11", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx804", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx900", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx902", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx904", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx906", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx908", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx90a", {102, 256, 65536, 16, 4, 8, 16}},
+    {"gfx90c", {102, 256, 65536, 16, 4, 4, 16}},
+    {"gfx942", {102, 256, 65536, 16, 8, 8, 16}},
+    {"gfx950", {102, 256, 163840, 16, 8, 8, 16}},
+    {"gfx1010", {106, 256, 65536, 16, 4, 4, 0}},
+    {"gfx1011", {106, 256, 65536, 16, 4, 4, 0}},
+    {"gfx1012", {106, 256, 65536, 16, 4, 4, 0}},
+    {"gfx1030", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1031", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1032", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1034", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1035", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1100", {106, 256, 65536, 16, 4, 12, 0}},
+    {"gfx1101", {106, 256, 65536, 16, 4, 12, 0}},
+    {"gfx1102", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1103", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1150", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1151", {106, 256, 65536, 16, 4, 12, 0}},
+    {"gfx1152", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1153", {106, 256, 65536, 16, 4, 8, 0}},
+    {"gfx1200", {106, 256, 65536, 16, 4, 12, 0}},
+    {"gfx1201", {106, 256, 65536, 16, 4, 12, 0}}
 };
@@ -0,0 +1,153 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for a graph of tasks with dependencies that runs on a pool of threads.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+// Shared.
+#include "common/rg_log.h"
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_device_executor.h"
+#include "radeon_gpu_analyzer_cli/kc_task_graph.h"
+
+// The interval at which a worker that waits for a shared thread checks again whether one is free.
+static const std::chrono::milliseconds kSharedThreadPollInterval(10);
+
+KcTaskGraph::KcTaskGraph(int jobs, bool is_shared)
+    : is_shared_(is_shared)
+{
+    unsigned int thread_count = (jobs < 0 ? 1 : static_cast<unsigned int>(jobs));
+    if (thread_count == 0)
+    {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    // The thread that calls Wait() is one of the workers.
+    for (unsigned int i = 1; i < thread_count; i++)
+    {
+        workers_.emplace_back(&KcTaskGraph::RunWorker, this);
+    }
+}
+
+KcTaskGraph::~KcTaskGraph()
+{
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        is_stopping_ = true;
+    }
+    state_changed_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+KcTaskGraph::TaskId KcTaskGraph::AddTask(const Task& task, const std::vector<TaskId>& dependencies)
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    const TaskId                 id = nodes_.size();
+    nodes_.emplace_back();
+    Node& node = nodes_.back();
+    node.task  = task;
+    for (TaskId dependency : dependencies)
+    {
+        assert(dependency < id);
+        if (dependency < id && !nodes_[dependency].is_done)
+        {
+            nodes_[dependency].dependents.push_back(id);
+            node.pending_dependency_count++;
+        }
+    }
+    pending_task_count_++;
+
+    if (node.pending_dependency_count == 0)
+    {
+        ready_tasks_.push_back(id);
+        lock.unlock();
+        state_changed_.notify_one();
+    }
+    return id;
+}
+
+void KcTaskGraph::Wait()
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    while (pending_task_count_ > 0)
+    {
+        if (ready_tasks_.empty())
+        {
+            state_changed_.wait(lock);
+        }
+        else
+        {
+            RunReadyTask(lock);
+        }
+    }
+}
+
+void KcTaskGraph::RunReadyTask(std::unique_lock<std::mutex>& lock)
+{
+    const TaskId id = ready_tasks_.front();
+    ready_tasks_.pop_front();
+
+    // Release the task (and whatever it holds) once it was run.
+    Task task;
+    task.swap(nodes_[id].task);
+    lock.unlock();
+    task();
+    task = nullptr;
+    lock.lock();
+
+    Node& node   = nodes_[id];
+    node.is_done = true;
+    for (TaskId dependent : node.dependents)
+    {
+        if (--nodes_[dependent].pending_dependency_count == 0)
+        {
+            ready_tasks_.push_back(dependent);
+        }
+    }
+    node.dependents.clear();
+    pending_task_count_--;
+
+    // Wake up the workers for the released tasks, and Wait() if this was the last task.
+    state_changed_.notify_all();
+}
+
+void KcTaskGraph::RunWorker()
+{
+    std::unique_lock<std::mutex> lock(lock_);
+    while (!is_stopping_)
+    {
+        if (ready_tasks_.empty())
+        {
+            state_changed_.wait(lock);
+        }
+        else if (!is_shared_ || KcDeviceExecutor::TryTakeSharedThread())
+        {
+            RunReadyTask(lock);
+            if (is_shared_)
+            {
+                KcDeviceExecutor::ReturnSharedThread();
+            }
+        }
+        else
+        {
+            // All of the shared threads are busy. The shared threads are returned by other executors and graphs,
+            // so this worker checks again shortly, unless the task is taken by Wait() or by a worker of this graph first.
+            state_changed_.wait_for(lock, kSharedThreadPollInterval);
+        }
+    }
+    lock.unlock();
+
+    // Release the log slot of this thread, since the number of the slots is limited.
+    RgLog::CloseThreadLog();
+}
@@ -0,0 +1,80 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for a graph of tasks with dependencies that runs on a pool of threads.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERCLI_SRC_KC_TASK_GRAPH_H_
+#define RGA_RADEONGPUANALYZERCLI_SRC_KC_TASK_GRAPH_H_
+
+// C++.
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A graph of tasks with dependencies, that runs on a pool of worker threads.
+// A task starts once all of the tasks that it depends on are done. Tasks can be added while the graph is running,
+// so the tasks of one device can run while other devices are still being compiled.
+class KcTaskGraph
+{
+public:
+    typedef size_t                TaskId;
+    typedef std::function<void()> Task;
+
+    // Create a graph that runs its tasks on up to "jobs" threads (0 for the number of hardware threads).
+    // The thread that calls Wait() is one of them, so with a single job the tasks only run in Wait().
+    // If "is_shared" is true, the other threads run a task only while they hold one of the threads that are shared by the
+    // executors (see KcDeviceExecutor::SetSharedThreadCount()), so that the graph and the executors that run at once
+    // do not use more threads than they share. The thread that calls Wait() uses the shared thread that it holds.
+    explicit KcTaskGraph(int jobs, bool is_shared = false);
+
+    // Waits for all of the tasks and stops the worker threads.
+    ~KcTaskGraph();
+
+    // Add a task that starts once all of the given tasks are done.
+    // This function can be called from any thread, including from a running task.
+    TaskId AddTask(const Task& task, const std::vector<TaskId>& dependencies = {});
+
+    // Run tasks on the calling thread until all of the tasks that were added are done.
+    void Wait();
+
+private:
+    struct Node
+    {
+        Task                task;
+        size_t              pending_dependency_count = 0;
+        std::vector<TaskId> dependents;
+        bool                is_done = false;
+    };
+
+    // Run the next ready task with "lock" released, and release its dependents.
+    void RunReadyTask(std::unique_lock<std::mutex>& lock);
+
+    // The main function of the worker threads.
+    void RunWorker();
+
+    // The nodes of the graph, indexed by the task ID. A deque keeps the nodes in place as the graph grows.
+    std::deque<Node> nodes_;
+
+    // The tasks whose dependencies are done.
+    std::deque<TaskId> ready_tasks_;
+
+    // The number of tasks that are not done.
+    size_t pending_task_count_ = 0;
+
+    // True when the worker threads should exit.
+    bool is_stopping_ = false;
+
+    // True if the worker threads take one of the shared threads for each task.
+    bool is_shared_ = false;
+
+    std::mutex               lock_;
+    std::condition_variable  state_changed_;
+    std::vector<std::thread> workers_;
+};
+
+#endif // RGA_RADEONGPUANALYZERCLI_SRC_KC_TASK_GRAPH_H_
@@ -0,0 +1,178 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Implementation for the recorder of trace events of the CLI phases.
+//=============================================================================
+
+// C++.
+#include <atomic>
+#include <fstream>
+#include <mutex>
+
+// JSON.
+#include "json/json-3.11.3/single_include/nlohmann/json.hpp"
+
+// Infra.
+#include "external/amdt_os_wrappers/Include/osProcess.h"
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
+
+// A recorded span.
+struct TraceEvent
+{
+    std::string                                      category;
+    std::string                                      name;
+    int64_t                                          start_us     = 0;
+    int64_t                                          duration_us  = 0;
+    int                                              thread_index = 0;
+    std::vector<std::pair<std::string, std::string>> args;
+};
+
+// The state of the recording.
+static std::atomic<bool>                     is_trace_enabled(false);
+static std::mutex                            trace_lock;
+static std::string                           trace_filename;
+static std::chrono::steady_clock::time_point trace_start;
+static std::vector<TraceEvent>               trace_events;
+static int                                   trace_thread_count = 0;
+
+// The context of the calling thread.
+static thread_local std::string trace_device;
+static thread_local std::string trace_kernel;
+
+// The index of the calling thread in the trace (the threads are numbered in the order of their first event).
+// Must be called with "trace_lock" held.
+static int GetTraceThreadIndex()
+{
+    static thread_local int thread_index = -1;
+    if (thread_index == -1)
+    {
+        thread_index = trace_thread_count++;
+    }
+    return thread_index;
+}
+
+void KcTrace::Start(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(trace_lock);
+    trace_filename = filename;
+    trace_start    = std::chrono::steady_clock::now();
+    trace_events.clear();
+
+    // The thread that starts the recording is the main thread.
+    GetTraceThreadIndex();
+    is_trace_enabled = true;
+}
+
+bool KcTrace::Finish()
+{
+    bool ret = true;
+    if (is_trace_enabled)
+    {
+        std::lock_guard<std::mutex> lock(trace_lock);
+        is_trace_enabled = false;
+
+        const unsigned long process_id = static_cast<unsigned long>(osGetCurrentProcessId());
+        nlohmann::json      events     = nlohmann::json::array();
+        for (int i = 0; i < trace_thread_count; i++)
+        {
+            events.push_back({{"name", "thread_name"},
+                              {"ph", "M"},
+                              {"pid", process_id},
+                              {"tid", i},
+                              {"args", {{"name", (i == 0 ? std::string("main") : "worker " + std::to_string(i))}}}});
+        }
+
+        for (const TraceEvent& event : trace_events)
+        {
+            nlohmann::json args = nlohmann::json::object();
+            for (const auto& arg : event.args)
+            {
+                args[arg.first] = arg.second;
+            }
+            events.push_back({{"name", event.name},
+                              {"cat", event.category},
+                              {"ph", "X"},
+                              {"ts", event.start_us},
+                              {"dur", event.duration_us},
+                              {"pid", process_id},
+                              {"tid", event.thread_index},
+                              {"args", args}});
+        }
+        trace_events.clear();
+
+        std::ofstream output(trace_filename);
+        nlohmann::json trace = {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+        output << trace.dump() << std::endl;
+        ret = output.good();
+    }
+    return ret;
+}
+
+bool KcTrace::IsEnabled()
+{
+    return is_trace_enabled;
+}
+
+KcTrace::Span::Span(const char* category, const std::string& name)
+    : is_enabled_(is_trace_enabled)
+{
+    if (is_enabled_)
+    {
+        category_ = category;
+        name_     = name;
+        if (!trace_device.empty())
+        {
+            args_.emplace_back("device", trace_device);
+        }
+        if (!trace_kernel.empty())
+        {
+            args_.emplace_back("kernel", trace_kernel);
+        }
+
+        // Take the time last, so that the span does not include its own setup.
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+KcTrace::Span::~Span()
+{
+    if (is_enabled_ && is_trace_enabled)
+    {
+        const auto end = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(trace_lock);
+        TraceEvent                  event;
+        event.category     = category_;
+        event.name         = name_;
+        event.start_us     = std::chrono::duration_cast<std::chrono::microseconds>(start_ - trace_start).count();
+        event.duration_us  = std::chrono::duration_cast<std::chrono::microseconds>(end - start_).count();
+        event.thread_index = GetTraceThreadIndex();
+        event.args         = std::move(args_);
+        trace_events.push_back(std::move(event));
+    }
+}
+
+void KcTrace::Span::AddArg(const std::string& key, const std::string& value)
+{
+    if (is_enabled_)
+    {
+        args_.emplace_back(key, value);
+    }
+}
+
+KcTrace::Context::Context(const std::string& device, const std::string& kernel)
+    : prev_device_(trace_device)
+    , prev_kernel_(trace_kernel)
+{
+    trace_device = device;
+    trace_kernel = kernel;
+}
+
+KcTrace::Context::~Context()
+{
+    trace_device = prev_device_;
+    trace_kernel = prev_kernel_;
+}
@@ -0,0 +1,70 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Header for the recorder of trace events of the CLI phases.
+//=============================================================================
+
+#ifndef RGA_RADEONGPUANALYZERCLI_SRC_KC_TRACE_H_
+#define RGA_RADEONGPUANALYZERCLI_SRC_KC_TRACE_H_
+
+// C++.
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Records the time spent in the phases of the CLI and in the launched processes, and writes it as a
+// Chrome trace file (the JSON trace event format, which can be opened with chrome://tracing or Perfetto).
+// Recording is disabled unless Start() is called, in which case spans cost nothing but a flag check.
+class KcTrace
+{
+public:
+    // Start recording. The recorded events are written to "filename" by Finish().
+    static void Start(const std::string& filename);
+
+    // Write the recorded events to the trace file and stop recording.
+    // Returns false if the trace file cannot be written.
+    static bool Finish();
+
+    // True if events are being recorded.
+    static bool IsEnabled();
+
+    // A span of time on the calling thread, from construction to destruction.
+    // The span is tagged with the device and the kernel of the thread's context (see Context).
+    class Span
+    {
+    public:
+        Span(const char* category, const std::string& name);
+        ~Span();
+
+        // Attach an argument to the span.
+        void AddArg(const std::string& key, const std::string& value);
+
+    private:
+        bool                                             is_enabled_ = false;
+        const char*                                      category_   = nullptr;
+        std::string                                      name_;
+        std::chrono::steady_clock::time_point            start_;
+        std::vector<std::pair<std::string, std::string>> args_;
+    };
+
+    // Sets the device and the kernel that the spans of the calling thread are tagged with, from construction to
+    // destruction (the previous context is restored then).
+    class Context
+    {
+    public:
+        explicit Context(const std::string& device, const std::string& kernel = "");
+        ~Context();
+
+    private:
+        std::string prev_device_;
+        std::string prev_kernel_;
+    };
+};
+
+// Trace event categories.
+static const char* kTraceCategoryPhase   = "phase";
+static const char* kTraceCategoryProcess = "process";
+
+#endif  // RGA_RADEONGPUANALYZERCLI_SRC_KC_TRACE_H_
@@ -4,6 +4,10 @@
 /// @file
 /// @brief Implementation for CLI utility functions.
 //=============================================================================
+// C++.
+#include <atomic>
+#include <mutex>
+
 // XML.
 #include "tinyxml2.h"
 
@@ -21,6 +25,8 @@
 #include "source/common/rga_cli_defs.h"
 
 // Backend.
+#include "radeon_gpu_analyzer_backend/be_file_sink.h"
+#include "radeon_gpu_analyzer_backend/be_program_builder.h"
 #include "radeon_gpu_analyzer_backend/be_static_isa_analyzer.h"
 #include "radeon_gpu_analyzer_backend/be_utils.h"
 #include "radeon_gpu_analyzer_backend/be_string_constants.h"
@@ -37,10 +43,18 @@
 #include "common/rg_log.h"
 #include "common/rga_version_info.h"
 #include "radeon_gpu_analyzer_cli/kc_statistics_device_props.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 
 #ifndef _WIN32
 #pragma GCC diagnostic ignored "-Wunused-variable"
 #include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
 #endif
 
 using namespace beKA;
@@ -49,16 +63,9 @@ using namespace beKA;
 static const gtString  kRgaCliLogFileName           = L"rga_cli";
 static const gtString  kRgaCliLogFileExt            = L"log";
 static const gtString  kRgaCliParsedIsaFileExt      = L"csv";
-static const gtString  kRgaCliTempStdoutFilename    = L"rga_stdout";
-static const gtString  kRgaCliTempStdoutFileExt     = L"txt";
-static const gtString  kRgaCliTempStderrFilename    = L"rga_stderr";
-static const gtString  kRgaCliTempStderrFileExt     = L"txt";
 static const char*     kStrFopenModeAppend          = "a";
 
 // Constants: error messages.
-static const char* kStrErrorCannotLocateLiveregAnalyzer     = "Error: cannot locate the live register analyzer.";
-static const char* kStrErrorCannotLaunchLiveregAnalyzer     = "Error: cannot launch the live register analyzer.";
-static const char* kStrErrorCannotLaunchCfgAnalyzer         = "Error: cannot launch the control graph generator.";
 static const char* kStrErrorCannotFindIsaFile               = "Error: ISA file not found.";
 static const char* kStrErrorCouldNotDetectTarget            = "Error: could not detect target GPU -> ";
 static const char* kStrErrorAmbiguousTarget                 = "Error: ambiguous target GPU name -> ";
@@ -66,6 +73,7 @@ static const char* kStrErrorFailedToOpenLogFile             = "Error: failed to
 
 // Constants: warning messages.
 static const char* kStrWarningFailedToDeleteLogFiles = "Warning: failed to delete old log files.";
+static const char* kStrWarningInvalidLoopIterationLine = "Warning: ignoring invalid line in loop iteration file: ";
 
 // Constants: info messages.
 static const char* kStrLaunchingExternalProcess = "Info: launching external process: \n";
@@ -309,7 +317,10 @@ std::string KcUtils::DeviceStatisticsToCsvString(const Config& config, const std
     output << beKA::AnalysisData::na_or(statistics.num_threads_per_group_z) << csv_separator;
 
     // ISA size.
-    output << beKA::AnalysisData::na_or(statistics.isa_size);
+    output << beKA::AnalysisData::na_or(statistics.isa_size) << csv_separator;
+
+    // Estimated cycles.
+    output << beKA::AnalysisData::na_or(statistics.estimated_cycles);
 
     output << std::endl;
 
@@ -373,6 +384,7 @@ std::string KcUtils::GetStatisticsCsvHeaderString(char csv_separator)
     static const char* kStrInfoCsvHeaderOpenclWorkgroupDimensionY = "CL_WORKGROUP_Y_DIMENSION";
     static const char* kStrInfoCsvHeaderOpenclWorkgroupDimensionZ = "CL_WORKGROUP_Z_DIMENSION";
     static const char* kStrInfoCsvHeaderIsaSizeBytes = "ISA_SIZE";
+    static const char* kStrInfoCsvHeaderEstimatedCycles = "ESTIMATED_CYCLES";
 
     std::stringstream output;
     output << kStrInfoCsvHeaderDevice << csv_separator;
@@ -390,7 +402,8 @@ std::string KcUtils::GetStatisticsCsvHeaderString(char csv_separator)
     output << kStrInfoCsvHeaderOpenclWorkgroupDimensionX << csv_separator;
     output << kStrInfoCsvHeaderOpenclWorkgroupDimensionY << csv_separator;
     output << kStrInfoCsvHeaderOpenclWorkgroupDimensionZ << csv_separator;
-    output << kStrInfoCsvHeaderIsaSizeBytes;
+    output << kStrInfoCsvHeaderIsaSizeBytes << csv_separator;
+    output << kStrInfoCsvHeaderEstimatedCycles;
     return output.str().c_str();
 }
 
@@ -403,6 +416,53 @@ void KcUtils::CreateStatisticsFile(const gtString& filename, const Config& confi
     CreateStatisticsFile(filename, config, tmp_map, log_callback);
 }
 
+uint64_t KcUtils::EstimateIsaCycles(const Config& config, const std::string& isa_text, const std::string& device, bool is_header_required)
+{
+    uint64_t estimated_cycles = static_cast<uint64_t>(-1);
+    BeProgramBuilder::EstimateIsaCycles(isa_text, device, config.loop_iteration_count, config.loop_iteration_overrides, estimated_cycles, is_header_required);
+    return estimated_cycles;
+}
+
+bool KcUtils::ReadLoopIterationFile(const std::string&                    filename,
+                                    std::unordered_map<std::string, int>& loop_iteration_counts,
+                                    LoggingCallbackFunction               callback)
+{
+    std::string content;
+    bool        ret = ReadTextFile(filename, content, callback);
+    if (ret)
+    {
+        std::stringstream content_stream(content);
+        std::string       line;
+        while (std::getline(content_stream, line))
+        {
+            std::stringstream line_stream(line);
+            std::string       label;
+            int               iteration_count = 0;
+            if ((line_stream >> label) && label[0] != '#')
+            {
+                // Accept the label as it appears in the disassembly, with its trailing colon.
+                if (label.back() == ':')
+                {
+                    label.pop_back();
+                }
+
+                if (!label.empty() && (line_stream >> iteration_count) && iteration_count > 0)
+                {
+                    loop_iteration_counts[label] = iteration_count;
+                }
+                else if (callback != nullptr)
+                {
+                    std::stringstream log;
+                    log << kStrWarningInvalidLoopIterationLine << line << std::endl;
+                    callback(log.str());
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
 char KcUtils::GetCsvSeparator(const Config& config)
 {
     char csv_separator;
@@ -496,25 +556,11 @@ static bool EvaluateAnalysisResult(beStatus rc, LoggingCallbackFunction callback
 
         switch (rc)
         {
-        case beKA::kBeStatusShaeCannotLocateAnalyzer:
-            // Failed to locate the ISA analyzer.
-            msg << kStrErrorCannotLocateLiveregAnalyzer << std::endl;
-            break;
-
         case beKA::kBeStatusShaeIsaFileNotFound:
             // ISA file not found.
             msg << kStrErrorCannotFindIsaFile << std::endl;
             break;
 
-        case beKA::kBeStatusShaeFailedToLaunch:
-#ifndef __linux__
-            // Failed to launch the ISA analyzer.
-            // On Linux, there is an issue with this return code due to the
-            // executable format that we use for the backend.
-            msg << kStrErrorCannotLaunchLiveregAnalyzer << std::endl;
-#endif
-            break;
-
         case beKA::kBeStatusGeneralFailed:
         default:
             // Generic error message.
@@ -544,21 +590,22 @@ bool KcUtils::PerformLiveRegisterAnalysis(const gtString&         isa_filename,
                                           const gtString&         target,
                                           const gtString&         output_filename,
                                           LoggingCallbackFunction callback,
-                                          bool                    print_cmd,
                                           bool                    is_reg_type_sgpr,
                                           beWaveSize              wave_size)
 {
-    // Call the backend.
-    beStatus rc = BeStaticIsaAnalyzer::PerformLiveRegisterAnalysis(isa_filename, target, output_filename, wave_size, print_cmd, is_reg_type_sgpr);
-
-    return EvaluateAnalysisResult(rc, callback);
+    const gtString no_output_filename;
+    return PerformLiveRegisterAnalysis(isa_filename,
+                                       target,
+                                       is_reg_type_sgpr ? no_output_filename : output_filename,
+                                       is_reg_type_sgpr ? output_filename : no_output_filename,
+                                       callback,
+                                       wave_size);
 }
 
 bool KcUtils::PerformLiveRegisterAnalysis(const std::string&      isa_filename, 
                                           const std::string&      target,
                                           const std::string&      output_filename,
                                           LoggingCallbackFunction callback,
-                                          bool                    print_cmd,
                                           bool                    is_reg_type_sgpr)
 {
     // Convert the arguments to gtString.
@@ -570,14 +617,27 @@ bool KcUtils::PerformLiveRegisterAnalysis(const std::string&      isa_filename,
     target_gtstr << target.c_str();
 
     // Invoke the routine.
-    return PerformLiveRegisterAnalysis(isa_name_gtstr, target_gtstr, output_filename_gtstr, callback, print_cmd, is_reg_type_sgpr);
+    return PerformLiveRegisterAnalysis(isa_name_gtstr, target_gtstr, output_filename_gtstr, callback, is_reg_type_sgpr);
+}
+
+bool KcUtils::PerformLiveRegisterAnalysis(const gtString&         isa_filename,
+                                          const gtString&         target,
+                                          const gtString&         vgpr_output_filename,
+                                          const gtString&         sgpr_output_filename,
+                                          LoggingCallbackFunction callback,
+                                          beWaveSize              wave_size)
+{
+    // Call the backend.
+    beStatus rc = BeStaticIsaAnalyzer::PerformLiveRegisterAnalysis(isa_filename, target, vgpr_output_filename, sgpr_output_filename, wave_size);
+
+    return EvaluateAnalysisResult(rc, callback);
 }
 
-bool KcUtils::GenerateControlFlowGraph(const gtString& isa_file_name, const gtString& target, const gtString& output_filename,
-                                       LoggingCallbackFunction callback, bool per_inst_cfg, bool printCmd)
+bool KcUtils::GenerateControlFlowGraph(const gtString& isa_file_name, const gtString&, const gtString& output_filename,
+                                       LoggingCallbackFunction callback, bool per_inst_cfg)
 {
     // Call the backend.
-    beStatus rc = BeStaticIsaAnalyzer::GenerateControlFlowGraph(isa_file_name, target, output_filename, per_inst_cfg, printCmd);
+    beStatus rc = BeStaticIsaAnalyzer::GenerateControlFlowGraph(isa_file_name, output_filename, per_inst_cfg);
     if (rc != kBeStatusSuccess && callback != nullptr)
     {
         // Inform the user in case of an error.
@@ -585,25 +645,11 @@ bool KcUtils::GenerateControlFlowGraph(const gtString& isa_file_name, const gtSt
 
         switch (rc)
         {
-            case beKA::kBeStatusShaeCannotLocateAnalyzer:
-                // Failed to locate the ISA analyzer.
-                msg << kStrErrorCannotLocateLiveregAnalyzer << std::endl;
-                break;
-
             case beKA::kBeStatusShaeIsaFileNotFound:
                 // ISA file not found.
                 msg << kStrErrorCannotFindIsaFile << std::endl;
                 break;
 
-            case beKA::kBeStatusShaeFailedToLaunch:
-#ifndef __linux__
-                // Failed to launch the ISA analyzer.
-                // On Linux, there is an issue with this return code due to the
-                // executable format that we use for the backend.
-                msg << kStrErrorCannotLaunchCfgAnalyzer << std::endl;
-#endif
-                break;
-
             case beKA::kBeStatusGeneralFailed:
             default:
                 // Generic error message.
@@ -621,19 +667,17 @@ bool KcUtils::GenerateControlFlowGraph(const gtString& isa_file_name, const gtSt
     return (rc == kBeStatusSuccess);
 }
 
-bool KcUtils::GenerateControlFlowGraph(const std::string& isa_filename, const std::string& target, const std::string& output_filename,
-    LoggingCallbackFunction pCallback, bool per_inst_cfg, bool print_cmd)
+bool KcUtils::GenerateControlFlowGraph(const std::string& isa_filename, const std::string&, const std::string& output_filename,
+    LoggingCallbackFunction pCallback, bool per_inst_cfg)
 {
     // Convert the arguments to gtString.
     gtString isa_name_gtstr;
     isa_name_gtstr << isa_filename.c_str();
     gtString output_filename_gtstr;
     output_filename_gtstr << output_filename.c_str();
-    gtString target_gtstr;
-    target_gtstr << target.c_str();
 
     // Invoke the routine.
-    return GenerateControlFlowGraph(isa_name_gtstr, target_gtstr, output_filename_gtstr, pCallback, per_inst_cfg, print_cmd);
+    return GenerateControlFlowGraph(isa_name_gtstr, gtString(), output_filename_gtstr, pCallback, per_inst_cfg);
 }
 
 void KcUtils::ConstructOutputFileName(const std::string& base_output_filename, const std::string& default_suffix,
@@ -799,16 +843,24 @@ gtString KcUtils::ConstructTempFileName(const gtString& prefix, const gtString &
         osFilePath temp_file_path;
         temp_file_path.setFileDirectory(rga_temp_dir);
 
+        // Ensure that the file name is unique for any invocation by the existing CLI process.
+        // The devices (and the requests of the server mode) can be compiled concurrently, so the suffix is shared by the threads,
+        // and every name but the first one gets a suffix even if the file has not been created yet.
+        static std::atomic<unsigned> unique_suffix(0);
+
         gtString temp_file_base_name = prefix;
         temp_file_base_name.appendUnsignedIntNumber(osGetCurrentProcessId());
         gtString temp_filename = temp_file_base_name;
+        const unsigned call_index = unique_suffix++;
+        if (call_index > 0)
+        {
+            temp_filename.append(L"_");
+            temp_filename.appendUnsignedIntNumber(call_index);
+        }
         temp_filename.append(L".");
         temp_filename.append(ext);
         temp_file_path.setFileName(temp_filename);
 
-        // Ensure that the file name is unique for any invocation by the existing CLI process.
-        static unsigned unique_suffix = 0;
-
         uint32_t suffix_num = 0;
         while (temp_file_path.exists() && suffix_num < kMAX_ATTEMPTS)
         {
@@ -835,17 +887,65 @@ std::string KcUtils::ConstructTempFileName(const std::string & prefix, const std
     return filename_gtstr.asASCIICharArray();
 }
 
+bool KcUtils::CreateDeviceTempDir(const std::string& device, std::string& temp_dir)
+{
+    osDirectory rga_temp_dir;
+    bool        ret = GetRGATempDir(rga_temp_dir);
+    if (ret)
+    {
+        gtString sub_dir_name;
+        sub_dir_name << device.c_str() << L"_";
+        sub_dir_name.appendUnsignedIntNumber(osGetCurrentProcessId());
+
+        osFilePath temp_dir_path = rga_temp_dir.directoryPath();
+        temp_dir_path.appendSubDirectory(sub_dir_name);
+
+        osDirectory device_temp_dir;
+        temp_dir_path.getFileDirectory(device_temp_dir);
+        ret = device_temp_dir.exists() || device_temp_dir.create();
+        if (ret)
+        {
+            temp_dir = device_temp_dir.directoryPath().asString().asASCIICharArray();
+        }
+    }
+    return ret;
+}
+
+bool KcUtils::DeleteDeviceTempDir(const std::string& temp_dir)
+{
+    bool ret = temp_dir.empty();
+    if (!ret)
+    {
+        gtString temp_dir_gtstr;
+        temp_dir_gtstr << temp_dir.c_str();
+        osDirectory device_temp_dir;
+        device_temp_dir.setDirectoryFullPathFromString(temp_dir_gtstr);
+        ret = !device_temp_dir.exists() || device_temp_dir.deleteRecursively();
+    }
+    return ret;
+}
+
 bool KcUtils::GetMarketingNameToCodenameMapping(DeviceNameMap& cards_map)
 {
-    bool ret = BeUtils::GetMarketingNameToCodenameMapping(cards_map);
+    // The mapping does not change during the lifetime of the process, so it is built once.
+    static DeviceNameMap cached_cards_map;
+    static bool          is_cached = false;
+    static std::mutex    cache_lock;
 
-    // Remove the disabled devices.
-    for (const std::string& disabledDevice : kRgaDisabledDevices)
+    std::lock_guard<std::mutex> lock(cache_lock);
+    if (!is_cached)
     {
-        cards_map.erase(disabledDevice);
+        is_cached = BeUtils::GetMarketingNameToCodenameMapping(cached_cards_map);
+
+        // Remove the disabled devices.
+        for (const std::string& disabledDevice : kRgaDisabledDevices)
+        {
+            cached_cards_map.erase(disabledDevice);
+        }
     }
 
-    return ret;
+    cards_map = cached_cards_map;
+    return is_cached;
 }
 
 // Converts "srcName" string to lowercase and removes all spaces and '-'.
@@ -1156,6 +1256,64 @@ void KcUtils::PrintRgaVersion()
     std::cout << std::endl;
 }
 
+// Split a command line into arguments, as a shell would, but without any expansion or redirection:
+// the arguments are separated by white spaces, and quotes group the characters between them (the quotes are removed).
+static void SplitCommandLine(const std::string& cmd_line, std::vector<std::string>& args)
+{
+    std::string arg;
+    bool        is_in_arg = false;
+    char        quote     = 0;
+    for (char c : cmd_line)
+    {
+        if (quote != 0)
+        {
+            if (c == quote)
+            {
+                quote = 0;
+            }
+            else
+            {
+                arg += c;
+            }
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quote     = c;
+            is_in_arg = true;
+        }
+        else if (c == ' ' || c == '\t' || c == '\n')
+        {
+            if (is_in_arg)
+            {
+                args.push_back(arg);
+                arg.clear();
+                is_in_arg = false;
+            }
+        }
+        else
+        {
+            arg += c;
+            is_in_arg = true;
+        }
+    }
+
+    if (is_in_arg)
+    {
+        args.push_back(arg);
+    }
+}
+
+// Record a trace span for a launched process, named after its executable.
+class ProcessTraceSpan : public KcTrace::Span
+{
+public:
+    ProcessTraceSpan(const std::string& exec_path, const std::string& cmd_line)
+        : KcTrace::Span(kTraceCategoryProcess, exec_path.substr(exec_path.find_last_of("/\\") + 1))
+    {
+        AddArg("command", cmd_line);
+    }
+};
+
 #ifdef _WIN32
 KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path, const std::string& args, const std::string& dir,
     unsigned long, bool print_cmd, std::string& std_out, std::string& std_err, long& exit_code)
@@ -1192,12 +1350,14 @@ KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path, cons
     cmd << exec_path.c_str() << " " << args.c_str();
 
     // Launch the process.
+    ProcessTraceSpan trace_span(exec_path, cmd.str());
     bool should_cancel = false;
     gtString working_dir = work_dir.asString();
     gtString cmd_output;
     gtString cmd_output_err;
     bool is_launch_success = osExecAndGrabOutputAndError(cmd.str().c_str(), should_cancel,
-        working_dir, cmd_output, cmd_output_err);
+        working_dir, cmd_output, cmd_output_err, &exit_code);
+    trace_span.AddArg("exit_code", std::to_string(exit_code));
 
     // Read stdout and stderr.
     std_out = cmd_output.asASCIICharArray();
@@ -1254,6 +1414,7 @@ KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path,
     cmd << exec_path.c_str() << " " << args.c_str();
 
     // Launch the process.
+    ProcessTraceSpan trace_span(exec_path, cmd.str());
     bool     should_cancel = false;
     gtString working_dir   = work_dir.asString();
     gtString cmd_output;
@@ -1262,7 +1423,8 @@ KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path,
     bool     is_launch_success = false;
     if (print_dbg)
     {
-        is_launch_success = osExecAndGrabOutputAndErrorDebug(cmd.str().c_str(), should_cancel, working_dir, cmd_output, cmd_output_err, cmd_output_debug);
+        is_launch_success =
+            osExecAndGrabOutputAndErrorDebug(cmd.str().c_str(), should_cancel, working_dir, cmd_output, cmd_output_err, cmd_output_debug, &exit_code);
         if (!cmd_output_debug.isEmpty())
         {
             std::cout << std::endl << dbg_prologue << std::endl << std::endl;
@@ -1272,8 +1434,9 @@ KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path,
     }
     else
     {
-        is_launch_success = osExecAndGrabOutputAndError(cmd.str().c_str(), should_cancel, working_dir, cmd_output, cmd_output_err);
+        is_launch_success = osExecAndGrabOutputAndError(cmd.str().c_str(), should_cancel, working_dir, cmd_output, cmd_output_err, &exit_code);
     }
+    trace_span.AddArg("exit_code", std::to_string(exit_code));
 
     // Read stdout and stderr.
     std_out   = cmd_output.asASCIICharArray();
@@ -1288,110 +1451,218 @@ KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path,
 }
 
 #else
-KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path, const std::string& args, const std::string& dir,
-    unsigned long time_out, bool print_cmd, std::string& std_out, std::string& std_err, long& exit_code)
-{
-    osProcessId      compiler_proc_id;
-    osProcessHandle  compiler_proc_handle;
-    osThreadHandle   compiler_thread_handle;
-    ProcessStatus    status = ProcessStatus::kSuccess;
+// The size of the chunks in which the output of a launched process is read.
+static const size_t kProcessOutputChunkSize = 65536;
 
-    // Set working directory, executable and arguments.
-    osFilePath  work_dir;
-    if (dir == "")
-    {
-        work_dir.setPath(osFilePath::OS_CURRENT_DIRECTORY);
-    }
-    else
-    {
-        gtString  dir_gtstr;
-        dir_gtstr << dir.c_str();
-        work_dir.setFileDirectory(dir_gtstr);
-    }
+// posix_spawn_file_actions_addchdir_np() is only available since glibc 2.29.
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 29))
+#define KC_SPAWN_CHDIR_THROUGH_SHELL
+#endif
 
-    gtString exec_path_gtstr, args_gtstr;
-    exec_path_gtstr << exec_path.c_str();
-    args_gtstr << args.c_str();
+// Launch a process with posix_spawn (no shell is involved), with the given arguments (the first one is the executable).
+// The stdout and stderr of the process are captured through pipes, which are drained while the process runs, so the
+// process never blocks on a full pipe and the wait ends as soon as the process closes its output, instead of polling for
+// its termination. The stdin of the process is redirected from /dev/null.
+static KcUtils::ProcessStatus SpawnProcess(const std::vector<std::string>& args, const std::string& dir, unsigned long time_out,
+                                           std::string& std_out, std::string& std_err, long& exit_code)
+{
+    KcUtils::ProcessStatus status = KcUtils::ProcessStatus::kLaunchFailed;
+    std_out.clear();
+    std_err.clear();
+    exit_code = 0;
 
-    // Create temporary files for stdout/stderr.
-    gtString  out_filename = KcUtils::ConstructTempFileName(kRgaCliTempStdoutFilename, kRgaCliTempStdoutFileExt);
-    gtString  err_filename = KcUtils::ConstructTempFileName(kRgaCliTempStderrFilename, kRgaCliTempStderrFileExt);
+    // The pipes are created with O_CLOEXEC, so that processes that are launched concurrently by other threads
+    // do not inherit them (which would delay the end of the output until those processes exit).
+    int  out_pipe[2]     = {-1, -1};
+    int  err_pipe[2]     = {-1, -1};
+    bool is_pipe_created = !args.empty() && pipe2(out_pipe, O_CLOEXEC) == 0 && pipe2(err_pipe, O_CLOEXEC) == 0;
 
-    if (out_filename.isEmpty() || err_filename.isEmpty())
+    // Without the chdir file action, the process is launched through the shell, which changes the directory
+    // and then replaces itself with the process (the arguments are passed as they are, without being parsed).
+    std::vector<std::string> spawn_args = args;
+#ifdef KC_SPAWN_CHDIR_THROUGH_SHELL
+    if (!dir.empty() && !args.empty())
     {
-        status = ProcessStatus::kCreateTempFileFailed;
+        spawn_args = {"/bin/sh", "-c", "cd \"$0\" && exec \"$@\"", dir};
+        spawn_args.insert(spawn_args.end(), args.begin(), args.end());
     }
-    else
-    {
-        std::stringstream msg;
-        msg << kStrLaunchingExternalProcess << exec_path_gtstr.asASCIICharArray()
-            << " " << args_gtstr.asASCIICharArray();
-
-        RgLog::file << msg.str() << std::endl;
+#endif
 
-        if (print_cmd)
+    pid_t pid = -1;
+    if (is_pipe_created)
+    {
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_adddup2(&actions, out_pipe[1], STDOUT_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, err_pipe[1], STDERR_FILENO);
+#ifndef KC_SPAWN_CHDIR_THROUGH_SHELL
+        if (!dir.empty())
         {
-            RgLog::stdOut << msg.str() << std::endl;
+            posix_spawn_file_actions_addchdir_np(&actions, dir.c_str());
         }
+#endif
 
-        args_gtstr += L" >";
-        args_gtstr += out_filename;
-        args_gtstr += L" 2>";
-        args_gtstr += err_filename;
-
-        // Launch a process.
-        bool  proc_status = osLaunchSuspendedProcess(exec_path_gtstr,
-            args_gtstr,
-            work_dir,
-            compiler_proc_id,
-            compiler_proc_handle,
-            compiler_thread_handle,
-            false,  // Don't create a window
-            true);  // Redirect stdout & stderr
-
-        if (proc_status && osResumeSuspendedProcess(compiler_proc_id, compiler_proc_handle, compiler_thread_handle, false))
+        std::vector<char*> argv;
+        for (const std::string& arg : spawn_args)
         {
-            proc_status = osWaitForProcessToTerminate(compiler_proc_id, time_out, &exit_code);
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
 
-            if (!proc_status)
-            {
-                osTerminateProcess(compiler_proc_id);
-                status = ProcessStatus::kTimeOut;
-            }
+        if (posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ) == 0)
+        {
+            status = KcUtils::ProcessStatus::kSuccess;
         }
-        else
+        posix_spawn_file_actions_destroy(&actions);
+    }
+
+    // Only the child writes to the pipes.
+    for (int fd : {out_pipe[1], err_pipe[1]})
+    {
+        if (fd != -1)
         {
-            status = ProcessStatus::kLaunchFailed;
+            close(fd);
         }
     }
 
-    // Read the content of stderr and stdout files.
-    std_out = std_err = "";
-    if (status == ProcessStatus::kSuccess)
+    if (status == KcUtils::ProcessStatus::kSuccess)
     {
-        if (FileNotEmpty(out_filename.asASCIICharArray()))
+        // Read both pipes until the process closes them.
+        const auto        deadline   = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_out);
+        struct pollfd     fds[2]     = {{out_pipe[0], POLLIN, 0}, {err_pipe[0], POLLIN, 0}};
+        std::string*      output[2]  = {&std_out, &std_err};
+        int               open_count = 2;
+        std::vector<char> buffer(kProcessOutputChunkSize);
+        while (open_count > 0 && status == KcUtils::ProcessStatus::kSuccess)
+        {
+            int poll_timeout = -1;
+            if (time_out != kProcessWaitInfinite)
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                poll_timeout   = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+            }
+
+            int ready_count = poll(fds, 2, poll_timeout);
+            if (ready_count == 0)
+            {
+                status = KcUtils::ProcessStatus::kTimeOut;
+            }
+            else if (ready_count < 0 && errno != EINTR)
+            {
+                status = KcUtils::ProcessStatus::kReadOutputFailed;
+            }
+            else
+            {
+                for (int i = 0; i < 2; i++)
+                {
+                    if (fds[i].fd != -1 && fds[i].revents != 0)
+                    {
+                        ssize_t read_size = read(fds[i].fd, buffer.data(), buffer.size());
+                        if (read_size > 0)
+                        {
+                            output[i]->append(buffer.data(), static_cast<size_t>(read_size));
+                        }
+                        else if (read_size == 0 || errno != EINTR)
+                        {
+                            // End of the output (negative fds are ignored by poll()).
+                            close(fds[i].fd);
+                            fds[i].fd = -1;
+                            open_count--;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (const struct pollfd& fd : fds)
         {
-            if (!KcUtils::ReadTextFile(out_filename.asASCIICharArray(), std_out, nullptr))
+            if (fd.fd != -1)
             {
-                status = ProcessStatus::kReadTempFileFailed;
+                close(fd.fd);
             }
-            std::remove(out_filename.asASCIICharArray());
         }
 
-        if (FileNotEmpty(err_filename.asASCIICharArray()))
+        // The process may still be running if its output was not read to the end.
+        if (status != KcUtils::ProcessStatus::kSuccess)
+        {
+            kill(pid, SIGKILL);
+        }
+
+        // Collect the exit status of the process.
+        int wait_status = 0;
+        while (waitpid(pid, &wait_status, 0) == -1 && errno == EINTR)
+        {
+        }
+        exit_code = (WIFEXITED(wait_status) ? WEXITSTATUS(wait_status) : -1);
+    }
+    else
+    {
+        for (int fd : {out_pipe[0], err_pipe[0]})
         {
-            if (!KcUtils::ReadTextFile(err_filename.asASCIICharArray(), std_err, nullptr))
+            if (fd != -1)
             {
-                status = ProcessStatus::kReadTempFileFailed;
+                close(fd);
             }
-            std::remove(err_filename.asASCIICharArray());
         }
     }
 
     return status;
 }
+
+KcUtils::ProcessStatus KcUtils::LaunchProcess(const std::string& exec_path, const std::string& args, const std::string& dir,
+    unsigned long time_out, bool print_cmd, std::string& std_out, std::string& std_err, long& exit_code)
+{
+    // Log the invocation event.
+    std::stringstream msg;
+    msg << kStrLaunchingExternalProcess << exec_path << " " << args;
+
+    RgLog::file << msg.str() << std::endl;
+    if (print_cmd)
+    {
+        RgLog::stdOut << msg.str() << std::endl;
+    }
+
+    // Launch the executable directly, without a shell.
+    std::vector<std::string> argv = {exec_path};
+    SplitCommandLine(args, argv);
+
+    ProcessTraceSpan trace_span(exec_path, exec_path + " " + args);
+    ProcessStatus    status = SpawnProcess(argv, dir, time_out, std_out, std_err, exit_code);
+    trace_span.AddArg("exit_code", std::to_string(exit_code));
+
+    return status;
+}
 #endif
 
+bool KcUtils::ExecAndGrabOutput(const std::string& cmd_line, gtString& output, std::string& error)
+{
+    std::vector<std::string> argv;
+    SplitCommandLine(cmd_line, argv);
+    ProcessTraceSpan trace_span(argv.empty() ? "" : argv[0], cmd_line);
+
+#ifdef _WIN32
+    bool     should_cancel = false;
+    gtString working_dir   = osFilePath(osFilePath::OS_CURRENT_DIRECTORY).asString();
+    gtString cmd_output_err;
+    long     exit_code = 0;
+    bool     ret       = osExecAndGrabOutputAndError(cmd_line.c_str(), should_cancel, working_dir, output, cmd_output_err, &exit_code);
+    trace_span.AddArg("exit_code", std::to_string(exit_code));
+    error = cmd_output_err.asASCIICharArray();
+
+    return ret;
+#else
+
+    std::string std_out;
+    long        exit_code = 0;
+    bool        ret       = (SpawnProcess(argv, "", kProcessWaitInfinite, std_out, error, exit_code) == ProcessStatus::kSuccess);
+    trace_span.AddArg("exit_code", std::to_string(exit_code));
+    output.fromASCIIString(std_out.c_str());
+
+    return ret;
+#endif
+}
+
 bool KcUtils::FileNotEmpty(const std::string filename)
 {
     bool  ret = false;
@@ -1523,6 +1794,57 @@ bool KcUtils::WriteTextFile(const std::string& filename, const std::string& cont
     return ret;
 }
 
+bool KcUtils::WriteParsedIsaCsvFile(const std::string&      isa_text,
+                                    const std::string&      device,
+                                    bool                    add_line_numbers,
+                                    const std::string&      filename,
+                                    BeFileSink&             sink,
+                                    LoggingCallbackFunction callback,
+                                    const Config*           config,
+                                    uint64_t*               estimated_cycles)
+{
+    assert(config == nullptr || estimated_cycles != nullptr);
+    if (estimated_cycles != nullptr)
+    {
+        *estimated_cycles = static_cast<uint64_t>(-1);
+    }
+
+    bool ret = sink.Open(filename);
+    if (ret)
+    {
+        // The rows are written as the instructions are converted, so the CSV text is never held in memory as a whole.
+        ret = sink.Write(add_line_numbers ? kStrCsvParsedIsaHeaderLineNumbers : kStrCsvParsedIsaHeader);
+        if (config != nullptr)
+        {
+            ret = ret && (BeProgramBuilder::ParseIsaToCsv(isa_text, device, sink, add_line_numbers, true, config->loop_iteration_count,
+                                                          config->loop_iteration_overrides, *estimated_cycles) == beKA::kBeStatusSuccess);
+        }
+        else
+        {
+            ret = ret && (BeProgramBuilder::ParseIsaToCsv(isa_text, device, sink, add_line_numbers, true) == beKA::kBeStatusSuccess);
+        }
+        ret = ret && sink.Write("\n");
+        ret = sink.Close() && ret;
+
+        if (!ret)
+        {
+            // Do not leave a partial CSV file behind.
+            std::remove(filename.c_str());
+        }
+    }
+    else
+    {
+        std::stringstream log;
+        log << kStrErrorCannotOpenFileForWriteA << filename << kStrErrorCannotOpenFileForWriteB << std::endl;
+        if (callback != nullptr)
+        {
+            callback(log.str());
+        }
+    }
+
+    return ret;
+}
+
 // Get current system time.
 static bool CurrentTime(struct tm& time_buffer)
 {
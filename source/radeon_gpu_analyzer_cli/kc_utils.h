@@ -11,6 +11,7 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <unordered_map>
 
 // Infra.
 #include "external/amdt_base_tools/Include/gtString.h"
@@ -24,6 +25,8 @@
 #include "radeon_gpu_analyzer_cli/kc_config.h"
 #include "radeon_gpu_analyzer_cli/kc_statistics_parser.h"
 
+class BeFileSink;
+
 // Constants.
 static const unsigned long kProcessWaitInfinite = 0xFFFFFFFF;
 
@@ -40,7 +43,8 @@ public:
         kLaunchFailed,
         kTimeOut,
         kCreateTempFileFailed,
-        kReadTempFileFailed
+        kReadTempFileFailed,
+        kReadOutputFailed
     };
 
     // Helper function to validate a shader's file name and generate the appropriate output message.
@@ -88,6 +92,25 @@ public:
     // Converts the device statistics to a CSV string.
     static std::string DeviceStatisticsToCsvString(const Config& config, const std::string& device, const beKA::AnalysisData& statistics);
 
+    // Estimates the number of cycles that it takes to execute the given ISA on the given device, with loop bodies weighted
+    // by the loop iteration counts from the user's configuration. When the ISA is also converted to CSV, the estimate is made
+    // from the same parse by WriteParsedIsaCsvFile() instead.
+    // Returns the estimated cycles, or -1 (N/A) if the ISA could not be parsed.
+    // config - the user's configuration
+    // isa_text - the ISA disassembly text
+    // device - the target device
+    // is_header_required - true to add the standard disassembly header to the ISA text before parsing it
+    static uint64_t EstimateIsaCycles(const Config& config, const std::string& isa_text, const std::string& device, bool is_header_required);
+
+    // Reads the iteration counts of specific loops from a text file.
+    // Each line holds the label of a loop header block followed by the iteration count. Empty lines and lines that start with '#' are ignored.
+    // filename - the loop iteration file
+    // loop_iteration_counts - the iteration count of each loop, by the loop header label
+    // callback - a log callback
+    static bool ReadLoopIterationFile(const std::string&                    filename,
+                                      std::unordered_map<std::string, int>& loop_iteration_counts,
+                                      LoggingCallbackFunction               callback);
+
     // Deletes the a file from the file system.
     // file_full_path - the full path to the file to be deleted.
     static bool DeleteFile(const gtString& file_full_path);
@@ -114,13 +137,11 @@ public:
     // target - the target device name
     // output_filename - the output file name
     // callback - callback to log messages
-    // print_cmd - print command line to stdout
     // is_reg_type_sgpr - true for sgpr analysis, default is vgpr.
     static bool PerformLiveRegisterAnalysis(const gtString&         isa_filename,
                                             const gtString&         target,
                                             const gtString&         output_filename,
-                                            LoggingCallbackFunction callback, 
-                                            bool                    print_cmd,
+                                            LoggingCallbackFunction callback,
                                             bool                    is_reg_type_sgpr = false,
                                             beWaveSize              wave_size = beWaveSize::kUnknown);
 
@@ -130,31 +151,43 @@ public:
     // target - the target device name
     // output_filename - the output file name
     // callback - callback to log messages
-    // print_cmd - print command line to stdout
     static bool PerformLiveRegisterAnalysis(const std::string&      isa_filename,
                                             const std::string&      target, 
                                             const std::string&      output_filename,
                                             LoggingCallbackFunction callback,
-                                            bool                    print_cmd,
                                             bool                    is_reg_type_sgpr = false);
 
+    // Performs live VGPR and SGPR analysis for the ISA in the given file in a single pass,
+    // and dumps the output to the given output file names.
+    // isa_filename - the disassembled ISA file name
+    // target - the target device name
+    // vgpr_output_filename - the VGPR output file name, or empty if VGPR analysis is not required
+    // sgpr_output_filename - the SGPR output file name, or empty if SGPR analysis is not required
+    // callback - callback to log messages
+    static bool PerformLiveRegisterAnalysis(const gtString&         isa_filename,
+                                            const gtString&         target,
+                                            const gtString&         vgpr_output_filename,
+                                            const gtString&         sgpr_output_filename,
+                                            LoggingCallbackFunction callback,
+                                            beWaveSize              wave_size = beWaveSize::kUnknown);
+
     // Generates control flow graph for the given ISA.
     // isa_file_name - the disassembled ISA file name
-    // target - the target device name
+    // target - the target device name (not used, since the graph does not depend on the device)
     // outputFileName - the output file name
     // callback - callback to log messages
-    // print_cmd - print command line to stdout
+    // perInstCfg - true for a per-instruction graph, false for a per-block graph
     static bool GenerateControlFlowGraph(const gtString& isa_file_name, const gtString& target, const gtString& outputFileName,
-                                         LoggingCallbackFunction callback, bool perInstCfg, bool print_cmd);
+                                         LoggingCallbackFunction callback, bool perInstCfg);
 
     // Generates control flow graph for the given ISA.
     // isa_file_name - the disassembled ISA file name
-    // target - the target device name
+    // target - the target device name (not used, since the graph does not depend on the device)
     // outputFileName - the output file name
     // callback - callback to log messages
-    // print_cmd - print command line to stdout
+    // perInstCfg - true for a per-instruction graph, false for a per-block graph
     static bool GenerateControlFlowGraph(const std::string& isa_file_name, const std::string& target, const std::string& outputFileName,
-        LoggingCallbackFunction callback, bool perInstCfg, bool print_cmd);
+        LoggingCallbackFunction callback, bool perInstCfg);
 
     // Generates an output file name in the Analyzer CLI format.
     // base_output_filename - the base output file name as configured by the user's command
@@ -199,6 +232,14 @@ public:
     // std::string version of ConstructTempFileName().
     static std::string ConstructTempFileName(const std::string& prefix, const std::string& ext);
 
+    // Creates a subdirectory of the RGA temp directory for the temporary files of the compiler for the given device.
+    // The subdirectory is unique to the device and to the process, so that the devices can be compiled concurrently.
+    // Returns the full path of the subdirectory in "temp_dir".
+    static bool CreateDeviceTempDir(const std::string& device, std::string& temp_dir);
+
+    // Deletes a subdirectory that was created by CreateDeviceTempDir() with all of its content.
+    static bool DeleteDeviceTempDir(const std::string& temp_dir);
+
     // Get all available graphics cards public names, grouped by the internal code name.
     static bool GetMarketingNameToCodenameMapping(DeviceNameMap& cards_map);
 
@@ -238,6 +279,26 @@ public:
     // \param[in]  callback  callback for logging
     static bool WriteTextFile(const std::string& filename, const std::string& content, LoggingCallbackFunction callback);
 
+    // Convert ISA text to CSV form with additional data, and write it to a file through the given sink.
+    // The sink can be reused across files to avoid reallocating its write buffer.
+    // \param[in]  isa_text          the ISA disassembly text
+    // \param[in]  device            the target device
+    // \param[in]  add_line_numbers  true to add the source line numbers to the CSV rows
+    // \param[in]  filename          the name of the CSV file to be created
+    // \param[in]  sink              the sink used for writing the file
+    // \param[in]  callback          callback for logging
+    // \param[in]  config            if not null, the cycles that it takes to execute the ISA are estimated from the same parse,
+    //                               with the loop iteration counts of this configuration (see EstimateIsaCycles())
+    // \param[out] estimated_cycles  the estimated cycles, or -1 (N/A) if the ISA could not be parsed (required if "config" is not null)
+    static bool WriteParsedIsaCsvFile(const std::string&      isa_text,
+                                      const std::string&      device,
+                                      bool                    add_line_numbers,
+                                      const std::string&      filename,
+                                      BeFileSink&             sink,
+                                      LoggingCallbackFunction callback,
+                                      const Config*           config           = nullptr,
+                                      uint64_t*               estimated_cycles = nullptr);
+
     // Copy a text file.
     // \param[in]  filename_from   the name of the file to copy
     // \param[in]  filename_to     the name of the file to be created
@@ -306,6 +367,14 @@ public:
                                        long&              exit_code);
 #endif
 
+    // Execute the provided command line (the executable followed by its arguments) and capture its output.
+    // On Linux, the process is launched without a shell, and its output is read while it runs.
+    // \param[in]  cmd_line the command line to execute
+    // \param[out] output   the content of stdout stream dumped by the process
+    // \param[out] error    the content of stderr stream dumped by the process
+    // Returns true if the process was launched and its output was read.
+    static bool ExecAndGrabOutput(const std::string& cmd_line, gtString& output, std::string& error);
+
     // Open new CLI log file and delete old files (older than 1 week).
     static bool  InitCLILogFile(const Config& config);
 
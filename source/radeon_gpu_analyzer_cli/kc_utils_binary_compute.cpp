@@ -7,6 +7,7 @@
 
 // C++.
 #include <cassert>
+#include <set>
 
 // Shared.
 #include "common/rga_entry_type.h"
@@ -97,53 +98,27 @@ void ComputeBinaryWorkflowStrategy::StoreOutputFilesToOutputMD(const Config&
     output_metadata_[{asic, kernel_name}] = outFiles;
 }
 
-void ComputeBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData&)
+void ComputeBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData&, std::ostream& out)
 {
     CmpilerPaths compiler_paths   = {config.compiler_bin_path, config.compiler_inc_path, config.compiler_lib_path};
     bool         should_print_cmd = config.print_process_cmd_line;
 
-    KcUtilsLightning util(output_metadata_, should_print_cmd, log_callback_);
-    beKA::beStatus   status = beKA::beStatus::kBeStatusSuccess;
-
-    // Generate CSV files with parsed ISA if required.
-    if (config.is_parsed_isa_required)
-    {
-        status = util.ParseIsaFilesToCSV(config.is_line_numbers_required) ? beKA::beStatus::kBeStatusSuccess : beKA::beStatus::kBeStatusParseIsaToCsvFailed;
-    }
-
-    // Extract Statistics if required.
-    if (status == beKA::beStatus::kBeStatusSuccess)
-    {
-        util.ExtractStatistics(config);
-    }
-
-    // Block post-processing until quality of analysis engine improves when processing llvm disassembly.
-    bool is_livereg_required = !config.livereg_analysis_file.empty();
-    if (is_livereg_required && (status == beKA::beStatus::kBeStatusSuccess))
-    {
-        // Perform Live Registers analysis if required.
-        util.PerformLiveVgprAnalysis(config);
-    }
-
-    bool is_sgpr_livereg_required = !config.sgpr_livereg_analysis_file.empty();
-    if (is_sgpr_livereg_required && (status == beKA::beStatus::kBeStatusSuccess))
-    {
-        // Perform Live Registers analysis if required.
-        util.PerformLiveSgprAnalysis(config);
-    }
-
-    bool is_cfg_required = (!config.block_cfg_file.empty() || !config.inst_cfg_file.empty());
-    if (is_cfg_required && (status == beKA::beStatus::kBeStatusSuccess))
+    // The kernels of the code object are post-processed like the outputs of an OpenCL compilation: the parsed ISA, statistics,
+    // live register analysis, CFG and metadata of each kernel are tasks of a graph, whose threads are shared with the other code objects.
+    std::set<std::string> devices;
+    for (const auto& output_md_item : output_metadata_)
     {
-        // Extract Control Flow Graph.
-        util.ExtractCFG(config);
+        devices.insert(output_md_item.first.first);
     }
 
-    // Extract CodeObj metadata if required.
-    if ((status == beKA::beStatus::kBeStatusSuccess) && !config.metadata_file.empty())
+    KcTaskGraph              post_processing_graph(should_print_cmd ? 1 : config.jobs, true);
+    KcPostProcessorLightning post_processor(config, compiler_paths, should_print_cmd, log_callback_);
+    for (const std::string& device : devices)
     {
-        util.ExtractMetadata(compiler_paths, config.metadata_file);
+        post_processor.AddDeviceTasks(device, output_metadata_, post_processing_graph);
     }
+    post_processing_graph.Wait();
+    post_processor.Report(out);
 }
 
 bool ComputeBinaryWorkflowStrategy::GenerateSessionMetadataFile(const Config& config)
@@ -28,7 +28,7 @@ public:
                                     std::string&                              error_msg) override;
 
     // Perform post-processing actions for compute workflows.
-    void RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md) override;
+    void RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md, std::ostream& out) override;
 
     // Generates the metadata for the binary.
     bool GenerateSessionMetadataFile(const Config& config) override;
@@ -8,6 +8,7 @@
 #define RGA_RADEONGPUANALYZERCLI_SRC_KC_UTILS_BINARY_DEFAULT_H_
 
 // C++.
+#include <ostream>
 #include <vector>
 
 // Backend
@@ -38,8 +39,8 @@ public:
                                             const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md,
                                             std::string&                              error_msg) = 0;
 
-    // Perform post-processing actions.
-    virtual void RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md) = 0;
+    // Perform post-processing actions. The console output of the steps is written to "out".
+    virtual void RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md, std::ostream& out) = 0;
 
     // Generates the metadata for the binary.
     virtual bool GenerateSessionMetadataFile(const Config& config) = 0;
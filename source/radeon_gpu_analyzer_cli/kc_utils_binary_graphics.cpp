@@ -126,7 +126,7 @@ void GraphicsBinaryWorkflowStrategy::StoreOutputFilesToOutputMD(const Config&
     }
 }
 
-void GraphicsBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData&)
+void GraphicsBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData&, std::ostream&)
 {
     const auto&   suffixes = beProgramBuilderBinary::GetStageFileSuffixesFromApi(graphics_api_);
     KcUtilsVulkan vk_util(output_metadata_, "", log_callback_, suffixes);
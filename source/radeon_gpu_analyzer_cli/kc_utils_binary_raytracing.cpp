@@ -19,6 +19,7 @@
 #include "radeon_gpu_analyzer_cli/kc_utils_dxr.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_vulkan.h"
 #include "radeon_gpu_analyzer_cli/kc_utils.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 #include "radeon_gpu_analyzer_cli/kc_xml_writer.h"
 
 beWaveSize ExtractWaveSizeForShaderSubtype(const BeAmdPalMetaData::PipelineMetaData& pipeline, BeAmdPalMetaData::ShaderSubtype shader_subtype)
@@ -111,7 +112,7 @@ beKA::beStatus RayTracingBinaryWorkflowStrategy::WriteOutputFiles(const Config&
     return status;
 }
 
-void RayTracingBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md)
+void RayTracingBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& config, const BeAmdPalMetaData::PipelineMetaData& amdpal_pipeline_md, std::ostream&)
 {
     KcUtilsDxr     util(output_metadata_, config.print_process_cmd_line, log_callback_);
     beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
@@ -119,12 +120,14 @@ void RayTracingBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& conf
     // Generate CSV files with parsed ISA if required.
     if (config.is_parsed_isa_required)
     {
+        KcTrace::Span span(kTraceCategoryPhase, "CSV conversion");
         status = util.ParseIsaFilesToCSV(config.is_line_numbers_required) ? beKA::beStatus::kBeStatusSuccess : beKA::beStatus::kBeStatusParseIsaToCsvFailed;
     }
 
     // Extract Statistics if required.
     if (status == beKA::beStatus::kBeStatusSuccess)
     {
+        KcTrace::Span span(kTraceCategoryPhase, "Statistics");
         util.ExtractStatistics(config, amdpal_pipeline_md);
     }
 
@@ -133,12 +136,14 @@ void RayTracingBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& conf
     if (is_livereg_required && (status == beKA::beStatus::kBeStatusSuccess))
     {
         // Perform Live Registers analysis if required.
+        KcTrace::Span span(kTraceCategoryPhase, "Liveness");
         status = util.PerformLiveVgprAnalysis(config) ? beKA::beStatus::kBeStatusSuccess : beKA::beStatus::kBeStatusParseIsaToCsvFailed;
     }
     bool is_live_sgpr_required = !config.sgpr_livereg_analysis_file.empty();
     if (is_live_sgpr_required && (status == beKA::beStatus::kBeStatusSuccess))
     {
         // Perform Live Registers analysis if required.
+        KcTrace::Span span(kTraceCategoryPhase, "Liveness");
         status = util.PerformLiveSgprAnalysis(config) ? beKA::beStatus::kBeStatusSuccess : beKA::beStatus::kBeStatusParseIsaToCsvFailed;
     }
 
@@ -146,6 +151,7 @@ void RayTracingBinaryWorkflowStrategy::RunPostProcessingSteps(const Config& conf
     if (is_cfg_required && (status == beKA::beStatus::kBeStatusSuccess))
     {
         // Extract Control Flow Graph.
+        KcTrace::Span span(kTraceCategoryPhase, "CFG");
         util.ExtractCFG(config);
     }
 }
@@ -15,6 +15,7 @@
 #include "common/rg_log.h"
 
 // Backend.
+#include "source/radeon_gpu_analyzer_backend/be_file_sink.h"
 #include "source/radeon_gpu_analyzer_backend/be_program_builder_lightning.h"
 #include "source/radeon_gpu_analyzer_backend/be_program_builder_binary.h"
 #include "source/radeon_gpu_analyzer_backend/be_utils.h"
@@ -51,25 +52,26 @@ std::set<std::string> KcUtilsDxr::session_output_files_ = {};
 bool KcUtilsDxr::ParseIsaFilesToCSV(bool line_numbers) const
 {
     bool ret = true;
+
+    // The sink is shared by all output files, so that its write buffer is reused.
+    BeFileSink csv_sink;
     for (const auto& output_md_item : output_metadata_)
     {
         if (output_md_item.second.status)
         {
             const RgOutputFiles& output_files = output_md_item.second;
-            std::string          isa, parsed_isa, parsed_isa_filename;
+            std::string          isa, parsed_isa_filename;
             const std::string&   device = output_md_item.first.first;
             const std::string&   entry  = output_md_item.first.second;
 
             bool status = KcUtils::ReadTextFile(output_files.isa_file, isa, nullptr);
             if (status)
             {
-                if ((status = KcUtilsVulkan::GetParsedIsaCsvText(isa, device, line_numbers, parsed_isa)) == true)
+                status = (KcUtils::GetParsedISAFileName(output_files.isa_file, parsed_isa_filename) == beKA::kBeStatusSuccess);
+                if (status)
                 {
-                    status = (KcUtils::GetParsedISAFileName(output_files.isa_file, parsed_isa_filename) == beKA::kBeStatusSuccess);
-                    if (status)
-                    {
-                        status = (KcUtilsVulkan::WriteIsaToFile(parsed_isa_filename, parsed_isa, log_callback_) == beKA::kBeStatusSuccess);
-                    }
+                    // Stream the ISA CSV to disk.
+                    status = KcUtils::WriteParsedIsaCsvFile(isa, device, line_numbers, parsed_isa_filename, csv_sink, log_callback_);
                     if (status)
                     {
                         output_metadata_[{device, entry}].isa_csv_file = parsed_isa_filename;
@@ -125,7 +127,7 @@ bool KcUtilsDxr::PerformLiveVgprAnalysis(const Config& config) const
             if (!livereg_out_filename.isEmpty())
             {
                 KcUtils::PerformLiveRegisterAnalysis(
-                    isa_filename, device_gtstr, livereg_out_filename, log_callback_, config.print_process_cmd_line, false, output_files.wave_size);
+                    isa_filename, device_gtstr, livereg_out_filename, log_callback_, false, output_files.wave_size);
                 if (BeUtils::IsFilePresent(livereg_out_filename.asASCIICharArray()))
                 {
                     // Store the name of livereg output file in the RGA output files metadata.
@@ -196,7 +198,7 @@ bool KcUtilsDxr::PerformLiveSgprAnalysis(const Config& config) const
             if (!livereg_out_filename.isEmpty())
             {
                 KcUtils::PerformLiveRegisterAnalysis(
-                    isa_filename, device_gtstr, livereg_out_filename, log_callback_, config.print_process_cmd_line, true, output_files.wave_size);
+                    isa_filename, device_gtstr, livereg_out_filename, log_callback_, true, output_files.wave_size);
                 if (BeUtils::IsFilePresent(livereg_out_filename.asASCIICharArray()))
                 {
                     // Store the name of livereg output file in the RGA output files metadata.
@@ -266,7 +268,7 @@ bool KcUtilsDxr::ExtractCFG(const Config& config) const
             if (!cfg_out_filename.isEmpty())
             {
                 KcUtils::GenerateControlFlowGraph(
-                    isa_filename, device_gtstr, cfg_out_filename, log_callback_, !config.inst_cfg_file.empty(), config.print_process_cmd_line);
+                    isa_filename, device_gtstr, cfg_out_filename, log_callback_, !config.inst_cfg_file.empty());
 
                 if (!BeUtils::IsFilePresent(cfg_out_filename.asASCIICharArray()))
                 {
@@ -5,7 +5,10 @@
 /// @brief Implementation for OpenCL helper functions.
 //=============================================================================
 // C++
+#include <algorithm>
+#include <filesystem>
 #include <sstream>
+#include <system_error>
 
 // External.
 #include "external/amdt_os_wrappers/Include/osFilePath.h"
@@ -15,15 +18,18 @@
 #include "common/rga_shared_utils.h"
 
 // Backend.
+#include "radeon_gpu_analyzer_backend/be_file_sink.h"
 #include "radeon_gpu_analyzer_backend/be_metadata_parser.h"
 #include "radeon_gpu_analyzer_backend/be_program_builder_lightning.h"
 
 // Local.
+#include "radeon_gpu_analyzer_cli/kc_build_cache.h"
 #include "radeon_gpu_analyzer_cli/kc_cli_string_constants.h"
 #include "radeon_gpu_analyzer_cli/kc_statistics_device_props.h"
 #include "radeon_gpu_analyzer_cli/kc_utils_lightning.h"
 #include "radeon_gpu_analyzer_cli/kc_utils.h"
 #include "radeon_gpu_analyzer_cli/kc_xml_writer.h"
+#include "radeon_gpu_analyzer_cli/kc_trace.h"
 
 const char* const kStrKernelName = "Kernel name: ";
 
@@ -46,17 +52,17 @@ static const std::string kOpenclAttributeQualifierToken       = "__attribute__";
 static const std::string kOpenclPragmaToken                   = "pragma";
 
 
-static void LogPreStep(const std::string& msg, const std::string& device = "")
+static void LogPreStep(std::ostream& out, const std::string& msg, const std::string& device = "")
 {
-    std::cout << msg << device << "... ";
+    out << msg << device << "... ";
 }
 
-static void LogResult(bool result)
+static void LogResult(std::ostream& out, bool result)
 {
-    std::cout << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
+    out << (result ? kStrInfoSuccess : kStrInfoFailed) << std::endl;
 }
 
-void KcUtilsLightning::LogErrorStatus(beKA::beStatus status, const std::string& error_msg)
+void KcUtilsLightning::LogErrorStatus(beKA::beStatus status, const std::string& error_msg, std::ostream& out)
 {
     const char* kStrErrorCannotFindBinary = "Error: cannot find binary file.";
     switch (status)
@@ -64,356 +70,298 @@ void KcUtilsLightning::LogErrorStatus(beKA::beStatus status, const std::string&
     case beKA::beStatus::kBeStatusSuccess:
         break;
     case beKA::beStatus::kBeStatusLightningCompilerLaunchFailed:
-        std::cout << std::endl << kStrErrorCannotInvokeCompiler << std::endl;
+        out << std::endl << kStrErrorCannotInvokeCompiler << std::endl;
         break;
     case beKA::beStatus::kBeStatusLightningCompilerGeneratedError:
-        std::cout << std::endl << kStrErrorOpenclOfflineCompileError << std::endl;
-        std::cout << error_msg << std::endl;
+        out << std::endl << kStrErrorOpenclOfflineCompileError << std::endl;
+        out << error_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusNoOutputFileGenerated:
-        std::cout << std::endl << kStrErrorOpenclOfflineNoOutputFileGenerated << std::endl;
+        out << std::endl << kStrErrorOpenclOfflineNoOutputFileGenerated << std::endl;
         break;
     case beKA::beStatus::kBeStatusNoBinaryForDevice:
-        std::cout << std::endl << kStrErrorCannotFindBinary << std::endl;
+        out << std::endl << kStrErrorCannotFindBinary << std::endl;
         break;
     case beKA::beStatus::kBeStatusLightningDisassembleFailed:
-        std::cout << std::endl << kStrErrorOpenclOfflineDisassemblerError << std::endl;
-        std::cout << error_msg << std::endl;
+        out << std::endl << kStrErrorOpenclOfflineDisassemblerError << std::endl;
+        out << error_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusLightningCompilerTimeOut:
-        std::cout << std::endl << kStrErrorOpenclOfflineCompileTimeout << std::endl;
-        std::cout << error_msg << std::endl;
+        out << std::endl << kStrErrorOpenclOfflineCompileTimeout << std::endl;
+        out << error_msg << std::endl;
         break;
     case beKA::beStatus::kBeStatusLightningSplitIsaFailed:
-        std::cout << std::endl << kStrErrorOpenclOfflineSplitIsaError << std::endl;
-        std::cout << error_msg << std::endl;
+        out << std::endl << kStrErrorOpenclOfflineSplitIsaError << std::endl;
+        out << error_msg << std::endl;
         break;
     default:
-        std::cout << std::endl << (error_msg.empty() ? kStrErrorUnknownCompilationStatus : error_msg) << std::endl;
+        out << std::endl << (error_msg.empty() ? kStrErrorUnknownCompilationStatus : error_msg) << std::endl;
         break;
     }
 }
 
-bool KcUtilsLightning::ParseIsaFilesToCSV(bool line_numbers) const
+// Make "target_filename" a copy of "source_filename": a hard link if possible, or a copy of the file otherwise.
+static bool ShareOutputFile(const std::string& source_filename, const std::string& target_filename)
 {
-    bool ret = true;
-    for (const auto& output_md_item : output_metadata_)
+    std::error_code error;
+    bool            ret = std::filesystem::equivalent(source_filename, target_filename, error);
+    if (!ret)
     {
-        if (output_md_item.second.status)
-        {
-            const RgOutputFiles& output_files = output_md_item.second;
-            std::string          isa, parsed_isa, parsed_isa_filename;
-            const std::string&   device = output_md_item.first.first;
-            const std::string&   entry  = output_md_item.first.second;
-
-            bool status = KcUtils::ReadTextFile(output_files.isa_file, isa, nullptr);
-            if (status)
-            {
-                if ((status = KcUtilsLightning::GetParsedIsaCsvText(isa, device, line_numbers, parsed_isa)) == true)
-                {
-                    status = (KcUtils::GetParsedISAFileName(output_files.isa_file, parsed_isa_filename) == beKA::kBeStatusSuccess);
-                    if (status)
-                    {
-                        status = (KcUtilsLightning::WriteIsaToFile(parsed_isa_filename, parsed_isa, log_callback_) == beKA::kBeStatusSuccess);
-                    }
-                    if (status)
-                    {
-                        output_metadata_[{device, entry}].isa_csv_file = parsed_isa_filename;
-                    }
-                }
-
-                if (!status)
-                {
-                    RgLog::stdErr << kStrErrorFailedToConvertToCsvFormat << output_files.isa_file << std::endl;
-                }
-            }
-            ret &= status;
-        }
+        std::filesystem::remove(target_filename, error);
+        std::filesystem::create_hard_link(source_filename, target_filename, error);
+        ret = !error || std::filesystem::copy_file(source_filename, target_filename, std::filesystem::copy_options::overwrite_existing, error);
     }
-
     return ret;
 }
 
-bool KcUtilsLightning::PerformLiveVgprAnalysis(const Config& config) const
+// Share the CSV file of a kernel with a byte-identical ISA file instead of parsing the ISA again.
+static bool ShareKernelIsaCsv(const RgOutputFiles& source_files, RgOutputFiles& output_files)
 {
-    bool              ret = true;
-    std::stringstream error_msg;
-
-    for (auto& output_md_item : output_metadata_)
+    std::string parsed_isa_filename;
+    bool        ret = !source_files.isa_csv_file.empty() && KcUtils::GetParsedISAFileName(output_files.isa_file, parsed_isa_filename) &&
+               ShareOutputFile(source_files.isa_csv_file, parsed_isa_filename);
+    if (ret)
     {
-        RgOutputFiles& output_files = output_md_item.second;
-        if (output_files.status)
-        {
-            const std::string& device               = output_md_item.first.first;
-            const std::string& entry_name           = output_md_item.first.second;
-            const std::string& entry_abbrivation    = output_md_item.second.entry_abbreviation;
-            gtString           livereg_out_filename = L"";
-            gtString           isa_filename;
-            isa_filename << output_files.isa_file.c_str();
-            gtString device_gtstr;
-            device_gtstr << device.c_str();
-
-            // Inform the user.
-            std::cout << kStrInfoPerformingLiveregAnalysisVgpr << device << kStrInfoOpenclOfflineKernelForKernel << entry_name << "... ";
-
-            // Construct a name for the output livereg file.
-            if (entry_abbrivation.empty())
-            {
-                KcUtils::ConstructOutputFileName(
-                    config.livereg_analysis_file, kStrDefaultExtensionLivereg, kStrDefaultExtensionText, entry_name, device, livereg_out_filename);
-            }
-            else
-            {
-                KcUtils::ConstructOutputFileName(
-                    config.livereg_analysis_file, kStrDefaultExtensionLivereg, kStrDefaultExtensionText, entry_abbrivation, device, livereg_out_filename);
-            }
-
-            if (!livereg_out_filename.isEmpty())
-            {
-                // Perform live VGPR analysis and force wave 64 for OpenCL kernels. Currently the wave size information
-                // is missing from LLVM disassembly, therefore Shae is not able to deduce the value from the disassembly.
-                // Therefore we will use a default of wave64 (this would be ignored by Shae for pre-RDNA targets).
-                KcUtils::PerformLiveRegisterAnalysis(
-                    isa_filename, device_gtstr, livereg_out_filename, log_callback_, config.print_process_cmd_line, false, output_files.wave_size);
-                if (BeProgramBuilderLightning::VerifyOutputFile(livereg_out_filename.asASCIICharArray()))
-                {
-                    // Store the name of livereg output file in the RGA output files metadata.
-                    output_files.livereg_file = livereg_out_filename.asASCIICharArray();
-                    std::cout << kStrInfoSuccess << std::endl;
-                }
-                else
-                {
-                    error_msg << kStrErrorCannotPerformLiveregAnalysis << " " << kStrKernelName << entry_name << std::endl;
-                    std::cout << kStrInfoFailed << std::endl;
-                    ret = false;
-                }
-            }
-            else
-            {
-                error_msg << kStrErrorOpenclOfflineFailedToCreateOutputFilenameForKernel << entry_name << std::endl;
-                ret = false;
-            }
-        }
+        output_files.isa_csv_file = parsed_isa_filename;
     }
+    return ret;
+}
 
-    if (!ret)
+// Parse the ISA of a single kernel and write it to a CSV file.
+// If "is_estimate_required" is true, the cycles of the kernel are estimated from the same parse, and stored to "estimated_cycles".
+static bool ParseKernelIsaToCSV(const Config&           config,
+                                const std::string&      device,
+                                RgOutputFiles&          output_files,
+                                bool                    is_estimate_required,
+                                LoggingCallbackFunction log_callback,
+                                uint64_t&               estimated_cycles)
+{
+    std::string isa_text, parsed_isa_filename;
+    BeFileSink  csv_sink;
+    bool        ret = KcUtils::ReadTextFile(output_files.isa_file, isa_text, nullptr) &&
+               KcUtils::GetParsedISAFileName(output_files.isa_file, parsed_isa_filename) &&
+               KcUtils::WriteParsedIsaCsvFile(isa_text,
+                                              device,
+                                              config.is_line_numbers_required,
+                                              parsed_isa_filename,
+                                              csv_sink,
+                                              log_callback,
+                                              (is_estimate_required ? &config : nullptr),
+                                              &estimated_cycles);
+    if (ret)
     {
-        log_callback_(error_msg.str());
+        output_files.isa_csv_file = parsed_isa_filename;
     }
-
     return ret;
 }
 
-bool KcUtilsLightning::PerformLiveSgprAnalysis(const Config& config) const
+// Estimate the cycles of a single kernel from its ISA file, when its ISA is not converted to CSV.
+// Returns -1 (N/A) if the ISA could not be read or parsed.
+static uint64_t EstimateKernelIsaCycles(const Config& config, const std::string& device, const RgOutputFiles& output_files)
 {
-    bool              ret = true;
-    std::stringstream error_msg;
+    std::string isa_text;
+    return (KcUtils::ReadTextFile(output_files.isa_file, isa_text, nullptr) ? KcUtils::EstimateIsaCycles(config, isa_text, device, true)
+                                                                             : static_cast<uint64_t>(-1));
+}
+
+// Perform live VGPR and SGPR analysis of a single kernel, as required by the config.
+// Both register classes are analyzed in a single pass over the ISA of the kernel.
+// The progress is printed to "out", and the errors are appended to "error_msg".
+static bool PerformKernelLiveRegisterAnalysis(const Config&           config,
+                                              const std::string&      device,
+                                              const std::string&      entry_name,
+                                              RgOutputFiles&          output_files,
+                                              LoggingCallbackFunction log_callback,
+                                              std::ostream&           out,
+                                              std::ostream&           error_msg)
+{
+    bool ret = true;
 
-    for (auto& output_md_item : output_metadata_)
+    const bool is_vgpr_required = !config.livereg_analysis_file.empty();
+    const bool is_sgpr_required = !config.sgpr_livereg_analysis_file.empty();
+
+    const std::string& entry_abbrivation = output_files.entry_abbreviation;
+    const std::string& file_entry_name   = (entry_abbrivation.empty() ? entry_name : entry_abbrivation);
+    gtString           vgpr_out_filename = L"";
+    gtString           sgpr_out_filename = L"";
+    gtString           isa_filename;
+    isa_filename << output_files.isa_file.c_str();
+    gtString device_gtstr;
+    device_gtstr << device.c_str();
+
+    // Construct names for the output livereg files.
+    if (is_vgpr_required)
     {
-        RgOutputFiles& output_files = output_md_item.second;
-        if (output_files.status)
-        {
-            const std::string& device               = output_md_item.first.first;
-            const std::string& entry_name           = output_md_item.first.second;
-            const std::string& entry_abbrivation    = output_md_item.second.entry_abbreviation;
-            gtString           livereg_out_filename = L"";
-            gtString           isa_filename;
-            isa_filename << output_files.isa_file.c_str();
-            gtString device_gtstr;
-            device_gtstr << device.c_str();
+        KcUtils::ConstructOutputFileName(
+            config.livereg_analysis_file, kStrDefaultExtensionLivereg, kStrDefaultExtensionText, file_entry_name, device, vgpr_out_filename);
+    }
+    if (is_sgpr_required)
+    {
+        KcUtils::ConstructOutputFileName(config.sgpr_livereg_analysis_file,
+                                         kStrDefaultExtensionLiveregSgpr,
+                                         kStrDefaultExtensionText,
+                                         file_entry_name,
+                                         device,
+                                         sgpr_out_filename);
+    }
 
-            // Inform the user.
-            std::cout << kStrInfoPerformingLiveregAnalysisSgpr << device << kStrInfoOpenclOfflineKernelForKernel << entry_name << "... ";
+    if ((!is_vgpr_required || !vgpr_out_filename.isEmpty()) && (!is_sgpr_required || !sgpr_out_filename.isEmpty()))
+    {
+        // Perform live VGPR and SGPR analysis in a single pass over the ISA. The wave size is missing from LLVM disassembly,
+        // so it is taken from the kernel's metadata (this would be ignored for pre-RDNA targets).
+        KcUtils::PerformLiveRegisterAnalysis(isa_filename, device_gtstr, vgpr_out_filename, sgpr_out_filename, log_callback, output_files.wave_size);
 
-            // Construct a name for the output livereg file.
-            if (entry_abbrivation.empty())
+        if (is_vgpr_required)
+        {
+            // Inform the user.
+            out << kStrInfoPerformingLiveregAnalysisVgpr << device << kStrInfoOpenclOfflineKernelForKernel << entry_name << "... ";
+            if (BeProgramBuilderLightning::VerifyOutputFile(vgpr_out_filename.asASCIICharArray()))
             {
-                KcUtils::ConstructOutputFileName(config.sgpr_livereg_analysis_file,
-                                                 kStrDefaultExtensionLiveregSgpr,
-                                                 kStrDefaultExtensionText, 
-                                                 entry_name,
-                                                 device,
-                                                 livereg_out_filename);
+                // Store the name of livereg output file in the RGA output files metadata.
+                output_files.livereg_file = vgpr_out_filename.asASCIICharArray();
+                out << kStrInfoSuccess << std::endl;
             }
             else
             {
-                KcUtils::ConstructOutputFileName(config.sgpr_livereg_analysis_file,
-                                                 kStrDefaultExtensionLiveregSgpr,
-                                                 kStrDefaultExtensionText,
-                                                 entry_abbrivation,
-                                                 device,
-                                                 livereg_out_filename);
+                error_msg << kStrErrorCannotPerformLiveregAnalysis << " " << kStrKernelName << entry_name << std::endl;
+                out << kStrInfoFailed << std::endl;
+                ret = false;
             }
+        }
 
-            if (!livereg_out_filename.isEmpty())
+        if (is_sgpr_required)
+        {
+            // Inform the user.
+            out << kStrInfoPerformingLiveregAnalysisSgpr << device << kStrInfoOpenclOfflineKernelForKernel << entry_name << "... ";
+            if (BeProgramBuilderLightning::VerifyOutputFile(sgpr_out_filename.asASCIICharArray()))
             {
-                // Perform live SGPR analysis and force wave 64 for OpenCL kernels. Currently the wave size information
-                // is missing from LLVM disassembly, therefore Shae is not able to deduce the value from the disassembly.
-                // Therefore we will use a default of wave64 (this would be ignored by Shae for pre-RDNA targets).
-                KcUtils::PerformLiveRegisterAnalysis(
-                    isa_filename, device_gtstr, livereg_out_filename, log_callback_, config.print_process_cmd_line, true, output_files.wave_size);
-                if (BeProgramBuilderLightning::VerifyOutputFile(livereg_out_filename.asASCIICharArray()))
-                {
-                    // Store the name of livereg output file in the RGA output files metadata.
-                    output_files.livereg_sgpr_file = livereg_out_filename.asASCIICharArray();
-                    std::cout << kStrInfoSuccess << std::endl;
-                }
-                else
-                {
-                    error_msg << kStrErrorCannotPerformLiveregAnalysisSgpr << " " << kStrKernelName << entry_name << std::endl;
-                    std::cout << kStrInfoFailed << std::endl;
-                    ret = false;
-                }
+                // Store the name of livereg output file in the RGA output files metadata.
+                output_files.livereg_sgpr_file = sgpr_out_filename.asASCIICharArray();
+                out << kStrInfoSuccess << std::endl;
             }
             else
             {
-                error_msg << kStrErrorOpenclOfflineFailedToCreateOutputFilenameForKernel << entry_name << std::endl;
+                error_msg << kStrErrorCannotPerformLiveregAnalysisSgpr << " " << kStrKernelName << entry_name << std::endl;
+                out << kStrInfoFailed << std::endl;
                 ret = false;
             }
         }
     }
-
-    if (!ret)
+    else
     {
-        log_callback_(error_msg.str());
+        error_msg << kStrErrorOpenclOfflineFailedToCreateOutputFilenameForKernel << entry_name << std::endl;
+        ret = false;
     }
 
     return ret;
 }
 
-bool KcUtilsLightning::ExtractCFG(const Config& config) const
+// Extract the Control Flow Graph of a single kernel. The name of the CFG file is returned in "cfg_filename".
+// If "shared_cfg_filename" is not empty, it is the CFG of a byte-identical ISA file, which is shared instead of building the graph again.
+// The progress is printed to "out", and the errors are appended to "error_msg".
+static bool ExtractKernelCFG(const Config&           config,
+                             const std::string&      device,
+                             const std::string&      entry_name,
+                             const RgOutputFiles&    output_files,
+                             const std::string&      shared_cfg_filename,
+                             LoggingCallbackFunction log_callback,
+                             std::ostream&           out,
+                             std::ostream&           error_msg,
+                             std::string&            cfg_filename)
 {
-    bool              ret = true;
-    std::stringstream error_msg;
-
-    for (auto& output_md_item : output_metadata_)
+    bool               ret               = true;
+    const std::string& entry_abbrivation = output_files.entry_abbreviation;
+    gtString           cfg_out_filename  = L"";
+    gtString           isa_filename;
+    isa_filename << output_files.isa_file.c_str();
+    gtString device_gtstr;
+    device_gtstr << device.c_str();
+
+    bool is_per_basic_block_cfg = !config.block_cfg_file.empty();
+    out << (is_per_basic_block_cfg ? kStrInfoContructingPerBlockCfg1 : kStrInfoContructingPerInstructionCfg1) << device
+        << kStrInfoOpenclOfflineKernelForKernel << entry_name << "... ";
+
+    // Construct a name for the output CFG file.
+    std::string base_file = (is_per_basic_block_cfg ? config.block_cfg_file : config.inst_cfg_file);
+    if (entry_abbrivation.empty())
     {
-        RgOutputFiles& outputFiles = output_md_item.second;
-
-        if (outputFiles.status)
+        KcUtils::ConstructOutputFileName(base_file, KC_STR_DEFAULT_CFG_SUFFIX, kStrDefaultExtensionDot, entry_name, device, cfg_out_filename);
+    }
+    else
+    {
+        KcUtils::ConstructOutputFileName(base_file, KC_STR_DEFAULT_CFG_SUFFIX, kStrDefaultExtensionDot, entry_abbrivation, device, cfg_out_filename);
+    }
+    if (!cfg_out_filename.isEmpty())
+    {
+        cfg_filename = cfg_out_filename.asASCIICharArray();
+        if (shared_cfg_filename.empty() || !ShareOutputFile(shared_cfg_filename, cfg_filename))
         {
-            const std::string& device            = output_md_item.first.first;
-            const std::string& entry_name        = output_md_item.first.second;
-            const std::string& entry_abbrivation = output_md_item.second.entry_abbreviation;
-            gtString           cfg_out_filename = L"";
-            gtString           isa_filename;
-            isa_filename << outputFiles.isa_file.c_str();
-            gtString device_gtstr;
-            device_gtstr << device.c_str();
-
-            bool is_per_basic_block_cfg = !config.block_cfg_file.empty();
-            std::cout << (is_per_basic_block_cfg ? kStrInfoContructingPerBlockCfg1 : kStrInfoContructingPerInstructionCfg1) << device
-                      << kStrInfoOpenclOfflineKernelForKernel << entry_name << "... ";
-
-            // Construct a name for the output CFG file.
-            std::string base_file = (is_per_basic_block_cfg ? config.block_cfg_file : config.inst_cfg_file);
-            if (entry_abbrivation.empty())
-            {
-                KcUtils::ConstructOutputFileName(base_file, KC_STR_DEFAULT_CFG_SUFFIX, kStrDefaultExtensionDot, entry_name, device, cfg_out_filename);
-            }
-            else
-            {
-                KcUtils::ConstructOutputFileName(base_file, KC_STR_DEFAULT_CFG_SUFFIX, kStrDefaultExtensionDot, entry_abbrivation, device, cfg_out_filename);
-            }
-            if (!cfg_out_filename.isEmpty())
-            {
-                KcUtils::GenerateControlFlowGraph(
-                    isa_filename, device_gtstr, cfg_out_filename, log_callback_, !config.inst_cfg_file.empty(), config.print_process_cmd_line);
+            KcUtils::GenerateControlFlowGraph(
+                isa_filename, device_gtstr, cfg_out_filename, log_callback, !config.inst_cfg_file.empty());
+        }
 
-                if (!BeProgramBuilderLightning::VerifyOutputFile(cfg_out_filename.asASCIICharArray()))
-                {
-                    error_msg << kStrErrorCannotGenerateCfg << " " << kStrKernelName << entry_name << std::endl;
-                    std::cout << kStrInfoFailed << std::endl;
-                    ret = false;
-                }
-                else
-                {
-                    std::cout << kStrInfoSuccess << std::endl;
-                }
-            }
-            else
-            {
-                error_msg << kStrErrorOpenclOfflineFailedToCreateOutputFilenameForKernel << entry_name << std::endl;
-                ret = false;
-            }
+        if (!BeProgramBuilderLightning::VerifyOutputFile(cfg_filename))
+        {
+            error_msg << kStrErrorCannotGenerateCfg << " " << kStrKernelName << entry_name << std::endl;
+            out << kStrInfoFailed << std::endl;
+            cfg_filename.clear();
+            ret = false;
+        }
+        else
+        {
+            out << kStrInfoSuccess << std::endl;
         }
     }
-
-    if (!ret)
+    else
     {
-        log_callback_(error_msg.str());
+        error_msg << kStrErrorOpenclOfflineFailedToCreateOutputFilenameForKernel << entry_name << std::endl;
+        ret = false;
     }
 
     return ret;
 }
 
-beKA::beStatus KcUtilsLightning::ExtractMetadata(const CmpilerPaths& compiler_paths, const std::string& metadata_filename) const
+// Extract the AMD GPU metadata from the binary of a single device and store it to a text file.
+static beKA::beStatus ExtractDeviceMetadata(const CmpilerPaths&     compiler_paths,
+                                            const std::string&      metadata_filename,
+                                            const std::string&      device,
+                                            const std::string&      bin_filename,
+                                            bool                    should_print_cmd,
+                                            LoggingCallbackFunction log_callback)
 {
-    beKA::beStatus current_status = beKA::beStatus::kBeStatusSuccess;
-    beKA::beStatus status         = beKA::beStatus::kBeStatusSuccess;
+    static const char* kStrDefaultExtensionMd = "md";
+
+    beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
     std::string    metadata_text;
     gtString       out_filename;
-
-    // A set of already processed devices.
-    std::set<std::string> devices;
-
-    // outputMDNode is: pair{pair{device, kernel}, rgOutputFiles}.
-    for (auto& output_md_node : output_metadata_)
+    KcUtils::ConstructOutputFileName(metadata_filename, "", kStrDefaultExtensionMd, kStrDefaultExtensionText, device, out_filename);
+    if (!out_filename.isEmpty())
     {
-        if (output_md_node.second.status)
+        status = BeProgramBuilderLightning::ExtractMetadata(compiler_paths.bin, bin_filename, should_print_cmd, metadata_text);
+        if (status == beKA::beStatus::kBeStatusSuccess && !metadata_text.empty())
         {
-            const std::string& device = output_md_node.first.first;
-            if (devices.count(device) == 0)
-            {
-                devices.insert(device);
-                const std::string  bin_filename           = output_md_node.second.bin_file;
-                static const char* kStrDefaultExtensionMd = "md";
-                KcUtils::ConstructOutputFileName(metadata_filename, "", kStrDefaultExtensionMd, kStrDefaultExtensionText, device, out_filename);
-                if (!out_filename.isEmpty())
-                {
-                    current_status = BeProgramBuilderLightning::ExtractMetadata(compiler_paths.bin, bin_filename, should_print_cmd_, metadata_text);
-                    if (current_status == beKA::beStatus::kBeStatusSuccess && !metadata_text.empty())
-                    {
-                        current_status = KcUtils::WriteTextFile(out_filename.asASCIICharArray(), metadata_text, log_callback_)
-                                             ? beKA::beStatus::kBeStatusSuccess
-                                             : beKA::beStatus::kBeStatusWriteToFileFailed;
-                    }
-                }
-                else
-                {
-                    current_status = beKA::beStatus::kBeStatusLightningExtractMetadataFailed;
-                }
-            }
-            status = (current_status == beKA::beStatus::kBeStatusSuccess ? status : beKA::beStatus::kBeStatusLightningExtractMetadataFailed);
+            status = KcUtils::WriteTextFile(out_filename.asASCIICharArray(), metadata_text, log_callback) ? beKA::beStatus::kBeStatusSuccess
+                                                                                                          : beKA::beStatus::kBeStatusWriteToFileFailed;
         }
     }
-
-    if (status != beKA::beStatus::kBeStatusSuccess)
+    else
     {
-        std::stringstream msg;
-        msg << kStrErrorOpenclOfflineFailedToExtractMetadata << std::endl;
-        log_callback_(msg.str());
+        status = beKA::beStatus::kBeStatusLightningExtractMetadataFailed;
     }
-
     return status;
 }
 
 // Get the ISA size and store it to "kernelCodeProps" structure.
-static beKA::beStatus GetIsaSize(const std::string& isaFileName, KernelCodeProperties& kernelCodeProps)
+static beKA::beStatus GetIsaSize(const std::string& isa_text, KernelCodeProperties& kernelCodeProps)
 {
     beKA::beStatus status = beKA::beStatus::kBeStatusLightningGetISASizeFailed;
-    if (!isaFileName.empty())
+    if (!isa_text.empty())
     {
-        std::string isa_text;
-        if (KcUtils::ReadTextFile(isaFileName, isa_text, nullptr))
+        int isa_size = BeProgramBuilderLightning::GetIsaSize(isa_text);
+        if (isa_size != -1)
         {
-            int isa_size = BeProgramBuilderLightning::GetIsaSize(isa_text);
-            if (isa_size != -1)
-            {
-                kernelCodeProps.isa_size = isa_size;
-                status                   = beKA::beStatus::kBeStatusSuccess;
-            }
+            kernelCodeProps.isa_size = isa_size;
+            status                   = beKA::beStatus::kBeStatusSuccess;
         }
     }
 
@@ -495,7 +443,8 @@ static bool StoreStatistics(const Config&             config,
         stats_text << beKA::AnalysisData::na_or(stats.num_threads_per_group_x) << separator;
         stats_text << beKA::AnalysisData::na_or(stats.num_threads_per_group_y) << separator;
         stats_text << beKA::AnalysisData::na_or(stats.num_threads_per_group_z) << separator;
-        stats_text << beKA::AnalysisData::na_or(stats.isa_size);
+        stats_text << beKA::AnalysisData::na_or(stats.isa_size) << separator;
+        stats_text << beKA::AnalysisData::na_or(stats.estimated_cycles);
         stats_text << std::endl;
 
         ret = KcUtils::WriteTextFile(stats_filename.asASCIICharArray(), stats_text.str(), nullptr);
@@ -504,82 +453,83 @@ static bool StoreStatistics(const Config&             config,
     return ret;
 }
 
-beKA::beStatus KcUtilsLightning::ExtractStatistics(const Config& config) const
+// Extract the statistics of the kernels of a single device from the binary of the device, and store them to CSV files if required.
+// This also sets the wave size of the kernels, which is missing from the LLVM disassembly.
+// "kernel_output_files" maps the name of each kernel of the device to its output files, and "kernel_estimated_cycles" maps it to
+// the cycles that were estimated when its ISA was parsed.
+// The kernels whose ISA size cannot be read from their disassembly take the code size that was read from the symbol table
+// of the binary with their output files. The kernels that were not disassembled (statistics only) have no cycle estimate.
+static beKA::beStatus ExtractDeviceStatistics(const Config&                                config,
+                                              const std::string&                           device,
+                                              const std::string&                           bin_filename,
+                                              const std::map<std::string, RgOutputFiles*>& kernel_output_files,
+                                              const std::map<std::string, uint64_t>&       kernel_estimated_cycles)
 {
-    std::string    device = "", stat_filename = config.analysis_file, out_stat_filename;
-    beKA::beStatus status = beKA::beStatus::kBeStatusSuccess;
-
-    if (!stat_filename.empty())
-    {
-        LogPreStep(kStrInfoExtractingStats);
-    }
-
-    for (auto& output_md_item : output_metadata_)
+    const std::string& stat_filename = config.analysis_file;
+    CodePropsMap       code_props;
+    beKA::beStatus     status =
+        BeProgramBuilderLightning::ExtractKernelCodeProps(config.compiler_bin_path, bin_filename, config.print_process_cmd_line, code_props);
+    if (status == beKA::beStatus::kBeStatusSuccess)
     {
-        beKA::AnalysisData stats_data;
-        CodePropsMap       code_props;
-        const std::string& current_device = output_md_item.first.first;
-        if (device != current_device && output_md_item.second.status)
+        for (auto& kernel_code_props : code_props)
         {
-            status = BeProgramBuilderLightning::ExtractKernelCodeProps(
-                config.compiler_bin_path, output_md_item.second.bin_file, config.print_process_cmd_line, code_props);
-            if (status != beKA::beStatus::kBeStatusSuccess)
-            {
-                break;
-            }
-            for (auto& kernel_code_props : code_props)
+            if (config.function.empty() || config.function == kernel_code_props.first)
             {
-                if (config.function.empty() || config.function == kernel_code_props.first)
+                auto out_files = kernel_output_files.find(kernel_code_props.first);
+                if (out_files != kernel_output_files.end())
                 {
-                    auto out_files = output_metadata_.find({current_device, kernel_code_props.first});
-                    if (out_files != output_metadata_.end())
+                    RgOutputFiles& output_files = *out_files->second;
+                    output_files.wave_size      = BeAmdPalMetaData::GetWaveSize(kernel_code_props.second.wavefront_size);
+
+                    if (!stat_filename.empty())
                     {
-                        out_files->second.wave_size = BeAmdPalMetaData::GetWaveSize(kernel_code_props.second.wavefront_size);
+                        std::string        entry_name{kernel_code_props.first};
+                        const std::string& entry_abbrivation = output_files.entry_abbreviation;
+                        if (!entry_abbrivation.empty())
+                        {
+                            entry_name = entry_abbrivation;
+                        }
 
-                        if (!stat_filename.empty())
+                        beKA::AnalysisData stats_data;
+                        std::string        isa_text, out_stat_filename;
+                        bool               is_isa_size_known = false;
+                        if (!output_files.isa_file.empty() && KcUtils::ReadTextFile(output_files.isa_file, isa_text, nullptr))
                         {
-                            std::string        entry_name{kernel_code_props.first};
-                            const std::string& entry_abbrivation = out_files->second.entry_abbreviation;
-                            if (!entry_abbrivation.empty())
+                            is_isa_size_known = (GetIsaSize(isa_text, kernel_code_props.second) == beKA::beStatus::kBeStatusSuccess);
+                        }
+                        if (!is_isa_size_known && output_files.code_size > 0)
+                        {
+                            kernel_code_props.second.isa_size = output_files.code_size;
+                            is_isa_size_known                 = true;
+                        }
+                        if (BuildAnalysisData(kernel_code_props.second, device, stats_data))
+                        {
+                            // The rest of the statistics are still reported when the ISA size is not known.
+                            if (!is_isa_size_known)
                             {
-                                entry_name = entry_abbrivation;
+                                stats_data.isa_size = static_cast<uint64_t>(-1);
                             }
-
-                            std::string current_isa_file;
-                            KcUtils::ConstructOutputFileName(config.isa_file, "", kStrDefaultExtensionIsa, entry_name, current_device, current_isa_file);
-                            if (GetIsaSize(current_isa_file, kernel_code_props.second) &&
-                                BuildAnalysisData(kernel_code_props.second, current_device, stats_data))
+                            auto estimated_cycles       = kernel_estimated_cycles.find(kernel_code_props.first);
+                            stats_data.estimated_cycles = (estimated_cycles != kernel_estimated_cycles.end() ? estimated_cycles->second : static_cast<uint64_t>(-1));
+                            status = StoreStatistics(config, stat_filename, device, entry_name, stats_data, out_stat_filename)
+                                         ? status
+                                         : beKA::beStatus::kBeStatusWriteToFileFailed;
+                            if (status == beKA::beStatus::kBeStatusSuccess)
                             {
-                                status = StoreStatistics(config, stat_filename, current_device, entry_name, stats_data, out_stat_filename)
-                                             ? status
-                                             : beKA::beStatus::kBeStatusWriteToFileFailed;
-                                if (status == beKA::beStatus::kBeStatusSuccess)
-                                {
-                                    out_files->second.stats_file = out_stat_filename;
-                                }
+                                output_files.stats_file = out_stat_filename;
                             }
                         }
                     }
                 }
             }
-
-            device = output_md_item.first.first;
         }
     }
 
-    if (!stat_filename.empty())
-    {
-        LogResult(status == beKA::beStatus::kBeStatusSuccess);
-    }
-
     return status;
 }
 
 bool KcUtilsLightning::GetParsedIsaCsvText(const std::string& isaText, const std::string& device, bool add_line_numbers, std::string& csv_text)
 {
-    static const char* kStrCsvParsedIsaHeader            = "Address, Opcode, Operands, Functional Unit, Cycles, Binary Encoding\n";
-    static const char* kStrCsvParsedIsaHeaderLineNumbers = "Address, Source Line Number, Opcode, Operands, Functional Unit, Cycles, Binary Encoding\n";
-
     bool        ret = false;
     std::string parsed_isa;
     if (BeProgramBuilder::ParseIsaToCsv(isaText, device, parsed_isa, add_line_numbers, true) == beKA::kBeStatusSuccess)
@@ -867,7 +817,7 @@ bool KcUtilsLightning::ExtractEntries(const std::string&  file_name,
     else
     {
         // In case of error, prepSrc contains the error message printed by LC Preprocessor.
-        LogErrorStatus(status, prep_src);
+        LogErrorStatus(status, prep_src, std::cout);
     }
 
     return ret;
@@ -903,3 +853,247 @@ std::string KcUtilsLightning::PrefixWithISAHeader(const std::string& kernel_name
     kernel_isa_text_ss << kernel_isa_text;
     return kernel_isa_text_ss.str();
 }
+
+KcPostProcessorLightning::KcPostProcessorLightning(const Config&           config,
+                                                   const CmpilerPaths&     compiler_paths,
+                                                   bool                    should_print_cmd,
+                                                   LoggingCallbackFunction log_callback)
+    : config_(config)
+    , compiler_paths_(compiler_paths)
+    , should_print_cmd_(should_print_cmd)
+    , log_callback_(log_callback)
+{
+}
+
+void KcPostProcessorLightning::AddDeviceTasks(const std::string& device, RgClOutputMetadata& output_metadata, KcTaskGraph& graph)
+{
+    const bool is_stats_required    = !config_.analysis_file.empty();
+    const bool is_livereg_required  = !config_.livereg_analysis_file.empty() || !config_.sgpr_livereg_analysis_file.empty();
+    const bool is_cfg_required      = !config_.block_cfg_file.empty() || !config_.inst_cfg_file.empty();
+    const bool is_metadata_required = !config_.metadata_file.empty();
+
+    devices_.emplace_back();
+    DeviceTasks& device_tasks = devices_.back();
+    device_tasks.device       = device;
+
+    // The output files of the kernels of the device, and the binary of the device (taken from its first successfully built kernel).
+    // The tasks hold pointers to the output files, since the output metadata may grow while they run.
+    std::map<std::string, RgOutputFiles*> kernel_output_files;
+    std::string                           bin_filename;
+    for (auto iter = output_metadata.lower_bound({device, ""}); iter != output_metadata.end() && iter->first.first == device; ++iter)
+    {
+        kernel_output_files[iter->first.second] = &iter->second;
+        if (iter->second.status)
+        {
+            if (bin_filename.empty())
+            {
+                bin_filename = iter->second.bin_file;
+            }
+            device_tasks.kernels.emplace_back();
+            device_tasks.kernels.back().entry_name   = iter->first.second;
+            device_tasks.kernels.back().output_files = &iter->second;
+        }
+    }
+
+    if (!device_tasks.kernels.empty())
+    {
+        if (is_metadata_required)
+        {
+            TaskResult& result = device_tasks.metadata;
+            graph.AddTask([this, &result, device, bin_filename]() {
+                KcTrace::Context trace_context(device);
+                KcTrace::Span    span(kTraceCategoryPhase, "Metadata extraction");
+                result.is_ok = (ExtractDeviceMetadata(compiler_paths_, config_.metadata_file, device, bin_filename, should_print_cmd_, log_callback_) ==
+                                beKA::beStatus::kBeStatusSuccess);
+            });
+        }
+
+        // The ISA of each kernel is parsed once, to convert it to CSV and to estimate its cycles for the statistics.
+        std::vector<KcTaskGraph::TaskId> isa_tasks;
+        for (KernelTasks& kernel : device_tasks.kernels)
+        {
+            // The parsed ISA, the cycle estimate and the CFG only depend on the ISA text, so a kernel whose ISA file is byte-identical to
+            // the one of a kernel that was already added shares them. The ISA file starts with the kernel name, so these are the same
+            // kernel on different devices.
+            if (config_.is_parsed_isa_required || is_stats_required || is_cfg_required)
+            {
+                std::string isa_text;
+                if (KcUtils::ReadTextFile(kernel.output_files->isa_file, isa_text, nullptr))
+                {
+                    auto unique_isa = unique_isa_kernels_.emplace(KcBuildCache::ComputeKey({isa_text}), &kernel);
+                    if (!unique_isa.second)
+                    {
+                        kernel.same_isa_kernel = unique_isa.first->second;
+                    }
+                }
+            }
+
+            // The tasks that share the results of another kernel wait for its tasks.
+            std::vector<KcTaskGraph::TaskId> same_isa_task;
+            if (kernel.same_isa_kernel != nullptr)
+            {
+                same_isa_task.push_back(kernel.same_isa_kernel->isa_task);
+            }
+
+            if (config_.is_parsed_isa_required || is_stats_required)
+            {
+                kernel.isa_task = graph.AddTask(
+                    [this, &kernel, device, is_stats_required]() {
+                        KcTrace::Context   trace_context(device, kernel.entry_name);
+                        KcTrace::Span      span(kTraceCategoryPhase, config_.is_parsed_isa_required ? "CSV conversion" : "Cycle estimate");
+                        const KernelTasks* same_isa_kernel = kernel.same_isa_kernel;
+                        if (same_isa_kernel != nullptr)
+                        {
+                            kernel.estimated_cycles = same_isa_kernel->estimated_cycles;
+                        }
+
+                        if (config_.is_parsed_isa_required)
+                        {
+                            kernel.csv.is_ok =
+                                (same_isa_kernel != nullptr && same_isa_kernel->csv.is_ok &&
+                                 ShareKernelIsaCsv(*same_isa_kernel->output_files, *kernel.output_files)) ||
+                                ParseKernelIsaToCSV(config_, device, *kernel.output_files, is_stats_required, log_callback_, kernel.estimated_cycles);
+                        }
+                        else if (same_isa_kernel == nullptr)
+                        {
+                            kernel.estimated_cycles = EstimateKernelIsaCycles(config_, device, *kernel.output_files);
+                        }
+                    },
+                    same_isa_task);
+                isa_tasks.push_back(kernel.isa_task);
+            }
+        }
+
+        // The statistics take the cycle estimates of the kernels from their parsed ISA.
+        // The live register analysis depends on the wave size of the kernels, which is extracted with the statistics.
+        std::vector<KcTaskGraph::TaskId> stats_task;
+        if (is_stats_required || is_livereg_required)
+        {
+            TaskResult& result = device_tasks.stats;
+            stats_task.push_back(graph.AddTask(
+                [this, &result, &device_tasks, bin_filename, kernel_output_files]() {
+                    KcTrace::Context trace_context(device_tasks.device);
+                    KcTrace::Span    span(kTraceCategoryPhase, "Statistics");
+                    std::map<std::string, uint64_t> kernel_estimated_cycles;
+                    for (const KernelTasks& kernel : device_tasks.kernels)
+                    {
+                        kernel_estimated_cycles[kernel.entry_name] = kernel.estimated_cycles;
+                    }
+                    result.is_ok = (ExtractDeviceStatistics(config_, device_tasks.device, bin_filename, kernel_output_files, kernel_estimated_cycles) ==
+                                    beKA::beStatus::kBeStatusSuccess);
+                },
+                (is_stats_required ? isa_tasks : std::vector<KcTaskGraph::TaskId>())));
+        }
+
+        for (KernelTasks& kernel : device_tasks.kernels)
+        {
+            if (is_livereg_required)
+            {
+                graph.AddTask(
+                    [this, &kernel, device]() {
+                        KcTrace::Context trace_context(device, kernel.entry_name);
+                        KcTrace::Span    span(kTraceCategoryPhase, "Liveness");
+                        kernel.livereg.is_ok = PerformKernelLiveRegisterAnalysis(
+                            config_, device, kernel.entry_name, *kernel.output_files, log_callback_, kernel.livereg.out, kernel.livereg.error_msg);
+                    },
+                    stats_task);
+            }
+
+            if (is_cfg_required)
+            {
+                std::vector<KcTaskGraph::TaskId> same_isa_cfg_task;
+                if (kernel.same_isa_kernel != nullptr)
+                {
+                    same_isa_cfg_task.push_back(kernel.same_isa_kernel->cfg_task);
+                }
+
+                kernel.cfg_task = graph.AddTask(
+                    [this, &kernel, device]() {
+                        KcTrace::Context  trace_context(device, kernel.entry_name);
+                        KcTrace::Span     span(kTraceCategoryPhase, "CFG");
+                        const std::string shared_cfg_filename = (kernel.same_isa_kernel != nullptr ? kernel.same_isa_kernel->cfg_filename : "");
+                        kernel.cfg.is_ok                      = ExtractKernelCFG(config_,
+                                                            device,
+                                                            kernel.entry_name,
+                                                            *kernel.output_files,
+                                                            shared_cfg_filename,
+                                                            log_callback_,
+                                                            kernel.cfg.out,
+                                                            kernel.cfg.error_msg,
+                                                            kernel.cfg_filename);
+                    },
+                    same_isa_cfg_task);
+            }
+        }
+    }
+}
+
+bool KcPostProcessorLightning::Report(std::ostream& out) const
+{
+    bool ret = true;
+
+    // Parsed ISA.
+    for (const DeviceTasks& device_tasks : devices_)
+    {
+        for (const KernelTasks& kernel : device_tasks.kernels)
+        {
+            if (!kernel.csv.is_ok)
+            {
+                RgLog::stdErr << kStrErrorFailedToConvertToCsvFormat << kernel.output_files->isa_file << std::endl;
+                ret = false;
+            }
+        }
+    }
+
+    // Statistics.
+    if (!config_.analysis_file.empty())
+    {
+        bool is_stats_ok = true;
+        for (const DeviceTasks& device_tasks : devices_)
+        {
+            is_stats_ok &= device_tasks.stats.is_ok;
+        }
+        LogPreStep(out, kStrInfoExtractingStats);
+        LogResult(out, is_stats_ok);
+        ret &= is_stats_ok;
+    }
+
+    // Live register analysis and control flow graphs, each followed by its errors.
+    for (TaskResult KernelTasks::*step : {&KernelTasks::livereg, &KernelTasks::cfg})
+    {
+        bool              is_step_ok = true;
+        std::stringstream error_msg;
+        for (const DeviceTasks& device_tasks : devices_)
+        {
+            for (const KernelTasks& kernel : device_tasks.kernels)
+            {
+                const TaskResult& result = kernel.*step;
+                out << result.out.str();
+                error_msg << result.error_msg.str();
+                is_step_ok &= result.is_ok;
+            }
+        }
+
+        if (!is_step_ok)
+        {
+            log_callback_(error_msg.str());
+            ret = false;
+        }
+    }
+
+    // Code object metadata.
+    bool is_metadata_ok = true;
+    for (const DeviceTasks& device_tasks : devices_)
+    {
+        is_metadata_ok &= device_tasks.metadata.is_ok;
+    }
+    if (!is_metadata_ok)
+    {
+        std::stringstream msg;
+        msg << kStrErrorOpenclOfflineFailedToExtractMetadata << std::endl;
+        log_callback_(msg.str());
+        ret = false;
+    }
+
+    return ret;
+}
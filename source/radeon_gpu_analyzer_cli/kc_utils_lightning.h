@@ -8,7 +8,12 @@
 #ifndef RGA_RADEONGPUANALYZERCLI_SRC_KC_UTILS_LIGHTNING_H_
 #define RGA_RADEONGPUANALYZERCLI_SRC_KC_UTILS_LIGHTNING_H_
 // C++.
+#include <deque>
+#include <iostream>
+#include <map>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 
 // Backend.
 #include "source/radeon_gpu_analyzer_backend/be_include.h"
@@ -17,6 +22,7 @@
 // Local.
 #include "source/radeon_gpu_analyzer_cli/kc_data_types.h"
 #include "radeon_gpu_analyzer_cli/kc_config.h"
+#include "radeon_gpu_analyzer_cli/kc_task_graph.h"
 
 // Kernel Header Strings.
 static const std::string kLcKernelIsaHeader1 = "AMD Kernel Code for ";
@@ -27,33 +33,8 @@ static const std::string kLcKernelIsaHeader3 = "@kernel ";
 class KcUtilsLightning
 {
 public:
-    KcUtilsLightning(RgClOutputMetadata& output_metadata, bool should_print_cmd, LoggingCallbackFunction log_callback)
-        : output_metadata_(output_metadata)
-        , should_print_cmd_(should_print_cmd)
-        , log_callback_(log_callback)
-    {
-    }
-
-    // Log Error Status.
-    static void LogErrorStatus(beKA::beStatus status, const std::string& error_msg);
-
-    // Parse ISA files and generate separate files that contain parsed ISA in CSV format.
-    bool ParseIsaFilesToCSV(bool add_line_numbers) const;
-
-    // Perform live VGPR analysis.
-    bool PerformLiveVgprAnalysis(const Config& config) const;
-
-    // Perform live VGPR analysis.
-    bool PerformLiveSgprAnalysis(const Config& config) const;
-
-    // Extract program Control Flow Graph.
-    bool ExtractCFG(const Config& config) const;
-
-    // Get the AMD GPU metadata from the binary.
-    beKA::beStatus ExtractMetadata(const CmpilerPaths& compiler_paths, const std::string& metadata_filename) const;
-
-    // Extract Resource Usage (statistics) data.
-    beKA::beStatus ExtractStatistics(const Config& config) const;
+    // Log Error Status to the given stream.
+    static void LogErrorStatus(beKA::beStatus status, const std::string& error_msg, std::ostream& out);
 
     // Convert ISA text to CSV form with additional data.
     static bool GetParsedIsaCsvText(const std::string& isaText, const std::string& device, bool add_line_numbers, std::string& csvText);
@@ -69,18 +50,71 @@ public:
 
     // Delete all temporary files created by RGA.
     static void DeleteTempFiles(const RgClOutputMetadata& output_metadata);
+};
 
-private:
-    // ---- DATA ----
+// Post-processing of the OpenCL compilation outputs, as a graph of tasks with one task per (device, kernel, step).
+// The steps of different kernels and devices run concurrently, and the steps of a device can start while other devices
+// are still being compiled. The console output of the tasks is held and printed by Report(), in the order of the steps,
+// devices and kernels, so that it does not depend on the order in which the tasks ran.
+class KcPostProcessorLightning
+{
+public:
+    KcPostProcessorLightning(const Config& config, const CmpilerPaths& compiler_paths, bool should_print_cmd, LoggingCallbackFunction log_callback);
 
-    // Output Metadata.
-    RgClOutputMetadata& output_metadata_;
+    // Add the post-processing tasks of the given device to "graph": the parsed ISA, statistics, live register analysis,
+    // control flow graph and code object metadata, as required by the config.
+    // The entries of the device in "output_metadata" must not be removed until the tasks are done.
+    void AddDeviceTasks(const std::string& device, RgClOutputMetadata& output_metadata, KcTaskGraph& graph);
 
-    // Specifies whether the "-#" option (print commands) is enabled.
-    bool should_print_cmd_ = false;
+    // Print the console output and the errors of the tasks to "out". Must be called after all of the tasks are done.
+    // Returns true if all of the tasks succeeded.
+    bool Report(std::ostream& out) const;
 
-    // Log callback function.
+private:
+    // The result of a single task.
+    struct TaskResult
+    {
+        bool              is_ok = true;
+        std::stringstream out;
+        std::stringstream error_msg;
+    };
+
+    // The per-kernel tasks.
+    struct KernelTasks
+    {
+        std::string         entry_name;
+        RgOutputFiles*      output_files = nullptr;
+        TaskResult          csv;
+        TaskResult          livereg;
+        TaskResult          cfg;
+        KcTaskGraph::TaskId isa_task = 0;
+        KcTaskGraph::TaskId cfg_task = 0;
+        std::string         cfg_filename;
+
+        // The cycles that were estimated when the ISA was parsed, for the statistics (-1 if none).
+        uint64_t estimated_cycles = static_cast<uint64_t>(-1);
+
+        // A kernel with a byte-identical ISA file, whose parsed ISA, cycle estimate and CFG are shared with this kernel (nullptr if none).
+        const KernelTasks* same_isa_kernel = nullptr;
+    };
+
+    // The per-device tasks. The kernels are held in a deque, since the tasks refer to them.
+    struct DeviceTasks
+    {
+        std::string             device;
+        std::deque<KernelTasks> kernels;
+        TaskResult              stats;
+        TaskResult              metadata;
+    };
+
+    const Config&           config_;
+    CmpilerPaths            compiler_paths_;
+    bool                    should_print_cmd_ = false;
     LoggingCallbackFunction log_callback_;
+    std::deque<DeviceTasks> devices_;
 
+    // The first kernel with each unique ISA file, by the hash of the ISA text.
+    std::unordered_map<std::string, const KernelTasks*> unique_isa_kernels_;
 };
+
 #endif  // RGA_RADEONGPUANALYZERCLI_SRC_KC_UTILS_LIGHTNING_H_
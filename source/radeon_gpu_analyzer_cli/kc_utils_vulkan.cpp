@@ -11,6 +11,7 @@
 #include "external/amdt_os_wrappers/Include/osFilePath.h"
 
 // Backend.
+#include "radeon_gpu_analyzer_backend/be_file_sink.h"
 #include "radeon_gpu_analyzer_backend/emulator/parser/be_isa_parser.h"
 #include "radeon_gpu_analyzer_backend/be_program_builder_vulkan.h"
 #include "radeon_gpu_analyzer_backend/be_utils.h"
@@ -21,6 +22,7 @@
 #include "source/radeon_gpu_analyzer_cli/kc_utils.h"
 #include "radeon_gpu_analyzer_cli/kc_xml_writer.h"
 #include "source/radeon_gpu_analyzer_cli/kc_statistics_device_props.h"
+#include "source/radeon_gpu_analyzer_cli/kc_trace.h"
 
 // Vulkan statistics tags.
 static const std::string kStrVulkanStatsTitle                = "Statistics:";
@@ -36,29 +38,28 @@ bool KcUtilsVulkan::ParseIsaFilesToCSV(bool line_numbers, const std::string& dev
 {
     bool ret = true;
 
+    // The sink is shared by all output files, so that its write buffer is reused.
+    BeFileSink csv_sink;
+
     // Step through existing output items to determine which files to generate CSV ISA for.
     for (auto& output_file : metadata)
     {
         if (!output_file.isa_file.empty())
         {
-            std::string isa, parsed_isa, parsed_isa_filename;
+            std::string isa, parsed_isa_filename;
             bool        status = KcUtils::ReadTextFile(output_file.isa_file, isa, nullptr);
 
             if (status)
             {
-                // Convert the ISA text to CSV format.
-                if ((status = KcUtilsVulkan::GetParsedIsaCsvText(isa, device_string, line_numbers, parsed_isa)) == true)
+                status = (KcUtils::GetParsedISAFileName(output_file.isa_file, parsed_isa_filename) == beKA::kBeStatusSuccess);
+                if (status)
                 {
-                    status = (KcUtils::GetParsedISAFileName(output_file.isa_file, parsed_isa_filename) == beKA::kBeStatusSuccess);
+                    // Convert the ISA text to CSV format, and stream it to disk.
+                    status = KcUtils::WriteParsedIsaCsvFile(isa, device_string, line_numbers, parsed_isa_filename, csv_sink, log_callback_);
                     if (status)
                     {
-                        // Attempt to write the ISA CSV to disk.
-                        status = (KcUtilsVulkan::WriteIsaToFile(parsed_isa_filename, parsed_isa, log_callback_) == beKA::kBeStatusSuccess);
-                        if (status)
-                        {
-                            // Update the session metadata output to include the path to the ISA CSV.
-                            output_file.isa_csv_file = parsed_isa_filename;
-                        }
+                        // Update the session metadata output to include the path to the ISA CSV.
+                        output_file.isa_csv_file = parsed_isa_filename;
                     }
                 }
 
@@ -74,90 +75,75 @@ bool KcUtilsVulkan::ParseIsaFilesToCSV(bool line_numbers, const std::string& dev
     return ret;
 }
 
-bool KcUtilsVulkan::PerformLiveVgprAnalysis(const Config& conf, const std::string& device, RgVkOutputMetadata& device_md) const
+bool KcUtilsVulkan::PerformLiveRegisterAnalysis(const Config& conf, const std::string& device, RgVkOutputMetadata& device_md) const
 {
     bool ret = true;
 
-    const std::string& device_suffix = (conf.asics.empty() && !physical_adapter_name_.empty() ? "" : device);
+    const std::string& device_suffix    = (conf.asics.empty() && !physical_adapter_name_.empty() ? "" : device);
+    const bool         is_vgpr_required = !conf.livereg_analysis_file.empty();
+    const bool         is_sgpr_required = !conf.sgpr_livereg_analysis_file.empty();
     gtString           device_gtstr;
     device_gtstr << device.c_str();
 
-    std::cout << kStrInfoPerformingLiveregAnalysisVgpr << device << "... " << std::endl;
+    if (is_vgpr_required)
+    {
+        std::cout << kStrInfoPerformingLiveregAnalysisVgpr << device << "... " << std::endl;
+    }
+    if (is_sgpr_required)
+    {
+        std::cout << kStrInfoPerformingLiveregAnalysisSgpr << device << "... " << std::endl;
+    }
 
     std::size_t stage = 0;
     for (auto& stage_md : device_md)
     {
         if (!stage_md.isa_file.empty() && ret)
         {
-            std::string out_file_name;
-            gtString    out_filename_gtstr, isa_filename_gtstr;
-
-            // Construct a name for the livereg output file.
-            ret = KcUtils::ConstructOutFileName(conf.livereg_analysis_file,
-                                                vulkan_stage_file_suffix_[stage],
-                                                device_suffix,
-                                                kStrDefaultExtensionLivereg,
-                                                out_file_name,
-                                                !KcUtils::IsDirectory(conf.livereg_analysis_file));
+            std::string vgpr_out_file_name;
+            std::string sgpr_out_file_name;
+            gtString    vgpr_out_filename_gtstr, sgpr_out_filename_gtstr, isa_filename_gtstr;
 
-            if (ret && !out_file_name.empty())
+            // Construct names for the livereg output files.
+            if (is_vgpr_required)
             {
-                out_filename_gtstr << out_file_name.c_str();
-                isa_filename_gtstr << stage_md.isa_file.c_str();
-
-                KcUtils::PerformLiveRegisterAnalysis(
-                    isa_filename_gtstr, device_gtstr, out_filename_gtstr, log_callback_, conf.print_process_cmd_line, false, stage_md.wave_size);
-                ret                   = BeUtils::IsFilePresent(out_file_name);
-                stage_md.livereg_file = out_file_name;
+                ret = KcUtils::ConstructOutFileName(conf.livereg_analysis_file,
+                                                    vulkan_stage_file_suffix_[stage],
+                                                    device_suffix,
+                                                    kStrDefaultExtensionLivereg,
+                                                    vgpr_out_file_name,
+                                                    !KcUtils::IsDirectory(conf.livereg_analysis_file)) &&
+                      !vgpr_out_file_name.empty();
             }
-            else
+            if (ret && is_sgpr_required)
             {
-                RgLog::stdOut << kStrErrorFailedCreateOutputFilename << std::endl;
+                ret = KcUtils::ConstructOutFileName(conf.sgpr_livereg_analysis_file,
+                                                    vulkan_stage_file_suffix_[stage],
+                                                    device_suffix,
+                                                    kStrDefaultExtensionLiveregSgpr,
+                                                    sgpr_out_file_name,
+                                                    !KcUtils::IsDirectory(conf.sgpr_livereg_analysis_file)) &&
+                      !sgpr_out_file_name.empty();
             }
-        }
-        ++stage;
-    }
-
-    LogResult(ret);
-
-    return ret;
-}
-
-bool KcUtilsVulkan::PerformLiveSgprAnalysis(const Config& conf, const std::string& device, RgVkOutputMetadata& device_md) const
-{
-    bool ret = true;
-
-    const std::string& device_suffix = (conf.asics.empty() && !physical_adapter_name_.empty() ? "" : device);
-    gtString           device_gtstr;
-    device_gtstr << device.c_str();
 
-    std::cout << kStrInfoPerformingLiveregAnalysisSgpr << device << "... " << std::endl;
-
-    std::size_t stage = 0;
-    for (auto& stage_md : device_md)
-    {
-        if (!stage_md.isa_file.empty() && ret)
-        {
-            std::string out_file_name;
-            gtString    out_filename_gtstr, isa_filename_gtstr;
-
-            // Construct a name for the livereg output file.
-            ret = KcUtils::ConstructOutFileName(conf.sgpr_livereg_analysis_file,
-                                                vulkan_stage_file_suffix_[stage],
-                                                device_suffix,
-                                                kStrDefaultExtensionLiveregSgpr,
-                                                out_file_name,
-                                                !KcUtils::IsDirectory(conf.sgpr_livereg_analysis_file));
-
-            if (ret && !out_file_name.empty())
+            if (ret)
             {
-                out_filename_gtstr << out_file_name.c_str();
+                vgpr_out_filename_gtstr << vgpr_out_file_name.c_str();
+                sgpr_out_filename_gtstr << sgpr_out_file_name.c_str();
                 isa_filename_gtstr << stage_md.isa_file.c_str();
 
+                // Analyze the VGPRs and the SGPRs in a single pass over the ISA.
                 KcUtils::PerformLiveRegisterAnalysis(
-                    isa_filename_gtstr, device_gtstr, out_filename_gtstr, log_callback_, conf.print_process_cmd_line, stage_md.wave_size);
-                ret                        = BeUtils::IsFilePresent(out_file_name);
-                stage_md.livereg_sgpr_file = out_file_name;
+                    isa_filename_gtstr, device_gtstr, vgpr_out_filename_gtstr, sgpr_out_filename_gtstr, log_callback_, stage_md.wave_size);
+                if (is_vgpr_required)
+                {
+                    ret                   = BeUtils::IsFilePresent(vgpr_out_file_name);
+                    stage_md.livereg_file = vgpr_out_file_name;
+                }
+                if (is_sgpr_required)
+                {
+                    ret                        = ret && BeUtils::IsFilePresent(sgpr_out_file_name);
+                    stage_md.livereg_sgpr_file = sgpr_out_file_name;
+                }
             }
             else
             {
@@ -206,7 +192,7 @@ bool KcUtilsVulkan::ExtractCFG(const Config& config, const std::string& device,
                 isa_filename_gtstr << stage_md.isa_file.c_str();
 
                 KcUtils::GenerateControlFlowGraph(
-                    isa_filename_gtstr, device_gtstr, out_filename_gtstr, log_callback_, per_inst_cfg, config.print_process_cmd_line);
+                    isa_filename_gtstr, device_gtstr, out_filename_gtstr, log_callback_, per_inst_cfg);
                 ret = BeUtils::IsFilePresent(out_filename);
             }
             else
@@ -233,28 +219,26 @@ void KcUtilsVulkan::RunPostProcessingSteps(const Config& config) const
         bool               is_ok         = true;
         const std::string& device_string = device_md_node.first;
         auto&              device_md     = device_md_node.second;
+        KcTrace::Context   trace_context(device_string);
 
         // Convert ISA text to CSV if required.
         if (is_ok && config.is_parsed_isa_required)
         {
+            KcTrace::Span span(kTraceCategoryPhase, "CSV conversion");
             is_ok = ParseIsaFilesToCSV(true, device_string, device_md);
         }
 
-        // Analyze live registers (vgpr) if requested.
-        if (is_ok && !config.livereg_analysis_file.empty())
+        // Analyze live registers (vgpr and sgpr) if requested.
+        if (is_ok && (!config.livereg_analysis_file.empty() || !config.sgpr_livereg_analysis_file.empty()))
         {
-            is_ok = PerformLiveVgprAnalysis(config, device_string, device_md);
-        }
-
-        // Analyze live registers (sgpr) if requested.
-        if (is_ok && !config.sgpr_livereg_analysis_file.empty())
-        {
-            is_ok = PerformLiveSgprAnalysis(config, device_string, device_md);
+            KcTrace::Span span(kTraceCategoryPhase, "Liveness");
+            is_ok = PerformLiveRegisterAnalysis(config, device_string, device_md);
         }
 
         // Generate CFG if requested.
         if (is_ok && (!config.block_cfg_file.empty() || !config.inst_cfg_file.empty()))
         {
+            KcTrace::Span span(kTraceCategoryPhase, "CFG");
             is_ok = ExtractCFG(config, device_string, device_md);
         }
     }
@@ -274,6 +258,24 @@ void KcUtilsVulkan::DeleteTempFiles(std::vector<std::string>& temp_files)
     temp_files.clear();
 }
 
+void KcUtilsVulkan::GetOutputFiles(const std::map<std::string, RgVkOutputMetadata>&              output_metadata,
+                                   const std::array<std::string, BePipelineStage::kCount>& stage_names,
+                                   RgClOutputMetadata&                                     output_files)
+{
+    output_files.clear();
+    for (const auto& device_md : output_metadata)
+    {
+        for (int stage = 0; stage < BePipelineStage::kCount; stage++)
+        {
+            // Skip the stages that are not a part of the pipeline.
+            if (!device_md.second[stage].isa_file.empty() || !device_md.second[stage].stats_file.empty())
+            {
+                output_files[std::make_pair(device_md.first, stage_names[stage])] = device_md.second[stage];
+            }
+        }
+    }
+}
+
 // Parse the content of Vulkan stats and store values to "data" structure.
 static bool ParseVulkanStats(const std::string isa_text, const std::string& stats_text, beKA::AnalysisData& data)
 {
@@ -373,6 +375,8 @@ beKA::beStatus KcUtilsVulkan::ConvertStats(const std::string& isa_file,
         beKA::AnalysisData stats_data;
         if ((result = ParseVulkanStats(isa_text, stats_text, stats_data)) == true)
         {
+            stats_data.estimated_cycles = KcUtils::EstimateIsaCycles(config, isa_text, device, true);
+
             gtString filename_gtstr;
             filename_gtstr << stats_file.c_str();
             KcUtils::CreateStatisticsFile(filename_gtstr, config, device, stats_data, nullptr);
@@ -395,9 +399,6 @@ beKA::beStatus KcUtilsVulkan::WriteIsaToFile(const std::string& file_name, const
 
 bool KcUtilsVulkan::GetParsedIsaCsvText(const std::string& isaText, const std::string& device, bool add_line_numbers, std::string& csv_text)
 {
-    static const char* kStrCsvParsedIsaHeader            = "Address, Opcode, Operands, Functional Unit, Cycles, Binary Encoding\n";
-    static const char* kStrCsvParsedIsaHeaderLineNumbers = "Address, Source Line Number, Opcode, Operands, Functional Unit, Cycles, Binary Encoding\n";
-
     bool        ret = false;
     std::string parsed_isa;
     if (BeProgramBuilder::ParseIsaToCsv(isaText, device, parsed_isa, add_line_numbers, true) == beKA::kBeStatusSuccess)
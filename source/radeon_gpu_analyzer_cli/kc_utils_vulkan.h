@@ -51,6 +51,11 @@ public:
     // Delete temporary files.
     static void DeleteTempFiles(std::vector<std::string>& temp_files);
 
+    // Get the output files of the pipeline stages in "output_metadata", mapped by {device, stage name}.
+    static void GetOutputFiles(const std::map<std::string, RgVkOutputMetadata>&              output_metadata,
+                               const std::array<std::string, BePipelineStage::kCount>& stage_names,
+                               RgClOutputMetadata&                                     output_files);
+
     // Convert statistics file from Vulkan mode into normal RGA stats format.
     static beKA::beStatus ConvertStats(const BeVkPipelineFiles& isaFiles,
                                        const BeVkPipelineFiles& stats_files,
@@ -90,11 +95,8 @@ private:
     // Parse ISA files and generate separate files that contain parsed ISA in CSV format.
     bool ParseIsaFilesToCSV(bool add_line_numbers, const std::string& device_string, RgVkOutputMetadata& metadata) const;
 
-    // Perform the live registers analysis.
-    bool PerformLiveVgprAnalysis(const Config& config, const std::string& device_string, RgVkOutputMetadata& metadata) const;
-
-    // Perform the live registers analysis.
-    bool PerformLiveSgprAnalysis(const Config& config, const std::string& device_string, RgVkOutputMetadata& metadata) const;
+    // Perform the live registers analysis of the VGPRs and the SGPRs, as required by the config.
+    bool PerformLiveRegisterAnalysis(const Config& config, const std::string& device_string, RgVkOutputMetadata& metadata) const;
 
     // Generate the per-block or per-instruction Control Flow Graph.
     bool ExtractCFG(const Config& config, const std::string& device_string, const RgVkOutputMetadata& metadata) const;
@@ -0,0 +1,724 @@
+//=============================================================================
+/// Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief Micro-benchmark for the ISA parsing and post-processing pipeline.
+///
+/// Generates synthetic LC, LLPC and amdgpu-dis disassembly corpora of growing
+/// size, runs the text processing stages of the pipeline on them, and reports
+/// the throughput (lines per second) and the peak heap allocation of each stage.
+///
+/// With a baseline file, the time and the peak heap allocation of each stage are
+/// compared with the baseline, and the benchmark fails (exits with a non-zero code)
+/// if any of them exceeds the baseline by more than the tolerance.
+///
+/// Usage: rga_perf_bench [max_lines] [iterations] [--baseline <file>] [--tolerance <fraction>] [--update-baseline]
+///   --baseline <file>        The baseline to compare the results with (see rga_perf_bench_baseline.csv).
+///   --tolerance <fraction>   The fraction by which the time of a stage may exceed the baseline (default: 0.25).
+///   --update-baseline        Write the results to the baseline file instead of comparing them.
+//=============================================================================
+
+// C++.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Local.
+#include "radeon_gpu_analyzer_cli/kc_cli_commander_lightning.h"
+
+// Backend.
+#include "radeon_gpu_analyzer_backend/be_program_builder.h"
+#include "radeon_gpu_analyzer_backend/be_utils.h"
+#include "radeon_gpu_analyzer_backend/emulator/parser/be_isa_parser.h"
+
+// Static constants.
+
+// The sizes of the generated corpora, in lines.
+static const size_t kCorpusLineCounts[] = {1000, 10000, 100000, 1000000, 4000000};
+
+// The default upper bound on the corpus size, and the default number of runs of each stage.
+static const size_t kDefaultMaxLineCount = 1000000;
+static const int    kDefaultIterationCount = 3;
+
+// The number of lines of each kernel or shader of a corpus.
+static const size_t kLinesPerKernel = 2000;
+
+// The device that the CSV stage computes the instruction cycles for.
+static const char* kBenchDevice = "gfx1100";
+
+// The size of the header that precedes each heap allocation, and holds its size.
+static const size_t kAllocationHeaderSize = alignof(std::max_align_t);
+
+// The default fraction by which the time of a stage may exceed the baseline.
+static const double kDefaultBaselineTolerance = 0.25;
+
+// The fraction by which the peak allocation of a stage may exceed the baseline.
+// The allocation does not depend on the load of the machine, so its tolerance is tighter than the one of the time.
+static const double kBaselineAllocTolerance = 0.1;
+
+// The differences from the baseline that are within the noise of the measurement, and are not reported as regressions.
+static const double kBaselineMinTimeDifferenceMs     = 2.0;
+static const size_t kBaselineMinAllocDifferenceBytes = 64 * 1024;
+
+// The header line of the baseline file. The lines that start with '#' are comments.
+static const char* kBaselineHeader = "Stage,Format,Lines,Time (ms),Peak alloc (KB)";
+
+// Instructions that the corpora are built of, with the number of 32-bit encoding words of each.
+struct BenchInstruction
+{
+    const char* text;
+    int         word_count;
+};
+
+static const BenchInstruction kBenchInstructions[] = {
+    {"s_load_dwordx2 s[0:1], s[4:5], 0x0", 2},
+    {"s_load_dwordx4 s[8:11], s[0:1], 0x10", 2},
+    {"s_waitcnt lgkmcnt(0)", 1},
+    {"s_mov_b32 s2, 0", 1},
+    {"s_add_i32 s2, s2, 1", 1},
+    {"s_cmp_lt_i32 s2, 10", 1},
+    {"s_and_b64 exec, exec, vcc", 1},
+    {"v_mov_b32_e32 v2, 0", 1},
+    {"v_add_u32_e32 v2, v2, v0", 1},
+    {"v_readfirstlane_b32 s4, v2", 1},
+    {"v_mad_f32 v0, v1, v2, v3", 2},
+    {"v_fma_f64 v[0:1], v[2:3], v[4:5], v[6:7]", 2},
+    {"v_cmp_gt_u32_e32 vcc, s4, v0", 1},
+    {"buffer_load_dword v1, v0, s[0:3], 0 offen", 2},
+    {"global_load_dword v3, v[0:1], off", 2},
+    {"global_store_dword v[0:1], v2, off", 2},
+    {"ds_read_b32 v1, v2", 2},
+    {"ds_write_b32 v1, v2", 2},
+};
+
+// The disassembly formats of the corpora.
+enum class BenchIsaFormat
+{
+    // LC disassembly, as it is split to kernels by the OpenCL mode.
+    kLc,
+
+    // LLPC disassembly of a pipeline shader.
+    kLlpc,
+
+    // amdgpu-dis disassembly of a code object, followed by its metadata.
+    kAmdgpuDis
+};
+
+// A generated disassembly corpus.
+struct BenchCorpus
+{
+    // The name of the format of the corpus.
+    std::string format_name;
+
+    // The whole disassembly text.
+    std::string text;
+
+    // The names of the kernels in the text.
+    std::vector<std::string> kernel_names;
+
+    // The code size of each kernel, in bytes.
+    std::map<std::string, int> kernel_code_sizes;
+
+    // The disassembly of each shader, for the formats that are compiled per shader.
+    std::vector<std::string> shader_texts;
+
+    // The number of lines in the text.
+    size_t line_count = 0;
+};
+
+// The measurement of a single stage.
+struct BenchResult
+{
+    double seconds = 0;
+    size_t peak_allocated_bytes = 0;
+};
+
+// The measurement of a stage on a corpus, as it is reported and stored in the baseline.
+struct BenchRecord
+{
+    std::string stage_name;
+    std::string format_name;
+    size_t      line_count = 0;
+    double      milliseconds = 0;
+    size_t      peak_allocated_kb = 0;
+
+    // The key of the record in the baseline.
+    std::string Key() const
+    {
+        return stage_name + "," + format_name + "," + std::to_string(line_count);
+    }
+};
+
+// *** INTERNALLY LINKED SYMBOLS - START ***
+
+// The number of bytes that are currently allocated on the heap, and the peak since the last reset.
+static std::atomic<size_t> current_allocated_bytes(0);
+static std::atomic<size_t> peak_allocated_bytes(0);
+
+// The results of the stages that ran, in the order in which they ran.
+static std::vector<BenchRecord> bench_records;
+
+static void TrackAllocation(size_t size)
+{
+    size_t current = current_allocated_bytes.fetch_add(size) + size;
+    size_t peak    = peak_allocated_bytes.load();
+    while (current > peak && !peak_allocated_bytes.compare_exchange_weak(peak, current))
+    {
+    }
+}
+
+static void* AllocateTracked(size_t size)
+{
+    void* block = std::malloc(size + kAllocationHeaderSize);
+    if (block != nullptr)
+    {
+        *static_cast<size_t*>(block) = size;
+        TrackAllocation(size);
+        block = static_cast<char*>(block) + kAllocationHeaderSize;
+    }
+    return block;
+}
+
+static void FreeTracked(void* ptr)
+{
+    if (ptr != nullptr)
+    {
+        void* block = static_cast<char*>(ptr) - kAllocationHeaderSize;
+        current_allocated_bytes.fetch_sub(*static_cast<size_t*>(block));
+        std::free(block);
+    }
+}
+
+static size_t CountLines(const std::string& text)
+{
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+static size_t CountLines(const std::vector<std::string>& texts)
+{
+    size_t ret = 0;
+    for (const std::string& text : texts)
+    {
+        ret += CountLines(text);
+    }
+    return ret;
+}
+
+// Append the "// <address>: <encoding>" annotation of an instruction.
+static void AppendLcEncoding(std::mt19937& rng, int address, int word_count, std::string& line)
+{
+    char annotation[64];
+    std::snprintf(annotation, sizeof(annotation), " // %012X: %08X", address, static_cast<unsigned int>(rng()));
+    line.append(annotation);
+    if (word_count == 2)
+    {
+        std::snprintf(annotation, sizeof(annotation), " %08X", static_cast<unsigned int>(rng()));
+        line.append(annotation);
+    }
+}
+
+// Append the "; <encoding>" annotation of an instruction.
+static void AppendLlpcEncoding(std::mt19937& rng, int word_count, std::string& line)
+{
+    char annotation[32];
+    std::snprintf(annotation, sizeof(annotation), " ; %08X", static_cast<unsigned int>(rng()));
+    line.append(annotation);
+    if (word_count == 2)
+    {
+        std::snprintf(annotation, sizeof(annotation), " %08X", static_cast<unsigned int>(rng()));
+        line.append(annotation);
+    }
+}
+
+// Generate the body of a kernel: instruction lines, with a loop every few dozens of lines.
+// Returns the code size of the body, in bytes.
+static int GenerateKernelBody(std::mt19937& rng, BenchIsaFormat format, size_t line_count, const std::string& label_prefix, std::string& text)
+{
+    const size_t kInstructionCount = sizeof(kBenchInstructions) / sizeof(kBenchInstructions[0]);
+    const size_t kLoopLength       = 40;
+    int          address           = 0x1000;
+    std::string  line;
+    for (size_t i = 0; i < line_count; ++i)
+    {
+        line.clear();
+        if (i % kLoopLength == 0)
+        {
+            // Loop header label.
+            line.append(label_prefix).append(std::to_string(i / kLoopLength)).append(":");
+        }
+        else
+        {
+            const bool        is_back_branch = (i % kLoopLength == kLoopLength - 1);
+            const std::string branch_text    = "s_cbranch_scc1 " + label_prefix + std::to_string(i / kLoopLength);
+            const BenchInstruction& instruction = kBenchInstructions[rng() % kInstructionCount];
+            const int word_count = is_back_branch ? 1 : instruction.word_count;
+            line.append(format == BenchIsaFormat::kLlpc ? "  " : "\t").append(is_back_branch ? branch_text.c_str() : instruction.text);
+            if (format == BenchIsaFormat::kLlpc)
+            {
+                AppendLlpcEncoding(rng, word_count, line);
+            }
+            else
+            {
+                line.resize(std::max<size_t>(line.size(), 52), ' ');
+                AppendLcEncoding(rng, address, word_count, line);
+            }
+            address += 4 * word_count;
+        }
+        text.append(line).append("\n");
+    }
+    return address - 0x1000;
+}
+
+// Generate a corpus of the given format with (about) the given number of lines.
+static void GenerateCorpus(BenchIsaFormat format, size_t line_count, BenchCorpus& corpus)
+{
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(line_count));
+    const size_t kernel_count = std::max<size_t>(1, line_count / kLinesPerKernel);
+    const size_t kernel_lines = std::min(line_count, kLinesPerKernel);
+
+    std::stringstream metadata;
+    for (size_t k = 0; k < kernel_count; ++k)
+    {
+        const std::string kernel_name = "bench_kernel_" + std::to_string(k);
+        std::string       kernel_text;
+        if (format == BenchIsaFormat::kLc)
+        {
+            // The kernel, followed by library code that the LC appends to it, which is removed by the ISA reduction.
+            kernel_text.append(kernel_name).append(":\n");
+            corpus.kernel_code_sizes[kernel_name] = GenerateKernelBody(rng, format, kernel_lines * 9 / 10, "BB" + std::to_string(k) + "_", kernel_text);
+            GenerateKernelBody(rng, format, kernel_lines / 10, "LIB" + std::to_string(k) + "_", kernel_text);
+            corpus.text.append(kernel_text).append("\n");
+        }
+        else if (format == BenchIsaFormat::kLlpc)
+        {
+            kernel_text.append(kStrHsailDisassemblyTokenStart).append("_amdgpu_cs_main:\n");
+            GenerateKernelBody(rng, format, kernel_lines, "_L" + std::to_string(k) + "_", kernel_text);
+            kernel_text.append("end\n");
+            corpus.text.append(kernel_text);
+            corpus.shader_texts.push_back(kernel_text);
+        }
+        else
+        {
+            kernel_text.append(kernel_name).append(":\n");
+            GenerateKernelBody(rng, format, kernel_lines, ".LBB" + std::to_string(k) + "_", kernel_text);
+            corpus.text.append(kernel_text).append("\n");
+            corpus.shader_texts.push_back(kernel_text);
+
+            metadata << "      .group_segment_fixed_size: " << (k % 4) * 1024 << "\n"
+                     << "      .name:           " << kernel_name << "\n"
+                     << "      .sgpr_count:     " << 16 + k % 80 << "\n"
+                     << "      .sgpr_spill_count: 0\n"
+                     << "      .symbol:         " << kernel_name << ".kd\n"
+                     << "      .vgpr_count:     " << 8 + k % 200 << "\n"
+                     << "      .vgpr_spill_count: 0\n"
+                     << "      .wavefront_size: 64\n";
+        }
+        corpus.kernel_names.push_back(kernel_name);
+    }
+
+    if (format == BenchIsaFormat::kAmdgpuDis)
+    {
+        corpus.text.append("---\namdhsa.kernels:\n").append(metadata.str()).append("...\n");
+    }
+
+    static const char* kFormatNames[] = {"LC", "LLPC", "amdgpu-dis"};
+    corpus.format_name = kFormatNames[static_cast<int>(format)];
+    corpus.line_count  = CountLines(corpus.text);
+}
+
+// Run the given stage the given number of times.
+// Reports the best time, and the highest peak of heap allocation above the allocation level at the start of a run.
+static BenchResult RunStage(int iteration_count, const std::function<void()>& stage)
+{
+    BenchResult ret;
+    for (int i = 0; i < iteration_count; ++i)
+    {
+        const size_t base_allocated_bytes = current_allocated_bytes.load();
+        peak_allocated_bytes.store(base_allocated_bytes);
+
+        auto start = std::chrono::steady_clock::now();
+        stage();
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        ret.seconds              = (i == 0 ? duration.count() : std::min(ret.seconds, duration.count()));
+        ret.peak_allocated_bytes = std::max(ret.peak_allocated_bytes, peak_allocated_bytes.load() - base_allocated_bytes);
+    }
+    return ret;
+}
+
+static void PrintResultHeader()
+{
+    std::printf("%-38s %-11s %10s %12s %14s %16s\n", "Stage", "Format", "Lines", "Time (ms)", "Lines/s", "Peak alloc (KB)");
+}
+
+// Print the result of a stage, and record it for the baseline.
+static void PrintResult(const char* stage_name, const BenchCorpus& corpus, size_t line_count, const BenchResult& result)
+{
+    const double lines_per_second = (result.seconds > 0 ? line_count / result.seconds : 0);
+    bench_records.push_back({stage_name, corpus.format_name, line_count, result.seconds * 1000, result.peak_allocated_bytes / 1024});
+    std::printf("%-38s %-11s %10zu %12.3f %14.0f %16zu\n",
+                stage_name,
+                corpus.format_name.c_str(),
+                line_count,
+                result.seconds * 1000,
+                lines_per_second,
+                result.peak_allocated_bytes / 1024);
+}
+
+// Run the stages of the LC pipeline: split the disassembly to kernels, reduce the kernels, and parse them.
+static void BenchLc(const BenchCorpus& corpus, int iteration_count)
+{
+    KcCLICommanderLightning::IsaMap kernel_isa_texts;
+    BenchResult result = RunStage(iteration_count, [&]() {
+        kernel_isa_texts.clear();
+        KcCLICommanderLightning::SplitISAText(corpus.text, corpus.kernel_names, kernel_isa_texts);
+    });
+    PrintResult("KcCLICommanderLightning::SplitISAText", corpus, corpus.line_count, result);
+
+    KcCLICommanderLightning::IsaMap reduced_isa_texts;
+    result = RunStage(iteration_count, [&]() {
+        reduced_isa_texts = kernel_isa_texts;
+        for (auto& kernel_isa : reduced_isa_texts)
+        {
+            KcCLICommanderLightning::ReduceKernelISA(corpus.kernel_code_sizes.at(kernel_isa.first), kernel_isa.second);
+        }
+    });
+    size_t line_count = 0;
+    for (const auto& kernel_isa : kernel_isa_texts)
+    {
+        line_count += CountLines(kernel_isa.second);
+    }
+    PrintResult("KcCLICommanderLightning::ReduceISA", corpus, line_count, result);
+
+    std::vector<std::string> kernel_texts;
+    for (const auto& kernel_isa : reduced_isa_texts)
+    {
+        kernel_texts.push_back(kernel_isa.second);
+    }
+    line_count = CountLines(kernel_texts);
+
+    result = RunStage(iteration_count, [&]() {
+        for (const std::string& kernel_text : kernel_texts)
+        {
+            ParserIsa parser;
+            parser.Parse(kernel_text);
+        }
+    });
+    PrintResult("ParserIsa::Parse", corpus, line_count, result);
+
+    result = RunStage(iteration_count, [&]() {
+        for (const std::string& kernel_text : kernel_texts)
+        {
+            ParserIsa parser;
+            parser.ParseForSize(kernel_text);
+        }
+    });
+    PrintResult("ParserIsa::ParseForSize", corpus, line_count, result);
+
+    result = RunStage(iteration_count, [&]() {
+        for (const std::string& kernel_text : kernel_texts)
+        {
+            std::string csv_text;
+            BeProgramBuilder::ParseIsaToCsv(kernel_text, kBenchDevice, csv_text);
+        }
+    });
+    PrintResult("BeProgramBuilder::ParseIsaToCsv", corpus, line_count, result);
+}
+
+// Run the parsing stages on the shaders of an LLPC or amdgpu-dis corpus.
+static void BenchShaders(const BenchCorpus& corpus, int iteration_count, bool is_header_required)
+{
+    const size_t line_count = CountLines(corpus.shader_texts);
+
+    BenchResult result = RunStage(iteration_count, [&]() {
+        for (const std::string& shader_text : corpus.shader_texts)
+        {
+            ParserIsa parser;
+            parser.Parse(shader_text);
+        }
+    });
+    PrintResult("ParserIsa::Parse", corpus, line_count, result);
+
+    result = RunStage(iteration_count, [&]() {
+        for (const std::string& shader_text : corpus.shader_texts)
+        {
+            ParserIsa parser;
+            parser.ParseForSize(shader_text);
+        }
+    });
+    PrintResult("ParserIsa::ParseForSize", corpus, line_count, result);
+
+    result = RunStage(iteration_count, [&]() {
+        for (const std::string& shader_text : corpus.shader_texts)
+        {
+            std::string csv_text;
+            BeProgramBuilder::ParseIsaToCsv(shader_text, kBenchDevice, csv_text, false, is_header_required);
+        }
+    });
+    PrintResult("BeProgramBuilder::ParseIsaToCsv", corpus, line_count, result);
+}
+
+// Run the statistics extraction on an amdgpu-dis corpus.
+static void BenchCodeObjectStatistics(const BenchCorpus& corpus, int iteration_count)
+{
+    std::map<std::string, beKA::AnalysisData> statistics;
+    BenchResult result = RunStage(iteration_count, [&]() { BeUtils::ExtractCodeObjectStatistics(corpus.text, statistics); });
+    PrintResult("BeUtils::ExtractCodeObjectStatistics", corpus, corpus.line_count, result);
+}
+
+// Write the recorded results to the baseline file.
+// The times depend on the machine, so the baseline is regenerated on the machine that runs the check.
+static bool WriteBaseline(const std::string& filename, size_t max_line_count, int iteration_count)
+{
+    std::ofstream file(filename);
+    file << "# Baseline of rga_perf_bench: the best time of " << iteration_count << " runs, and the peak heap allocation of each stage.\n"
+         << "# Regenerate with a release build: rga_perf_bench " << max_line_count << " " << iteration_count << " --baseline <file> --update-baseline\n"
+         << kBaselineHeader << "\n";
+    for (const BenchRecord& record : bench_records)
+    {
+        char time_text[32];
+        std::snprintf(time_text, sizeof(time_text), "%.3f", record.milliseconds);
+        file << record.Key() << "," << time_text << "," << record.peak_allocated_kb << "\n";
+    }
+    return file.good();
+}
+
+// Read the baseline file. The records are stored by their keys.
+static bool ReadBaseline(const std::string& filename, std::map<std::string, BenchRecord>& baseline)
+{
+    std::ifstream file(filename);
+    std::string   line;
+    bool          ret = file.good();
+    while (ret && std::getline(file, line))
+    {
+        if (!line.empty() && line[0] != '#' && line != kBaselineHeader)
+        {
+            // The names of the stages and the formats do not hold commas.
+            std::vector<std::string> fields;
+            std::stringstream        line_stream(line);
+            std::string              field;
+            while (std::getline(line_stream, field, ','))
+            {
+                fields.push_back(field);
+            }
+            ret = (fields.size() == 5);
+            if (ret)
+            {
+                BenchRecord record;
+                record.stage_name        = fields[0];
+                record.format_name       = fields[1];
+                record.line_count        = std::strtoull(fields[2].c_str(), nullptr, 10);
+                record.milliseconds      = std::strtod(fields[3].c_str(), nullptr);
+                record.peak_allocated_kb = std::strtoull(fields[4].c_str(), nullptr, 10);
+                baseline[record.Key()]   = record;
+            }
+            else
+            {
+                std::cerr << "Error: invalid baseline line: " << line << std::endl;
+            }
+        }
+    }
+    return ret;
+}
+
+// Compare the recorded results with the baseline, and print the results that exceed it by more than the tolerance.
+// Returns false if any of the results exceeds the baseline.
+static bool CheckBaseline(const std::map<std::string, BenchRecord>& baseline, double tolerance)
+{
+    bool   ret           = true;
+    size_t checked_count = 0;
+    for (const BenchRecord& record : bench_records)
+    {
+        auto iter = baseline.find(record.Key());
+        if (iter != baseline.end())
+        {
+            const BenchRecord& base      = iter->second;
+            const double       max_time  = std::max(base.milliseconds * (1 + tolerance), base.milliseconds + kBaselineMinTimeDifferenceMs);
+            const double       max_alloc = std::max(base.peak_allocated_kb * (1 + kBaselineAllocTolerance),
+                                                    static_cast<double>(base.peak_allocated_kb + kBaselineMinAllocDifferenceBytes / 1024));
+            if (record.milliseconds > max_time)
+            {
+                std::printf("Regression: %s (%s, %zu lines): %.3f ms, baseline %.3f ms.\n",
+                            record.stage_name.c_str(), record.format_name.c_str(), record.line_count, record.milliseconds, base.milliseconds);
+                ret = false;
+            }
+            if (record.peak_allocated_kb > max_alloc)
+            {
+                std::printf("Regression: %s (%s, %zu lines): peak allocation %zu KB, baseline %zu KB.\n",
+                            record.stage_name.c_str(), record.format_name.c_str(), record.line_count, record.peak_allocated_kb, base.peak_allocated_kb);
+                ret = false;
+            }
+            checked_count++;
+        }
+    }
+
+    // A baseline that covers none of the results does not check anything, for example when the stages were renamed.
+    if (checked_count == 0)
+    {
+        std::cerr << "Error: none of the results is in the baseline." << std::endl;
+        ret = false;
+    }
+    std::printf("Compared %zu of %zu results with the baseline (time tolerance %.0f%%, allocation tolerance %.0f%%): %s.\n",
+                checked_count, bench_records.size(), tolerance * 100, kBaselineAllocTolerance * 100, ret ? "passed" : "FAILED");
+    return ret;
+}
+
+// *** INTERNALLY LINKED SYMBOLS - END ***
+
+// Replace the global allocation functions to measure the heap allocation of the stages.
+void* operator new(size_t size)
+{
+    void* ret = AllocateTracked(size);
+    if (ret == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ret;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocateTracked(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocateTracked(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    FreeTracked(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    FreeTracked(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    FreeTracked(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    FreeTracked(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    FreeTracked(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    FreeTracked(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t      max_line_count     = kDefaultMaxLineCount;
+    int         iteration_count    = kDefaultIterationCount;
+    std::string baseline_file;
+    double      tolerance          = kDefaultBaselineTolerance;
+    bool        is_baseline_update = false;
+    int         positional_count   = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--baseline" && i + 1 < argc)
+        {
+            baseline_file = argv[++i];
+        }
+        else if (arg == "--tolerance" && i + 1 < argc)
+        {
+            tolerance = std::max(0.0, std::strtod(argv[++i], nullptr));
+        }
+        else if (arg == "--update-baseline")
+        {
+            is_baseline_update = true;
+        }
+        else if (positional_count == 0)
+        {
+            max_line_count = std::strtoull(argv[i], nullptr, 10);
+            positional_count++;
+        }
+        else if (positional_count == 1)
+        {
+            iteration_count = std::max(1, std::atoi(argv[i]));
+            positional_count++;
+        }
+        else
+        {
+            std::cerr << "Error: unexpected argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // Read the baseline before the run, so that a missing baseline fails early.
+    std::map<std::string, BenchRecord> baseline;
+    if (!baseline_file.empty() && !is_baseline_update && !ReadBaseline(baseline_file, baseline))
+    {
+        std::cerr << "Error: cannot read the baseline file " << baseline_file << "." << std::endl;
+        return 1;
+    }
+
+    std::cout << "RGA ISA pipeline benchmark: corpora of up to " << max_line_count << " lines, best of " << iteration_count << " runs." << std::endl;
+    PrintResultHeader();
+    for (size_t line_count : kCorpusLineCounts)
+    {
+        if (line_count <= max_line_count)
+        {
+            BenchCorpus lc_corpus;
+            GenerateCorpus(BenchIsaFormat::kLc, line_count, lc_corpus);
+            BenchLc(lc_corpus, iteration_count);
+
+            BenchCorpus llpc_corpus;
+            GenerateCorpus(BenchIsaFormat::kLlpc, line_count, llpc_corpus);
+            BenchShaders(llpc_corpus, iteration_count, false);
+
+            BenchCorpus amdgpu_dis_corpus;
+            GenerateCorpus(BenchIsaFormat::kAmdgpuDis, line_count, amdgpu_dis_corpus);
+            BenchShaders(amdgpu_dis_corpus, iteration_count, true);
+            BenchCodeObjectStatistics(amdgpu_dis_corpus, iteration_count);
+            std::cout << std::endl;
+        }
+    }
+
+    int ret = 0;
+    if (!baseline_file.empty() && is_baseline_update)
+    {
+        if (WriteBaseline(baseline_file, max_line_count, iteration_count))
+        {
+            std::cout << "Baseline written to " << baseline_file << "." << std::endl;
+        }
+        else
+        {
+            std::cerr << "Error: cannot write the baseline file " << baseline_file << "." << std::endl;
+            ret = 1;
+        }
+    }
+    else if (!baseline_file.empty())
+    {
+        ret = CheckBaseline(baseline, tolerance) ? 0 : 1;
+    }
+
+    return ret;
+}
@@ -350,6 +350,9 @@ struct RgResourceUsageData
     int         cl_workgroup_y_dimension;
     int         cl_workgroup_z_dimension;
     int         isa_size;
+
+    // Estimated cycles to execute the ISA, or 0 if the estimate is not available.
+    unsigned long long estimated_cycles = 0;
 };
 
 // A structure used to hold data parsed from a livereg output file.
@@ -6,6 +6,7 @@
 //=============================================================================
 // C++.
 #include <cassert>
+#include <cstdlib>
 
 // Local.
 #include "radeon_gpu_analyzer_gui/rg_resource_usage_csv_file_parser.h"
@@ -15,9 +16,11 @@ bool RgResourceUsageCsvFileParser::ProcessLineTokens(const std::vector<std::stri
     bool ret = false;
 
     // Verify that the number of tokens matches the number of columns in the file being parsed.
-    int num_tokens = static_cast<int>(tokens.size());
-    assert(num_tokens == rgResourceUsageCsvFileColumns::kCount);
-    if (num_tokens == rgResourceUsageCsvFileColumns::kCount)
+    // Files that were generated before the estimated cycles column was added are accepted as well.
+    int  num_tokens           = static_cast<int>(tokens.size());
+    bool has_estimated_cycles = (num_tokens == rgResourceUsageCsvFileColumns::kCount);
+    assert(has_estimated_cycles || num_tokens == rgResourceUsageCsvFileColumns::kEstimatedCycles);
+    if (has_estimated_cycles || num_tokens == rgResourceUsageCsvFileColumns::kEstimatedCycles)
     {
         // Extract all info from the file's line tokens.
         resource_usage_data_.device                = tokens[rgResourceUsageCsvFileColumns::kDevice];
@@ -36,6 +39,8 @@ bool RgResourceUsageCsvFileParser::ProcessLineTokens(const std::vector<std::stri
         resource_usage_data_.cl_workgroup_y_dimension = std::atoi(tokens[rgResourceUsageCsvFileColumns::kClWorkgroupYDimension].c_str());
         resource_usage_data_.cl_workgroup_z_dimension = std::atoi(tokens[rgResourceUsageCsvFileColumns::kClWorkgroupZDimension].c_str());
         resource_usage_data_.isa_size               = std::atoi(tokens[rgResourceUsageCsvFileColumns::kIsaSize].c_str());
+        resource_usage_data_.estimated_cycles =
+            has_estimated_cycles ? std::strtoull(tokens[rgResourceUsageCsvFileColumns::kEstimatedCycles].c_str(), nullptr, 10) : 0;
         ret = true;
     }
 
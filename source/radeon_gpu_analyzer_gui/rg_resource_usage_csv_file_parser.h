@@ -51,6 +51,7 @@ private:
         kClWorkgroupYDimension,
         kClWorkgroupZDimension,
         kIsaSize,
+        kEstimatedCycles,
         kCount
     };
 };